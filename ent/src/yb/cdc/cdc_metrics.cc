@@ -65,6 +65,28 @@ METRIC_DEFINE_gauge_int64(cdc, last_readable_opid_index, "CDC Last Readable OpId
 // CDC Server Metrics
 METRIC_DEFINE_counter(server, cdc_rpc_proxy_count, "CDC Rpc Proxy Count", yb::MetricUnit::kRequests,
   "Number of CDC GetChanges requests that required proxy forwarding");
+METRIC_DEFINE_counter(server, cdc_record_cache_hits, "CDC Record Cache Hits",
+  yb::MetricUnit::kOperations,
+  "Number of write operations whose CDC records were served from the tablet record cache");
+METRIC_DEFINE_counter(server, cdc_record_cache_misses, "CDC Record Cache Misses",
+  yb::MetricUnit::kOperations,
+  "Number of write operations whose CDC records were not found in the tablet record cache");
+
+// CDC Consumer Stream metrics.
+METRIC_DEFINE_entity(cdc_consumer_stream);
+METRIC_DEFINE_counter(cdc_consumer_stream, apply_records, "CDC Consumer Applied Records",
+  yb::MetricUnit::kEntries,
+  "Number of CDC records applied on the consumer.");
+METRIC_DEFINE_counter(cdc_consumer_stream, apply_bytes, "CDC Consumer Applied Bytes",
+  yb::MetricUnit::kBytes,
+  "Size of the write requests sent to apply CDC records on the consumer.");
+METRIC_DEFINE_counter(cdc_consumer_stream, apply_write_rpcs, "CDC Consumer Write Rpcs",
+  yb::MetricUnit::kRequests,
+  "Number of successful write rpcs sent to apply CDC records on the consumer.");
+METRIC_DEFINE_histogram(cdc_consumer_stream, apply_latency, "CDC Consumer Apply Latency",
+  yb::MetricUnit::kMicroseconds,
+  "Time taken to apply all records of a GetChanges response on the consumer.",
+  60000000LU /* max int */, 2 /* digits */);
 
 namespace yb {
 namespace cdc {
@@ -84,7 +106,24 @@ CDCTabletMetrics::CDCTabletMetrics(const scoped_refptr<MetricEntity>& entity)
 
 CDCServerMetrics::CDCServerMetrics(const scoped_refptr<MetricEntity>& entity)
     : MINIT(cdc_rpc_proxy_count),
+      MINIT(cdc_record_cache_hits),
+      MINIT(cdc_record_cache_misses),
       entity_(entity) { }
+
+CDCConsumerStreamMetrics::CDCConsumerStreamMetrics(const scoped_refptr<MetricEntity>& entity)
+    : MINIT(apply_records),
+      MINIT(apply_bytes),
+      MINIT(apply_write_rpcs),
+      MINIT(apply_latency),
+      entity_(entity) { }
+
+std::shared_ptr<CDCConsumerStreamMetrics> CDCConsumerStreamMetrics::Create(
+    MetricRegistry* metric_registry, const std::string& stream_id) {
+  MetricEntity::AttributeMap attrs;
+  attrs["stream_id"] = stream_id;
+  return std::make_shared<CDCConsumerStreamMetrics>(
+      METRIC_ENTITY_cdc_consumer_stream.Instantiate(metric_registry, stream_id, attrs));
+}
 #undef MINIT
 #undef GINIT
 
@@ -46,6 +46,7 @@ template<class T>
 class AtomicGauge;
 class Histogram;
 class MetricEntity;
+class MetricRegistry;
 
 namespace cdc {
 
@@ -78,12 +79,31 @@ class CDCServerMetrics {
   explicit CDCServerMetrics(const scoped_refptr<MetricEntity>& metric_entity_server);
 
   scoped_refptr<Counter> cdc_rpc_proxy_count;
+  scoped_refptr<Counter> cdc_record_cache_hits;
+  scoped_refptr<Counter> cdc_record_cache_misses;
   // Future Metric: scoped_refptr<Counter> cdc_rpc_error_count;
 
  private:
   scoped_refptr<MetricEntity> entity_;
 };
 
+// Container for xCluster consumer metrics of records applied from a single stream.
+class CDCConsumerStreamMetrics {
+ public:
+  explicit CDCConsumerStreamMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+
+  static std::shared_ptr<CDCConsumerStreamMetrics> Create(
+      MetricRegistry* metric_registry, const std::string& stream_id);
+
+  scoped_refptr<Counter> apply_records;
+  scoped_refptr<Counter> apply_bytes;
+  scoped_refptr<Counter> apply_write_rpcs;
+  scoped_refptr<Histogram> apply_latency;
+
+ private:
+  scoped_refptr<MetricEntity> entity_;
+};
+
 } // namespace cdc
 } // namespace yb
 #endif // ENT_SRC_YB_CDC_CDC_METRICS_H
@@ -12,6 +12,9 @@
 
 #include "yb/cdc/cdc_producer.h"
 
+#include <google/protobuf/unknown_field_set.h>
+
+#include "yb/cdc/cdc_record_cache.h"
 #include "yb/cdc/cdc_service.pb.h"
 #include "yb/common/transaction.h"
 #include "yb/common/wire_protocol.h"
@@ -358,6 +361,20 @@ CHECKED_STATUS PopulateTransactionRecord(const ReplicateMsgPtr& msg,
   return Status::OK();
 }
 
+// Records shared through the record cache are added to the response already serialized, as
+// unknown fields with the number of the records field. So they are sent and parsed by consumers
+// as regular records, without being copied as messages. Responses that use the cache contain
+// only such records, to preserve the order of records.
+void AddEncodedRecord(const std::string& record, GetChangesResponsePB* resp) {
+  resp->mutable_unknown_fields()->AddLengthDelimited(
+      GetChangesResponsePB::kRecordsFieldNumber, record);
+}
+
+bool IsEncodedRecord(const google::protobuf::UnknownField& field) {
+  return field.number() == GetChangesResponsePB::kRecordsFieldNumber &&
+         field.type() == google::protobuf::UnknownField::TYPE_LENGTH_DELIMITED;
+}
+
 } // namespace
 
 Status GetChanges(const std::string& stream_id,
@@ -368,7 +385,8 @@ Status GetChanges(const std::string& stream_id,
                   const MemTrackerPtr& mem_tracker,
                   consensus::ReplicateMsgsHolder* msgs_holder,
                   GetChangesResponsePB* resp,
-                  int64_t* last_readable_opid_index) {
+                  int64_t* last_readable_opid_index,
+                  CDCRecordCache* record_cache) {
   // Request scope on transaction participant so that transactions are not removed from participant
   // while RequestScope is active.
   RequestScope request_scope;
@@ -390,16 +408,47 @@ Status GetChanges(const std::string& stream_id,
   OpId checkpoint;
   auto ordered_messages = VERIFY_RESULT(SortWrites(read_ops.messages, txn_map, &checkpoint));
 
+  const auto& tablet = *tablet_peer->tablet();
+  auto schema = tablet.schema();
+  auto schema_version = tablet.metadata()->schema_version();
   for (const auto& msg : ordered_messages) {
     switch (msg->op_type()) {
       case consensus::OperationType::UPDATE_TRANSACTION_OP:
-        RETURN_NOT_OK(PopulateTransactionRecord(msg, resp->add_records()));
+        if (record_cache) {
+          CDCRecordPB record;
+          RETURN_NOT_OK(PopulateTransactionRecord(msg, &record));
+          AddEncodedRecord(record.SerializeAsString(), resp);
+        } else {
+          RETURN_NOT_OK(PopulateTransactionRecord(msg, resp->add_records()));
+        }
         break;
 
-      case consensus::OperationType::WRITE_OP:
-        RETURN_NOT_OK(PopulateWriteRecord(msg, txn_map, stream_metadata,
-                                          *tablet_peer->tablet()->schema(), resp));
+      case consensus::OperationType::WRITE_OP: {
+        if (!record_cache) {
+          RETURN_NOT_OK(PopulateWriteRecord(msg, txn_map, stream_metadata, *schema, resp));
+          break;
+        }
+        // Records produced for a write depend only on the operation, record format and schema,
+        // so they could be shared by all streams reading this tablet.
+        auto op_id = OpId::FromPB(msg->id());
+        auto records = record_cache->Get(op_id, stream_metadata.record_format, schema_version);
+        if (!records) {
+          GetChangesResponsePB write_resp;
+          RETURN_NOT_OK(PopulateWriteRecord(msg, txn_map, stream_metadata, *schema, &write_resp));
+          auto encoded_records = std::make_shared<CDCRecordCache::EncodedRecords>();
+          encoded_records->reserve(write_resp.records_size());
+          for (const auto& record : write_resp.records()) {
+            encoded_records->push_back(record.SerializeAsString());
+          }
+          records = encoded_records;
+          record_cache->Put(
+              op_id, stream_metadata.record_format, schema_version, std::move(encoded_records));
+        }
+        for (const auto& record : *records) {
+          AddEncodedRecord(record, resp);
+        }
         break;
+      }
 
       default:
         // Nothing to do for other operation types.
@@ -417,5 +466,29 @@ Status GetChanges(const std::string& stream_id,
   return Status::OK();
 }
 
+int NumRecords(const GetChangesResponsePB& resp) {
+  const auto& unknown_fields = resp.unknown_fields();
+  int result = resp.records_size();
+  for (int i = 0; i != unknown_fields.field_count(); ++i) {
+    if (IsEncodedRecord(unknown_fields.field(i))) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+uint64_t LastRecordTime(const GetChangesResponsePB& resp) {
+  // Encoded records are serialized after regular ones.
+  const auto& unknown_fields = resp.unknown_fields();
+  for (int i = unknown_fields.field_count(); i-- > 0;) {
+    const auto& field = unknown_fields.field(i);
+    if (IsEncodedRecord(field)) {
+      CDCRecordPB record;
+      return record.ParseFromString(field.length_delimited()) ? record.time() : 0;
+    }
+  }
+  return resp.records_size() > 0 ? resp.records(resp.records_size() - 1).time() : 0;
+}
+
 }  // namespace cdc
 }  // namespace yb
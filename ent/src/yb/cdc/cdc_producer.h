@@ -31,6 +31,8 @@
 namespace yb {
 namespace cdc {
 
+class CDCRecordCache;
+
 struct StreamMetadata {
   TableId table_id;
   CDCRecordType record_type;
@@ -51,7 +53,15 @@ CHECKED_STATUS GetChanges(const std::string& stream_id,
                           const std::shared_ptr<MemTracker>& mem_tracker,
                           consensus::ReplicateMsgsHolder* msgs_holder,
                           GetChangesResponsePB* resp,
-                          int64_t* last_readable_opid_index = nullptr);
+                          int64_t* last_readable_opid_index = nullptr,
+                          CDCRecordCache* record_cache = nullptr);
+
+// Returns number of records in resp, including records added in the serialized form when the
+// record cache is used.
+int NumRecords(const GetChangesResponsePB& resp);
+
+// Returns time of the last record in resp, or 0 if there are no records.
+uint64_t LastRecordTime(const GetChangesResponsePB& resp);
 
 }  // namespace cdc
 }  // namespace yb
@@ -0,0 +1,95 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#include "yb/cdc/cdc_record_cache.h"
+
+namespace yb {
+namespace cdc {
+
+CDCRecordCache::CDCRecordCache(const MemTrackerPtr& parent_mem_tracker, size_t capacity_bytes,
+                               const scoped_refptr<Counter>& hits,
+                               const scoped_refptr<Counter>& misses)
+    : capacity_bytes_(capacity_bytes),
+      mem_tracker_(MemTracker::FindOrCreateTracker("CDCRecordCache", parent_mem_tracker)),
+      hits_(hits),
+      misses_(misses) {
+}
+
+CDCRecordCache::~CDCRecordCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_bytes_) {
+    mem_tracker_->Release(size_bytes_);
+  }
+}
+
+std::shared_ptr<const CDCRecordCache::EncodedRecords> CDCRecordCache::Get(
+    const OpId& op_id, CDCRecordFormat format, uint32_t schema_version) {
+  std::shared_ptr<const EncodedRecords> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(Key(op_id, format, schema_version));
+    if (it != entries_.end()) {
+      result = it->second.records;
+    }
+  }
+  if (result) {
+    hits_->Increment();
+  } else {
+    misses_->Increment();
+  }
+  return result;
+}
+
+void CDCRecordCache::Put(const OpId& op_id, CDCRecordFormat format, uint32_t schema_version,
+                         std::shared_ptr<const EncodedRecords> records) {
+  Entry entry;
+  entry.size_bytes = sizeof(Entry) + sizeof(EncodedRecords) +
+                     records->capacity() * sizeof(std::string);
+  for (const auto& record : *records) {
+    entry.size_bytes += record.capacity();
+  }
+  entry.records = std::move(records);
+  if (entry.size_bytes > capacity_bytes_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto size_bytes = entry.size_bytes;
+  if (!entries_.emplace(Key(op_id, format, schema_version), std::move(entry)).second) {
+    // Another stream has already cached records for this operation.
+    return;
+  }
+  size_bytes_ += size_bytes;
+  mem_tracker_->Consume(size_bytes);
+  EvictUnlocked();
+}
+
+size_t CDCRecordCache::size_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_bytes_;
+}
+
+void CDCRecordCache::EvictUnlocked() {
+  size_t evicted_bytes = 0;
+  while (size_bytes_ > capacity_bytes_ && !entries_.empty()) {
+    auto it = entries_.begin();
+    size_bytes_ -= it->second.size_bytes;
+    evicted_bytes += it->second.size_bytes;
+    entries_.erase(it);
+  }
+  if (evicted_bytes) {
+    mem_tracker_->Release(evicted_bytes);
+  }
+}
+
+}  // namespace cdc
+}  // namespace yb
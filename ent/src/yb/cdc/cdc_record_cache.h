@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef ENT_SRC_YB_CDC_CDC_RECORD_CACHE_H
+#define ENT_SRC_YB_CDC_CDC_RECORD_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "yb/cdc/cdc_service.pb.h"
+#include "yb/gutil/thread_annotations.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
+#include "yb/util/opid.h"
+
+namespace yb {
+namespace cdc {
+
+// Per tablet cache of CDC records produced from WRITE_OP entries of the WAL.
+// Decoding write batches into CDC records is the most expensive part of GetChanges, so records
+// are produced and serialized once, and then served to all streams that read the same tablet with
+// the same record format. Entries are keyed by op id, so the oldest entries are evicted first,
+// which are the ones least likely to be read again.
+class CDCRecordCache {
+ public:
+  // Serialized CDCRecordPB messages.
+  typedef std::vector<std::string> EncodedRecords;
+
+  CDCRecordCache(const MemTrackerPtr& parent_mem_tracker, size_t capacity_bytes,
+                 const scoped_refptr<Counter>& hits, const scoped_refptr<Counter>& misses);
+  ~CDCRecordCache();
+
+  // Returns records for the specified operation, or nullptr if they are not cached.
+  // Records are immutable once cached, so they could be used after eviction and without the lock.
+  std::shared_ptr<const EncodedRecords> Get(
+      const OpId& op_id, CDCRecordFormat format, uint32_t schema_version);
+
+  // Caches records that were produced for the specified operation.
+  void Put(const OpId& op_id, CDCRecordFormat format, uint32_t schema_version,
+           std::shared_ptr<const EncodedRecords> records);
+
+  size_t size_bytes() const;
+
+ private:
+  typedef std::tuple<OpId, CDCRecordFormat, uint32_t> Key;
+
+  struct Entry {
+    std::shared_ptr<const EncodedRecords> records;
+    size_t size_bytes = 0;
+  };
+
+  void EvictUnlocked() REQUIRES(mutex_);
+
+  const size_t capacity_bytes_;
+  MemTrackerPtr mem_tracker_;
+  scoped_refptr<Counter> hits_;
+  scoped_refptr<Counter> misses_;
+
+  mutable std::mutex mutex_;
+  std::map<Key, Entry> entries_ GUARDED_BY(mutex_);
+  size_t size_bytes_ GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace cdc
+}  // namespace yb
+
+#endif // ENT_SRC_YB_CDC_CDC_RECORD_CACHE_H
@@ -15,6 +15,8 @@
 #include <shared_mutex>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 
 #include <boost/algorithm/string.hpp>
 
@@ -38,17 +40,23 @@
 #include "yb/client/yb_table_name.h"
 #include "yb/client/yb_op.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/service_util.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/errno.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/shared_lock.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(cdc_read_rpc_timeout_ms, 30 * 1000,
              "Timeout used for CDC read rpc calls.  Reads normally occur cross-cluster.");
 TAG_FLAG(cdc_read_rpc_timeout_ms, advanced);
@@ -75,6 +83,18 @@ DEFINE_int32(update_min_cdc_indices_interval_secs, 60,
              "replicated index across all streams is sent to the other peers in the configuration. "
              "If flag enable_log_retention_by_op_idx is disabled, this flag has no effect.");
 
+DEFINE_int32(cdc_max_long_poll_timeout_ms, 5000,
+             "Maximum time a GetChanges request without changes waits for new changes, when "
+             "long polling is requested by the consumer.");
+TAG_FLAG(cdc_max_long_poll_timeout_ms, advanced);
+TAG_FLAG(cdc_max_long_poll_timeout_ms, runtime);
+
+DEFINE_int64(cdc_record_cache_capacity_bytes, 32_MB,
+             "Capacity of the per tablet cache of CDC records, that is shared by all streams "
+             "reading the tablet. Used only for tablets read by more than one stream. "
+             "0 disables the cache.");
+TAG_FLAG(cdc_record_cache_capacity_bytes, advanced);
+
 DECLARE_bool(enable_log_retention_by_op_idx);
 
 DECLARE_int32(cdc_checkpoint_opid_interval_ms);
@@ -94,6 +114,114 @@ constexpr int kMaxDurationForTabletLookup = 50;
 const client::YBTableName kCdcStateTableName(
     YQL_DATABASE_CQL, master::kSystemNamespaceName, master::kCdcStateTableName);
 
+namespace {
+
+// Long poll GetChanges request waiting for new changes.
+struct LongPollWait {
+  GetChangesResponsePB* resp;
+  std::shared_ptr<RpcContext> context;
+  std::shared_ptr<consensus::Consensus> consensus;
+  // Set by whoever first resumes or cancels the wait, only this one responds to the request.
+  std::atomic<bool> resumed{false};
+  std::atomic<int64_t> waiter_id{0};
+  std::atomic<rpc::ScheduledTaskId> timeout_task_id{rpc::kUninitializedScheduledTaskId};
+};
+
+void RespondLongPollError(LongPollWait* wait, const Status& status) {
+  SetupErrorAndRespond(
+      wait->resp->mutable_error(), status, CDCErrorPB::INTERNAL_ERROR, wait->context.get());
+}
+
+Status LongPollShutdownStatus() {
+  return STATUS(ServiceUnavailable, "CDC service is shutting down", "" /* msg2 */,
+                Errno(ESHUTDOWN));
+}
+
+}  // namespace
+
+class CDCServiceImpl::LongPollWaits {
+ public:
+  explicit LongPollWaits(rpc::Scheduler* scheduler) : scheduler_(scheduler) {
+    CHECK_OK(ThreadPoolBuilder("cdc-long-poll").Build(&pool_));
+  }
+
+  rpc::Scheduler& scheduler() {
+    return *scheduler_;
+  }
+
+  // Returns false and responds to the request if the service is shutting down.
+  bool Add(const std::shared_ptr<LongPollWait>& wait) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!stopped_) {
+        waits_.insert(wait);
+        return true;
+      }
+    }
+    wait->resumed.store(true, std::memory_order_release);
+    RespondLongPollError(wait.get(), LongPollShutdownStatus());
+    return false;
+  }
+
+  // Submits task that processes the request again, unless the wait was already resumed.
+  void Resume(const std::shared_ptr<LongPollWait>& wait, const std::function<void()>& task) {
+    if (wait->resumed.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    Status status;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      waits_.erase(wait);
+      status = stopped_ ? LongPollShutdownStatus() : pool_->SubmitFunc(task);
+    }
+    if (!status.ok()) {
+      Cancel(*wait);
+      RespondLongPollError(wait.get(), status);
+    }
+  }
+
+  // Unregisters the majority replicated waiter and the timeout task of the wait.
+  void Cancel(const LongPollWait& wait) {
+    auto waiter_id = wait.waiter_id.load(std::memory_order_acquire);
+    if (waiter_id != 0) {
+      wait.consensus->UnregisterMajorityReplicatedWaiter(waiter_id);
+    }
+    auto timeout_task_id = wait.timeout_task_id.load(std::memory_order_acquire);
+    if (timeout_task_id != rpc::kUninitializedScheduledTaskId) {
+      scheduler_->Abort(timeout_task_id);
+    }
+  }
+
+  void Shutdown() {
+    std::unordered_set<std::shared_ptr<LongPollWait>> waits;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopped_) {
+        return;
+      }
+      stopped_ = true;
+      waits.swap(waits_);
+    }
+    for (const auto& wait : waits) {
+      if (!wait->resumed.exchange(true, std::memory_order_acq_rel)) {
+        Cancel(*wait);
+        RespondLongPollError(wait.get(), LongPollShutdownStatus());
+      }
+    }
+    // Let already submitted requests finish, so they are not dropped without a response.
+    pool_->Wait();
+    pool_->Shutdown();
+  }
+
+ private:
+  rpc::Scheduler* const scheduler_;
+  std::unique_ptr<ThreadPool> pool_;
+
+  std::mutex mutex_;
+  std::unordered_set<std::shared_ptr<LongPollWait>> waits_ GUARDED_BY(mutex_);
+  bool stopped_ GUARDED_BY(mutex_) = false;
+};
+
 CDCServiceImpl::CDCServiceImpl(TSTabletManager* tablet_manager,
                                const scoped_refptr<MetricEntity>& metric_entity_server,
                                MetricRegistry* metric_registry)
@@ -108,6 +236,8 @@ CDCServiceImpl::CDCServiceImpl(TSTabletManager* tablet_manager,
       server->messenger());
   async_client_init_->Start();
 
+  long_poll_waits_ = std::make_shared<LongPollWaits>(&server->messenger()->scheduler());
+
   get_minimum_checkpoints_and_update_peers_thread_.reset(new std::thread(
       &CDCServiceImpl::ReadCdcMinReplicatedIndexForAllTabletsAndUpdatePeers, this));
 }
@@ -334,6 +464,27 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
     return;
   }
 
+  auto wait_deadline = CoarseMonoClock::now();
+  if (req->long_poll_timeout_ms() > 0) {
+    // Leave some time to respond before the client gives up on the request.
+    constexpr auto kLongPollResponseMargin = 100ms;
+    wait_deadline = std::min(
+        wait_deadline + std::min(req->long_poll_timeout_ms(),
+                                 static_cast<uint32_t>(FLAGS_cdc_max_long_poll_timeout_ms)) * 1ms,
+        context.GetClientDeadline() - kLongPollResponseMargin);
+  }
+
+  ProcessGetChanges(
+      req, resp, std::make_shared<RpcContext>(std::move(context)), producer_tablet, tablet_peer,
+      wait_deadline);
+}
+
+void CDCServiceImpl::ProcessGetChanges(const GetChangesRequestPB* req,
+                                       GetChangesResponsePB* resp,
+                                       std::shared_ptr<RpcContext> context,
+                                       const ProducerTabletInfo& producer_tablet,
+                                       const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+                                       CoarseTimePoint wait_deadline) {
   auto session = async_client_init_->client()->NewSession();
   OpId op_id;
 
@@ -342,32 +493,42 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   } else {
     auto result = GetLastCheckpoint(producer_tablet, session);
     RPC_CHECK_AND_RETURN_ERROR(result.ok(), result.status(), resp->mutable_error(),
-                               CDCErrorPB::INTERNAL_ERROR, context);
+                               CDCErrorPB::INTERNAL_ERROR, *context);
     op_id = *result;
   }
 
   auto record = GetStream(req->stream_id());
   RPC_CHECK_AND_RETURN_ERROR(record.ok(), record.status(), resp->mutable_error(),
-                             CDCErrorPB::INTERNAL_ERROR, context);
+                             CDCErrorPB::INTERNAL_ERROR, *context);
 
   int64_t last_readable_index;
   consensus::ReplicateMsgsHolder msgs_holder;
   MemTrackerPtr mem_tracker = GetMemTracker(tablet_peer, producer_tablet);
-  s = cdc::GetChanges(
+  auto record_cache = GetRecordCache(tablet_peer);
+  Status s = cdc::GetChanges(
       req->stream_id(), req->tablet_id(), op_id, *record->get(), tablet_peer, mem_tracker,
-      &msgs_holder, resp, &last_readable_index);
+      &msgs_holder, resp, &last_readable_index, record_cache.get());
   RPC_STATUS_RETURN_ERROR(
       s,
       resp->mutable_error(),
       s.IsNotFound() ? CDCErrorPB::CHECKPOINT_TOO_OLD : CDCErrorPB::UNKNOWN_ERROR,
-      context);
+      *context);
+
+  // Nothing new since the requested checkpoint, so wait for new changes instead of making the
+  // consumer poll again.
+  if (NumRecords(*resp) == 0 && OpId::FromPB(resp->checkpoint().op_id()) == op_id &&
+      CoarseMonoClock::now() < wait_deadline) {
+    WaitForChanges(
+        req, resp, std::move(context), producer_tablet, tablet_peer, last_readable_index,
+        wait_deadline);
+    return;
+  }
 
-  uint64_t last_record_hybrid_time = resp->records_size() > 0 ?
-      resp->records(resp->records_size() - 1).time() : 0;
+  uint64_t last_record_hybrid_time = LastRecordTime(*resp);
 
   s = UpdateCheckpoint(producer_tablet, OpId::FromPB(resp->checkpoint().op_id()), op_id, session,
                        last_record_hybrid_time);
-  RPC_STATUS_RETURN_ERROR(s, resp->mutable_error(), CDCErrorPB::INTERNAL_ERROR, context);
+  RPC_STATUS_RETURN_ERROR(s, resp->mutable_error(), CDCErrorPB::INTERNAL_ERROR, *context);
 
   {
     std::shared_ptr<consensus::Consensus> shared_consensus = tablet_peer->shared_consensus();
@@ -376,7 +537,7 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
         STATUS_SUBSTITUTE(InternalError, "Failed to get tablet $0 peer consensus",
             req->tablet_id()),
         resp->mutable_error(),
-        CDCErrorPB::INTERNAL_ERROR, context);
+        CDCErrorPB::INTERNAL_ERROR, *context);
 
     shared_consensus->UpdateCDCConsumerOpId(GetMinSentCheckpointForTablet(req->tablet_id()));
   }
@@ -389,11 +550,10 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
     tablet_metric->last_read_opid_index->set_value(lid.index());
     tablet_metric->last_readable_opid_index->set_value(last_readable_index);
     tablet_metric->last_checkpoint_opid_index->set_value(op_id.index);
-    if (resp->records_size() > 0) {
-      auto& last_record = resp->records(resp->records_size()-1);
-      tablet_metric->last_read_hybridtime->set_value(last_record.time());
+    if (NumRecords(*resp) > 0) {
+      tablet_metric->last_read_hybridtime->set_value(last_record_hybrid_time);
       tablet_metric->last_read_physicaltime->set_value(
-          HybridTime(last_record.time()).GetPhysicalValueMicros());
+          HybridTime(last_record_hybrid_time).GetPhysicalValueMicros());
       // Only count bytes responded if we are including a response payload.
       tablet_metric->rpc_payload_bytes_responded->Increment(resp->ByteSize());
     } else {
@@ -401,7 +561,61 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
     }
   }
 
-  context.RespondSuccess();
+  context->RespondSuccess();
+}
+
+void CDCServiceImpl::WaitForChanges(const GetChangesRequestPB* req,
+                                    GetChangesResponsePB* resp,
+                                    std::shared_ptr<RpcContext> context,
+                                    const ProducerTabletInfo& producer_tablet,
+                                    const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+                                    int64_t last_readable_index,
+                                    CoarseTimePoint wait_deadline) {
+  auto consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    SetupErrorAndRespond(
+        resp->mutable_error(),
+        STATUS_FORMAT(InternalError, "Failed to get tablet $0 peer consensus", req->tablet_id()),
+        CDCErrorPB::INTERNAL_ERROR, context.get());
+    return;
+  }
+
+  auto wait = std::make_shared<LongPollWait>();
+  wait->resp = resp;
+  wait->context = std::move(context);
+  wait->consensus = consensus;
+  if (!long_poll_waits_->Add(wait)) {
+    return;
+  }
+
+  // Changes are read on a separate pool, because the wait could be resumed from the raft pool,
+  // while processing the request reads and writes cdc_state table. The pool is drained on
+  // shutdown, so only this task refers to the service.
+  std::function<void()> process = [this, wait, req, producer_tablet, tablet_peer, wait_deadline] {
+    long_poll_waits_->Cancel(*wait);
+    wait->resp->Clear();
+    ProcessGetChanges(
+        req, wait->resp, wait->context, producer_tablet, tablet_peer, wait_deadline);
+  };
+  // Invoked when new changes are available or wait deadline passed, whichever happens first.
+  auto resume = [waits = long_poll_waits_, wait, process] {
+    waits->Resume(wait, process);
+  };
+
+  wait->waiter_id.store(
+      consensus->RegisterMajorityReplicatedWaiter(last_readable_index, resume),
+      std::memory_order_release);
+  if (wait->resumed.load(std::memory_order_acquire)) {
+    return;
+  }
+  auto& scheduler = long_poll_waits_->scheduler();
+  auto timeout_task_id = scheduler.Schedule(
+      [resume](const Status&) { resume(); }, wait_deadline - CoarseMonoClock::now());
+  wait->timeout_task_id.store(timeout_task_id, std::memory_order_release);
+  // The wait could be resumed before the timeout task id was stored.
+  if (wait->resumed.load(std::memory_order_acquire)) {
+    scheduler.Abort(timeout_task_id);
+  }
 }
 
 void CDCServiceImpl::UpdatePeersCdcMinReplicatedIndex(const TabletId& tablet_id,
@@ -938,6 +1152,9 @@ void CDCServiceImpl::BootstrapProducer(const BootstrapProducerRequestPB* req,
 }
 
 void CDCServiceImpl::Shutdown() {
+  if (long_poll_waits_) {
+    long_poll_waits_->Shutdown();
+  }
   if (async_client_init_) {
     async_client_init_->Shutdown();
     rpcs_.Shutdown();
@@ -1260,6 +1477,47 @@ MemTrackerPtr CDCServiceImpl::GetMemTracker(
   return it->mem_tracker;
 }
 
+std::shared_ptr<CDCRecordCache> CDCServiceImpl::GetRecordCache(
+    const std::shared_ptr<tablet::TabletPeer>& tablet_peer) {
+  if (FLAGS_cdc_record_cache_capacity_bytes <= 0) {
+    return nullptr;
+  }
+  const auto& tablet_id = tablet_peer->tablet_id();
+  {
+    SharedLock<decltype(mutex_)> l(mutex_);
+    // Records are shared only by streams reading the same tablet, so with a single stream the
+    // cache would only add copies.
+    if (tablet_checkpoints_.get<TabletTag>().count(tablet_id) <= 1) {
+      return nullptr;
+    }
+    auto it = record_caches_.find(tablet_id);
+    if (it != record_caches_.end() && it->second.tablet_peer.lock() == tablet_peer) {
+      return it->second.cache;
+    }
+  }
+
+  std::lock_guard<decltype(mutex_)> l(mutex_);
+  auto& entry = record_caches_[tablet_id];
+  if (entry.tablet_peer.lock() != tablet_peer) {
+    // Tablet peer was recreated, for instance after remote bootstrap, so records cached for the
+    // old peer could be stale.
+    entry.tablet_peer = tablet_peer;
+    entry.cache = std::make_shared<CDCRecordCache>(
+        MemTracker::FindOrCreateTracker("CDC", tablet_peer->tablet()->mem_tracker()),
+        FLAGS_cdc_record_cache_capacity_bytes, server_metrics_->cdc_record_cache_hits,
+        server_metrics_->cdc_record_cache_misses);
+    // Drop caches of tablets that are no longer hosted by this server.
+    for (auto it = record_caches_.begin(); it != record_caches_.end();) {
+      if (it->second.tablet_peer.expired()) {
+        it = record_caches_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return entry.cache;
+}
+
 Status CDCServiceImpl::CheckTabletValidForStream(const ProducerTabletInfo& info) {
   {
     SharedLock<rw_spinlock> l(mutex_);
@@ -22,6 +22,7 @@
 
 #include "yb/cdc/cdc_metrics.h"
 #include "yb/cdc/cdc_producer.h"
+#include "yb/cdc/cdc_record_cache.h"
 #include "yb/cdc/cdc_service.proxy.h"
 #include "yb/cdc/cdc_util.h"
 
@@ -37,6 +38,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/service_util.h"
+#include "yb/util/threadpool.h"
 
 namespace yb {
 
@@ -142,6 +144,24 @@ class CDCServiceImpl : public CDCServiceIf {
                               std::shared_ptr<rpc::RpcContext> context,
                               std::shared_ptr<tablet::TabletPeer> peer);
 
+  // Reads changes starting from the requested checkpoint and responds. When there are no new
+  // changes and wait_deadline has not passed yet, the response is delayed until new changes are
+  // majority replicated or wait_deadline passes.
+  void ProcessGetChanges(const GetChangesRequestPB* req,
+                         GetChangesResponsePB* resp,
+                         std::shared_ptr<rpc::RpcContext> context,
+                         const ProducerTabletInfo& producer_tablet,
+                         const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+                         CoarseTimePoint wait_deadline);
+
+  void WaitForChanges(const GetChangesRequestPB* req,
+                      GetChangesResponsePB* resp,
+                      std::shared_ptr<rpc::RpcContext> context,
+                      const ProducerTabletInfo& producer_tablet,
+                      const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+                      int64_t last_readable_index,
+                      CoarseTimePoint wait_deadline);
+
   void TabletLeaderGetCheckpoint(const GetCheckpointRequestPB* req,
                                  GetCheckpointResponsePB* resp,
                                  rpc::RpcContext* context,
@@ -162,6 +182,10 @@ class CDCServiceImpl : public CDCServiceIf {
       const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
       const ProducerTabletInfo& producer_info);
 
+  // Returns cache of CDC records shared by all streams that read the specified tablet.
+  std::shared_ptr<CDCRecordCache> GetRecordCache(
+      const std::shared_ptr<tablet::TabletPeer>& tablet_peer);
+
   OpId GetMinAppliedCheckpointForTablet(const std::string& tablet_id,
                                         const std::shared_ptr<client::YBSession>& session);
 
@@ -243,6 +267,14 @@ class CDCServiceImpl : public CDCServiceIf {
   std::unordered_map<std::string, std::shared_ptr<StreamMetadata>> stream_metadata_
       GUARDED_BY(mutex_);
 
+  struct TabletRecordCache {
+    std::weak_ptr<tablet::TabletPeer> tablet_peer;
+    std::shared_ptr<CDCRecordCache> cache;
+  };
+
+  // Map of tablet id -> CDC record cache of this tablet.
+  std::unordered_map<TabletId, TabletRecordCache> record_caches_ GUARDED_BY(mutex_);
+
   // Map of HostPort -> CDCServiceProxy. This is used to redirect requests to tablet leader's
   // CDC service proxy.
   CDCServiceProxyMap cdc_service_map_ GUARDED_BY(mutex_);
@@ -258,6 +290,12 @@ class CDCServiceImpl : public CDCServiceIf {
   // True when this service is stopped. Used to inform
   // get_minimum_checkpoints_and_update_peers_thread_ that it should exit.
   std::atomic<bool> cdc_service_stopped_{false};
+
+  // Long poll GetChanges requests waiting for new changes, and the pool used to process them once
+  // changes are available. Wait callbacks hold it by shared pointer, because they could fire after
+  // this service is shut down.
+  class LongPollWaits;
+  std::shared_ptr<LongPollWaits> long_poll_waits_;
 };
 
 }  // namespace cdc
@@ -612,6 +612,85 @@ TEST_F(CDCServiceTest, TestGetChanges) {
   }
 }
 
+// Tests that streams reading the same tablet get the same records, that are produced once and
+// served from the tablet CDC record cache, and that the cache is not used while the tablet is
+// read by a single stream.
+TEST_F(CDCServiceTest, TestGetChangesFromRecordCache) {
+  CDCStreamId stream_id1;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id1);
+  CDCStreamId stream_id2;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id2);
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+  WriteTestRow(1, 11, "key1", tablet_id, proxy);
+  WriteTestRow(2, 22, "key2", tablet_id, proxy);
+
+  std::shared_ptr<tablet::TabletPeer> tablet_peer;
+  ASSERT_TRUE(cluster_->mini_tablet_server(0)->server()->tablet_manager()->LookupTablet(tablet_id,
+      &tablet_peer));
+
+  const auto& tserver = cluster_->mini_tablet_server(0)->server();
+  auto cdc_service = dynamic_cast<CDCServiceImpl*>(
+      tserver->rpc_server()->service_pool("yb.cdc.CDCService")->TEST_get_service().get());
+  auto server_metrics = cdc_service->GetCDCServerMetrics();
+  auto initial_hits = server_metrics->cdc_record_cache_hits->value();
+  auto initial_misses = server_metrics->cdc_record_cache_misses->value();
+
+  auto get_cached_bytes = [&tablet_peer]() -> int64_t {
+    auto cache_mem_tracker = MemTracker::FindTracker(
+        "CDCRecordCache", MemTracker::FindTracker("CDC", tablet_peer->tablet()->mem_tracker()));
+    return cache_mem_tracker ? cache_mem_tracker->consumption() : 0;
+  };
+
+  // The first stream polls before the second one, so the tablet is read by a single stream.
+  // Then the second stream fills the cache, and the first stream reads the same records again.
+  const CDCStreamId* stream_ids[] = {&stream_id1, &stream_id2, &stream_id1};
+  GetChangesResponsePB change_resp[3];
+  int64_t cached_bytes = 0;
+  for (int i = 0; i != 3; ++i) {
+    GetChangesRequestPB change_req;
+    change_req.set_tablet_id(tablet_id);
+    change_req.set_stream_id(*stream_ids[i]);
+    change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+    change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+
+    RpcController rpc;
+    SCOPED_TRACE(change_req.DebugString());
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp[i], &rpc));
+    SCOPED_TRACE(change_resp[i].DebugString());
+    ASSERT_FALSE(change_resp[i].has_error());
+    ASSERT_EQ(change_resp[i].records_size(), 2);
+
+    if (i == 0) {
+      // Cache is not used for a tablet read by a single stream.
+      ASSERT_EQ(get_cached_bytes(), 0);
+      ASSERT_EQ(server_metrics->cdc_record_cache_misses->value(), initial_misses);
+      ASSERT_EQ(server_metrics->cdc_record_cache_hits->value(), initial_hits);
+    } else if (i == 1) {
+      // Records of both writes were produced and cached for the second stream.
+      cached_bytes = get_cached_bytes();
+      ASSERT_GT(cached_bytes, 0);
+      ASSERT_EQ(server_metrics->cdc_record_cache_misses->value(), initial_misses + 2);
+      ASSERT_EQ(server_metrics->cdc_record_cache_hits->value(), initial_hits);
+    } else {
+      // Records for the first stream were served from cache, so nothing was added to it.
+      ASSERT_EQ(get_cached_bytes(), cached_bytes);
+      ASSERT_EQ(server_metrics->cdc_record_cache_misses->value(), initial_misses + 2);
+      ASSERT_EQ(server_metrics->cdc_record_cache_hits->value(), initial_hits + 2);
+    }
+  }
+
+  for (int i = 1; i != 3; ++i) {
+    for (int j = 0; j != change_resp[0].records_size(); ++j) {
+      ASSERT_EQ(change_resp[0].records(j).ShortDebugString(),
+                change_resp[i].records(j).ShortDebugString());
+    }
+  }
+}
+
 TEST_F(CDCServiceTest, TestGetChangesInvalidStream) {
   std::string tablet_id;
   GetTablet(&tablet_id);
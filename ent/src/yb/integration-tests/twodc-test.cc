@@ -857,6 +857,34 @@ TEST_P(TwoDCTest, ApplyOperations) {
   Destroy();
 }
 
+TEST_P(TwoDCTest, ApplyOperationsToMoreConsumerTablets) {
+  // Records from a single producer tablet are applied in parallel to several consumer tablets.
+  // Repeated inserts and deletes of the same keys make sure per key order is preserved.
+  uint32_t replication_factor = NonTsanVsTsan(3, 1);
+  auto tables = ASSERT_RESULT(SetUpWithParams({8}, {1}, replication_factor));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.reserve(1);
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  constexpr uint32_t kNumKeys = 50;
+  WriteWorkload(0, kNumKeys, producer_client(), tables[0]->name());
+  for (int i = 0; i < 3; i++) {
+    WriteWorkload(0, kNumKeys, producer_client(), tables[0]->name(), true /* delete_op */);
+    WriteWorkload(0, kNumKeys / 2, producer_client(), tables[0]->name());
+  }
+
+  // Verify that both clusters have the same records.
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
 TEST_P(TwoDCTest, ApplyOperationsWithTransactions) {
   uint32_t replication_factor = NonTsanVsTsan(3, 1);
   auto tables = ASSERT_RESULT(SetUpWithParams({2}, {2}, replication_factor));
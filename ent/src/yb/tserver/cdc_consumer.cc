@@ -23,6 +23,7 @@
 #include "yb/tserver/cdc_poller.h"
 
 #include "yb/cdc/cdc_consumer.pb.h"
+#include "yb/cdc/cdc_metrics.h"
 
 #include "yb/client/client.h"
 
@@ -85,7 +86,7 @@ Result<std::unique_ptr<CDCConsumer>> CDCConsumer::Create(
 
   local_client->client->SetLocalTabletServer(tserver->permanent_uuid(), tserver->proxy(), tserver);
   auto cdc_consumer = std::make_unique<CDCConsumer>(std::move(is_leader_for_tablet), proxy_cache,
-      tserver->permanent_uuid(), std::move(local_client));
+      tserver->permanent_uuid(), std::move(local_client), tserver->metric_registry());
 
   // TODO(NIC): Unify cdc_consumer thread_pool & remote_client_ threadpools
   RETURN_NOT_OK(yb::Thread::Create(
@@ -98,10 +99,12 @@ Result<std::unique_ptr<CDCConsumer>> CDCConsumer::Create(
 CDCConsumer::CDCConsumer(std::function<bool(const std::string&)> is_leader_for_tablet,
                          rpc::ProxyCache* proxy_cache,
                          const string& ts_uuid,
-                         std::unique_ptr<CDCClient> local_client) :
+                         std::unique_ptr<CDCClient> local_client,
+                         MetricRegistry* metric_registry) :
   is_leader_for_tablet_(std::move(is_leader_for_tablet)),
   log_prefix_(Format("[TS $0]: ", ts_uuid)),
-  local_client_(std::move(local_client)) {}
+  local_client_(std::move(local_client)),
+  metric_registry_(metric_registry) {}
 
 CDCConsumer::~CDCConsumer() {
   Shutdown();
@@ -374,6 +377,16 @@ int32_t CDCConsumer::cluster_config_version() const {
   return cluster_config_version_.load(std::memory_order_acquire);
 }
 
+std::shared_ptr<cdc::CDCConsumerStreamMetrics> CDCConsumer::GetStreamMetrics(
+    const std::string& stream_id) {
+  std::lock_guard<std::mutex> l(stream_metrics_mutex_);
+  auto& result = stream_metrics_[stream_id];
+  if (!result) {
+    result = cdc::CDCConsumerStreamMetrics::Create(metric_registry_, stream_id);
+  }
+  return result;
+}
+
 } // namespace enterprise
 } // namespace tserver
 } // namespace yb
@@ -22,6 +22,7 @@
 
 namespace yb {
 
+class MetricRegistry;
 class Thread;
 class ThreadPool;
 
@@ -36,6 +37,7 @@ class SecureContext;
 
 namespace cdc {
 
+class CDCConsumerStreamMetrics;
 class ConsumerRegistryPB;
 
 } // namespace cdc
@@ -72,7 +74,8 @@ class CDCConsumer {
   CDCConsumer(std::function<bool(const std::string&)> is_leader_for_tablet,
       rpc::ProxyCache* proxy_cache,
       const std::string& ts_uuid,
-      std::unique_ptr<CDCClient> local_client);
+      std::unique_ptr<CDCClient> local_client,
+      MetricRegistry* metric_registry);
 
   ~CDCConsumer();
   void Shutdown();
@@ -97,6 +100,9 @@ class CDCConsumer {
     return TEST_num_successful_write_rpcs.load(std::memory_order_acquire);
   }
 
+  // Returns metrics of records applied from the specified stream.
+  std::shared_ptr<cdc::CDCConsumerStreamMetrics> GetStreamMetrics(const std::string& stream_id);
+
  private:
   // Runs a thread that periodically polls for any new threads.
   void RunThread();
@@ -156,6 +162,12 @@ class CDCConsumer {
   std::atomic<int32_t> cluster_config_version_ GUARDED_BY(master_data_mutex_) = {-1};
 
   std::atomic<uint32_t> TEST_num_successful_write_rpcs {0};
+
+  MetricRegistry* metric_registry_;
+
+  std::mutex stream_metrics_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<cdc::CDCConsumerStreamMetrics>> stream_metrics_
+      GUARDED_BY(stream_metrics_mutex_);
 };
 
 } // namespace enterprise
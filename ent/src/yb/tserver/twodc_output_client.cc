@@ -14,6 +14,7 @@
 
 #include <shared_mutex>
 
+#include "yb/cdc/cdc_metrics.h"
 #include "yb/cdc/cdc_util.h"
 #include "yb/cdc/cdc_rpc.h"
 #include "yb/client/client.h"
@@ -26,6 +27,7 @@
 #include "yb/tserver/twodc_write_interface.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 
 DECLARE_int32(cdc_write_rpc_timeout_ms);
@@ -34,6 +36,13 @@ DEFINE_bool(cdc_force_remote_tserver, false,
             "Avoid local tserver apply optimization for CDC and force remote RPCs.");
 TAG_FLAG(cdc_force_remote_tserver, runtime);
 
+DEFINE_int32(cdc_max_parallel_apply_write_rpcs, 16,
+             "Max number of write rpcs that the CDC Consumer sends in parallel, to different "
+             "consumer tablets, while applying records polled from a producer tablet. Writes to "
+             "the same consumer tablet are always sent one at a time.");
+TAG_FLAG(cdc_max_parallel_apply_write_rpcs, advanced);
+TAG_FLAG(cdc_max_parallel_apply_write_rpcs, runtime);
+
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
 namespace yb {
@@ -47,11 +56,13 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   TwoDCOutputClient(
       CDCConsumer* cdc_consumer,
       const cdc::ConsumerTabletInfo& consumer_tablet_info,
+      const std::shared_ptr<cdc::CDCConsumerStreamMetrics>& stream_metrics,
       const std::shared_ptr<CDCClient>& local_client,
       std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk,
       bool use_local_tserver) :
       cdc_consumer_(cdc_consumer),
       consumer_tablet_info_(consumer_tablet_info),
+      stream_metrics_(stream_metrics),
       local_client_(local_client),
       apply_changes_clbk_(std::move(apply_changes_clbk)),
       use_local_tserver_(use_local_tserver) {}
@@ -61,7 +72,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   CHECKED_STATUS ApplyChanges(const cdc::GetChangesResponsePB* resp) override;
 
   void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                          rpc::Rpcs::Handle handle);
+                          rpc::Rpcs::Handle handle, const TabletId& tablet_id, size_t request_size);
 
  private:
   void TabletLookupCallback(
@@ -71,7 +82,13 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   void WriteIfAllRecordsProcessed();
 
-  void SendNextCDCWriteToTablet();
+  // Sends write requests that could be sent without breaking the order of writes to the same
+  // tablet, up to cdc_max_parallel_apply_write_rpcs in flight.
+  void SendNextCDCWrites();
+
+  void SendCDCWrite(std::unique_ptr<WriteRequestPB> write_request);
+
+  void WriteDone(const TabletId& tablet_id, const Status& status);
 
   // Increment processed record count.
   // Returns true if all records are processed, false if there are still some pending records.
@@ -84,6 +101,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   CDCConsumer* cdc_consumer_;
   cdc::ConsumerTabletInfo consumer_tablet_info_;
+  std::shared_ptr<cdc::CDCConsumerStreamMetrics> stream_metrics_;
   std::shared_ptr<CDCClient> local_client_;
   std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk_;
 
@@ -99,11 +117,17 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   uint32_t processed_record_count_ GUARDED_BY(lock_) = 0;
   uint32_t record_count_ GUARDED_BY(lock_) = 0;
+  int write_rpcs_in_flight_ GUARDED_BY(lock_) = 0;
+  CoarseTimePoint apply_start_;
 
   // This will cache the response to an ApplyChanges() request.
   cdc::GetChangesResponsePB twodc_resp_copy_;
 
-  std::unique_ptr<TwoDCWriteInterface> write_strategy_;
+  // Consumer tablet of each record in twodc_resp_copy_. Tablet lookups complete in arbitrary
+  // order, so records are passed to write_strategy_ only after all lookups are done.
+  std::vector<TabletId> record_tablet_ids_;
+
+  std::unique_ptr<TwoDCWriteInterface> write_strategy_ GUARDED_BY(lock_);
 };
 
 Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_resp) {
@@ -126,8 +150,10 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_r
     done_processing_ = false;
     processed_record_count_ = 0;
     record_count_ = poller_resp->records_size();
+    write_rpcs_in_flight_ = 0;
     ResetWriteInterface(&write_strategy_);
   }
+  apply_start_ = CoarseMonoClock::Now();
 
   // Ensure we have records.
   if (poller_resp->records_size() == 0) {
@@ -154,6 +180,8 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_r
       twodc_resp_copy_.add_records()->CopyFrom(poller_resp->records(i));
     }
   }
+  record_tablet_ids_.clear();
+  record_tablet_ids_.resize(twodc_resp_copy_.records_size());
 
   for (int i = 0; i < twodc_resp_copy_.records_size(); i++) {
     // All KV-pairs within a single CDC record will be for the same row.
@@ -199,8 +227,16 @@ void TwoDCOutputClient::WriteIfAllRecordsProcessed() {
       // Return error, if any, without applying records.
       HandleResponse();
     } else {
+      // Process records in the order they were received, so writes to the same key are applied
+      // in order.
+      {
+        std::lock_guard<decltype(lock_)> l(lock_);
+        for (int i = 0; i != twodc_resp_copy_.records_size(); ++i) {
+          write_strategy_->ProcessRecord(record_tablet_ids_[i], twodc_resp_copy_.records(i));
+        }
+      }
       // Apply the writes on consumer.
-      SendNextCDCWriteToTablet();
+      SendNextCDCWrites();
     }
   }
 }
@@ -214,21 +250,40 @@ void TwoDCOutputClient::TabletLookupCallback(
     return;
   }
 
-  write_strategy_->ProcessRecord(tablet->get()->tablet_id(), twodc_resp_copy_.records(record_idx));
+  record_tablet_ids_[record_idx] = tablet->get()->tablet_id();
 
   WriteIfAllRecordsProcessed();
 }
 
 void TwoDCOutputClient::TabletLookupCallbackFastTrack(const size_t record_idx) {
-  write_strategy_->ProcessRecord(consumer_tablet_info_.tablet_id,
-      twodc_resp_copy_.records(record_idx));
+  record_tablet_ids_[record_idx] = consumer_tablet_info_.tablet_id;
 
   WriteIfAllRecordsProcessed();
 }
 
-void TwoDCOutputClient::SendNextCDCWriteToTablet() {
-  auto write_request = write_strategy_->GetNextWriteRequest();
+void TwoDCOutputClient::SendNextCDCWrites() {
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    if (!error_status_.ok()) {
+      return;
+    }
+    while (write_rpcs_in_flight_ < std::max(FLAGS_cdc_max_parallel_apply_write_rpcs, 1)) {
+      auto write_request = write_strategy_->GetNextWriteRequest();
+      if (!write_request) {
+        break;
+      }
+      ++write_rpcs_in_flight_;
+      write_requests.push_back(std::move(write_request));
+    }
+  }
+
+  for (auto& write_request : write_requests) {
+    SendCDCWrite(std::move(write_request));
+  }
+}
 
+void TwoDCOutputClient::SendCDCWrite(std::unique_ptr<WriteRequestPB> write_request) {
   auto deadline = CoarseMonoClock::Now() +
                   MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
   auto write_rpc_handle = local_client_->rpcs->Prepare();
@@ -240,32 +295,59 @@ void TwoDCOutputClient::SendNextCDCWriteToTablet() {
         local_client_->client.get(),
         write_request.get(),
         std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this,
-                  std::placeholders::_1, std::placeholders::_2, write_rpc_handle),
+                  std::placeholders::_1, std::placeholders::_2, write_rpc_handle,
+                  write_request->tablet_id(), write_request->ByteSize()),
         UseLocalTserver());
     (**write_rpc_handle).SendRpc();
   } else {
     LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+    WriteDone(write_request->tablet_id(),
+              STATUS(Aborted, "Unable to prepare CDC write rpc, client is shutting down"));
   }
 }
 
 void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                                           rpc::Rpcs::Handle handle) {
+                                           rpc::Rpcs::Handle handle, const TabletId& tablet_id,
+                                           size_t request_size) {
   auto retained = local_client_->rpcs->Unregister(handle);
   if (!status.ok()) {
-    HandleError(status, true /* done */);
+    WriteDone(tablet_id, status);
     return;
   } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()), true /* done */);
+    WriteDone(tablet_id, StatusFromPB(response.error().status()));
     return;
   }
 
   cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
+  if (stream_metrics_) {
+    stream_metrics_->apply_write_rpcs->Increment();
+    stream_metrics_->apply_bytes->IncrementBy(request_size);
+  }
+
+  WriteDone(tablet_id, Status::OK());
+}
+
+void TwoDCOutputClient::WriteDone(const TabletId& tablet_id, const Status& status) {
+  if (!status.ok()) {
+    HandleError(status, false /* done */);
+  }
 
-  if (!write_strategy_->HasMoreWrites()) {
+  bool done;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    --write_rpcs_in_flight_;
+    write_strategy_->WriteRequestDone(tablet_id);
+    // On failure wait for writes that are still in flight, before returning the response, since
+    // the caller re-applies all records of the batch.
+    done = write_rpcs_in_flight_ == 0 &&
+           (!error_status_.ok() || !write_strategy_->HasMoreWrites());
+  }
+
+  if (done) {
     // Last record, return response to caller.
     HandleResponse();
   } else {
-    SendNextCDCWriteToTablet();
+    SendNextCDCWrites();
   }
 }
 
@@ -288,6 +370,11 @@ void TwoDCOutputClient::HandleResponse() {
     response.status = error_status_;
     if (response.status.ok()) {
       response.last_applied_op_id = op_id_;
+      if (stream_metrics_) {
+        stream_metrics_->apply_records->IncrementBy(twodc_resp_copy_.records_size());
+        stream_metrics_->apply_latency->Increment(
+            MonoDelta(CoarseMonoClock::Now() - apply_start_).ToMicroseconds());
+      }
     }
     op_id_ = consensus::MinimumOpId();
   }
@@ -307,11 +394,13 @@ bool TwoDCOutputClient::IncProcessedRecordCount() {
 std::unique_ptr<cdc::CDCOutputClient> CreateTwoDCOutputClient(
     CDCConsumer* cdc_consumer,
     const cdc::ConsumerTabletInfo& consumer_tablet_info,
+    const std::shared_ptr<cdc::CDCConsumerStreamMetrics>& stream_metrics,
     const std::shared_ptr<CDCClient>& local_client,
     std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk,
     bool use_local_tserver) {
-  return std::make_unique<TwoDCOutputClient>(cdc_consumer, consumer_tablet_info, local_client,
-                                             std::move(apply_changes_clbk), use_local_tserver);
+  return std::make_unique<TwoDCOutputClient>(cdc_consumer, consumer_tablet_info, stream_metrics,
+                                             local_client, std::move(apply_changes_clbk),
+                                             use_local_tserver);
 }
 
 } // namespace enterprise
@@ -20,6 +20,12 @@ namespace yb {
 
 class ThreadPool;
 
+namespace cdc {
+
+class CDCConsumerStreamMetrics;
+
+} // namespace cdc
+
 namespace tserver {
 namespace enterprise {
 
@@ -29,6 +35,7 @@ struct CDCClient;
 std::unique_ptr<cdc::CDCOutputClient> CreateTwoDCOutputClient(
     CDCConsumer* cdc_consumer,
     const cdc::ConsumerTabletInfo& consumer_tablet_info,
+    const std::shared_ptr<cdc::CDCConsumerStreamMetrics>& stream_metrics,
     const std::shared_ptr<CDCClient>& local_client,
     std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk,
     bool use_local_tserver);
@@ -31,8 +31,14 @@ namespace enterprise {
 class TwoDCWriteInterface {
  public:
   virtual ~TwoDCWriteInterface() {}
+  // Returns the next write request that could be sent while the write requests returned earlier,
+  // and not yet reported to WriteRequestDone, are still in flight. Returns nullptr when there is no
+  // such request.
   virtual std::unique_ptr <WriteRequestPB> GetNextWriteRequest() = 0;
+  // Notifies that the write request returned earlier for the specified tablet has completed.
+  virtual void WriteRequestDone(const std::string& tablet_id) = 0;
   virtual void ProcessRecord(const std::string& tablet_id, const cdc::CDCRecordPB& record) = 0;
+  // Returns true if there are write requests that were not yet returned by GetNextWriteRequest.
   virtual bool HasMoreWrites() = 0;
 };
 
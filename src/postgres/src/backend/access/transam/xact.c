@@ -2722,6 +2722,13 @@ AbortTransaction(void)
 		pgstat_report_xact_timestamp(0);
 	}
 
+	/*
+	 * Wait for writes the failed statement sent in background, so they do not outlive the
+	 * transaction and their errors are reported together with the statement error.
+	 */
+	if (IsYugaByteEnabled())
+		YBResetOperationsBuffering();
+
 	if (YBTransactionsEnabled()) {
 		YBCPgAbortTransaction();
 	}
@@ -2787,7 +2794,8 @@ CleanupTransaction(void)
 void
 StartTransactionCommand(void)
 {
-	if (IsYugaByteEnabled())
+	/* Writes of previous statements of a transaction block stay buffered until commit. */
+	if (IsYugaByteEnabled() && !IsTransactionBlock())
 		YBResetOperationsBuffering();
 
 	TransactionState s = CurrentTransactionState;
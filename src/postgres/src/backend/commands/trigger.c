@@ -5938,6 +5938,7 @@ AfterTriggerSaveEvent(EState *estate, ResultRelInfo *relinfo,
 	for (i = 0; i < trigdesc->numtriggers; i++)
 	{
 		Trigger    *trigger = &trigdesc->triggers[i];
+		bool		fk_check_required = false;
 
 		if (!TRIGGER_TYPE_MATCHES(trigger->tgtype,
 								  tgtype_level,
@@ -5975,6 +5976,7 @@ AfterTriggerSaveEvent(EState *estate, ResultRelInfo *relinfo,
 						/* skip queuing this event */
 						continue;
 					}
+					fk_check_required = true;
 					break;
 
 				case RI_TRIGGER_NONE:
@@ -6010,6 +6012,17 @@ AfterTriggerSaveEvent(EState *estate, ResultRelInfo *relinfo,
 				continue;		/* Uniqueness definitely not violated */
 		}
 
+		/*
+		 * For FK checks on YugaByte relations remember the referencing row, so
+		 * that the checks fired at the end of the statement read all the
+		 * referenced rows in one batch.  Updates are only remembered when
+		 * RI_FKey_fk_upd_check_required says the check will run.
+		 */
+		if (TRIGGER_FIRED_BY_INSERT(event))
+			fk_check_required = RI_FKey_trigger_type(trigger->tgfoid) == RI_TRIGGER_FK;
+		if (fk_check_required && IsYBRelation(rel) && row_trigger && newtup != NULL)
+			YBAddFKReferenceIntent(trigger, rel, newtup);
+
 		/*
 		 * Fill in event structure and add it to the current query's queue.
 		 * Note we set ats_table to NULL whenever this trigger doesn't use
@@ -444,7 +444,7 @@ standard_ExecutorFinish(QueryDesc *queryDesc)
 
 	// Flush buffered operations straight before elapsed time calculation.
 	if (IsYugaByteEnabled())
-		YBEndOperationsBuffering();
+		YBEndStatementOperationsBuffering();
 
 	if (queryDesc->totaltime)
 		InstrStopNode(queryDesc->totaltime, 0);
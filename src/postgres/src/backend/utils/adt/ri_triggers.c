@@ -181,6 +181,19 @@ typedef struct RI_CompareHashEntry
 	FmgrInfo	cast_func_finfo;	/* in case we must coerce input */
 } RI_CompareHashEntry;
 
+/* ----------
+ * YBFKReferenceIntent
+ *
+ *	A row of a YugaByte relation queued for an FK check, whose referenced row
+ *	is not yet part of the batch read by the check.
+ * ----------
+ */
+typedef struct YBFKReferenceIntent
+{
+	Oid			constraint_id;	/* OID of the FK pg_constraint entry */
+	HeapTuple	new_row;		/* copy of the referencing row */
+} YBFKReferenceIntent;
+
 
 /* ----------
  * Local data
@@ -191,6 +204,8 @@ static HTAB *ri_query_cache = NULL;
 static HTAB *ri_compare_cache = NULL;
 static dlist_head ri_constraint_cache_valid_list;
 static int	ri_constraint_cache_valid_count = 0;
+static List *yb_fk_reference_intents = NIL;	/* in TopTransactionContext */
+static bool yb_fk_reference_intents_callback_registered = false;
 
 
 /* ----------
@@ -248,8 +263,16 @@ static void ri_ReportViolation(const RI_ConstraintInfo *riinfo,
 				   HeapTuple violator, TupleDesc tupdesc,
 				   int queryno) pg_attribute_noreturn();
 
-static void BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx,
+static YBCPgStatement YBNewTupleIdStatement(Relation pk_rel, Relation idx_rel);
+static void BuildYBTupleId(YBCPgStatement ybc_stmt, Relation pk_rel, Relation fk_rel, Relation idx,
 					const RI_ConstraintInfo *riinfo, HeapTuple tup, void **data, int64_t *bytes);
+static Relation YBOpenFKReferenceIndex(const RI_ConstraintInfo *riinfo, Oid *ref_table_id);
+static void YBBuildFKReference(Relation pk_rel, Relation fk_rel,
+					const RI_ConstraintInfo *riinfo, HeapTuple new_row,
+					Oid *ref_table_id, char **tuple_id, int64_t *tuple_id_size);
+static void YBAddPendingFKReferenceIntents(Relation pk_rel, Relation fk_rel,
+					const RI_ConstraintInfo *riinfo);
+static void YBFKReferenceIntentsXactCallback(XactEvent event, void *arg);
 
 
 /* ----------
@@ -403,25 +426,19 @@ RI_FKey_check(TriggerData *trigdata)
 	 */
 	if (IsYBRelation(pk_rel))
 	{
-		/*
-		 * Get the referenced index table.
-		 * For primary key index, we need to use the base table relation.
-		 */
-		Relation idx_rel = RelationIdGetRelation(riinfo->conindid);
-		if (idx_rel->rd_index != NULL)
-		{
-			ref_table_id = idx_rel->rd_index->indisprimary ?
-					idx_rel->rd_index->indrelid : riinfo->conindid;
-		}
-
-		BuildYBTupleId(
-			pk_rel /* Primary table */,
-			fk_rel /* Reference table */,
-			ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel /* Reference index */,
-			riinfo, new_row, (void **)&tuple_id, &tuple_id_size);
-		RelationClose(idx_rel);
-
-		if (tuple_id != NULL && YBCForeignKeyReferenceExists(ref_table_id, tuple_id, tuple_id_size))
+		bool		exists = false;
+
+		YBAddPendingFKReferenceIntents(pk_rel, fk_rel, riinfo);
+		YBBuildFKReference(pk_rel, fk_rel, riinfo, new_row,
+						   &ref_table_id, &tuple_id, &tuple_id_size);
+
+		if (tuple_id != NULL)
+			HandleYBStatus(YBCForeignKeyReferenceExists(YBCGetDatabaseOid(pk_rel),
+														ref_table_id,
+														tuple_id,
+														tuple_id_size,
+														&exists));
+		if (exists)
 		{
 			elog(DEBUG1, "Skipping FK check for table %d, ybctid %s", ref_table_id, tuple_id);
 			heap_close(pk_rel, RowShareLock);
@@ -2690,10 +2707,12 @@ ri_PerformCheck(const RI_ConstraintInfo *riinfo,
 	return SPI_processed != 0;
 }
 
-static void
-BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx_rel,
-				const RI_ConstraintInfo *riinfo, HeapTuple tup,
-				void **value, int64_t *bytes)
+/*
+ * Create the statement used by BuildYBTupleId to build ybctids of idx_rel,
+ * which is either pk_rel or its unique index.
+ */
+static YBCPgStatement
+YBNewTupleIdStatement(Relation pk_rel, Relation idx_rel)
 {
 	YBCPgStatement ybc_stmt;
 	YBCPgPrepareParameters prepare_params;
@@ -2705,7 +2724,14 @@ BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx_rel,
 
 	HandleYBStatus(YBCPgNewSelect(
 		YBCGetDatabaseOid(idx_rel), RelationGetRelid(idx_rel), &prepare_params, &ybc_stmt));
+	return ybc_stmt;
+}
 
+static void
+BuildYBTupleId(YBCPgStatement ybc_stmt, Relation pk_rel, Relation fk_rel, Relation idx_rel,
+				const RI_ConstraintInfo *riinfo, HeapTuple tup,
+				void **value, int64_t *bytes)
+{
 	TupleDesc	tupdesc = fk_rel->rd_att;
 	const int16 *attnums = riinfo->fk_attnums;
 	AttrNumber minattr = YBSystemFirstLowInvalidAttributeNumber + 1;
@@ -2754,7 +2780,169 @@ BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx_rel,
 	type_entity->datum_to_yb(tuple_id, value, bytes);
 
 	pfree(attrs);
+}
+
+/*
+ * Open the index supporting the constraint and set ref_table_id to the table
+ * the referenced rows are read from (for primary key, the base table is used).
+ * The result must be closed with RelationClose.
+ */
+static Relation
+YBOpenFKReferenceIndex(const RI_ConstraintInfo *riinfo, Oid *ref_table_id)
+{
+	Relation idx_rel = RelationIdGetRelation(riinfo->conindid);
+	if (idx_rel->rd_index != NULL)
+	{
+		*ref_table_id = idx_rel->rd_index->indisprimary ?
+				idx_rel->rd_index->indrelid : riinfo->conindid;
+	}
+	return idx_rel;
+}
+
+/*
+ * Build the ybctid of the row referenced by new_row in the referenced table or
+ * unique index (for primary key, the base table is used).
+ */
+static void
+YBBuildFKReference(Relation pk_rel, Relation fk_rel,
+				   const RI_ConstraintInfo *riinfo, HeapTuple new_row,
+				   Oid *ref_table_id, char **tuple_id, int64_t *tuple_id_size)
+{
+	Relation	idx_rel = YBOpenFKReferenceIndex(riinfo, ref_table_id);
+	Relation	ref_rel = *ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel;
+	YBCPgStatement ybc_stmt = YBNewTupleIdStatement(pk_rel, ref_rel);
+
+	BuildYBTupleId(
+		ybc_stmt,
+		pk_rel /* Primary table */,
+		fk_rel /* Reference table */,
+		ref_rel /* Reference index */,
+		riinfo, new_row, (void **)tuple_id, tuple_id_size);
 	HandleYBStatus(YBCPgDeleteStatement(ybc_stmt));
+	RelationClose(idx_rel);
+}
+
+/*
+ * Add the rows referenced by the rows queued by YBAddFKReferenceIntent for
+ * this constraint to the batch read by the next FK check.  This runs once per
+ * statement, when its first check fires, so pk_rel (opened by RI_FKey_check),
+ * the reference index and the statement building the ybctids are shared by
+ * all the queued rows.
+ */
+static void
+YBAddPendingFKReferenceIntents(Relation pk_rel, Relation fk_rel,
+							   const RI_ConstraintInfo *riinfo)
+{
+	Relation	idx_rel = NULL;
+	Relation	ref_rel = NULL;
+	Oid			ref_table_id = InvalidOid;
+	YBCPgStatement ybc_stmt = NULL;
+	MemoryContext tmp_context = NULL;
+	MemoryContext old_context = NULL;
+	ListCell   *cell;
+	ListCell   *prev = NULL;
+	ListCell   *next;
+
+	for (cell = list_head(yb_fk_reference_intents); cell != NULL; cell = next)
+	{
+		YBFKReferenceIntent *intent = (YBFKReferenceIntent *) lfirst(cell);
+		char	   *tuple_id = NULL;
+		int64_t		tuple_id_size = 0;
+
+		next = lnext(cell);
+		if (intent->constraint_id != riinfo->constraint_id)
+		{
+			prev = cell;
+			continue;
+		}
+
+		if (ybc_stmt == NULL)
+		{
+			idx_rel = YBOpenFKReferenceIndex(riinfo, &ref_table_id);
+			ref_rel = ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel;
+			ybc_stmt = YBNewTupleIdStatement(pk_rel, ref_rel);
+			tmp_context = AllocSetContextCreate(CurrentMemoryContext,
+												"YB FK reference intents",
+												ALLOCSET_SMALL_SIZES);
+			old_context = MemoryContextSwitchTo(tmp_context);
+		}
+
+		BuildYBTupleId(ybc_stmt, pk_rel, fk_rel, ref_rel, riinfo, intent->new_row,
+					   (void **)&tuple_id, &tuple_id_size);
+		if (tuple_id != NULL)
+			HandleYBStatus(YBCAddForeignKeyReferenceIntent(ref_table_id, tuple_id, tuple_id_size));
+		MemoryContextReset(tmp_context);
+
+		heap_freetuple(intent->new_row);
+		pfree(intent);
+		yb_fk_reference_intents = list_delete_cell(yb_fk_reference_intents, cell, prev);
+	}
+
+	if (ybc_stmt != NULL)
+	{
+		MemoryContextSwitchTo(old_context);
+		MemoryContextDelete(tmp_context);
+		HandleYBStatus(YBCPgDeleteStatement(ybc_stmt));
+		RelationClose(idx_rel);
+	}
+}
+
+/*
+ * The queued rows live in TopTransactionContext, forget them when it is gone.
+ */
+static void
+YBFKReferenceIntentsXactCallback(XactEvent event, void *arg)
+{
+	switch (event)
+	{
+		case XACT_EVENT_COMMIT:
+		case XACT_EVENT_PARALLEL_COMMIT:
+		case XACT_EVENT_ABORT:
+		case XACT_EVENT_PARALLEL_ABORT:
+		case XACT_EVENT_PREPARE:
+			yb_fk_reference_intents = NIL;
+			break;
+		default:
+			break;
+	}
+}
+
+/*
+ * YBAddFKReferenceIntent -
+ *
+ *	Remember a row inserted or updated in a YugaByte relation whose FK check
+ *	trigger event is being queued, so that when the checks fire at the end of
+ *	the statement, all the referenced rows are read from DocDB in one batch
+ *	instead of one by one.  Only the row is copied here; the ybctids of the
+ *	referenced rows are built by the first check, which already has the
+ *	referenced relation open.  Violations are still reported by RI_FKey_check.
+ */
+void
+YBAddFKReferenceIntent(Trigger *trigger, Relation fk_rel, HeapTuple new_row)
+{
+	const RI_ConstraintInfo *riinfo;
+	YBFKReferenceIntent *intent;
+	MemoryContext old_context;
+
+	riinfo = ri_FetchConstraintInfo(trigger, fk_rel, false);
+
+	/* Only fully specified keys are looked up in the referenced table. */
+	if (riinfo->confmatchtype == FKCONSTR_MATCH_PARTIAL ||
+		ri_NullCheck(RelationGetDescr(fk_rel), new_row, riinfo, false) != RI_KEYS_NONE_NULL)
+		return;
+
+	if (!yb_fk_reference_intents_callback_registered)
+	{
+		RegisterXactCallback(YBFKReferenceIntentsXactCallback, NULL);
+		yb_fk_reference_intents_callback_registered = true;
+	}
+
+	old_context = MemoryContextSwitchTo(TopTransactionContext);
+	intent = (YBFKReferenceIntent *) palloc(sizeof(YBFKReferenceIntent));
+	intent->constraint_id = riinfo->constraint_id;
+	intent->new_row = heap_copytuple(new_row);
+	yb_fk_reference_intents = lappend(yb_fk_reference_intents, intent);
+	MemoryContextSwitchTo(old_context);
 }
 
 /*
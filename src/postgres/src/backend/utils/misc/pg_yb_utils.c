@@ -30,6 +30,7 @@
 #include "postgres.h"
 #include "miscadmin.h"
 #include "access/sysattr.h"
+#include "access/xact.h"
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
 #include "catalog/pg_database.h"
@@ -427,6 +428,9 @@ YBCCommitTransaction()
 	if (!IsYugaByteEnabled())
 		return true;
 
+	/* Send the writes that statements of the transaction block left buffered. */
+	HandleYBStatus(YBCPgFlushBufferedOperations());
+
 	YBCStatus status = YBCPgCommitTransaction();
 	if (status != NULL) {
 		YBCResetCommitStatus();
@@ -963,7 +967,29 @@ void YBEndOperationsBuffering() {
 	}
 }
 
+void YBEndStatementOperationsBuffering() {
+	if (buffering_nesting_level && !--buffering_nesting_level) {
+		/*
+		 * In a transaction block, writes of the statement stay buffered until a read needs them,
+		 * the buffer is full or the transaction commits. Their errors, like duplicate keys, are
+		 * reported by the statement that sends them or by the commit.
+		 */
+		HandleYBStatus(IsTransactionBlock() ? YBCPgStopOperationsBuffering()
+											: YBCPgFlushBufferedOperations());
+	}
+}
+
 void YBResetOperationsBuffering() {
 	buffering_nesting_level = 0;
-	YBCPgResetOperationsBuffering();
+	YBCStatus status = YBCPgResetOperationsBuffering();
+	if (status) {
+		/*
+		 * Writes sent in background by the failed statement failed too. The statement has already
+		 * reported its own error, so report this one as a warning.
+		 */
+		char* msg_buf = DupYBStatusMessage(status, false /* message_only */);
+		YBCFreeStatus(status);
+		ereport(WARNING,
+				(errmsg("Buffered writes of the failed statement failed: %s", msg_buf)));
+	}
 }
@@ -311,6 +311,7 @@ bool YBIsInitDbAlreadyDone();
 
 extern void YBBeginOperationsBuffering();
 extern void YBEndOperationsBuffering();
+extern void YBEndStatementOperationsBuffering();
 extern void YBResetOperationsBuffering();
 
 #endif /* PG_YB_UTILS_H */
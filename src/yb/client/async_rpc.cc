@@ -29,6 +29,7 @@
 
 #include "yb/util/cast.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/yb_pg_errcodes.h"
 
@@ -63,7 +64,14 @@ DEFINE_bool(detect_duplicates_for_retryable_requests, true,
             "Enable tracking of write requests that prevents the same write from being applied "
                 "twice.");
 
+DEFINE_bool(enable_multi_tablet_reads, true,
+            "Whether reads to different tablets led by the same tablet server should be sent in a "
+            "single MultiRead RPC.");
+TAG_FLAG(enable_multi_tablet_reads, evolving);
+TAG_FLAG(enable_multi_tablet_reads, runtime);
+
 DEFINE_CAPABILITY(PickReadTimeAtTabletServer, 0x8284d67b);
+DEFINE_CAPABILITY(MultiTabletRead, 0x3c9e51a7);
 
 using namespace std::placeholders;
 
@@ -642,6 +650,13 @@ ReadRpc::~ReadRpc() {
 }
 
 void ReadRpc::CallRemoteMethod() {
+  if (multi_read_pending_) {
+    // Request will be sent by MultiReadRpc.
+    multi_read_pending_ = false;
+    return;
+  }
+  multi_read_controller_ = nullptr;
+
   auto trace = trace_; // It is possible that we receive reply before returning from ReadAsync.
                        // Detailed explanation in WriteRpc::SendRpcToTserver.
   TRACE_TO(trace, "SendRpcToTserver");
@@ -718,7 +733,7 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         ql_op->mutable_response()->Swap(resp_.mutable_ql_batch(ql_idx));
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
+          Slice rows_data = CHECK_RESULT(sidecars_controller().GetSidecar(
               ql_response.rows_data_sidecar()));
           ql_op->mutable_rows_data()->assign(util::to_char_ptr(rows_data.data()), rows_data.size());
         }
@@ -735,7 +750,7 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         pgsql_op->mutable_response()->Swap(resp_.mutable_pgsql_batch(pgsql_idx));
         const auto& pgsql_response = pgsql_op->response();
         if (pgsql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
+          Slice rows_data = CHECK_RESULT(sidecars_controller().GetSidecar(
               pgsql_response.rows_data_sidecar()));
           down_cast<YBPgsqlReadOp*>(yb_op)->mutable_rows_data()->assign(
               util::to_char_ptr(rows_data.data()), rows_data.size());
@@ -780,6 +795,107 @@ void ReadRpc::ProcessResponseFromTserver(const Status& status) {
   SwapRequestsAndResponses(false);
 }
 
+const rpc::RpcController& ReadRpc::sidecars_controller() const {
+  return multi_read_controller_ ? *multi_read_controller_ : retrier().controller();
+}
+
+void ReadRpc::PrepareForMultiRead(RemoteTabletServer* ts, tserver::ReadRequestPB* req) {
+  TRACE_TO(trace_, "PrepareForMultiRead($0)", ts->permanent_uuid());
+
+  retained_self_ = shared_from_this();
+  tablet_invoker_.SetCurrentTServer(ts);
+  // Fills the request the same way as for a regular send, but CallRemoteMethod does not send it.
+  multi_read_pending_ = true;
+  SendRpcToTserver(retrier().attempt_num());
+  req->Swap(&req_);
+}
+
+void ReadRpc::MultiReadFinished(
+    const Status& status, tserver::ReadRequestPB* req, tserver::ReadResponsePB* resp,
+    const rpc::RpcController* controller) {
+  req_.Swap(req);
+  if (resp) {
+    resp_.Swap(resp);
+  }
+  multi_read_controller_ = controller;
+  Finished(status);
+}
+
+RemoteTabletServer* MultiReadTServer(const AsyncRpc& rpc) {
+  if (!FLAGS_enable_multi_tablet_reads) {
+    return nullptr;
+  }
+  auto& yb_op = *rpc.ops().front()->yb_op;
+  if (yb_op.group() != OpGroup::kLeaderRead ||
+      (yb_op.type() != YBOperation::Type::QL_READ &&
+       yb_op.type() != YBOperation::Type::PGSQL_READ) ||
+      rpc.table()->name().is_system()) {
+    return nullptr;
+  }
+  auto* ts = rpc.tablet().LeaderTServer();
+  if (!ts || ts->IsLocal() || !ts->HasCapability(CAPABILITY_MultiTabletRead)) {
+    return nullptr;
+  }
+  return ts;
+}
+
+MultiReadRpc::MultiReadRpc(
+    Batcher* batcher, RemoteTabletServer* ts, std::vector<std::shared_ptr<ReadRpc>> reads)
+    : Rpc(batcher->deadline(), batcher->messenger(), &batcher->proxy_cache()),
+      batcher_(batcher), ts_(ts), reads_(std::move(reads)) {
+}
+
+MultiReadRpc::~MultiReadRpc() {
+}
+
+void MultiReadRpc::SendRpc() {
+  if (!prepared_) {
+    auto status = ts_->InitProxy(batcher_->client_);
+    if (!status.ok()) {
+      // Let each read select a replica and report the failure on its own.
+      for (const auto& read : reads_) {
+        read->SendRpc();
+      }
+      return;
+    }
+
+    retained_self_ = shared_from_this();
+    for (const auto& read : reads_) {
+      read->PrepareForMultiRead(ts_, req_.add_reads());
+    }
+    prepared_ = true;
+  }
+
+  ts_->proxy()->MultiReadAsync(
+      req_, &resp_, PrepareController(), std::bind(&MultiReadRpc::Finished, this, Status::OK()));
+}
+
+std::string MultiReadRpc::ToString() const {
+  return Format("MultiRead(ts: $0, num_reads: $1, num_attempts: $2)",
+                ts_->permanent_uuid(), reads_.size(), num_attempts());
+}
+
+void MultiReadRpc::Finished(const Status& status) {
+  Status new_status = status;
+  if (new_status.ok() && mutable_retrier()->HandleResponse(this, &new_status)) {
+    // Retry of the whole RPC was scheduled.
+    return;
+  }
+  if (new_status.ok() && resp_.responses_size() != reads_.size()) {
+    new_status = STATUS_FORMAT(
+        IllegalState, "MultiRead response count mismatch: $0 reads sent, $1 responses received",
+        reads_.size(), resp_.responses_size());
+    LOG(DFATAL) << new_status;
+  }
+
+  for (size_t idx = 0; idx != reads_.size(); ++idx) {
+    reads_[idx]->MultiReadFinished(
+        new_status, req_.mutable_reads(idx),
+        new_status.ok() ? resp_.mutable_responses(idx) : nullptr, &retrier().controller());
+  }
+  retained_self_.reset();
+}
+
 }  // namespace internal
 }  // namespace client
 }  // namespace yb
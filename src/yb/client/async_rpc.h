@@ -168,10 +168,61 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
 
   virtual ~ReadRpc();
 
+  // Prepares this RPC to be sent to the specified tablet server as a part of MultiReadRpc.
+  // The request is moved to 'req' until MultiReadFinished is invoked.
+  void PrepareForMultiRead(RemoteTabletServer* ts, tserver::ReadRequestPB* req);
+
+  // Completes the first attempt of this RPC, that was sent as a part of MultiReadRpc.
+  // 'resp' is null when the whole MultiReadRpc failed. 'controller' is the controller of
+  // MultiReadRpc, that holds sidecars referenced by the response.
+  void MultiReadFinished(
+      const Status& status, tserver::ReadRequestPB* req, tserver::ReadResponsePB* resp,
+      const rpc::RpcController* controller);
+
  private:
   void SwapRequestsAndResponses(bool skip_responses);
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
+
+  const rpc::RpcController& sidecars_controller() const;
+
+  // Set while this RPC is being prepared to be sent as a part of MultiReadRpc.
+  bool multi_read_pending_ = false;
+
+  // Controller of MultiReadRpc, that holds sidecars of the current response.
+  // Reset when the request is retried using the regular Read RPC.
+  const rpc::RpcController* multi_read_controller_ = nullptr;
+};
+
+// Returns tablet server that should be used to send the specified RPC as a part of MultiReadRpc,
+// or nullptr if the RPC should be sent separately.
+RemoteTabletServer* MultiReadTServer(const AsyncRpc& rpc);
+
+// Sends reads to several tablets led by the same tablet server in a single RPC.
+// Each read is completed separately using its own ReadRpc, so retries after failures are
+// performed independently using the regular Read RPC.
+class MultiReadRpc : public rpc::Rpc {
+ public:
+  MultiReadRpc(
+      Batcher* batcher, RemoteTabletServer* ts, std::vector<std::shared_ptr<ReadRpc>> reads);
+
+  virtual ~MultiReadRpc();
+
+  void SendRpc() override;
+  std::string ToString() const override;
+
+ private:
+  void Finished(const Status& status) override;
+
+  scoped_refptr<Batcher> batcher_;
+  RemoteTabletServer* const ts_;
+  std::vector<std::shared_ptr<ReadRpc>> reads_;
+  bool prepared_ = false;
+
+  tserver::MultiReadRequestPB req_;
+  tserver::MultiReadResponsePB resp_;
+
+  rpc::RpcCommandPtr retained_self_;
 };
 
 }  // namespace internal
@@ -33,6 +33,7 @@
 #include "yb/client/batcher.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -542,6 +543,23 @@ void Batcher::ExecuteOperations(Initial initial) {
   // Use big enough value for preallocated storage, to avoid unnecessary allocations.
   boost::container::small_vector<std::shared_ptr<AsyncRpc>, 40> rpcs;
 
+  // Only one RPC could be executed in the current thread. Prefer the first one whose tablet leader
+  // is the local tserver, so the local tablet is processed in place instead of being queued to the
+  // service pool. If there is no such RPC, the last one is used.
+  size_t in_thread_rpc_idx = std::numeric_limits<size_t>::max();
+  auto allow_local_calls = [this, &in_thread_rpc_idx, &rpcs](RemoteTablet* tablet, bool last) {
+    if (!allow_local_calls_in_curr_thread_ ||
+        in_thread_rpc_idx != std::numeric_limits<size_t>::max()) {
+      return false;
+    }
+    auto* leader = tablet->LeaderTServer();
+    if (last || (leader && leader->IsLocal())) {
+      in_thread_rpc_idx = rpcs.size();
+      return true;
+    }
+    return false;
+  };
+
   // Now flush the ops for each tablet.
   auto start = ops_queue_.begin();
   auto start_group = (**start).yb_op->group();
@@ -554,9 +572,9 @@ void Batcher::ExecuteOperations(Initial initial) {
       // Consistent read is not required when whole batch fits into one command.
       bool need_consistent_read = force_consistent_read || start != ops_queue_.begin() ||
                                   it != ops_queue_.end();
+      auto* tablet = start->get()->tablet.get();
       rpcs.push_back(CreateRpc(
-          start->get()->tablet.get(), start, it, /* allow_local_calls_in_curr_thread */ false,
-          need_consistent_read));
+          tablet, start, it, allow_local_calls(tablet, /* last= */ false), need_consistent_read));
       start = it;
       start_group = it_group;
     }
@@ -564,16 +582,63 @@ void Batcher::ExecuteOperations(Initial initial) {
 
   // Consistent read is not required when whole batch fits into one command.
   bool need_consistent_read = force_consistent_read || start != ops_queue_.begin();
+  auto* tablet = start->get()->tablet.get();
   rpcs.push_back(CreateRpc(
-      start->get()->tablet.get(), start, ops_queue_.end(),
-      allow_local_calls_in_curr_thread_, need_consistent_read));
+      tablet, start, ops_queue_.end(), allow_local_calls(tablet, /* last= */ true),
+      need_consistent_read));
+
+  // RPC that could be executed in the current thread is sent last, after all remote RPCs are
+  // already in flight.
+  if (in_thread_rpc_idx < rpcs.size() - 1) {
+    std::rotate(rpcs.begin() + in_thread_rpc_idx, rpcs.begin() + in_thread_rpc_idx + 1,
+                rpcs.end());
+  }
 
   LOG_IF(DFATAL, ops_number != ops_queue_.size())
     << "Ops queue was modified while creating RPCs";
   ops_queue_.clear();
 
+  SendRpcs(rpcs);
+}
+
+template <class Rpcs>
+void Batcher::SendRpcs(const Rpcs& rpcs) {
+  // Reads within transaction could write intents, so they are always sent separately.
+  if (rpcs.size() < 2 || transaction()) {
+    for (const auto& rpc : rpcs) {
+      rpc->SendRpc();
+    }
+    return;
+  }
+
+  std::unordered_map<RemoteTabletServer*, std::vector<std::shared_ptr<ReadRpc>>> reads_by_ts;
+  // The last RPC could be executed in the current thread, so it is sent after multi reads.
+  std::shared_ptr<AsyncRpc> last_rpc;
   for (const auto& rpc : rpcs) {
-    rpc->SendRpc();
+    auto* ts = MultiReadTServer(*rpc);
+    if (ts) {
+      // MultiReadTServer accepts only leader reads, that are always sent using ReadRpc.
+      reads_by_ts[ts].push_back(std::static_pointer_cast<ReadRpc>(rpc));
+    } else if (&rpc == &rpcs.back()) {
+      last_rpc = rpc;
+    } else {
+      rpc->SendRpc();
+    }
+  }
+
+  for (auto& ts_and_reads : reads_by_ts) {
+    auto& reads = ts_and_reads.second;
+    if (reads.size() == 1) {
+      reads.front()->SendRpc();
+    } else {
+      VLOG(3) << "Sending " << reads.size() << " reads to " << ts_and_reads.first->ToString()
+              << " in a single RPC";
+      std::make_shared<MultiReadRpc>(this, ts_and_reads.first, std::move(reads))->SendRpc();
+    }
+  }
+
+  if (last_rpc) {
+    last_rpc->SendRpc();
   }
 }
 
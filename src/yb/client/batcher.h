@@ -203,6 +203,7 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   friend class AsyncRpc;
   friend class WriteRpc;
   friend class ReadRpc;
+  friend class MultiReadRpc;
 
   ~Batcher();
 
@@ -228,6 +229,11 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   void CheckForFinishedFlush();
   void FlushBuffersIfReady();
+
+  // Sends prepared RPCs. Reads to tablets led by the same tablet server are combined into
+  // MultiReadRpc when possible.
+  template <class Rpcs>
+  void SendRpcs(const Rpcs& rpcs);
   std::shared_ptr<AsyncRpc> CreateRpc(
       RemoteTablet* tablet, InFlightOps::const_iterator begin, InFlightOps::const_iterator end,
       bool allow_local_calls_in_curr_thread, bool need_consistent_read);
@@ -161,6 +161,11 @@ Status RemoteTabletServer::InitProxy(YBClient* client) {
   ScopedDnsTracker dns_tracker(dns_resolve_histogram_.get());
   proxy_.reset(new TabletServerServiceProxy(client->data_->proxy_cache_.get(), hostport));
   proxy_endpoint_ = hostport;
+  // Calls to the local tserver could go through shared memory, it is matched by uuid.
+  auto* messenger = client->messenger();
+  if (messenger) {
+    messenger->RegisterSharedMemoryRemote(uuid_, hostport);
+  }
 
   return Status::OK();
 }
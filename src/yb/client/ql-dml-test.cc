@@ -32,6 +32,7 @@
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/curl_util.h"
 #include "yb/util/jsonreader.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
 #include "yb/util/tostring.h"
@@ -44,6 +45,9 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(yb_num_shards_per_tserver);
 DECLARE_int64(db_block_cache_size_bytes);
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_bool(enable_multi_tablet_reads);
+
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_MultiRead);
 
 using namespace std::literals;
 
@@ -1181,6 +1185,49 @@ TEST_F(QLDmlTest, TestSimultaneousReadAndWrite) {
   }
 }
 
+// Reads rows from all tablets using a single flush, so reads to tablets led by the same tablet
+// server are combined into MultiRead RPCs when it is enabled.
+TEST_F(QLDmlTest, MultiTabletRead) {
+  constexpr int kNumRows = 100;
+  InsertRows(kNumRows);
+
+  auto num_multi_reads = [this] {
+    uint64_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      result += METRIC_handler_latency_yb_tserver_TabletServerService_MultiRead.Instantiate(
+          cluster_->mini_tablet_server(i)->server()->metric_entity())->TotalCount();
+    }
+    return result;
+  };
+
+  for (bool multi_tablet_reads : {true, false}) {
+    FLAGS_enable_multi_tablet_reads = multi_tablet_reads;
+    const auto multi_reads_before = num_multi_reads();
+    auto session = NewSession();
+    std::vector<YBqlReadOpPtr> ops;
+    for (int i = 0; i != kNumRows; ++i) {
+      ops.push_back(SelectRow(session, kValueColumns, KeyForIndex(i)));
+    }
+    ASSERT_OK(session->Flush());
+    for (int i = 0; i != kNumRows; ++i) {
+      ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, ops[i]->response().status());
+      auto rowblock = RowsResult(ops[i].get()).GetRowBlock();
+      ASSERT_EQ(1, rowblock->row_count());
+      const auto& row = rowblock->row(0);
+      ASSERT_EQ(ValueForIndex(i),
+                (RowValue{row.column(0).int32_value(), row.column(1).string_value()}));
+    }
+    const auto multi_reads = num_multi_reads() - multi_reads_before;
+    LOG(INFO) << "Multi tablet reads: " << multi_tablet_reads << ", MultiRead RPCs: "
+              << multi_reads;
+    if (multi_tablet_reads) {
+      ASSERT_GT(multi_reads, 0U);
+    } else {
+      ASSERT_EQ(multi_reads, 0U);
+    }
+  }
+}
+
 TEST_F(QLDmlTest, OpenRecentlyCreatedTable) {
   constexpr int kNumIterations = 10;
   constexpr int kNumKeys = 100;
@@ -77,6 +77,10 @@ class TabletInvoker {
   ::yb::HostPort ProxyEndpoint() const;
   YBClient& client() const { return *client_; }
   const RemoteTabletServer& current_ts() { return *current_ts_; }
+
+  // Uses the specified tablet server for the current attempt, without selecting it.
+  // Used when the request is sent as a part of an RPC that combines requests to several tablets.
+  void SetCurrentTServer(RemoteTabletServer* ts) { current_ts_ = ts; }
   bool local_tserver_only() const { return local_tserver_only_; }
 
  private:
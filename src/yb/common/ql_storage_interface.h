@@ -14,6 +14,8 @@
 #ifndef YB_COMMON_QL_STORAGE_INTERFACE_H
 #define YB_COMMON_QL_STORAGE_INTERFACE_H
 
+#include <vector>
+
 #include <boost/optional.hpp>
 
 #include "yb/common/hybrid_time.h"
@@ -97,6 +99,10 @@ class YQLStorageIf {
                                      const ReadHybridTime& read_time,
                                      const QLValuePB& ybctid,
                                      common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
+
+  // Loads the data of the rows with the specified ybctids into memory, so that reading the rows
+  // one by one does not wait for a separate disk read per row. Does nothing by default.
+  virtual void PrefetchRows(const std::vector<Slice>& ybctids) const {}
 };
 
 }  // namespace common
@@ -358,6 +358,15 @@ class Consensus {
 
   virtual void UpdateCDCConsumerOpId(const yb::OpId& op_id) = 0;
 
+  // Invokes callback when an op with index greater than the specified one is majority replicated,
+  // so it could be read by ReadReplicatedMessagesForCDC. Returns id of the waiter, that should be
+  // passed to UnregisterMajorityReplicatedWaiter if the caller is not interested in it anymore,
+  // or 0 if callback was already invoked.
+  virtual int64_t RegisterMajorityReplicatedWaiter(
+      int64_t index, std::function<void()> callback) = 0;
+
+  virtual void UnregisterMajorityReplicatedWaiter(int64_t waiter_id) = 0;
+
  protected:
   friend class RefCountedThreadSafe<Consensus>;
   friend class tablet::TabletPeer;
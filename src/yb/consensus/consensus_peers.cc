@@ -509,6 +509,8 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  // Process responses before user requests, so replication does not stall under overload.
+  controller->set_invoke_callback_mode(rpc::InvokeCallbackMode::kHighPriorityThreadPool);
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
@@ -870,5 +870,47 @@ TEST_F(ConsensusQueueTest, TestReadReplicatedMessagesForCDC) {
   ASSERT_EQ(last_committed_index - start, read_result.messages.size());
 }
 
+// Tests that majority replicated waiters are notified only after the majority replicated index
+// passes the index they are waiting for.
+TEST_F(ConsensusQueueTest, TestMajorityReplicatedWaiters) {
+  queue_->Init(MinimumOpId());
+  queue_->SetLeaderMode(MinimumOpId(), MinimumOpId().term(), BuildRaftConfigPBForTests(2));
+  queue_->TrackPeer(kPeerUuid);
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 10);
+  WaitForLocalPeerToAckIndex(10);
+  queue_->raft_pool_observers_token_->Wait();
+
+  std::atomic<int> notified_5{0};
+  std::atomic<int> notified_8{0};
+  std::atomic<int> notified_unregistered{0};
+  ASSERT_NE(queue_->RegisterMajorityReplicatedWaiter(5, [&notified_5] { ++notified_5; }), 0);
+  ASSERT_NE(queue_->RegisterMajorityReplicatedWaiter(8, [&notified_8] { ++notified_8; }), 0);
+  auto unregistered_id = queue_->RegisterMajorityReplicatedWaiter(
+      5, [&notified_unregistered] { ++notified_unregistered; });
+  ASSERT_NE(unregistered_id, 0);
+  queue_->UnregisterMajorityReplicatedWaiter(unregistered_id);
+
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(6), MinimumOpId().index());
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  queue_->raft_pool_observers_token_->Wait();
+
+  ASSERT_EQ(notified_5.load(), 1);
+  ASSERT_EQ(notified_8.load(), 0);
+  ASSERT_EQ(notified_unregistered.load(), 0);
+
+  // Waiting for an index that is already majority replicated invokes the callback immediately.
+  std::atomic<int> notified_3{0};
+  ASSERT_EQ(queue_->RegisterMajorityReplicatedWaiter(3, [&notified_3] { ++notified_3; }), 0);
+  ASSERT_EQ(notified_3.load(), 1);
+
+  // Closing the queue releases the remaining waiters.
+  queue_->Close();
+  ASSERT_EQ(notified_8.load(), 1);
+  ASSERT_EQ(notified_5.load(), 1);
+}
+
 }  // namespace consensus
 }  // namespace yb
@@ -1199,8 +1199,51 @@ void PeerMessageQueue::Close() {
     installed_num_sst_files_changed_listener_ = false;
   }
   raft_pool_observers_token_->Shutdown();
+  {
+    LockGuard lock(queue_lock_);
+    ClearUnlocked();
+  }
+  NotifyMajorityReplicatedWaiters(std::numeric_limits<int64_t>::max());
+}
+
+int64_t PeerMessageQueue::RegisterMajorityReplicatedWaiter(
+    int64_t index, std::function<void()> callback) {
+  {
+    LockGuard lock(queue_lock_);
+    if (queue_state_.state != State::kQueueClosed &&
+        queue_state_.majority_replicated_op_id.index() <= index) {
+      auto waiter_id = ++last_majority_replicated_waiter_id_;
+      majority_replicated_waiters_.emplace(
+          waiter_id, MajorityReplicatedWaiter{index, std::move(callback)});
+      return waiter_id;
+    }
+  }
+  callback();
+  return 0;
+}
+
+void PeerMessageQueue::UnregisterMajorityReplicatedWaiter(int64_t waiter_id) {
   LockGuard lock(queue_lock_);
-  ClearUnlocked();
+  majority_replicated_waiters_.erase(waiter_id);
+}
+
+void PeerMessageQueue::NotifyMajorityReplicatedWaiters(int64_t majority_replicated_index) {
+  std::vector<std::function<void()>> callbacks;
+  {
+    LockGuard lock(queue_lock_);
+    for (auto it = majority_replicated_waiters_.begin();
+         it != majority_replicated_waiters_.end();) {
+      if (it->second.index < majority_replicated_index) {
+        callbacks.push_back(std::move(it->second.callback));
+        it = majority_replicated_waiters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto& callback : callbacks) {
+    callback();
+  }
 }
 
 string PeerMessageQueue::ToString() const {
@@ -1330,6 +1373,8 @@ void PeerMessageQueue::NotifyObserversOfMajorityReplOpChangeTask(
       queue_state_.committed_op_id.CopyFrom(new_committed_index);
     }
   }
+
+  NotifyMajorityReplicatedWaiters(majority_replicated_data.op_id.index());
 }
 
 void PeerMessageQueue::NotifyObserversOfFailedFollower(const string& uuid,
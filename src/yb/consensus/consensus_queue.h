@@ -347,6 +347,15 @@ class PeerMessageQueue {
 
   void UpdateCDCConsumerOpId(const yb::OpId& op_id);
 
+  // Invokes callback when an op with index greater than the specified one is majority replicated,
+  // or when the queue is closed. Callback is invoked synchronously if such op is already majority
+  // replicated, otherwise it is invoked from raft pool thread, so it should not block.
+  // Returns id of the waiter, that could be used to unregister it, or 0 if callback was already
+  // invoked.
+  int64_t RegisterMajorityReplicatedWaiter(int64_t index, std::function<void()> callback);
+
+  void UnregisterMajorityReplicatedWaiter(int64_t waiter_id);
+
   // Get the maximum op ID that can be evicted for CDC consumer from log cache.
   yb::OpId GetCDCConsumerOpIdToEvict();
 
@@ -440,6 +449,9 @@ class PeerMessageQueue {
 
   void NotifyObserversOfTermChange(int64_t term);
 
+  // Invokes callbacks of waiters for ops with index less than the specified one.
+  void NotifyMajorityReplicatedWaiters(int64_t majority_replicated_index);
+
   void NotifyObserversOfFailedFollower(const std::string& uuid,
                                        int64_t term,
                                        const std::string& reason);
@@ -496,6 +508,15 @@ class PeerMessageQueue {
 
   std::vector<PeerMessageQueueObserver*> observers_;
 
+  struct MajorityReplicatedWaiter {
+    int64_t index;
+    std::function<void()> callback;
+  };
+
+  std::unordered_map<int64_t, MajorityReplicatedWaiter> majority_replicated_waiters_
+      GUARDED_BY(queue_lock_);
+  int64_t last_majority_replicated_waiter_id_ GUARDED_BY(queue_lock_) = 0;
+
   // The pool token which executes observer notifications.
   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token_;
 
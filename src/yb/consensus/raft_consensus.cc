@@ -2961,6 +2961,15 @@ void RaftConsensus::UpdateCDCConsumerOpId(const yb::OpId& op_id) {
   return queue_->UpdateCDCConsumerOpId(op_id);
 }
 
+int64_t RaftConsensus::RegisterMajorityReplicatedWaiter(
+    int64_t index, std::function<void()> callback) {
+  return queue_->RegisterMajorityReplicatedWaiter(index, std::move(callback));
+}
+
+void RaftConsensus::UnregisterMajorityReplicatedWaiter(int64_t waiter_id) {
+  queue_->UnregisterMajorityReplicatedWaiter(waiter_id);
+}
+
 void RaftConsensus::RollbackIdAndDeleteOpId(const ReplicateMsgPtr& replicate_msg,
                                             bool should_exists) {
   std::unique_ptr<OpId> op_id(replicate_msg->release_id());
@@ -252,6 +252,11 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   void UpdateCDCConsumerOpId(const yb::OpId& op_id) override;
 
+  int64_t RegisterMajorityReplicatedWaiter(
+      int64_t index, std::function<void()> callback) override;
+
+  void UnregisterMajorityReplicatedWaiter(int64_t waiter_id) override;
+
   // Start memory tracking of following operation in case it is still present in our caches.
   void TrackOperationMemory(const yb::OpId& op_id);
 
@@ -37,6 +37,7 @@
 #include "yb/util/tostring.h"
 
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
+DECLARE_int32(rocksdb_max_subcompactions);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 
@@ -1028,5 +1029,62 @@ TEST_F(DocOperationTest, MaxFileSizeWithWritesTrigger) {
   ASSERT_EQ(0, stats->GetCFStats(rocksdb::InternalStats::LEVEL0_SLOWDOWN_TOTAL));
 }
 
+TEST_F(DocOperationTest, Subcompactions) {
+  google::FlagSaver flag_saver;
+
+  ASSERT_OK(DisableCompactions());
+  auto schema = CreateSchema();
+  auto t0 = HybridTime::FromMicrosecondsAndLogicalValue(1000, 0);
+  const int kBatches = 8;
+  const int kRowsPerBatch = 5000;
+  // Every file covers the whole key range, so compaction output could not be split at input file
+  // boundaries only.
+  for (int i = 0; i != kBatches; ++i) {
+    for (int j = 0; j != kRowsPerBatch; ++j) {
+      int key = j * kBatches + i;
+      WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, {key, key, key, key},
+                 1000000, t0);
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  FLAGS_rocksdb_max_file_size_for_compaction = 100_KB;
+  FLAGS_rocksdb_max_subcompactions = 4;
+  ASSERT_OK(ReinitDBOptions());
+  WaitCompactionsDone(rocksdb());
+  FullyCompactHistoryBefore(t0);
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_GT(files.size(), 1U);
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.smallest.key < rhs.smallest.key;
+  });
+  // Output files of subcompactions should not overlap, and the same document should never be
+  // split between them.
+  for (size_t i = 1; i != files.size(); ++i) {
+    Slice prev_largest(files[i - 1].largest.key);
+    Slice smallest(files[i].smallest.key);
+    auto prev_doc_key_size = ASSERT_RESULT(
+        DocKey::EncodedSize(prev_largest, DocKeyPart::WHOLE_DOC_KEY));
+    auto doc_key_size = ASSERT_RESULT(DocKey::EncodedSize(smallest, DocKeyPart::WHOLE_DOC_KEY));
+    ASSERT_LT(Slice(prev_largest.data(), prev_doc_key_size).compare(
+                  Slice(smallest.data(), doc_key_size)), 0);
+  }
+
+  // Output files form one sorted run, so all of them have the seqno range of the whole output.
+  for (const auto& file : files) {
+    ASSERT_LE(file.smallest.seqno, file.largest.seqno);
+    ASSERT_EQ(files.front().smallest.seqno, file.smallest.seqno);
+    ASSERT_EQ(files.front().largest.seqno, file.largest.seqno);
+  }
+
+  for (int key = 0; key < kBatches * kRowsPerBatch; key += 97) {
+    QLRowBlock row_block = ReadQLRow(schema, key, t0);
+    ASSERT_EQ(1, row_block.row_count());
+    ASSERT_EQ(key, row_block.row(0).column(1).int32_value());
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
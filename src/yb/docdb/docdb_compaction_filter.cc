@@ -340,6 +340,15 @@ const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
 
+Slice DocDBCompactionFilterFactory::SubcompactionBoundary(const Slice& user_key) const {
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::WHOLE_DOC_KEY);
+  if (!doc_key_size.ok()) {
+    // Keys that are not valid documents are not tracked across keys by the filter.
+    return user_key;
+  }
+  return Slice(user_key.data(), *doc_key_size);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
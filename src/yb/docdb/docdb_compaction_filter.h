@@ -165,6 +165,10 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
       const rocksdb::CompactionFilter::Context& context) override;
   const char* Name() const override;
 
+  // DocDBCompactionFilter tracks overwrites within a document, so a document should never be split
+  // between subcompactions.
+  Slice SubcompactionBoundary(const Slice& user_key) const override;
+
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
   const KeyBounds* key_bounds_;
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <atomic>
 #include <thread>
 #include <memory>
 
@@ -21,15 +22,18 @@
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/version_edit.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/db/writebuffer.h"
+#include "yb/rocksdb/table/columnar_table_factory.h"
 #include "yb/rocksdb/table/filtering_iterator.h"
 #include "yb/rocksdb/util/compression.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -67,12 +71,32 @@ DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
+DEFINE_int64(rocksdb_node_compact_flush_rate_limit_bytes_per_sec, 0,
+             "When positive, flushes and compactions of all RocksDB instances of the node share "
+             "this write rate, instead of rocksdb_compact_flush_rate_limit_bytes_per_sec per "
+             "instance.");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximal number of threads that a single compaction could be split into, each "
+             "processing its own key range. Single level compaction is split only when "
+             "rocksdb_max_file_size_for_compaction is set, into output files of about twice that "
+             "size. Subcompactions run as tasks of the compaction thread pool.");
+DEFINE_bool(rocksdb_use_direct_io_for_flush_and_compaction, false,
+            "Whether flushes and compactions should write and read SST files with O_DIRECT, "
+            "so they do not evict pages used by foreground reads from the OS page cache.");
+DEFINE_uint64(rocksdb_direct_io_compaction_readahead_size_bytes, 2_MB,
+              "Size of reads of compaction inputs, when they are read with O_DIRECT.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
+DEFINE_bool(regular_db_columnar_sst, false,
+            "Whether full compactions of the regular RocksDB should write SST files in columnar "
+            "format, which is more compact and faster to scan.");
+DEFINE_uint64(regular_db_columnar_block_size_bytes, 256_KB,
+              "Size of keys and values stored in a single block of columnar SST files, before "
+              "encoding and compression.");
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -106,6 +130,16 @@ DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved smal
 
 DEFINE_bool(enable_ondisk_compression, true,
             "Determines whether SSTable compression is enabled or not.");
+DEFINE_string(rocksdb_compression_type, "Snappy",
+              "Compression type of SST files, when enable_ondisk_compression is set: "
+              "NoCompression, Snappy, Zlib, LZ4 or ZSTD.");
+DEFINE_string(rocksdb_bottommost_compression_type, "",
+              "Compression type of SST files written by compactions that include the oldest SST "
+              "file, so they contain most of the data. Accepts the same values as "
+              "rocksdb_compression_type, empty to use rocksdb_compression_type.");
+DEFINE_int32(rocksdb_zstd_max_dict_bytes, 16_KB,
+             "Maximal size of the dictionary, that is trained for each SST file compressed with "
+             "ZSTD. 0 to compress without dictionaries.");
 
 DEFINE_int32(priority_thread_pool_size, -1,
              "Max running workers in compaction thread pool. "
@@ -204,13 +238,45 @@ void PerformRocksDBSeek(
 
 namespace {
 
+// Skips SST files that do not contain keys within tablet key bounds. After tablet split, child
+// tablets share hard-linked SST files of the parent until they are compacted, so half of the
+// files could be skipped by a read without looking into them.
+class KeyBoundsFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  // Key bounds are copied, since the filter could outlive the tablet key bounds it was created
+  // from, when RocksDB instances of the tablet are reset.
+  KeyBoundsFileFilter(
+      const KeyBounds& key_bounds, std::shared_ptr<rocksdb::ReadFileFilter> inner_filter)
+      : key_bounds_(key_bounds), inner_filter_(std::move(inner_filter)) {}
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (!key_bounds_.lower.empty() &&
+        file.largest.user_key().compare(key_bounds_.lower.AsSlice()) < 0) {
+      return false;
+    }
+    if (!key_bounds_.upper.empty() &&
+        file.smallest.user_key().compare(key_bounds_.upper.AsSlice()) >= 0) {
+      return false;
+    }
+    return !inner_filter_ || inner_filter_->Filter(file);
+  }
+
+ private:
+  const KeyBounds key_bounds_;
+  std::shared_ptr<rocksdb::ReadFileFilter> inner_filter_;
+};
+
 rocksdb::ReadOptions PrepareReadOptions(
     rocksdb::DB* rocksdb,
+    const KeyBounds* key_bounds,
     BloomFilterMode bloom_filter_mode,
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
     const Slice* iterate_upper_bound) {
+  if (key_bounds && (!key_bounds->lower.empty() || !key_bounds->upper.empty())) {
+    file_filter = std::make_shared<KeyBoundsFileFilter>(*key_bounds, std::move(file_filter));
+  }
   rocksdb::ReadOptions read_opts;
   read_opts.query_id = query_id;
   if (FLAGS_use_docdb_aware_bloom_filter &&
@@ -234,8 +300,9 @@ BoundedRocksDbIterator CreateRocksDBIterator(
     const rocksdb::QueryId query_id,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
     const Slice* iterate_upper_bound) {
-  rocksdb::ReadOptions read_opts = PrepareReadOptions(rocksdb, bloom_filter_mode,
-      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+  rocksdb::ReadOptions read_opts = PrepareReadOptions(rocksdb, docdb_key_bounds,
+      bloom_filter_mode, user_key_for_filter, query_id, std::move(file_filter),
+      iterate_upper_bound);
   return BoundedRocksDbIterator(rocksdb, read_opts, docdb_key_bounds);
 }
 
@@ -250,8 +317,9 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
     const Slice* iterate_upper_bound) {
   // TODO(dtxn) do we need separate options for intents db?
-  rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
-      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+  rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, doc_db.key_bounds,
+      bloom_filter_mode, user_key_for_filter, query_id, std::move(file_filter),
+      iterate_upper_bound);
   return std::make_unique<IntentAwareIterator>(
       doc_db, read_opts, deadline, read_time, txn_op_context);
 }
@@ -373,8 +441,60 @@ rocksdb::InternalIterator* WrapIterator(
   return iterator;
 }
 
+std::atomic<PriorityThreadPool*> compactions_and_flushes_thread_pool{nullptr};
+
+// Stores DocKey as row, subkeys as column and hybrid time as version of columnar SST files.
+class DocDbColumnarKeySplitter : public rocksdb::ColumnarKeySplitter {
+ public:
+  const char* Name() const override { return "DocDbColumnarKeySplitter"; }
+
+  void Split(const Slice& user_key, size_t* row_size, size_t* column_size) const override {
+    auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::WHOLE_DOC_KEY);
+    int encoded_ht_size = 0;
+    // The hybrid time is preceded by ValueType::kHybridTime, which is also stored in version.
+    if (!doc_key_size.ok() ||
+        !DocHybridTime::CheckAndGetEncodedSize(user_key, &encoded_ht_size).ok() ||
+        *doc_key_size + encoded_ht_size + 1 > user_key.size()) {
+      *row_size = user_key.size();
+      *column_size = 0;
+      return;
+    }
+    *row_size = *doc_key_size;
+    *column_size = user_key.size() - *doc_key_size - encoded_ht_size - 1;
+  }
+};
+
+// Returns compression type with the name printed by CompressionTypeToString. Falls back to the
+// default compression type if it is unknown or not linked with the binary.
+rocksdb::CompressionType CompressionTypeFromName(const std::string& name) {
+  for (auto type : {rocksdb::kNoCompression, rocksdb::kSnappyCompression,
+                    rocksdb::kZlibCompression, rocksdb::kLZ4Compression, rocksdb::kZSTD}) {
+    if (name != rocksdb::CompressionTypeToString(type)) {
+      continue;
+    }
+    if (rocksdb::CompressionTypeSupported(type)) {
+      return type;
+    }
+    LOG(WARNING) << "Compression type " << name << " is not linked with the binary";
+    return rocksdb::Snappy_Supported() ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  }
+  LOG(DFATAL) << "Unknown compression type: " << name;
+  return rocksdb::Snappy_Supported() ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+}
+
 } // namespace
 
+PriorityThreadPool* CompactionsAndFlushesThreadPool() {
+  return compactions_and_flushes_thread_pool.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<rocksdb::RateLimiter> NodeCompactFlushRateLimiter() {
+  static const auto rate_limit = FLAGS_rocksdb_node_compact_flush_rate_limit_bytes_per_sec;
+  static std::shared_ptr<rocksdb::RateLimiter> rate_limiter(
+      rate_limit > 0 ? rocksdb::NewGenericRateLimiter(rate_limit) : nullptr);
+  return rate_limiter;
+}
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& log_prefix,
     const shared_ptr<rocksdb::Statistics>& statistics,
@@ -388,6 +508,10 @@ void InitRocksDBOptions(
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
   options->compaction_measure_io_stats = FLAGS_rocksdb_compaction_measure_io_stats;
+  if (FLAGS_rocksdb_use_direct_io_for_flush_and_compaction) {
+    options->use_direct_io_for_flush_and_compaction = true;
+    options->compaction_readahead_size = FLAGS_rocksdb_direct_io_compaction_readahead_size_bytes;
+  }
   options->memory_monitor = tablet_options.memory_monitor;
   if (FLAGS_db_write_buffer_size != -1) {
     options->write_buffer_size = FLAGS_db_write_buffer_size;
@@ -398,6 +522,8 @@ void InitRocksDBOptions(
   options->checkpoint_env = rocksdb::Env::Default();
   static PriorityThreadPool priority_thread_pool_for_compactions_and_flushes(
       FLAGS_priority_thread_pool_size);
+  compactions_and_flushes_thread_pool.store(
+      &priority_thread_pool_for_compactions_and_flushes, std::memory_order_release);
   options->priority_thread_pool_for_compactions_and_flushes =
       &priority_thread_pool_for_compactions_and_flushes;
 
@@ -405,8 +531,18 @@ void InitRocksDBOptions(
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
   }
 
-  options->compression = rocksdb::Snappy_Supported() && FLAGS_enable_ondisk_compression
-      ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  if (FLAGS_enable_ondisk_compression) {
+    options->compression = CompressionTypeFromName(FLAGS_rocksdb_compression_type);
+    // With single level universal compaction, bottommost compactions are the ones that include
+    // the oldest SST file.
+    if (!FLAGS_rocksdb_bottommost_compression_type.empty()) {
+      options->bottommost_compression =
+          CompressionTypeFromName(FLAGS_rocksdb_bottommost_compression_type);
+    }
+    options->compression_opts.max_dict_bytes = FLAGS_rocksdb_zstd_max_dict_bytes;
+  } else {
+    options->compression = rocksdb::kNoCompression;
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -439,7 +575,16 @@ void InitRocksDBOptions(
     table_options.index_type = rocksdb::IndexType::kBinarySearch;
   }
 
-  options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+  // Columnar SST files written by full compactions should be readable regardless of the flag, so
+  // block-based table factory is always wrapped. The reader is picked by the footer magic number
+  // of each file when it is opened.
+  rocksdb::ColumnarTableOptions columnar_table_options;
+  columnar_table_options.block_size = FLAGS_regular_db_columnar_block_size_bytes;
+  columnar_table_options.use_for_full_compactions = FLAGS_regular_db_columnar_sst;
+  columnar_table_options.key_splitter = std::make_shared<DocDbColumnarKeySplitter>();
+  options->table_factory.reset(rocksdb::NewColumnarTableFactory(
+      columnar_table_options,
+      std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(table_options))));
 
   // Compaction related options.
 
@@ -468,7 +613,10 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
-    if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
+    auto node_rate_limiter = NodeCompactFlushRateLimiter();
+    if (node_rate_limiter) {
+      options->rate_limiter = std::move(node_rate_limiter);
+    } else if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
     }
@@ -481,6 +629,7 @@ void InitRocksDBOptions(
   if (max_file_size_for_compaction != 0) {
     options->max_file_size_for_compaction = max_file_size_for_compaction;
   }
+  options->max_subcompactions = FLAGS_rocksdb_max_subcompactions;
 
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
 
@@ -490,6 +639,13 @@ void InitRocksDBOptions(
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
 
+void DisableColumnarSst(rocksdb::Options* options) {
+  auto* factory = dynamic_cast<rocksdb::ColumnarTableFactory*>(options->table_factory.get());
+  if (factory) {
+    options->table_factory = factory->base_factory();
+  }
+}
+
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
   options->log_prefix = log_prefix;
   options->info_log = std::make_shared<YBRocksDBLogger>(options->log_prefix);
@@ -113,6 +113,18 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Returns thread pool shared by compactions and flushes of all RocksDB instances of this process.
+// Returns nullptr if no RocksDB instance was initialized yet.
+PriorityThreadPool* CompactionsAndFlushesThreadPool();
+
+// Returns rate limiter shared by flushes and compactions of all RocksDB instances of this process,
+// or nullptr if rocksdb_node_compact_flush_rate_limit_bytes_per_sec is not set.
+std::shared_ptr<rocksdb::RateLimiter> NodeCompactFlushRateLimiter();
+
+// Makes full compactions write block-based SST files, even if columnar SST files are enabled by
+// regular_db_columnar_sst. Used for the intents DB, that never has columnar SST files.
+void DisableColumnarSst(rocksdb::Options* options);
+
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
@@ -552,6 +552,15 @@ Result<size_t> PgsqlReadOperation::ExecuteBatch(const common::YQLStorageIf& ql_s
   Schema projection;
   RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
 
+  if (request_.batch_arguments_size() > 1) {
+    std::vector<Slice> ybctids;
+    ybctids.reserve(request_.batch_arguments_size());
+    for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+      ybctids.push_back(batch_argument.ybctid().value().binary_value());
+    }
+    ql_storage.PrefetchRows(ybctids);
+  }
+
   QLTableRow row;
   size_t row_count = 0;
   for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
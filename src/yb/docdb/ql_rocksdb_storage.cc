@@ -230,5 +230,10 @@ Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
   return Status::OK();
 }
 
+void QLRocksDBStorage::PrefetchRows(const std::vector<Slice>& ybctids) const {
+  // Ybctid is the encoded document key, that is a prefix of all keys of the row.
+  doc_db_.regular->PrefetchKeys(rocksdb::ReadOptions::kDefault, ybctids);
+}
+
 }  // namespace docdb
 }  // namespace yb
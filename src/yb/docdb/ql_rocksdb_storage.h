@@ -81,6 +81,8 @@ class QLRocksDBStorage : public common::YQLStorageIf {
                              const QLValuePB& ybctid,
                              common::YQLRowwiseIteratorIf::UniPtr* iter) const override;
 
+  void PrefetchRows(const std::vector<Slice>& ybctids) const override;
+
  private:
   const DocDB doc_db_;
 };
@@ -20,6 +20,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/stol_utils.h"
 #include "yb/util/redis_util.h"
 
@@ -30,6 +31,21 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_int32(redis_sorted_set_scan_max_cardinality, 128,
+             "When several members of a sorted set with at most this many members are added or "
+             "removed, its whole member to score mapping is read with a single scan instead of "
+             "looking up every member separately.");
+TAG_FLAG(redis_sorted_set_scan_max_cardinality, advanced);
+TAG_FLAG(redis_sorted_set_scan_max_cardinality, runtime);
+
+DEFINE_int32(redis_packed_collection_max_cardinality, 64,
+             "Hashes and sorted sets with at most this many members are stored packed in a single "
+             "value instead of one entry per hash field or two per sorted set member. A collection "
+             "that grows past this size is converted to the regular layout and keeps it. 0 stops "
+             "packing new collections.");
+TAG_FLAG(redis_packed_collection_max_cardinality, advanced);
+TAG_FLAG(redis_packed_collection_max_cardinality, runtime);
+
 namespace yb {
 namespace docdb {
 
@@ -428,6 +444,213 @@ Result<int64_t> GetCardinality(IntentAwareIterator* iterator, const RedisKeyValu
   return subdoc_card_found ? subdoc_card.GetInt64() : 0;
 }
 
+// Looks up scores of sorted set members using the member to score mapping.
+class SortedSetScoreLookup {
+ public:
+  SortedSetScoreLookup(IntentAwareIterator* iterator, const RedisKeyValuePB& kv)
+      : iterator_(iterator),
+        encoded_reverse_key_(DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key())) {
+    PrimitiveValue(ValueType::kSSReverse).AppendToKey(&encoded_reverse_key_);
+  }
+
+  // Reads the whole mapping if the sorted set is small enough, so members are looked up in memory.
+  CHECKED_STATUS LoadIfSmall(int64_t card) {
+    if (card > FLAGS_redis_sorted_set_scan_max_cardinality) {
+      return Status::OK();
+    }
+    bool doc_found = false;
+    GetSubDocumentData data = { encoded_reverse_key_, &reverse_, &doc_found };
+    RETURN_NOT_OK(GetSubDocument(
+        iterator_, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+    loaded_ = true;
+    return Status::OK();
+  }
+
+  // Returns the score of the member, or none if it is not in the sorted set.
+  Result<boost::optional<double>> Get(const PrimitiveValue& member) {
+    if (loaded_) {
+      const SubDocument* score = reverse_.GetChild(member);
+      if (!score || score->value_type() == ValueType::kTombstone) {
+        return boost::none;
+      }
+      return score->GetDouble();
+    }
+
+    KeyBytes encoded_member_key = encoded_reverse_key_;
+    member.AppendToKey(&encoded_member_key);
+    SubDocument score;
+    bool score_found = false;
+    GetSubDocumentData data = { encoded_member_key, &score, &score_found };
+    RETURN_NOT_OK(GetSubDocument(
+        iterator_, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+    if (!score_found || score.value_type() == ValueType::kTombstone) {
+      return boost::none;
+    }
+    return score.GetDouble();
+  }
+
+ private:
+  IntentAwareIterator* iterator_;
+  KeyBytes encoded_reverse_key_;
+  bool loaded_ = false;
+  SubDocument reverse_;
+};
+
+// A small hash or sorted set packed in a single value, stored under the kNullLow subkey of the
+// collection, which sorts before hash fields and the sorted set subkeys. The value is a sequence of
+// key encoded pairs: field and value for hashes, member and score for sorted sets.
+class PackedCollection {
+ public:
+  // Maps hash fields to their values, or sorted set members to their scores.
+  typedef std::map<std::string, PrimitiveValue> Entries;
+
+  explicit PackedCollection(const RedisKeyValuePB& kv)
+      : encoded_doc_key_(DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key())),
+        encoded_packed_key_(encoded_doc_key_) {
+    SubKey().AppendToKey(&encoded_packed_key_);
+  }
+
+  static PrimitiveValue SubKey() { return PrimitiveValue(ValueType::kNullLow); }
+
+  // Reads the packed value. The iterator does not see writes of earlier operations in
+  // doc_write_batch, so these are checked first.
+  CHECKED_STATUS Load(IntentAwareIterator* iterator,
+                      const DocWriteBatch* doc_write_batch = nullptr) {
+    if (doc_write_batch) {
+      const auto& pairs = doc_write_batch->key_value_pairs();
+      for (auto it = pairs.rbegin(); it != pairs.rend(); ++it) {
+        const bool is_packed_key = it->first == encoded_packed_key_.AsStringRef();
+        if (!is_packed_key && it->first != encoded_doc_key_.AsStringRef()) {
+          continue;
+        }
+        Value value;
+        RETURN_NOT_OK(value.Decode(it->second));
+        if (is_packed_key) {
+          return Decode(value.primitive_value());
+        }
+        // Only a TTL update keeps the members of the collection written at the top level.
+        if (!(value.merge_flags() & Value::kTtlFlag)) {
+          return Status::OK();
+        }
+      }
+    }
+    SubDocument packed;
+    bool packed_found = false;
+    GetSubDocumentData data = { encoded_packed_key_, &packed, &packed_found };
+    RETURN_NOT_OK(GetSubDocument(
+        iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+    return packed_found ? Decode(packed) : Status::OK();
+  }
+
+  // Reads the packed value from the already read collection.
+  CHECKED_STATUS LoadFrom(const SubDocument& collection) {
+    const SubDocument* packed = collection.GetChild(SubKey());
+    return packed ? Decode(*packed) : Status::OK();
+  }
+
+  bool found() const { return found_; }
+
+  Entries& entries() { return entries_; }
+
+  const Entries& entries() const { return entries_; }
+
+  // Returns the hash field as a string value, or a value of type none if it is missing.
+  RedisValue Get(const std::string& field) const {
+    auto it = entries_.find(field);
+    if (it == entries_.end()) {
+      return RedisValue{REDIS_TYPE_NONE};
+    }
+    return RedisValue{REDIS_TYPE_STRING, it->second.GetString()};
+  }
+
+  // Returns the sorted set members with their scores, ordered by score and then by member like
+  // the score to member mapping.
+  std::vector<std::pair<double, std::string>> SortedByScore() const {
+    std::vector<std::pair<double, std::string>> members;
+    members.reserve(entries_.size());
+    for (const auto& entry : entries_) {
+      members.emplace_back(entry.second.GetDouble(), entry.first);
+    }
+    std::sort(members.begin(), members.end());
+    return members;
+  }
+
+  // Returns the children to write for the entries: the packed value while the collection is small
+  // enough, otherwise the regular layout of the given type, deleting the packed value if any.
+  SubDocument ToSubDocument(RedisDataType type) const {
+    SubDocument result;
+    if (static_cast<int64_t>(entries_.size()) <= FLAGS_redis_packed_collection_max_cardinality) {
+      KeyBytes encoded;
+      for (const auto& entry : entries_) {
+        PrimitiveValue(entry.first).AppendToKey(&encoded);
+        entry.second.AppendToKey(&encoded);
+      }
+      result.SetChild(SubKey(), SubDocument(PrimitiveValue(encoded.AsStringRef())));
+      return result;
+    }
+
+    if (found_) {
+      result.SetChild(SubKey(), SubDocument(ValueType::kTombstone));
+    }
+    if (type == REDIS_TYPE_HASH) {
+      for (const auto& entry : entries_) {
+        result.SetChild(PrimitiveValue(entry.first), SubDocument(entry.second));
+      }
+      return result;
+    }
+    SubDocument forward;
+    SubDocument reverse;
+    for (const auto& entry : entries_) {
+      forward.GetOrAddChild(entry.second).first->SetChild(
+          PrimitiveValue(entry.first), SubDocument(PrimitiveValue()));
+      reverse.SetChild(PrimitiveValue(entry.first), SubDocument(entry.second));
+    }
+    result.SetChild(PrimitiveValue(ValueType::kCounter),
+                    SubDocument(PrimitiveValue(static_cast<int64_t>(entries_.size()))));
+    result.SetChild(PrimitiveValue(ValueType::kSSForward), std::move(forward));
+    result.SetChild(PrimitiveValue(ValueType::kSSReverse), std::move(reverse));
+    return result;
+  }
+
+ private:
+  CHECKED_STATUS Decode(const PrimitiveValue& packed) {
+    if (packed.value_type() != ValueType::kString) {
+      return Status::OK();
+    }
+    Slice slice(packed.GetString());
+    while (!slice.empty()) {
+      PrimitiveValue key;
+      PrimitiveValue value;
+      RETURN_NOT_OK(key.DecodeFromKey(&slice));
+      RETURN_NOT_OK(value.DecodeFromKey(&slice));
+      entries_.emplace(key.GetString(), std::move(value));
+    }
+    found_ = true;
+    return Status::OK();
+  }
+
+  KeyBytes encoded_doc_key_;
+  KeyBytes encoded_packed_key_;
+  bool found_ = false;
+  Entries entries_;
+};
+
+// Populates the response with the given range of sorted set members, followed by their scores if
+// with_scores is set.
+CHECKED_STATUS PopulateResponseFromSortedSetMembers(
+    const std::vector<std::pair<double, std::string>>& members, size_t begin, size_t end,
+    bool reverse, bool with_scores, RedisResponsePB* response) {
+  response->set_allocated_array_response(new RedisArrayPB());
+  for (size_t i = begin; i < end; ++i) {
+    const auto& member = members[reverse ? end - 1 - (i - begin) : i];
+    RETURN_NOT_OK(AddResponseValuesGeneric(
+        PrimitiveValue(member.second), PrimitiveValue::Double(member.first), response,
+        /* add_keys */ true, /* add_values */ with_scores));
+  }
+  response->set_code(RedisResponsePB::OK);
+  return Status::OK();
+}
+
 template <typename AddResponseValues>
 CHECKED_STATUS GetAndPopulateResponseValues(
     IntentAwareIterator* iterator,
@@ -563,6 +786,33 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
           response_.set_error_message(wrong_type_message);
           return Status::OK();
         }
+
+        PackedCollection packed(kv);
+        if (kv.type() == REDIS_TYPE_HASH && data_type != REDIS_TYPE_NONE) {
+          RETURN_NOT_OK(packed.Load(iterator_.get(), data.doc_write_batch));
+        }
+        if (kv.type() == REDIS_TYPE_HASH && (data_type == REDIS_TYPE_NONE || packed.found())) {
+          bool field_existed = false;
+          for (int i = 0; i < kv.subkey_size(); i++) {
+            PrimitiveValue subkey_value;
+            RETURN_NOT_OK(PrimitiveValueFromSubKeyStrict(kv.subkey(i), kv.type(), &subkey_value));
+            auto inserted = packed.entries().emplace(
+                subkey_value.GetString(), PrimitiveValue(kv.value(i)));
+            if (!inserted.second) {
+              inserted.first->second = PrimitiveValue(kv.value(i));
+              field_existed = true;
+            }
+          }
+          if (kv.subkey_size() == 1 && EmulateRedisResponse(kv.type()) &&
+              !request_.set_request().expect_ok_response()) {
+            SetOptionalInt(field_existed ? REDIS_TYPE_STRING : REDIS_TYPE_NONE, 0, 1, &response_);
+          }
+          RETURN_NOT_OK(data.doc_write_batch->ExtendSubDocument(
+              doc_path, packed.ToSubDocument(kv.type()), data.read_time, data.deadline,
+              redis_query_id(), ttl));
+          break;
+        }
+
         SubDocument kv_entries = SubDocument();
         for (int i = 0; i < kv.subkey_size(); i++) {
           PrimitiveValue subkey_value;
@@ -603,6 +853,57 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
           return Status::OK();
         }
 
+        PackedCollection packed(kv);
+        if (data_type != REDIS_TYPE_NONE) {
+          RETURN_NOT_OK(packed.Load(iterator_.get(), data.doc_write_batch));
+        }
+        if (data_type == REDIS_TYPE_NONE || packed.found()) {
+          const auto& options = request_.set_request().sorted_set_options();
+          bool changed = false;
+          int return_value = 0;
+          for (int i = 0; i < kv.subkey_size(); i++) {
+            const double score = kv.subkey(i).double_subkey();
+            auto it = packed.entries().find(kv.value(i));
+            if (it == packed.entries().end()) {
+              // XX option calls for no new elements.
+              if (options.update_options() != SortedSetOptionsPB::XX) {
+                packed.entries().emplace(kv.value(i), PrimitiveValue::Double(score));
+                changed = true;
+                return_value++;
+              }
+              continue;
+            }
+            // NX option calls for only new elements.
+            if (options.update_options() == SortedSetOptionsPB::NX) {
+              continue;
+            }
+            const double old_score = it->second.GetDouble();
+            const double new_score = options.incr() ? old_score + score : score;
+            if (new_score != old_score) {
+              it->second = PrimitiveValue::Double(new_score);
+              changed = true;
+              if (options.ch()) {
+                return_value++;
+              }
+            }
+          }
+
+          if (changed) {
+            SubDocument kv_entries = packed.ToSubDocument(kv.type());
+            RETURN_NOT_OK(kv_entries.ConvertToRedisSortedSet());
+            if (data_type == REDIS_TYPE_NONE) {
+              RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
+                  doc_path, kv_entries, data.read_time, data.deadline, redis_query_id(), ttl));
+            } else {
+              RETURN_NOT_OK(data.doc_write_batch->ExtendSubDocument(
+                  doc_path, kv_entries, data.read_time, data.deadline, redis_query_id(), ttl));
+            }
+          }
+          response_.set_code(RedisResponsePB::OK);
+          response_.set_int_response(return_value);
+          break;
+        }
+
         // The SubDocuments to be inserted for card, the forward mapping, and reverse mapping.
         SubDocument kv_entries_card;
         SubDocument kv_entries_forward;
@@ -611,22 +912,21 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
         // The top level mapping.
         SubDocument kv_entries;
 
+        // When several members are added, the cardinality is read first, so a small sorted set
+        // could have all its scores read with a single scan.
+        boost::optional<int64_t> card;
+        SortedSetScoreLookup score_lookup(iterator_.get(), kv);
+        if (kv.subkey_size() > 1) {
+          card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+          RETURN_NOT_OK(score_lookup.LoadIfSmall(*card));
+        }
+
         int new_elements_added = 0;
         int return_value = 0;
         for (int i = 0; i < kv.subkey_size(); i++) {
           // Check whether the value is already in the document, if so delete it.
-          SubDocKey key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
-                                            PrimitiveValue(ValueType::kSSReverse),
-                                            PrimitiveValue(kv.value(i)));
-          SubDocument subdoc_reverse;
-          bool subdoc_reverse_found = false;
-          auto encoded_key_reverse = key_reverse.EncodeWithoutHt();
-          GetSubDocumentData get_data = { encoded_key_reverse, &subdoc_reverse,
-                                          &subdoc_reverse_found };
-          RETURN_NOT_OK(GetSubDocument(
-              data.doc_write_batch->doc_db(),
-              get_data, redis_query_id(), boost::none /* txn_op_context */, data.deadline,
-              data.read_time));
+          const auto existing_score = VERIFY_RESULT(score_lookup.Get(PrimitiveValue(kv.value(i))));
+          const bool subdoc_reverse_found = existing_score.is_initialized();
 
           // Flag indicating whether we should add the given entry to the sorted set.
           bool should_add_entry = true;
@@ -660,7 +960,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
                 // Both these options call for updating existing elements, set
                 // should_remove_existing_entry to true, and if the CH flag is on (return both
                 // elements changed and elements added), increment return_value.
-                double score_to_remove = subdoc_reverse.GetDouble();
+                double score_to_remove = *existing_score;
                 if (score_to_remove != kv.subkey(i).double_subkey()) {
                   should_remove_existing_entry = true;
                   if (request_.set_request().sorted_set_options().ch()) {
@@ -678,7 +978,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
           }
 
           if (should_remove_existing_entry) {
-            double score_to_remove = subdoc_reverse.GetDouble();
+            double score_to_remove = *existing_score;
             SubDocument subdoc_forward_tombstone;
             subdoc_forward_tombstone.SetChild(PrimitiveValue(kv.value(i)),
                                               SubDocument(ValueType::kTombstone));
@@ -690,7 +990,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
             // If the incr option is specified, we need insert the existing score + new score
             // instead of just the new score.
             double score_to_add = request_.set_request().sorted_set_options().incr() ?
-                kv.subkey(i).double_subkey() + subdoc_reverse.GetDouble() :
+                kv.subkey(i).double_subkey() + existing_score.get_value_or(0) :
                 kv.subkey(i).double_subkey();
 
             // Add the forward mapping to the entries.
@@ -706,9 +1006,11 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
         }
 
         if (new_elements_added > 0) {
-          int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+          if (!card) {
+            card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+          }
           // Insert card + new_elements_added back into the document for the updated card.
-          kv_entries_card = SubDocument(PrimitiveValue(card + new_elements_added));
+          kv_entries_card = SubDocument(PrimitiveValue(*card + new_elements_added));
           kv_entries.SetChild(PrimitiveValue(ValueType::kCounter), SubDocument(kv_entries_card));
         }
 
@@ -938,28 +1240,34 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       break;
     }
     case REDIS_TYPE_SORTEDSET: {
+      PackedCollection packed(kv);
+      if (data_type != REDIS_TYPE_NONE) {
+        RETURN_NOT_OK(packed.Load(iterator_.get(), data.doc_write_batch));
+      }
+      if (packed.found()) {
+        for (int i = 0; i < kv.subkey_size(); i++) {
+          num_keys += packed.entries().erase(kv.subkey(i).string_subkey());
+        }
+        values = packed.ToSubDocument(kv.type());
+        break;
+      }
       SubDocument values_card;
       SubDocument values_forward;
       SubDocument values_reverse;
       num_keys = kv.subkey_size();
+      int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+      SortedSetScoreLookup score_lookup(iterator_.get(), kv);
+      if (kv.subkey_size() > 1) {
+        RETURN_NOT_OK(score_lookup.LoadIfSmall(card));
+      }
       for (int i = 0; i < kv.subkey_size(); i++) {
         // Check whether the value is already in the document.
-        SubDocument doc_reverse;
-        bool doc_reverse_found = false;
-        SubDocKey subdoc_key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
-                                                 PrimitiveValue(ValueType::kSSReverse),
-                                                 PrimitiveValue(kv.subkey(i).string_subkey()));
         // Todo(Rahul): Add values to the write batch cache and then do an additional check.
         // As of now, we only check to see if a value is in rocksdb, and we should also check
         // the write batch.
-        auto encoded_subdoc_key_reverse = subdoc_key_reverse.EncodeWithoutHt();
-        GetSubDocumentData get_data = { encoded_subdoc_key_reverse, &doc_reverse,
-                                        &doc_reverse_found };
-        RETURN_NOT_OK(GetSubDocument(
-            data.doc_write_batch->doc_db(),
-            get_data, redis_query_id(), boost::none /* txn_op_context */, data.deadline,
-            data.read_time));
-        if (doc_reverse_found && doc_reverse.value_type() != ValueType::kTombstone) {
+        const auto score = VERIFY_RESULT(score_lookup.Get(
+            PrimitiveValue(kv.subkey(i).string_subkey())));
+        if (score) {
           // The value is already in the doc, needs to be removed.
           values_reverse.SetChild(PrimitiveValue(kv.subkey(i).string_subkey()),
                           SubDocument(ValueType::kTombstone));
@@ -967,14 +1275,13 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
           SubDocument doc_forward;
           doc_forward.SetChild(PrimitiveValue(kv.subkey(i).string_subkey()),
                                SubDocument(ValueType::kTombstone));
-          values_forward.SetChild(PrimitiveValue::Double(doc_reverse.GetDouble()),
+          values_forward.SetChild(PrimitiveValue::Double(*score),
                           SubDocument(doc_forward));
         } else {
           // If the key is absent, it doesn't contribute to the count of keys being deleted.
           num_keys--;
         }
       }
-      int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
       // The new cardinality is card - num_keys.
       values_card = SubDocument(PrimitiveValue(card - num_keys));
 
@@ -985,6 +1292,17 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       break;
     }
     default: {
+      if (kv.type() == REDIS_TYPE_HASH && data_type == REDIS_TYPE_HASH) {
+        PackedCollection packed(kv);
+        RETURN_NOT_OK(packed.Load(iterator_.get(), data.doc_write_batch));
+        if (packed.found()) {
+          for (int i = 0; i < kv.subkey_size(); i++) {
+            num_keys += packed.entries().erase(kv.subkey(i).string_subkey());
+          }
+          values = packed.ToSubDocument(kv.type());
+          break;
+        }
+      }
       num_keys = kv.subkey_size(); // We know the subkeys are distinct.
       // Avoid reads for redis timeseries type.
       if (EmulateRedisResponse(kv.type())) {
@@ -1066,7 +1384,14 @@ Status RedisWriteOperation::ApplyIncr(const DocOperationApplyData& data) {
   }
 
   int subkey = (kv.type() == REDIS_TYPE_HASH ? 0 : -1);
-  auto value = GetValue(data, subkey);
+  PackedCollection packed(kv);
+  if (kv.type() == REDIS_TYPE_HASH && container_type != REDIS_TYPE_NONE) {
+    RETURN_NOT_OK(packed.Load(iterator_.get(), data.doc_write_batch));
+  }
+  const bool use_packed =
+      kv.type() == REDIS_TYPE_HASH && (container_type == REDIS_TYPE_NONE || packed.found());
+  auto value = use_packed ? Result<RedisValue>(packed.Get(kv.subkey(0).string_subkey()))
+                          : GetValue(data, subkey);
   RETURN_NOT_OK(value);
 
   if (!VerifyTypeAndSetCode(RedisDataType::REDIS_TYPE_STRING, value->type, &response_,
@@ -1102,7 +1427,12 @@ Status RedisWriteOperation::ApplyIncr(const DocOperationApplyData& data) {
 
   DocPath doc_path = DocPath::DocPathFromRedisKey(kv.hash_code(), kv.key());
   PrimitiveValue new_pvalue = PrimitiveValue(std::to_string(new_value));
-  if (kv.type() == REDIS_TYPE_HASH) {
+  if (use_packed) {
+    packed.entries()[kv.subkey(0).string_subkey()] = new_pvalue;
+    return data.doc_write_batch->ExtendSubDocument(
+        doc_path, packed.ToSubDocument(kv.type()), data.read_time, data.deadline,
+        redis_query_id());
+  } else if (kv.type() == REDIS_TYPE_HASH) {
     SubDocument kv_entries = SubDocument();
     PrimitiveValue subkey_value;
     RETURN_NOT_OK(PrimitiveValueFromSubKeyStrict(kv.subkey(0), kv.type(), &subkey_value));
@@ -1344,7 +1674,21 @@ Status RedisReadOperation::ExecuteHGetAllLikeCommands(ValueType value_type,
   }
 
   if (VerifyTypeAndSetCode(value_type, doc.value_type(), &response_)) {
-    if (return_array_response) {
+    PackedCollection packed(request_.key_value());
+    if (value_type == ValueType::kObject || value_type == ValueType::kRedisSortedSet) {
+      // The array response already read the whole collection.
+      RETURN_NOT_OK(return_array_response ? packed.LoadFrom(doc) : packed.Load(iterator_.get()));
+    }
+    if (packed.found()) {
+      if (return_array_response) {
+        for (const auto& entry : packed.entries()) {
+          RETURN_NOT_OK(AddResponseValuesGeneric(
+              PrimitiveValue(entry.first), entry.second, &response_, add_keys, add_values));
+        }
+      } else {
+        response_.set_int_response(packed.entries().size());
+      }
+    } else if (return_array_response) {
       RETURN_NOT_OK(PopulateResponseFrom(doc.object_container(), AddResponseValuesGeneric,
                                          &response_, add_keys, add_values));
     } else {
@@ -1440,6 +1784,33 @@ Status RedisReadOperation::ExecuteCollectionGetRangeByBounds(
         data.high_index = &high_index;
       }
     }
+
+    PackedCollection packed(request_.key_value());
+    RETURN_NOT_OK(packed.Load(iterator_.get()));
+    if (packed.found()) {
+      const auto members = packed.SortedByScore();
+      size_t begin = 0;
+      while (begin < members.size() && !lower_bound.has_infinity_type() &&
+             (members[begin].first < low_double ||
+              (lower_bound.is_exclusive() && members[begin].first == low_double))) {
+        ++begin;
+      }
+      size_t end = begin;
+      while (end < members.size() &&
+             (upper_bound.has_infinity_type() || members[end].first < high_double ||
+              (!upper_bound.is_exclusive() && members[end].first == high_double))) {
+        ++end;
+      }
+      if (request_.has_range_request_limit()) {
+        begin = std::min<size_t>(end, begin + request_.index_range().lower_bound().index());
+        if (request_.range_request_limit() > 0) {
+          end = std::min<size_t>(end, begin + request_.range_request_limit());
+        }
+      }
+      return PopulateResponseFromSortedSetMembers(
+          members, begin, end, /* reverse */ false, /* with_scores */ add_keys, &response_);
+    }
+
     RETURN_NOT_OK(GetAndPopulateResponseValues(
         iterator_.get(), AddResponseValuesSortedSets, data, ValueType::kObject, request_,
         &response_,
@@ -1521,7 +1892,12 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
         return Status::OK();
       }
 
-      int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), request_.key_value()));
+      PackedCollection packed(request_.key_value());
+      RETURN_NOT_OK(packed.Load(iterator_.get()));
+      int64_t card = packed.entries().size();
+      if (!packed.found()) {
+        card = VERIFY_RESULT(GetCardinality(iterator_.get(), request_.key_value()));
+      }
 
       const RedisIndexBoundPB& low_index_bound = request_.index_range().lower_bound();
       const RedisIndexBoundPB& high_index_bound = request_.index_range().upper_bound();
@@ -1548,12 +1924,18 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
                                            true));
         return Status::OK();
       }
+
+      bool add_keys = request_.get_collection_range_request().with_scores();
+      if (packed.found()) {
+        return PopulateResponseFromSortedSetMembers(
+            packed.SortedByScore(), low_idx_normalized, high_idx_normalized + 1, reverse,
+            /* with_scores */ add_keys, &response_);
+      }
+
       auto encoded_doc_key = DocKey::EncodedFromRedisKey(
           request_.key_value().hash_code(), request_.key_value().key());
       PrimitiveValue(ValueType::kSSForward).AppendToKey(&encoded_doc_key);
 
-      bool add_keys = request_.get_collection_range_request().with_scores();
-
       IndexBound low_bound = IndexBound(low_idx_normalized, true /* is_lower */);
       IndexBound high_bound = IndexBound(high_idx_normalized, false /* is_lower */);
 
@@ -1710,7 +2092,13 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       }
       // If wrong type, we set the error code in the response.
       if (VerifyTypeAndSetCode(expected_type, type, &response_, VerifySuccessIfMissing::kTrue)) {
-        auto value = request_type == RedisGetRequestPB::TSGET ? GetOverrideValue() : GetValue();
+        PackedCollection packed(request_.key_value());
+        if (request_type == RedisGetRequestPB::HGET && type != REDIS_TYPE_NONE) {
+          RETURN_NOT_OK(packed.Load(iterator_.get()));
+        }
+        auto value = packed.found() ?
+            Result<RedisValue>(packed.Get(request_.key_value().subkey(0).string_subkey())) :
+            (request_type == RedisGetRequestPB::TSGET ? GetOverrideValue() : GetValue());
         RETURN_NOT_OK(value);
         if (VerifyTypeAndSetCode(RedisDataType::REDIS_TYPE_STRING, value->type, &response_,
             VerifySuccessIfMissing::kTrue)) {
@@ -1725,6 +2113,17 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       if (!VerifyTypeAndSetCode(expected_type, type, &response_, VerifySuccessIfMissing::kTrue)) {
         return Status::OK();
       }
+      PackedCollection packed(request_.key_value());
+      RETURN_NOT_OK(packed.Load(iterator_.get()));
+      if (packed.found()) {
+        auto it = packed.entries().find(request_.key_value().subkey(0).string_subkey());
+        if (it != packed.entries().end()) {
+          response_.set_string_response(std::to_string(it->second.GetDouble()));
+        } else {
+          response_.set_code(RedisResponsePB::NIL);
+        }
+        return Status::OK();
+      }
       SubDocKey key_reverse = SubDocKey(
           DocKey::FromRedisKey(request_.key_value().hash_code(), request_.key_value().key()),
           PrimitiveValue(ValueType::kSSReverse),
@@ -1747,7 +2146,16 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
     case RedisGetRequestPB::SISMEMBER: {
       RedisDataType type = VERIFY_RESULT(GetValueType());
       if (VerifyTypeAndSetCode(expected_type, type, &response_, VerifySuccessIfMissing::kTrue)) {
-        RedisDataType subtype = VERIFY_RESULT(GetValueType(0));
+        PackedCollection packed(request_.key_value());
+        if (request_type == RedisGetRequestPB::HEXISTS && type != REDIS_TYPE_NONE) {
+          RETURN_NOT_OK(packed.Load(iterator_.get()));
+        }
+        RedisDataType subtype = REDIS_TYPE_NONE;
+        if (packed.found()) {
+          subtype = packed.Get(request_.key_value().subkey(0).string_subkey()).type;
+        } else {
+          subtype = VERIFY_RESULT(GetValueType(0));
+        }
         SetOptionalInt(subtype, 1, &response_);
         response_.set_code(RedisResponsePB::OK);
       }
@@ -1757,7 +2165,13 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       RedisDataType type = VERIFY_RESULT(GetValueType());
       if (VerifyTypeAndSetCode(RedisDataType::REDIS_TYPE_HASH, type, &response_,
                                VerifySuccessIfMissing::kTrue)) {
-        auto value = GetValue();
+        PackedCollection packed(request_.key_value());
+        if (type != REDIS_TYPE_NONE) {
+          RETURN_NOT_OK(packed.Load(iterator_.get()));
+        }
+        auto value = packed.found() ?
+            Result<RedisValue>(packed.Get(request_.key_value().subkey(0).string_subkey())) :
+            GetValue();
         RETURN_NOT_OK(value);
         SetOptionalInt(value->type, value->value.length(), &response_);
         response_.set_code(RedisResponsePB::OK);
@@ -1776,6 +2190,10 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
 
       response_.set_allocated_array_response(new RedisArrayPB());
       const auto& req_kv = request_.key_value();
+      PackedCollection packed(req_kv);
+      if (type != REDIS_TYPE_NONE) {
+        RETURN_NOT_OK(packed.Load(iterator_.get()));
+      }
       size_t num_subkeys = req_kv.subkey_size();
       vector<int> indices(num_subkeys);
       for (int i = 0; i < num_subkeys; ++i) {
@@ -1796,7 +2214,9 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
             req_kv.subkey(indices[i - 1]).string_subkey()) {
           // If the condition above is false, we encountered the same key again, no need to call
           // GetValue() once more, current_value is already correct.
-          auto value = GetValue(indices[i]);
+          auto value = packed.found() ?
+              Result<RedisValue>(packed.Get(req_kv.subkey(indices[i]).string_subkey())) :
+              GetValue(indices[i]);
           RETURN_NOT_OK(value);
           if (value->type == REDIS_TYPE_STRING) {
             current_value = std::move(value->value);
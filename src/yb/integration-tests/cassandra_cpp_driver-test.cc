@@ -1581,6 +1581,33 @@ TEST_F(CppCassandraDriverTest, TestPrepare) {
   ExpectEqualTuples(input, output);
 }
 
+TEST_F(CppCassandraDriverTest, TestPrepareInsertWithConstants) {
+  ASSERT_OK(session_.ExecuteQuery(
+      "CREATE TABLE test.prepared_insert (h INT, r TEXT, v1 INT, v2 TEXT, PRIMARY KEY ((h), r))"));
+
+  // Executions after the first one reuse the write request template of the prepared statement,
+  // so make sure both constants and bind variables are written correctly by all of them.
+  auto prepared = ASSERT_RESULT(session_.Prepare(
+      "INSERT INTO test.prepared_insert (h, r, v1, v2) VALUES (?, 'range', ?, 'const')"));
+  constexpr int kRows = 10;
+  for (int i = 0; i != kRows; ++i) {
+    auto statement = prepared.Bind();
+    statement.Bind(0, i);
+    statement.Bind(1, i * 10);
+    ASSERT_OK(session_.Execute(statement));
+  }
+
+  for (int i = 0; i != kRows; ++i) {
+    ASSERT_OK(session_.ExecuteAndProcessOneRow(
+        Format("SELECT r, v1, v2 FROM test.prepared_insert WHERE h = $0", i),
+        [i](const CassandraRow& row) {
+          ASSERT_EQ(row.Value(0).As<std::string>(), "range");
+          ASSERT_EQ(row.Value(1).As<cass_int32_t>(), i * 10);
+          ASSERT_EQ(row.Value(2).As<std::string>(), "const");
+        }));
+  }
+}
+
 template <typename... ColumnsTypes>
 void TestTokenForTypes(
     CassandraSession* session,
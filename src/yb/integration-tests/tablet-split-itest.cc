@@ -86,6 +86,9 @@ class TabletSplitITest : public client::TransactionTestBase,
   // `num_rows` and nothing else.
   void CheckPostSplitTabletReplicasData(size_t num_rows);
 
+  // Waits until post-split tablet replicas compact away data shared with the source tablet.
+  CHECKED_STATUS WaitForPostSplitCompaction();
+
   // Checks source tablet behaviour after split:
   // - It should reject reads and writes.
   void CheckSourceTabletAfterSplit(const TabletId& source_tablet_id);
@@ -247,6 +250,26 @@ void TabletSplitITest::CheckPostSplitTabletReplicasData(size_t num_rows) {
   }
 }
 
+Status TabletSplitITest::WaitForPostSplitCompaction() {
+  LOG(INFO) << "Waiting for post-split compaction to be completed...";
+  return WaitFor([this] {
+      for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+        const auto* tablet = peer->tablet();
+        if (!tablet || tablet->table_type() == TRANSACTION_STATUS_TABLE_TYPE ||
+            tablet->metadata()->tablet_data_state() ==
+                tablet::TabletDataState::TABLET_DATA_SPLIT_COMPLETED) {
+          continue;
+        }
+        if (tablet->HasSstFilesWithDataOutsideKeyBounds()) {
+          VLOG(1) << consensus::MakeTabletLogPrefix(peer->tablet_id(), peer->permanent_uuid())
+                  << "has data outside of key bounds";
+          return false;
+        }
+      }
+      return true;
+    }, 15s * kTimeMultiplier, "Wait for post-split compaction to be completed");
+}
+
 void TabletSplitITest::CheckSourceTabletAfterSplit(const TabletId& source_tablet_id) {
   LOG(INFO) << "Checking source tablet behavior after split...";
   google::FlagSaver saver;
@@ -398,6 +421,9 @@ TEST_P(TabletSplitITest, SplitSingleTablet) {
 
   ASSERT_NO_FATALS(CheckPostSplitTabletReplicasData(kNumRows));
 
+  ASSERT_OK(WaitForPostSplitCompaction());
+  ASSERT_NO_FATALS(CheckPostSplitTabletReplicasData(kNumRows));
+
   ASSERT_NO_FATALS(CheckSourceTabletAfterSplit(source_tablet_id));
 
   master::GetTableLocationsResponsePB resp;
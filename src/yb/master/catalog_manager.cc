@@ -5819,7 +5819,7 @@ Status CatalogManager::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB&
             << " (" << bootstrap_peer_addr.ToString() << ").";
 
   auto rb_client = std::make_unique<tserver::RemoteBootstrapClient>(
-      tablet_id, master_->fs_manager());
+      tablet_id, master_->fs_manager(), master_->metric_entity());
 
   // Download and persist the remote superblock in TABLET_DATA_COPYING state.
   if (replacing_tablet) {
@@ -49,6 +49,12 @@ class MasterServiceImpl : public MasterServiceIf,
   MasterServiceImpl(const MasterServiceImpl&) = delete;
   void operator=(const MasterServiceImpl&) = delete;
 
+  // Heartbeats of tablet servers should not be shed, since a tablet server that misses them is
+  // considered dead.
+  bool CanShedByQueueDelay() const override {
+    return false;
+  }
+
   void TSHeartbeat(const TSHeartbeatRequestPB* req,
                    TSHeartbeatResponsePB* resp,
                    rpc::RpcContext rpc) override;
@@ -73,6 +73,14 @@ void MasterTabletServiceImpl::Write(const tserver::WriteRequestPB* req,
   tserver::TabletServiceImpl::Write(req, resp, std::move(context));
 }
 
+void MasterTabletServiceImpl::MultiRead(const tserver::MultiReadRequestPB* req,
+                                        tserver::MultiReadResponsePB* resp,
+                                        rpc::RpcContext context) {
+  // System tablets are always read using the regular Read RPC.
+  context.RespondRpcFailure(rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD,
+                            STATUS(NotSupported, "MultiRead is not supported by master"));
+}
+
 void MasterTabletServiceImpl::IsTabletServerReady(
     const tserver::IsTabletServerReadyRequestPB* req,
     tserver::IsTabletServerReadyResponsePB* resp,
@@ -33,6 +33,10 @@ class MasterTabletServiceImpl : public yb::tserver::TabletServiceImpl {
              tserver::WriteResponsePB* resp,
              rpc::RpcContext context) override;
 
+  void MultiRead(const tserver::MultiReadRequestPB* req,
+                 tserver::MultiReadResponsePB* resp,
+                 rpc::RpcContext context) override;
+
   void ListTablets(const tserver::ListTabletsRequestPB* req,
                    tserver::ListTabletsResponsePB* resp,
                    rpc::RpcContext context) override;
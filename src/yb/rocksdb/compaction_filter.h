@@ -157,6 +157,14 @@ class CompactionFilterFactory {
 
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
+
+  // Subcompactions split the compaction key range at boundary keys, and each subcompaction uses
+  // its own compaction filter. This method returns the prefix of user_key that should be used as
+  // a boundary instead of user_key itself, so all keys sharing this prefix are processed by the
+  // same filter instance.
+  virtual Slice SubcompactionBoundary(const Slice& user_key) const {
+    return user_key;
+  }
 };
 
 }  // namespace rocksdb
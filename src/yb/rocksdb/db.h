@@ -291,6 +291,12 @@ class DB {
                     keys, values);
   }
 
+  // Loads into the block cache SST data blocks of the default column family, that lookups or
+  // seeks to the specified keys would read, reading the blocks of each file together. Keys could
+  // be prefixes of the stored keys. This is only an optimization, so errors are ignored.
+  // Default implementation does nothing.
+  virtual void PrefetchKeys(const ReadOptions& options, const std::vector<Slice>& keys) {}
+
   // If the key definitely does not exist in the database, then this method
   // returns false, else true. If the caller wants to obtain value when the key
   // is found in memory, a bool for 'value_found' must be passed. 'value_found'
@@ -631,6 +637,13 @@ class DB {
 
   virtual void SetDisableFlushOnShutdown(bool disable_flush_on_shutdown) {}
 
+  // Schedules compaction of all files of the default column family in background, without
+  // waiting for its completion. Unlike CompactRange, it does not block automatic compactions.
+  // Returns Busy if some of the files are already being compacted.
+  virtual Status ScheduleFullCompaction() {
+    return STATUS(NotSupported, "Not implemented");
+  }
+
   // CompactFiles() inputs a list of files specified by file numbers and
   // compacts them to the specified level. Note that the behavior is different
   // from CompactRange() in that CompactFiles() performs the compaction job
@@ -74,12 +74,14 @@ TableBuilder* NewTableBuilder(const ImmutableCFOptions& ioptions,
                               WritableFileWriter* data_file,
                               const CompressionType compression_type,
                               const CompressionOptions& compression_opts,
-                              const bool skip_filters) {
+                              const bool skip_filters,
+                              const bool full_compaction) {
+  TableBuilderOptions table_builder_options(
+      ioptions, internal_comparator, int_tbl_prop_collector_factories, compression_type,
+      compression_opts, skip_filters);
+  table_builder_options.full_compaction = full_compaction;
   return ioptions.table_factory->NewTableBuilder(
-      TableBuilderOptions(ioptions, internal_comparator,
-          int_tbl_prop_collector_factories, compression_type,
-          compression_opts, skip_filters),
-      column_family_id, metadata_file, data_file);
+      table_builder_options, column_family_id, metadata_file, data_file);
 }
 
 namespace {
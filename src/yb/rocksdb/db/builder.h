@@ -68,7 +68,8 @@ TableBuilder* NewTableBuilder(const ImmutableCFOptions& options,
                               WritableFileWriter* data_file,
                               const CompressionType compression_type,
                               const CompressionOptions& compression_opts,
-                              const bool skip_filters = false);
+                              const bool skip_filters = false,
+                              const bool full_compaction = false);
 
 // Build a Table file from the contents of *iter.  The generated file
 // will be named according to number specified in meta. On success, the rest of
@@ -30,6 +30,7 @@
 #include <inttypes.h>
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "yb/rocksdb/compaction_filter.h"
@@ -544,7 +545,13 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    if (number_levels_ == 1) {
+      // Every output file of single level universal compaction is a separate sorted run, so
+      // output is split only into files that are too large to be picked for compaction again.
+      return mutable_cf_options_.max_file_size_for_compaction !=
+             std::numeric_limits<uint64_t>::max();
+    }
+    return output_level_ > 0;
   } else {
     return false;
   }
@@ -33,6 +33,8 @@
 #include <vector>
 #include <memory>
 #include <list>
+#include <condition_variable>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <utility>
@@ -52,6 +54,7 @@
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/port/likely.h"
 #include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/statistics.h"
@@ -72,6 +75,7 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/thread_status_util.h"
 
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
@@ -122,6 +126,12 @@ struct CompactionJob::SubcompactionState {
   CompactionJobStats compaction_job_stats;
   uint64_t approx_size;
 
+  // Largest user frontier reported by compaction filter of this subcompaction.
+  UserFrontierPtr largest_user_frontier;
+
+  // Suspender of the priority thread pool task running this subcompaction.
+  yb::PriorityThreadPoolSuspender* suspender = nullptr;
+
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
       : compaction(c),
@@ -153,6 +163,8 @@ struct CompactionJob::SubcompactionState {
     num_output_records = std::move(o.num_output_records);
     compaction_job_stats = std::move(o.compaction_job_stats);
     approx_size = std::move(o.approx_size);
+    largest_user_frontier = std::move(o.largest_user_frontier);
+    suspender = o.suspender;
     return *this;
   }
 
@@ -371,6 +383,9 @@ void CompactionJob::GenSubcompactionBoundaries() {
   auto* c = compact_->compaction;
   auto* cfd = c->column_family_data();
   const Comparator* cfd_comparator = cfd->user_comparator();
+  // Compaction filter could keep state between keys, so boundaries are adjusted by its factory.
+  CompactionFilterFactory* filter_factory = cfd->ioptions()->compaction_filter == nullptr
+      ? cfd->ioptions()->compaction_filter_factory : nullptr;
   std::vector<Slice> bounds;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
@@ -442,10 +457,23 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 
   // Group the ranges into subcompactions
-  const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  uint64_t max_output_files;
+  if (cfd->ioptions()->compaction_style == kCompactionStyleUniversal &&
+      c->number_levels() == 1) {
+    // Each subcompaction produces a single file, that should not be picked for compaction again
+    // even when the compaction drops a part of its input. So the range of a subcompaction is sized
+    // by the target file size, that is at least twice max_file_size_for_compaction.
+    const auto* mutable_cf_options = c->mutable_cf_options();
+    const uint64_t target_file_size = std::max(
+        mutable_cf_options->target_file_size_base,
+        2 * mutable_cf_options->max_file_size_for_compaction);
+    max_output_files = sum / target_file_size;
+  } else {
+    const double min_file_fill_percent = 4.0 / 5;
+    max_output_files = static_cast<uint64_t>(std::ceil(
+        sum / min_file_fill_percent /
+        cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  }
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -466,7 +494,15 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        Slice boundary = ExtractUserKey(ranges[i].range.limit);
+        if (filter_factory) {
+          boundary = filter_factory->SubcompactionBoundary(boundary);
+        }
+        // Boundary could match previous one after adjusting by compaction filter factory.
+        if (!boundaries_.empty() && cfd_comparator->Compare(boundaries_.back(), boundary) >= 0) {
+          continue;
+        }
+        boundaries_.emplace_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -479,6 +515,155 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+namespace {
+
+// Subcompaction that is run either by a priority thread pool task, or by the thread running the
+// whole compaction, whichever claims it first. The thread running the compaction claims
+// subcompactions that were not started by the pool yet, instead of waiting for them. So it never
+// waits for tasks queued behind it in a saturated pool.
+class SubcompactionRunner {
+ public:
+  typedef std::function<void(yb::PriorityThreadPoolSuspender*)> Func;
+
+  SubcompactionRunner(Func func, std::string description)
+      : func_(std::move(func)), description_(std::move(description)) {}
+
+  // Runs subcompaction in the current thread, unless it was already claimed by another thread.
+  void TryRun(yb::PriorityThreadPoolSuspender* suspender) {
+    if (claimed_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    func_(suspender);
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    cond_.notify_all();
+  }
+
+  // Waits until subcompaction claimed by another thread is done.
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return done_; });
+  }
+
+  const std::string& description() const {
+    return description_;
+  }
+
+ private:
+  const Func func_;
+  const std::string description_;
+  std::atomic<bool> claimed_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool done_ = false;
+};
+
+class SubcompactionTask : public yb::PriorityThreadPoolTask {
+ public:
+  explicit SubcompactionTask(std::shared_ptr<SubcompactionRunner> runner)
+      : runner_(std::move(runner)) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    // Aborted subcompaction is run by the thread running the compaction.
+    if (status.ok()) {
+      runner_->TryRun(suspender);
+    }
+  }
+
+  bool BelongsTo(void* key) override {
+    return false;
+  }
+
+  std::string ToString() const override {
+    return runner_->description();
+  }
+
+ private:
+  std::shared_ptr<SubcompactionRunner> runner_;
+};
+
+} // namespace
+
+void CompactionJob::RunSubcompactions(FileNumbersHolder* holder) {
+  auto& states = compact_->sub_compact_states;
+  auto* compaction = compact_->compaction;
+  auto* pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+
+  std::vector<std::shared_ptr<SubcompactionRunner>> runners;
+  runners.reserve(states.size() - 1);
+  // Used only when there is no priority thread pool, i.e. outside of YB.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < states.size(); i++) {
+    auto* state = &states[i];
+    auto runner = std::make_shared<SubcompactionRunner>(
+        [this, holder, state](yb::PriorityThreadPoolSuspender* suspender) {
+          state->suspender = suspender;
+          ProcessKeyValueCompaction(holder, state);
+        },
+        yb::Format("{ subcompaction $0 of $1 job: $2 }", i, states.size(), job_id_));
+    if (pool) {
+      std::unique_ptr<SubcompactionTask> task(new SubcompactionTask(runner));
+      auto status = pool->Submit(compaction->priority(), &task);
+      if (!status.ok()) {
+        // Subcompaction will be run by the current thread.
+        RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+            "[JOB %d] Failed to submit subcompaction: %s", job_id_, status.ToString().c_str());
+      }
+    } else {
+      threads.emplace_back(&SubcompactionRunner::TryRun, runner.get(), nullptr);
+    }
+    runners.push_back(std::move(runner));
+  }
+
+  // Always run the first subcompaction (whether or not there are also others) in the current
+  // thread to be efficient with resources.
+  states[0].suspender = compaction->suspender();
+  ProcessKeyValueCompaction(holder, &states[0]);
+
+  // Run subcompactions that were not picked by the pool yet, and wait for the rest.
+  for (const auto& runner : runners) {
+    runner->TryRun(compaction->suspender());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& runner : runners) {
+    runner->Wait();
+  }
+}
+
+// Output files of subcompactions have disjoint key ranges, but each of them could contain keys
+// from the whole input seqno range. So they could not be ordered by seqno against each other, and
+// single level universal compaction records them as one sorted run: all of them get the seqno
+// range of the whole output, see UniversalCompactionPicker::CalculateSortedRuns.
+void CompactionJob::SetOutputsSeqNoRange() {
+  auto* c = compact_->compaction;
+  if (c->column_family_data()->ioptions()->compaction_style != kCompactionStyleUniversal ||
+      c->output_level() != 0) {
+    return;
+  }
+  std::vector<FileMetaData*> outputs;
+  for (auto& state : compact_->sub_compact_states) {
+    for (auto& output : state.outputs) {
+      outputs.push_back(&output.meta);
+    }
+  }
+  if (outputs.size() < 2) {
+    return;
+  }
+
+  SequenceNumber smallest_seqno = kMaxSequenceNumber;
+  SequenceNumber largest_seqno = 0;
+  for (const auto* meta : outputs) {
+    smallest_seqno = std::min(smallest_seqno, meta->smallest.seqno);
+    largest_seqno = std::max(largest_seqno, meta->largest.seqno);
+  }
+  for (auto* meta : outputs) {
+    meta->smallest.seqno = smallest_seqno;
+    meta->largest.seqno = largest_seqno;
+  }
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -493,23 +678,18 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
-  }
+  RunSubcompactions(&file_numbers_holder);
 
-  // Always schedule the first subcompaction (whether or not there are also
-  // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
+  SetOutputsSeqNoRange();
 
-  // Wait for all other threads (if there are any) to finish execution
-  for (auto& thread : thread_pool) {
-    thread.join();
+  for (auto& state : compact_->sub_compact_states) {
+    if (state.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, std::move(state.largest_user_frontier),
+          UpdateUserValueType::kLargest);
+    }
   }
 
   if (output_directory_ && !db_options_.disableDataSync) {
@@ -660,7 +840,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = compaction_filter->GetLargestUserFrontier();
   }
 
   MergeHelper merge(
@@ -1043,15 +1223,16 @@ Status CompactionJob::OpenCompactionOutputFile(
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 
   {
-    auto setup_outfile = [this, sub_compact] (
+    // Suspender could be used only from the thread pool worker thread running the subcompaction.
+    auto* suspender = sub_compact->suspender;
+    auto setup_outfile = [this, suspender] (
         size_t preallocation_block_size, std::unique_ptr<WritableFile>* writable_file,
         std::unique_ptr<WritableFileWriter>* writer) {
       (*writable_file)->SetIOPriority(Env::IO_LOW);
       if (preallocation_block_size > 0) {
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
-      writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+      writer->reset(new WritableFileWriter(std::move(*writable_file), env_options_, suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -1071,12 +1252,18 @@ Status CompactionJob::OpenCompactionOutputFile(
   // data is going to be found
   bool skip_filters =
       cfd->ioptions()->optimize_filters_for_hits && bottommost_level_;
+  // Bottommost level contains most of the data, so it could use a stronger compression.
+  auto compression = sub_compact->compaction->output_compression();
+  if (bottommost_level_ && compression != kNoCompression &&
+      cfd->ioptions()->bottommost_compression != kDisableCompressionOption) {
+    compression = cfd->ioptions()->bottommost_compression;
+  }
   sub_compact->builder.reset(NewTableBuilder(
       *cfd->ioptions(), cfd->internal_comparator(),
       cfd->int_tbl_prop_collector_factories(), cfd->GetID(),
       sub_compact->base_outfile.get(), sub_compact->data_outfile.get(),
-      sub_compact->compaction->output_compression(), cfd->ioptions()->compression_opts,
-      skip_filters));
+      compression, cfd->ioptions()->compression_opts,
+      skip_filters, sub_compact->compaction->is_full_compaction()));
   LogFlush(db_options_.info_log);
   return Status::OK();
 }
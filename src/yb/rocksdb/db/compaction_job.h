@@ -110,6 +110,12 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Runs subcompactions 1...n-1 as priority thread pool tasks, and the first one in the current
+  // thread.
+  void RunSubcompactions(FileNumbersHolder* holder);
+  // Records outputs of single level universal compaction as one sorted run, see implementation for
+  // details.
+  void SetOutputsSeqNoRange();
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
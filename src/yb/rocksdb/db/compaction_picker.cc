@@ -28,6 +28,8 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
+
 #include <limits>
 #include <queue>
 #include <string>
@@ -1152,16 +1154,16 @@ bool UniversalCompactionPicker::NeedsCompaction(
 }
 
 struct UniversalCompactionPicker::SortedRun {
-  SortedRun(int _level, FileMetaData* _file, uint64_t _size,
+  SortedRun(int _level, std::vector<FileMetaData*> _files, uint64_t _size,
             uint64_t _compensated_file_size, bool _being_compacted)
       : level(_level),
-        file(_file),
+        files(std::move(_files)),
         size(_size),
         compensated_file_size(_compensated_file_size),
         being_compacted(_being_compacted) {
     assert(compensated_file_size > 0);
-    // Allowed either one of level and file.
-    assert((level != 0) != (file != nullptr));
+    // Allowed either one of level and files.
+    assert((level != 0) != !files.empty());
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1172,12 +1174,14 @@ struct UniversalCompactionPicker::SortedRun {
                     size_t sorted_run_count) const;
 
   int level;
-  // `file` Will be null for level > 0. For level = 0, the sorted run is
-  // for this file.
-  FileMetaData* file;
+  // `files` will be empty for level > 0. For level = 0, the sorted run is
+  // for these files: a single file, or files written by subcompactions of
+  // one compaction, that have the same seqno range and disjoint key ranges.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
-  // files in the level. `being_compacted` should be the same for all files
-  // in a non-zero level. Use the value here.
+  // files in the level, for level 0 - sum of sizes of all files of the run.
+  // `being_compacted` should be the same for all files in a non-zero level,
+  // and for all files of a level 0 run. Use the value here.
   uint64_t size;
   uint64_t compensated_file_size;
   bool being_compacted;
@@ -1187,14 +1191,20 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
                                                 size_t out_buf_size,
                                                 bool print_path) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
+    const auto* file = files.front();
+    int written;
     if (file->fd.GetPathId() == 0 || !print_path) {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
     } else {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64
-                                      "(path "
-                                      "%" PRIu32 ")",
-               file->fd.GetNumber(), file->fd.GetPathId());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64
+                                                "(path "
+                                                "%" PRIu32 ")",
+                         file->fd.GetNumber(), file->fd.GetPathId());
+    }
+    if (files.size() > 1 && written >= 0 && static_cast<size_t>(written) < out_buf_size) {
+      snprintf(out_buf + written, out_buf_size - written, " and %" ROCKSDB_PRIszt " more",
+               files.size() - 1);
     }
   } else {
     snprintf(out_buf, out_buf_size, "level %d", level);
@@ -1204,13 +1214,13 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
 void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     char* out_buf, size_t out_buf_size, size_t sorted_run_count) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
     snprintf(out_buf, out_buf_size,
              "file %" PRIu64 "[%" ROCKSDB_PRIszt
              "] "
-             "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             "and %" ROCKSDB_PRIszt " more with size %" PRIu64 " (compensated size %" PRIu64 ")",
+             files.front()->fd.GetNumber(), sorted_run_count, files.size() - 1, size,
+             compensated_file_size);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1225,10 +1235,29 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
                                                    const ImmutableCFOptions& ioptions,
                                                    uint64_t max_file_size) {
   std::vector<std::vector<SortedRun>> ret(1);
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
-    if (f->fd.GetTotalFileSize() <= max_file_size) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+  const auto& level0_files = vstorage.LevelFiles(0);
+  for (auto it = level0_files.begin(); it != level0_files.end();) {
+    // Files written by subcompactions of one compaction have the same seqno range, and form one
+    // sorted run, see CompactionJob::SetOutputsSeqNoRange. Level 0 files are ordered by seqno
+    // range, so such files are next to each other.
+    auto run_end = std::find_if(it + 1, level0_files.end(), [it](FileMetaData* f) {
+      return (*it)->largest.seqno == 0 || f->smallest.seqno != (*it)->smallest.seqno ||
+             f->largest.seqno != (*it)->largest.seqno;
+    });
+    std::vector<FileMetaData*> run_files(it, run_end);
+    it = run_end;
+    uint64_t total_size = 0;
+    uint64_t total_compensated_size = 0;
+    bool too_large = false;
+    for (auto* f : run_files) {
+      total_size += f->fd.GetTotalFileSize();
+      total_compensated_size += f->compensated_file_size;
+      too_large = too_large || f->fd.GetTotalFileSize() > max_file_size;
+    }
+    if (!too_large) {
+      const bool being_compacted = run_files.front()->being_compacted;
+      ret.back().emplace_back(
+          0, std::move(run_files), total_size, total_compensated_size, being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1262,7 +1291,9 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
       }
     }
     if (total_compensated_size > 0) {
-      ret.back().emplace_back(level, nullptr, total_size, total_compensated_size, being_compacted);
+      ret.back().emplace_back(
+          level, std::vector<FileMetaData*>(), total_size, total_compensated_size,
+          being_compacted);
     }
   }
 
@@ -1451,6 +1482,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
 // validate that all the chosen files of L0 are non overlapping in time
 #ifndef NDEBUG
   SequenceNumber prev_smallest_seqno = 0U;
+  SequenceNumber prev_largest_seqno = 0U;
   bool is_first = true;
 
   size_t level_index = 0U;
@@ -1459,10 +1491,13 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
       if (is_first) {
         is_first = false;
-      } else {
+      } else if (f->smallest.seqno != prev_smallest_seqno ||
+                 f->largest.seqno != prev_largest_seqno) {
+        // Files of the same sorted run have the same seqno range.
         DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
       }
       prev_smallest_seqno = f->smallest.seqno;
+      prev_largest_seqno = f->largest.seqno;
     }
     level_index = 1U;
   }
@@ -1692,8 +1727,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1818,8 +1853,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -185,6 +185,38 @@ TEST_F(DBBlockCacheTest, TestWithoutCompressedBlockCache) {
   }
 }
 
+TEST_F(DBBlockCacheTest, MultiGetReadsMissingBlocksTogether) {
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  InitTable(options);
+  ASSERT_OK(Flush());
+
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  Reopen(options);
+  RecordCacheCounters(options);
+
+  std::vector<std::string> key_strings;
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    key_strings.push_back(ToString(i));
+  }
+  key_strings.push_back("missing");
+  std::vector<Slice> keys(key_strings.begin(), key_strings.end());
+  std::vector<std::string> values;
+  auto statuses = db_->MultiGet(ReadOptions(), keys, &values);
+  ASSERT_EQ(keys.size(), statuses.size());
+  const std::string expected_value(kValueSize, 'a');
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_OK(statuses[i]);
+    ASSERT_EQ(expected_value, values[i]);
+  }
+  ASSERT_TRUE(statuses.back().IsNotFound());
+
+  // All data blocks were read together before the lookups, so every lookup found its block in the
+  // cache.
+  CheckCacheCounters(options, 0, kNumBlocks, kNumBlocks, 0);
+}
+
 #ifdef SNAPPY
 TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
   ReadOptions read_options;
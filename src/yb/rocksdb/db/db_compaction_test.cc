@@ -452,6 +452,36 @@ TEST_F(DBCompactionTest, TestTableReaderForCompaction) {
   rocksdb::SyncPoint::GetInstance()->ClearAllCallBacks();
 }
 
+TEST_F(DBCompactionTest, DirectIOForFlushAndCompaction) {
+  Options options = CurrentOptions();
+  options.env = env_;
+  options.use_direct_io_for_flush_and_compaction = true;
+  options.compaction_readahead_size = 64 * 1024;
+  options.level0_file_num_compaction_trigger = 3;
+  DestroyAndReopen(options);
+  Random rnd(301);
+
+  // Values of odd sizes, so flushed and compacted files do not end at the direct I/O alignment.
+  std::vector<std::string> values;
+  for (int file = 0; file < options.level0_file_num_compaction_trigger; ++file) {
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(RandomString(&rnd, 1 + rnd.Uniform(3000)));
+      ASSERT_OK(Put(Key(file * 100 + i), values.back()));
+    }
+    ASSERT_OK(Flush());
+  }
+  dbfull()->TEST_WaitForCompact();
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], Get(Key(static_cast<int>(i))));
+  }
+  Reopen(options);
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], Get(Key(static_cast<int>(i))));
+  }
+}
+
 TEST_P(DBCompactionTestWithParam, CompactionDeletionTriggerReopen) {
   for (int tid = 0; tid < 2; ++tid) {
     uint64_t db_size[3];
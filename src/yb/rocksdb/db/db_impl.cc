@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <climits>
 #include <cstdio>
+#include <deque>
 #include <map>
 #include <set>
 #include <stdexcept>
@@ -154,6 +155,19 @@ DEFINE_int32(compaction_priority_step_size, 5,
 DEFINE_int32(small_compaction_extra_priority, 1,
              "Small compaction will get small_compaction_extra_priority extra priority.");
 
+DEFINE_int32(compaction_priority_running_compaction_penalty, 1,
+             "Compaction task of DB loses compaction_priority_running_compaction_penalty "
+             "priority per every other compaction running for the same DB. Priorities of queued "
+             "tasks are recalculated when a compaction of the DB starts or finishes.");
+TAG_FLAG(compaction_priority_running_compaction_penalty, runtime);
+
+DEFINE_int32(compaction_priority_space_amp_step_percent, 100,
+             "Compaction task of DB gets 1 extra priority per every "
+             "compaction_priority_space_amp_step_percent percent of space amplification, i.e. "
+             "size of all SST files except the oldest one relative to the size of the oldest one. "
+             "0 - space amplification does not affect priority.");
+TAG_FLAG(compaction_priority_space_amp_step_percent, runtime);
+
 namespace rocksdb {
 
 namespace {
@@ -237,19 +251,23 @@ class DBImpl::ThreadPoolTask : public yb::PriorityThreadPoolTask {
 
 constexpr int kShuttingDownPriority = 200;
 constexpr int kFlushPriority = 100;
+// Space amplification is unbounded while the oldest SST file is small, so it could add at most
+// this priority.
+constexpr int kMaxSpaceAmpExtraPriority = 3;
 
 class DBImpl::CompactionTask : public ThreadPoolTask {
  public:
   CompactionTask(DBImpl* db_impl, DBImpl::ManualCompaction* manual_compaction)
       : ThreadPoolTask(db_impl), manual_compaction_(manual_compaction),
-        compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()) {
+        compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()),
+        description_(CalcDescription()) {
     db_impl->mutex_.AssertHeld();
   }
 
   CompactionTask(DBImpl* db_impl, std::unique_ptr<Compaction> compaction)
       : ThreadPoolTask(db_impl), manual_compaction_(nullptr),
         compaction_holder_(std::move(compaction)), compaction_(compaction_holder_.get()),
-        priority_(CalcPriority()) {
+        priority_(CalcPriority()), description_(CalcDescription()) {
     db_impl->mutex_.AssertHeld();
   }
 
@@ -276,7 +294,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   }
 
   std::string ToString() const override {
-    return yb::Format("{ compact db: $0 }", db_impl_->GetName());
+    return description_;
   }
 
   bool UpdatePriority() override {
@@ -295,6 +313,12 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
     return false;
   }
 
+  void Start() {
+    db_impl_->mutex_.AssertHeld();
+    started_ = true;
+    compaction_->SetPriority(priority_);
+  }
+
   void Complete() {
     db_impl_->mutex_.AssertHeld();
     compaction_ = nullptr;
@@ -322,18 +346,57 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
           (num_files - FLAGS_compaction_priority_start_bound) / FLAGS_compaction_priority_step_size;
     }
 
+    result += SpaceAmpExtraPriority(*current_version->storage_info());
+
     if (!db_impl_->IsLargeCompaction(*compaction_)) {
       result += FLAGS_small_compaction_extra_priority;
     }
 
+    // Each DB competes with all other DBs of the node for the same thread pool, so prefer DBs
+    // that don't have running compactions yet. Running task does not penalize itself.
+    auto other_running_compactions = db_impl_->num_total_running_compactions_ - (started_ ? 1 : 0);
+    result -= other_running_compactions * FLAGS_compaction_priority_running_compaction_penalty;
+
     return result;
   }
 
+  static int SpaceAmpExtraPriority(const VersionStorageInfo& storage_info) {
+    auto step_percent = FLAGS_compaction_priority_space_amp_step_percent;
+    const auto& files = storage_info.LevelFiles(0);
+    if (step_percent <= 0 || files.size() < 2) {
+      return 0;
+    }
+    // Level 0 files are ordered from the newest to the oldest.
+    uint64_t newer_files_size = 0;
+    for (size_t i = 0; i + 1 < files.size(); ++i) {
+      newer_files_size += files[i]->fd.GetTotalFileSize();
+    }
+    auto oldest_file_size = std::max<uint64_t>(files.back()->fd.GetTotalFileSize(), 1);
+    auto space_amp_percent = newer_files_size * 100 / oldest_file_size;
+    return static_cast<int>(std::min<uint64_t>(
+        space_amp_percent / step_percent, kMaxSpaceAmpExtraPriority));
+  }
+
+  // Description is calculated once, since compaction could be destroyed while the task is still
+  // present in the thread pool.
+  std::string CalcDescription() const {
+    auto* storage_info = compaction_->column_family_data()->GetSuperVersion()->current
+        ->storage_info();
+    return yb::Format(
+        "{ compact db: $0 manual: $1 large: $2 input files: $3 input size: $4 "
+            "l0 files: $5 }",
+        db_impl_->GetName(), manual_compaction_ != nullptr,
+        db_impl_->IsLargeCompaction(*compaction_), compaction_->num_input_files(0),
+        compaction_->CalculateTotalInputSize(), storage_info->l0_delay_trigger_count());
+  }
+
   // Only one of manual_compaction_ and compaction_ could be non null.
   DBImpl::ManualCompaction* const manual_compaction_;
   std::unique_ptr<Compaction> compaction_holder_;
   Compaction* compaction_;
   int priority_;
+  bool started_ = false;
+  const std::string description_;
 };
 
 class DBImpl::FlushTask : public ThreadPoolTask {
@@ -480,7 +543,7 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src) {
     result.db_paths.emplace_back(dbname, std::numeric_limits<uint64_t>::max());
   }
 
-  if (result.compaction_readahead_size > 0) {
+  if (result.compaction_readahead_size > 0 || result.use_direct_io_for_flush_and_compaction) {
     result.new_table_reader_for_compaction_inputs = true;
   }
 
@@ -580,6 +643,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname)
       next_job_id_(1),
       has_unpersisted_data_(false),
       env_options_(db_options_),
+      env_options_for_compaction_(env_->OptimizeForCompactionTableWrite(env_options_, db_options_)),
 #ifndef ROCKSDB_LITE
       wal_manager_(db_options_, env_options_),
 #endif  // ROCKSDB_LITE
@@ -1773,7 +1837,7 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
         s = BuildTable(dbname_,
                        env_,
                        *cfd->ioptions(),
-                       env_options_,
+                       env_options_for_compaction_,
                        cfd->table_cache(),
                        iter.get(),
                        &meta,
@@ -1848,7 +1912,7 @@ Result<FileNumbersHolder> DBImpl::FlushMemTableToOutputFile(
   }
 
   FlushJob flush_job(
-      dbname_, cfd, db_options_, mutable_cf_options, env_options_,
+      dbname_, cfd, db_options_, mutable_cf_options, env_options_for_compaction_,
       versions_.get(), &mutex_, &shutting_down_, snapshot_seqs,
       earliest_write_conflict_snapshot, mem_table_flush_filter, pending_outputs_.get(),
       job_context, log_buffer, directories_.GetDbDir(), directories_.GetDataDir(0U),
@@ -2264,7 +2328,7 @@ Status DBImpl::CompactFilesImpl(
 
   assert(is_snapshot_supported_ || snapshots_.empty());
   CompactionJob compaction_job(
-      job_context->job_id, c.get(), db_options_, env_options_, versions_.get(),
+      job_context->job_id, c.get(), db_options_, env_options_for_compaction_, versions_.get(),
       &shutting_down_, log_buffer, directories_.GetDbDir(),
       directories_.GetDataDir(c->output_path_id()), stats_, &mutex_, &bg_error_,
       snapshot_seqs, earliest_write_conflict_snapshot, pending_outputs_.get(), table_cache_,
@@ -2418,6 +2482,47 @@ void DBImpl::NotifyOnCompactionCompleted(
 #endif  // ROCKSDB_LITE
 }
 
+Status DBImpl::ScheduleFullCompaction() {
+  if (!db_options_.priority_thread_pool_for_compactions_and_flushes ||
+      !FLAGS_use_priority_thread_pool_for_compactions) {
+    return STATUS(NotSupported, "Full compaction could be scheduled only to priority thread pool");
+  }
+
+  auto cfd = default_cf_handle_->cfd();
+  if (cfd->ioptions()->compaction_style != kCompactionStyleUniversal ||
+      cfd->NumberLevels() != 1) {
+    return STATUS(NotSupported, "Full compaction could be scheduled only for single level "
+                                "universal compaction");
+  }
+
+  InstrumentedMutexLock lock(&mutex_);
+  if (shutting_down_.load(std::memory_order_acquire)) {
+    return STATUS(ShutdownInProgress, "");
+  }
+  if (cfd->IsDropped()) {
+    return STATUS(ShutdownInProgress, "Column family dropped");
+  }
+  if (HasPendingManualCompaction() || bg_compaction_paused_ > 0) {
+    return STATUS(Busy, "Manual compaction in progress or compactions paused");
+  }
+
+  InternalKey manual_end_storage;
+  InternalKey* manual_end = &manual_end_storage;
+  bool conflict = false;
+  auto compaction = cfd->CompactRange(
+      *cfd->GetLatestMutableCFOptions(), 0 /* input_level */, 0 /* output_level */,
+      0 /* output_path_id */, nullptr /* begin */, nullptr /* end */, &manual_end, &conflict);
+  if (!compaction) {
+    return conflict ? STATUS(Busy, "Some files are being compacted") : Status::OK();
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Scheduling full compaction of " << compaction->num_input_files(0)
+                        << " files";
+  cfd->Ref();
+  SubmitCompactionOrFlushTask(std::make_unique<CompactionTask>(this, std::move(compaction)));
+  return Status::OK();
+}
+
 void DBImpl::SetDisableFlushOnShutdown(bool disable_flush_on_shutdown) {
   // disable_flush_on_shutdown_ can only transition from false to true. This location
   // can be called multiple times with arg as false. It is only called once with arg
@@ -3304,6 +3409,16 @@ void DBImpl::BackgroundCallCompaction(ManualCompaction* m, std::unique_ptr<Compa
   if (compaction_task) {
     LOG_IF_WITH_PREFIX(DFATAL, compaction_tasks_.count(compaction_task) != 1)
         << "Running compaction for unknown task: " << compaction_task;
+    compaction_task->Start();
+
+    // Queued compaction tasks of this DB lose priority while this compaction is running.
+    TaskPriorityUpdater task_priority_updater(this);
+    task_priority_updater.Prepare();
+    if (!task_priority_updater.Empty()) {
+      mutex_.Unlock();
+      task_priority_updater.Apply();
+      mutex_.Lock();
+    }
   } else {
     LOG_IF_WITH_PREFIX(DFATAL, bg_compaction_scheduled_ == 0)
         << "Running compaction while no compactions were scheduled";
@@ -3323,10 +3438,13 @@ void DBImpl::BackgroundCallCompaction(ManualCompaction* m, std::unique_ptr<Compa
     WaitAfterBackgroundError(s, "compaction", &log_buffer);
   }
 
-  BackgroundJobComplete(s, &job_context, &log_buffer);
-
+  // Decrement before BackgroundJobComplete, so priorities of queued compaction tasks are
+  // recalculated without this compaction.
   assert(num_total_running_compactions_ > 0);
   num_total_running_compactions_--;
+
+  BackgroundJobComplete(s, &job_context, &log_buffer);
+
   if (compaction_task) {
       LOG_IF_WITH_PREFIX(DFATAL, compaction_tasks_.erase(compaction_task) != 1)
           << "Finished compaction with unknown task serial no: " << yb::ToString(compaction_task);
@@ -3582,7 +3700,7 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
 
     assert(is_snapshot_supported_ || snapshots_.empty());
     CompactionJob compaction_job(
-        job_context->job_id, c.get(), db_options_, env_options_,
+        job_context->job_id, c.get(), db_options_, env_options_for_compaction_,
         versions_.get(), &shutting_down_, log_buffer, directories_.GetDbDir(),
         directories_.GetDataDir(c->output_path_id()), stats_, &mutex_,
         &bg_error_, snapshot_seqs, earliest_write_conflict_snapshot,
@@ -3981,14 +4099,18 @@ std::vector<Status> DBImpl::MultiGet(
   }
   mutex_.Unlock();
 
-  // Contain a list of merge operations if merge occurs.
-  MergeContext merge_context;
-
   // Note: this always resizes the values array
   size_t num_keys = keys.size();
   std::vector<Status> stat_list(num_keys);
   values->resize(num_keys);
 
+  // Contain a list of merge operations if merge occurs.
+  std::vector<MergeContext> merge_contexts(num_keys);
+  std::deque<LookupKey> lookup_keys;
+
+  // Keys, that were not found in memtables, grouped by super version.
+  std::unordered_map<SuperVersion*, std::vector<Version::MultiGetEntry>> sst_lookups;
+
   // Keep track of bytes that we read for statistics-recording later
   uint64_t bytes_read = 0;
   PERF_TIMER_STOP(get_snapshot_time);
@@ -3997,12 +4119,13 @@ std::vector<Status> DBImpl::MultiGet(
   // First look in the memtable, then in the immutable memtable (if any).
   // s is both in/out. When in, s could either be OK or MergeInProgress.
   // merge_operands will contain the sequence of merges in the latter case.
+  // Keys, that were not found in memtables, are looked up in SST files together.
   for (size_t i = 0; i < num_keys; ++i) {
-    merge_context.Clear();
     Status& s = stat_list[i];
     std::string* value = &(*values)[i];
 
-    LookupKey lkey(keys[i], snapshot);
+    lookup_keys.emplace_back(keys[i], snapshot);
+    const LookupKey& lkey = lookup_keys.back();
     auto cfh = down_cast<ColumnFamilyHandleImpl*>(column_family[i]);
     auto mgd_iter = multiget_cf_data.find(cfh->cfd()->GetID());
     assert(mgd_iter != multiget_cf_data.end());
@@ -4012,23 +4135,32 @@ std::vector<Status> DBImpl::MultiGet(
         (read_options.read_tier == kPersistedTier && has_unpersisted_data_);
     bool done = false;
     if (!skip_memtable) {
-      if (super_version->mem->Get(lkey, value, &s, &merge_context)) {
+      if (super_version->mem->Get(lkey, value, &s, &merge_contexts[i])) {
         done = true;
         // TODO(?): RecordTick(stats_, MEMTABLE_HIT)?
-      } else if (super_version->imm->Get(lkey, value, &s, &merge_context)) {
+      } else if (super_version->imm->Get(lkey, value, &s, &merge_contexts[i])) {
         done = true;
         // TODO(?): RecordTick(stats_, MEMTABLE_HIT)?
       }
     }
     if (!done) {
-      PERF_TIMER_GUARD(get_from_output_files_time);
-      super_version->current->Get(read_options, lkey, value, &s,
-                                  &merge_context);
+      sst_lookups[super_version].push_back(
+          Version::MultiGetEntry{&lkey, value, &s, &merge_contexts[i]});
       // TODO(?): RecordTick(stats_, MEMTABLE_MISS)?
     }
+  }
 
-    if (s.ok()) {
-      bytes_read += value->size();
+  {
+    PERF_TIMER_GUARD(get_from_output_files_time);
+    for (const auto& super_version_and_entries : sst_lookups) {
+      super_version_and_entries.first->current->MultiGet(
+          read_options, super_version_and_entries.second);
+    }
+  }
+
+  for (size_t i = 0; i < num_keys; ++i) {
+    if (stat_list[i].ok()) {
+      bytes_read += (*values)[i].size();
     }
   }
 
@@ -4063,6 +4195,16 @@ std::vector<Status> DBImpl::MultiGet(
   return stat_list;
 }
 
+void DBImpl::PrefetchKeys(const ReadOptions& read_options, const std::vector<Slice>& keys) {
+  if (keys.empty()) {
+    return;
+  }
+  auto cfd = down_cast<ColumnFamilyHandleImpl*>(DefaultColumnFamily())->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  sv->current->PrefetchKeys(read_options, keys);
+  ReturnAndCleanupSuperVersion(cfd, sv);
+}
+
 #ifndef ROCKSDB_LITE
 Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
                        const std::string& file_path, bool move_file) {
@@ -282,6 +282,14 @@ class SpecialEnv : public EnvWrapper {
           return base_->Append(data);
         }
       }
+      bool UseOSBuffer() const override { return base_->UseOSBuffer(); }
+      size_t GetRequiredBufferAlignment() const override {
+        return base_->GetRequiredBufferAlignment();
+      }
+      Status PositionedAppend(const Slice& data, uint64_t offset) override {
+        env_->bytes_written_ += data.size();
+        return base_->PositionedAppend(data, offset);
+      }
       Status Truncate(uint64_t size) override { return base_->Truncate(size); }
       Status Close() override {
 // SyncPoint is not supported in Released Windows Mode.
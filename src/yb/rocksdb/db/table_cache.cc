@@ -417,6 +417,28 @@ Status TableCache::Get(const ReadOptions& options,
   return s;
 }
 
+void TableCache::PrefetchKeys(const ReadOptions& options,
+    const InternalKeyComparatorPtr& internal_comparator,
+    const FileDescriptor& fd, const Slice* keys, size_t count,
+    HistogramImpl* file_read_hist, bool skip_filters) {
+  TableReader* t = fd.table_reader;
+  Cache::Handle* handle = nullptr;
+  if (!t) {
+    Status s = FindTable(env_options_, internal_comparator, fd, &handle,
+                         options.query_id, options.read_tier == kBlockCacheTier /* no_io */,
+                         true /* record_read_stats */, file_read_hist, skip_filters);
+    if (!s.ok()) {
+      // The error will be reported by the lookup itself.
+      return;
+    }
+    t = GetTableReaderFromHandle(handle);
+  }
+  t->PrefetchKeys(options, keys, count, skip_filters);
+  if (handle != nullptr) {
+    ReleaseHandle(handle);
+  }
+}
+
 Status TableCache::GetTableProperties(
     const EnvOptions& env_options,
     const InternalKeyComparatorPtr& internal_comparator, const FileDescriptor& fd,
@@ -105,6 +105,13 @@ class TableCache {
              GetContext* get_context, HistogramImpl* file_read_hist = nullptr,
              bool skip_filters = false);
 
+  // Loads into the block cache data blocks of the specified file, that Get for the internal keys
+  // would read, see TableReader::PrefetchKeys.
+  void PrefetchKeys(const ReadOptions& options,
+                    const InternalKeyComparatorPtr& internal_comparator,
+                    const FileDescriptor& file_fd, const Slice* keys, size_t count,
+                    HistogramImpl* file_read_hist = nullptr, bool skip_filters = false);
+
   // Evict any entry for the specified file number
   static void Evict(Cache* cache, uint64_t file_number);
 
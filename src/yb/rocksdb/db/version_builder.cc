@@ -144,10 +144,19 @@ class VersionBuilder::Rep {
         auto f2 = level_files[i];
         if (level == 0) {
           assert(level_zero_cmp_(f1, f2));
+          // Files written by subcompactions of one compaction have the
+          // same seqno range and disjoint key ranges.
+          const auto& icmp = vstorage->InternalComparator();
+          const bool same_sorted_run =
+              f1->smallest.seqno == f2->smallest.seqno &&
+              f1->largest.seqno == f2->largest.seqno &&
+              (icmp->Compare(f1->largest.key, f2->smallest.key) < 0 ||
+               icmp->Compare(f2->largest.key, f1->smallest.key) < 0);
           assert(f1->largest.seqno > f2->largest.seqno ||
                  // We can have multiple files with seqno = 0 as a result of
                  // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
+                 (f1->largest.seqno == 0 && f2->largest.seqno == 0) ||
+                 same_sorted_run);
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
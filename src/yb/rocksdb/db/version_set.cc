@@ -33,6 +33,8 @@
 #include <map>
 #include <set>
 #include <climits>
+#include <deque>
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -226,11 +228,11 @@ class FilePicker {
 
   // getter for current file level
   // for GET_HIT_L0, GET_HIT_L1 & GET_HIT_L2_AND_UP counts
-  unsigned int GetHitFileLevel() { return hit_file_level_; }
+  unsigned int GetHitFileLevel() const { return hit_file_level_; }
 
   // Returns true if the most recent "hit file" (i.e., one returned by
   // GetNextFile()) is at the last index in its level.
-  bool IsHitFileLastInLevel() { return is_hit_file_last_in_level_; }
+  bool IsHitFileLastInLevel() const { return is_hit_file_last_in_level_; }
 
  private:
   unsigned int num_levels_;
@@ -947,42 +949,57 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       user_comparator(), internal_comparator().get());
   FdWithBoundaries* f = fp.GetNextFile();
   while (f != nullptr) {
-    *status = table_cache_->Get(
-        read_options, internal_comparator(), f->fd, ikey, &get_context,
-        cfd_->internal_stats()->GetFileReadHist(fp.GetHitFileLevel()),
-        IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
-                        fp.IsHitFileLastInLevel()));
-    // TODO: examine the behavior for corrupted key
-    if (!status->ok()) {
+    if (GetFromFile(read_options, ikey, user_key, *f, fp.GetHitFileLevel(),
+                    fp.IsHitFileLastInLevel(), &get_context, status)) {
       return;
     }
-
-    switch (get_context.State()) {
-      case GetContext::kNotFound:
-        // Keep searching in other files
-        break;
-      case GetContext::kFound:
-        if (fp.GetHitFileLevel() == 0) {
-          RecordTick(db_statistics_, GET_HIT_L0);
-        } else if (fp.GetHitFileLevel() == 1) {
-          RecordTick(db_statistics_, GET_HIT_L1);
-        } else if (fp.GetHitFileLevel() >= 2) {
-          RecordTick(db_statistics_, GET_HIT_L2_AND_UP);
-        }
-        return;
-      case GetContext::kDeleted:
-        // Use empty error message for speed
-        *status = STATUS(NotFound, "");
-        return;
-      case GetContext::kCorrupt:
-        *status = STATUS(Corruption, "corrupted key for ", user_key);
-        return;
-      case GetContext::kMerge:
-        break;
-    }
     f = fp.GetNextFile();
   }
 
+  FinishGet(user_key, get_context, value, merge_context, status, key_exists);
+}
+
+bool Version::GetFromFile(
+    const ReadOptions& read_options, const Slice& ikey, const Slice& user_key,
+    const FdWithBoundaries& file, unsigned int level, bool is_file_last_in_level,
+    GetContext* get_context, Status* status) {
+  *status = table_cache_->Get(
+      read_options, internal_comparator(), file.fd, ikey, get_context,
+      cfd_->internal_stats()->GetFileReadHist(level),
+      IsFilterSkipped(static_cast<int>(level), is_file_last_in_level));
+  // TODO: examine the behavior for corrupted key
+  if (!status->ok()) {
+    return true;
+  }
+
+  switch (get_context->State()) {
+    case GetContext::kNotFound:
+      // Keep searching in other files
+      return false;
+    case GetContext::kFound:
+      if (level == 0) {
+        RecordTick(db_statistics_, GET_HIT_L0);
+      } else if (level == 1) {
+        RecordTick(db_statistics_, GET_HIT_L1);
+      } else if (level >= 2) {
+        RecordTick(db_statistics_, GET_HIT_L2_AND_UP);
+      }
+      return true;
+    case GetContext::kDeleted:
+      // Use empty error message for speed
+      *status = STATUS(NotFound, "");
+      return true;
+    case GetContext::kCorrupt:
+      *status = STATUS(Corruption, "corrupted key for ", user_key);
+      return true;
+    case GetContext::kMerge:
+      return false;
+  }
+  return false;
+}
+
+void Version::FinishGet(const Slice& user_key, const GetContext& get_context, std::string* value,
+                        MergeContext* merge_context, Status* status, bool* key_exists) {
   if (GetContext::kMerge == get_context.State()) {
     if (!merge_operator_) {
       *status =  STATUS(InvalidArgument,
@@ -1008,6 +1025,135 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
   }
 }
 
+void Version::MultiGet(const ReadOptions& read_options, const std::vector<MultiGetEntry>& entries) {
+  struct KeyLookup {
+    KeyLookup(Version* version, const MultiGetEntry& entry)
+        : get_context(
+              version->user_comparator(), version->merge_operator_, version->info_log_,
+              version->db_statistics_,
+              entry.status->ok() ? GetContext::kNotFound : GetContext::kMerge,
+              entry.key->user_key(), entry.value, nullptr /* value_found */,
+              entry.merge_context, version->env_),
+          file_picker(
+              version->storage_info_.files_, entry.key->user_key(), entry.key->internal_key(),
+              &version->storage_info_.level_files_brief_,
+              version->storage_info_.num_non_empty_levels_,
+              &version->storage_info_.file_indexer_, version->user_comparator(),
+              version->internal_comparator().get()),
+          file(file_picker.GetNextFile()) {}
+
+    GetContext get_context;
+    FilePicker file_picker;
+    // File to look up the key in next, nullptr if the lookup is complete.
+    FdWithBoundaries* file;
+    bool found = false;
+  };
+
+  std::deque<KeyLookup> lookups;
+  std::vector<size_t> pending;
+  for (const auto& entry : entries) {
+    assert(entry.status->ok() || entry.status->IsMergeInProgress());
+    lookups.emplace_back(this, entry);
+    if (lookups.back().file != nullptr) {
+      pending.push_back(lookups.size() - 1);
+    }
+  }
+
+  std::vector<Slice> ikeys;
+  while (!pending.empty()) {
+    // Group the keys by the file, that they should be looked up in next.
+    std::sort(pending.begin(), pending.end(), [&lookups](size_t lhs, size_t rhs) {
+      return std::less<FdWithBoundaries*>()(lookups[lhs].file, lookups[rhs].file);
+    });
+    auto group_begin = pending.begin();
+    while (group_begin != pending.end()) {
+      FdWithBoundaries* file = lookups[*group_begin].file;
+      const auto& file_picker = lookups[*group_begin].file_picker;
+      const unsigned int level = file_picker.GetHitFileLevel();
+      const bool is_file_last_in_level = file_picker.IsHitFileLastInLevel();
+      auto group_end = std::find_if(group_begin, pending.end(), [&lookups, file](size_t idx) {
+        return lookups[idx].file != file;
+      });
+      if (group_end - group_begin > 1) {
+        ikeys.clear();
+        for (auto it = group_begin; it != group_end; ++it) {
+          ikeys.push_back(entries[*it].key->internal_key());
+        }
+        table_cache_->PrefetchKeys(
+            read_options, internal_comparator(), file->fd, ikeys.data(), ikeys.size(),
+            cfd_->internal_stats()->GetFileReadHist(level),
+            IsFilterSkipped(static_cast<int>(level), is_file_last_in_level));
+      }
+      for (auto it = group_begin; it != group_end; ++it) {
+        auto& lookup = lookups[*it];
+        const auto& entry = entries[*it];
+        if (GetFromFile(read_options, entry.key->internal_key(), entry.key->user_key(), *file,
+                        lookup.file_picker.GetHitFileLevel(),
+                        lookup.file_picker.IsHitFileLastInLevel(), &lookup.get_context,
+                        entry.status)) {
+          lookup.found = true;
+          lookup.file = nullptr;
+        } else {
+          lookup.file = lookup.file_picker.GetNextFile();
+        }
+      }
+      group_begin = group_end;
+    }
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [&lookups](size_t idx) {
+      return lookups[idx].file == nullptr;
+    }), pending.end());
+  }
+
+  for (size_t i = 0; i != entries.size(); ++i) {
+    if (!lookups[i].found) {
+      const auto& entry = entries[i];
+      FinishGet(entry.key->user_key(), lookups[i].get_context, entry.value, entry.merge_context,
+                entry.status, nullptr /* key_exists */);
+    }
+  }
+}
+
+void Version::PrefetchKeys(const ReadOptions& read_options, const std::vector<Slice>& user_keys) {
+  const Comparator* ucmp = user_comparator();
+  std::vector<std::string> ikeys;
+  ikeys.reserve(user_keys.size());
+  for (const auto& user_key : user_keys) {
+    ikeys.push_back(InternalKey::MaxPossibleForUserKey(user_key).Encode().ToBuffer());
+  }
+
+  // Whether the file could contain the user key, or a key starting with it.
+  auto may_contain = [ucmp](const FdWithBoundaries& file, const Slice& user_key) {
+    return ucmp->Compare(file.largest.user_key(), user_key) >= 0 &&
+           (ucmp->Compare(file.smallest.user_key(), user_key) <= 0 ||
+            file.smallest.user_key().starts_with(user_key));
+  };
+
+  std::vector<Slice> file_keys;
+  auto prefetch = [this, &read_options, &file_keys](
+      const FdWithBoundaries& file, int level, bool is_file_last_in_level) {
+    if (!file_keys.empty()) {
+      table_cache_->PrefetchKeys(
+          read_options, internal_comparator(), file.fd, file_keys.data(), file_keys.size(),
+          cfd_->internal_stats()->GetFileReadHist(level),
+          IsFilterSkipped(level, is_file_last_in_level));
+      file_keys.clear();
+    }
+  };
+
+  for (int level = 0; level < storage_info_.num_non_empty_levels(); ++level) {
+    const auto& level_files = storage_info_.LevelFilesBrief(level);
+    for (size_t file_idx = 0; file_idx != level_files.num_files; ++file_idx) {
+      const auto& file = level_files.files[file_idx];
+      for (size_t i = 0; i != user_keys.size(); ++i) {
+        if (may_contain(file, user_keys[i])) {
+          file_keys.push_back(ikeys[i]);
+        }
+      }
+      prefetch(file, level, file_idx + 1 == level_files.num_files);
+    }
+  }
+}
+
 bool Version::IsFilterSkipped(int level, bool is_file_last_in_level) {
   // Reaching the bottom level implies misses at all upper levels, so we'll
   // skip checking the filters when we predict a hit.
@@ -2089,7 +2235,7 @@ VersionSet::VersionSet(const std::string& dbname, const DBOptions* db_options,
       dbname_(dbname),
       db_options_(db_options),
       env_options_(storage_options),
-      env_options_compactions_(env_options_) {}
+      env_options_compactions_(env_->OptimizeForCompactionTableRead(env_options_, *db_options_)) {}
 
 VersionSet::~VersionSet() {
   // we need to delete column_family_set_ because its destructor depends on
@@ -2879,9 +3025,9 @@ Status VersionSet::Import(const std::string& source_dir,
     segments.emplace_back(file.smallest.seqno, file.largest.seqno);
   }
 
-  std::sort(segments.begin(), segments.end(), [](const auto& lhs, const auto& rhs) {
-    return lhs.first < rhs.first;
-  });
+  // Files written by subcompactions of one compaction have the same seqno range.
+  std::sort(segments.begin(), segments.end());
+  segments.erase(std::unique(segments.begin(), segments.end()), segments.end());
   auto prev = segments.front();
   for (size_t i = 1; i != segments.size(); ++i) {
     const auto& segment = segments[i];
@@ -68,6 +68,7 @@ class Writer;
 class Compaction;
 class InternalIterator;
 class LogBuffer;
+class GetContext;
 class LookupKey;
 class MemTable;
 class Version;
@@ -466,6 +467,29 @@ class Version {
            bool* value_found = nullptr, bool* key_exists = nullptr,
            SequenceNumber* seq = nullptr);
 
+  struct MultiGetEntry {
+    const LookupKey* key;
+    std::string* value;
+    // OK or MergeInProgress on input, as for Get.
+    Status* status;
+    MergeContext* merge_context;
+  };
+
+  // Looks up several keys with the same result as calling Get for each of them. The keys are
+  // looked up in files level by level, and data blocks of a file, that are needed by several keys,
+  // are read together.
+  //
+  // REQUIRES: lock is not held
+  void MultiGet(const ReadOptions& read_options, const std::vector<MultiGetEntry>& entries);
+
+  // Loads into the block cache data blocks of this version, that a Get or Seek to the specified
+  // user keys would read. Blocks of the same file are read together. The key is also looked up
+  // in files, whose smallest key starts with it, so the key could be a prefix of the stored keys,
+  // e.g. an encoded DocDB document key.
+  //
+  // REQUIRES: lock is not held
+  void PrefetchKeys(const ReadOptions& read_options, const std::vector<Slice>& user_keys);
+
   // Loads some stats information from files. Call without mutex held. It needs
   // to be called before applying the version to the version set.
   void PrepareApply(const MutableCFOptions& mutable_cf_options,
@@ -551,6 +575,16 @@ class Version {
   // that it eventually expires from the cache.
   bool IsFilterSkipped(int level, bool is_file_last_in_level = false);
 
+  // Looks up the key in a file picked for it. Returns true if the lookup is complete and *status
+  // contains its result, or false if the next file should be checked.
+  bool GetFromFile(const ReadOptions& read_options, const Slice& ikey, const Slice& user_key,
+                   const FdWithBoundaries& file, unsigned int level, bool is_file_last_in_level,
+                   GetContext* get_context, Status* status);
+
+  // Completes the lookup of the key, when no more files contain it.
+  void FinishGet(const Slice& user_key, const GetContext& get_context, std::string* value,
+                 MergeContext* merge_context, Status* status, bool* key_exists);
+
   // The helper function of UpdateAccumulatedStats, which may fill the missing
   // fields of file_mata from its associated TableProperties.
   // Returns true if it does initialize FileMetaData.
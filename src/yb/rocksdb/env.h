@@ -108,6 +108,12 @@ struct EnvOptions : public yb::FileSystemOptions {
   // If true, set the FD_CLOEXEC on open fd.
   bool set_fd_cloexec = true;
 
+  // If true, then open files with O_DIRECT, so reads bypass the OS page cache.
+  bool use_direct_reads = false;
+
+  // If true, then open files with O_DIRECT, so writes bypass the OS page cache.
+  bool use_direct_writes = false;
+
   // Allows OS to incrementally sync files to disk while they are being
   // written, in the background. Issue one request for every bytes_per_sync
   // written. 0 turns it off.
@@ -460,6 +466,16 @@ class Env {
   // files. Default implementation returns the copy of the same object.
   virtual EnvOptions OptimizeForManifestWrite(const EnvOptions& env_options)
       const;
+  // OptimizeForCompactionTableWrite will create a new EnvOptions object that is
+  // a copy of the EnvOptions in the parameters, but is optimized for writing
+  // table files by flushes and compactions.
+  virtual EnvOptions OptimizeForCompactionTableWrite(
+      const EnvOptions& env_options, const DBOptions& db_options) const;
+  // OptimizeForCompactionTableRead will create a new EnvOptions object that is
+  // a copy of the EnvOptions in the parameters, but is optimized for reading
+  // table files by compactions.
+  virtual EnvOptions OptimizeForCompactionTableRead(
+      const EnvOptions& env_options, const DBOptions& db_options) const;
 
   // Returns the status of all threads that belong to the current Env.
   virtual Status GetThreadList(std::vector<ThreadStatus>* thread_list) {
@@ -1017,6 +1033,10 @@ class WritableFileWrapper : public WritableFile {
  public:
   explicit WritableFileWrapper(std::unique_ptr<WritableFile> t) : target_(std::move(t)) { }
 
+  bool UseOSBuffer() const override { return target_->UseOSBuffer(); }
+  size_t GetRequiredBufferAlignment() const override {
+    return target_->GetRequiredBufferAlignment();
+  }
   Status Append(const Slice& data) override { return target_->Append(data); }
   Status PositionedAppend(const Slice& data, uint64_t offset) override {
     return target_->PositionedAppend(data, offset);
@@ -93,8 +93,12 @@ enum CompressionType : char {
   kBZip2Compression = 0x3,
   kLZ4Compression = 0x4,
   kLZ4HCCompression = 0x5,
-  // zstd format is not finalized yet so it's subject to changes.
+  kZSTD = 0x7,
+  // Blocks written before zstd format was finalized, they are still readable. Use kZSTD for new
+  // files.
   kZSTDNotFinalCompression = 0x40,
+  // Not a real compression type, only used in options to indicate that the option is not set.
+  kDisableCompressionOption = 0x7f,
 };
 
 enum CompactionStyle : char {
@@ -168,9 +172,18 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximal size of the dictionary, that is trained separately for each SST file on its first
+  // data blocks, stored in the file and used to compress all its data blocks. Only supported by
+  // kZSTD. 0 - dictionaries are not used.
+  uint32_t max_dict_bytes;
+  // Size of the data blocks buffered to train the dictionary.
+  // 0 - 100 times max_dict_bytes, as recommended by zstd.
+  uint32_t zstd_max_train_bytes;
+  CompressionOptions()
+      : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0), zstd_max_train_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes),
+        zstd_max_train_bytes(0) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -378,6 +391,14 @@ struct ColumnFamilyOptions {
   // change when data grows.
   std::vector<CompressionType> compression_per_level;
 
+  // Compression type of files written by compactions to the bottommost level, which contains most
+  // of the data. Overrides compression and compression_per_level for such compactions, unless
+  // compression is disabled for them. For example, kZSTD could be used for the bottommost level,
+  // while other levels use faster kSnappyCompression.
+  //
+  // Default: kDisableCompressionOption, i.e. the bottommost level is not treated specially.
+  CompressionType bottommost_compression;
+
   // different options for compression algorithms
   CompressionOptions compression_opts;
 
@@ -1174,6 +1195,17 @@ struct DBOptions {
   // Default: 0
   size_t compaction_readahead_size;
 
+  // If true, SST files written by flushes and compactions are opened with O_DIRECT, so they do
+  // not evict the pages used by foreground reads from the OS page cache. Compaction inputs are
+  // read with O_DIRECT as well, through aligned buffers, so compaction_readahead_size should be
+  // set to keep those reads large.
+  //
+  // Falls back to buffered I/O on file systems that do not support O_DIRECT.
+  // When true, we also force new_table_reader_for_compaction_inputs to true.
+  //
+  // Default: false
+  bool use_direct_io_for_flush_and_compaction;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -22,6 +22,8 @@
 //      device.
 //   2. Plain table: it is one of RocksDB's SST file format optimized
 //      for low query latency on pure-memory or really low-latency media.
+//   3. Columnar table: stores the output of full compactions column-wise,
+//      for compact storage and fast scans of data that is not updated anymore.
 //
 // A tutorial of rocksdb table formats is available here:
 //   https://github.com/facebook/rocksdb/wiki/A-Tutorial-of-RocksDB-SST-formats
@@ -375,6 +377,45 @@ extern TableFactory* NewCuckooTableFactory(
 
 #endif  // ROCKSDB_LITE
 
+class TableFactory;
+
+// Splits user keys for the columnar table format. The user key is split into three consecutive
+// parts: row, column and version. For instance, for DocDB keys, they are the DocKey, the subkeys
+// and the hybrid time.
+class ColumnarKeySplitter {
+ public:
+  virtual ~ColumnarKeySplitter() {}
+
+  virtual const char* Name() const = 0;
+
+  // Stores sizes of the row and column parts of the user key. The rest of the key is the version.
+  virtual void Split(const Slice& user_key, size_t* row_size, size_t* column_size) const = 0;
+};
+
+struct ColumnarTableOptions {
+  // Approximate size of keys and values stored in a single block, before encoding and compression.
+  // Each block is decoded as a whole, so blocks are larger than blocks of block-based tables.
+  size_t block_size = 256_KB;
+
+  // Whether full compactions write columnar tables. When false, all tables are written by the base
+  // factory, while existing columnar tables are still readable.
+  bool use_for_full_compactions = true;
+
+  // Splits user keys to rows, columns and versions. When not specified, the whole user key is
+  // considered as row.
+  std::shared_ptr<const ColumnarKeySplitter> key_splitter;
+};
+
+// Columnar table stores each block column-wise: the same rows are stored once per run, columns are
+// dictionary encoded, versions are delta encoded, and values are grouped by column and run-length
+// encoded.
+//
+// The factory writes columnar tables only for the output of full compactions, when
+// use_for_full_compactions is set. Other tables are written by base_factory. Both formats are
+// readable, the format is detected by the magic number of the table.
+extern TableFactory* NewColumnarTableFactory(
+    const ColumnarTableOptions& table_options, std::shared_ptr<TableFactory> base_factory);
+
 class RandomAccessFileReader;
 
 // A base class for table factories.
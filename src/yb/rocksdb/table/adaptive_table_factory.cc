@@ -20,6 +20,8 @@
 #ifndef ROCKSDB_LITE
 #include "yb/rocksdb/table/adaptive_table_factory.h"
 
+#include "yb/rocksdb/table/columnar_table_factory.h"
+#include "yb/rocksdb/table/columnar_table_reader.h"
 #include "yb/rocksdb/table/table_builder.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/port/port.h"
@@ -54,6 +56,7 @@ extern const uint64_t kLegacyPlainTableMagicNumber;
 extern const uint64_t kBlockBasedTableMagicNumber;
 extern const uint64_t kLegacyBlockBasedTableMagicNumber;
 extern const uint64_t kCuckooTableMagicNumber;
+extern const uint64_t kColumnarTableMagicNumber;
 
 Status AdaptiveTableFactory::NewTableReader(
     const TableReaderOptions& table_reader_options,
@@ -75,6 +78,10 @@ Status AdaptiveTableFactory::NewTableReader(
   } else if (footer.table_magic_number() == kCuckooTableMagicNumber) {
     return cuckoo_table_factory_->NewTableReader(
         table_reader_options, std::move(file), file_size, table);
+  } else if (footer.table_magic_number() == kColumnarTableMagicNumber) {
+    return ColumnarTableReader::Open(
+        table_reader_options, std::move(file), file_size,
+        GetBlockBasedTableCache(block_based_table_factory_.get()), table);
   } else {
     return STATUS(NotSupported, "Unidentified table format");
   }
@@ -106,11 +106,13 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
   return compressed_size < raw_size - (raw_size / 8u);
 }
 
-// format_version is the block format as defined in include/rocksdb/table.h
+}  // namespace
+
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const CompressionDict* compression_dict) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -161,9 +163,10 @@ Slice CompressBlock(const Slice& raw,
         return *compressed_output;
       }
       break;     // fall back to no compression.
+    case kZSTD:
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -177,8 +180,6 @@ Slice CompressBlock(const Slice& raw,
   return raw;
 }
 
-}  // namespace
-
 // kBlockBasedTableMagicNumber was picked by running
 //    echo rocksdb.table.block_based | sha1sum
 // and taking the leading 64 bits.
@@ -301,6 +302,19 @@ struct BlockBasedTableBuilder::Rep {
 
   std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors;
 
+  // Data blocks are buffered until the compression dictionary is trained on them, see
+  // CompressionOptions::max_dict_bytes.
+  struct BufferedDataBlock {
+    size_t size;
+    std::string last_key;
+    std::string next_block_first_key;
+  };
+  bool buffer_data_blocks = false;
+  size_t max_buffered_data_size = 0;
+  std::string buffered_data;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  std::unique_ptr<CompressionDict> compression_dict;
+
   yb::MemTrackerPtr mem_tracker;
 
   Rep(const ImmutableCFOptions& _ioptions,
@@ -392,6 +406,18 @@ BlockBasedTableBuilder::Rep::Rep(
       new BlockBasedTablePropertiesCollector(
           this, table_options.index_type, table_options.whole_key_filtering,
           _ioptions.prefix_extractor != nullptr));
+
+  // Block based filter and hash index require data blocks to be written in the same order as keys
+  // are added, so they could not be used while data blocks are buffered.
+  if (compression_type == kZSTD && compression_opts.max_dict_bytes > 0 &&
+      ZSTD_Dictionary_Supported() &&
+      (filter_block_builder == nullptr || filter_type != FilterType::kBlockBasedFilter) &&
+      table_options.index_type != IndexType::kHashSearch) {
+    buffer_data_blocks = true;
+    max_buffered_data_size = compression_opts.zstd_max_train_bytes > 0
+        ? compression_opts.zstd_max_train_bytes
+        : 100 * static_cast<size_t>(compression_opts.max_dict_bytes);
+  }
 }
 
 BlockBasedTableBuilder::BlockBasedTableBuilder(
@@ -489,11 +515,21 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   size_t data_block_size = 0;
 
   if (!r->data_block_builder.empty()) {
+    if (r->buffer_data_blocks) {
+      BufferDataBlock(next_block_first_key);
+      return;
+    }
     data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
         r->data_writer.get());
   }
   if (!ok()) return;
 
+  FinishDataBlock(data_block_size, &r->last_key, next_block_first_key);
+}
+
+void BlockBasedTableBuilder::FinishDataBlock(
+    size_t data_block_size, std::string* last_key, const Slice& next_block_first_key) {
+  Rep* const r = rep_;
   if (!r->table_options.skip_table_builder_flush) {
     r->status = r->data_writer->writer->Flush();
   }
@@ -514,7 +550,7 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   // "the r" as the key for the index block entry since it is >= all
   // entries in the first block and < all entries in subsequent
   // blocks.
-  r->data_index_builder->AddIndexEntry(&r->last_key,
+  r->data_index_builder->AddIndexEntry(last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
       r->data_pending_handle);
   while (r->data_index_builder->ShouldFlush()) {
@@ -533,6 +569,50 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   }
 }
 
+void BlockBasedTableBuilder::BufferDataBlock(const Slice& next_block_first_key) {
+  Rep* const r = rep_;
+  const Slice block_contents = r->data_block_builder.Finish();
+  r->buffered_data.append(block_contents.cdata(), block_contents.size());
+  r->buffered_data_blocks.push_back(Rep::BufferedDataBlock{
+      block_contents.size(), r->last_key, next_block_first_key.ToBuffer()});
+  r->data_block_builder.Reset();
+  if (r->buffered_data.size() >= r->max_buffered_data_size) {
+    WriteBufferedDataBlocks();
+  }
+}
+
+void BlockBasedTableBuilder::WriteBufferedDataBlocks() {
+  Rep* const r = rep_;
+  r->buffer_data_blocks = false;
+
+  std::vector<size_t> sample_lens;
+  sample_lens.reserve(r->buffered_data_blocks.size());
+  for (const auto& block : r->buffered_data_blocks) {
+    sample_lens.push_back(block.size);
+  }
+  auto dict = ZSTD_TrainDictionary(
+      r->buffered_data, sample_lens, r->compression_opts.max_dict_bytes);
+  // Blocks are compressed without dictionary, if it could not be trained, e.g. because the table
+  // is too small.
+  if (!dict.empty()) {
+    r->compression_dict = std::make_unique<CompressionDict>(std::move(dict), r->compression_opts);
+  }
+
+  size_t offset = 0;
+  for (auto& block : r->buffered_data_blocks) {
+    const size_t data_block_size = WriteBlock(
+        Slice(r->buffered_data.data() + offset, block.size), &r->data_pending_handle,
+        r->data_writer.get(), r->compression_dict.get());
+    offset += block.size;
+    if (!ok()) break;
+    FinishDataBlock(data_block_size, &block.last_key, block.next_block_first_key);
+    if (!ok()) break;
+  }
+  r->buffered_data.clear();
+  r->buffered_data.shrink_to_fit();
+  r->buffered_data_blocks.clear();
+}
+
 void BlockBasedTableBuilder::FlushFilterBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
@@ -564,14 +644,16 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice& next_block_first_key)
 size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
                                           BlockHandle* handle,
                                           FileWriterWithOffsetAndCachePrefix* writer_info) {
-  size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
+  size_t block_size = WriteBlock(
+      block->Finish(), handle, writer_info, rep_->compression_dict.get());
   block->Reset();
   return block_size;
 }
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const CompressionDict* compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -584,7 +666,7 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output, compression_dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -705,6 +787,9 @@ Status BlockBasedTableBuilder::Finish() {
   if (!r->data_block_builder.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
+  if (r->buffer_data_blocks) {
+    WriteBufferedDataBlocks();
+  }
   if (r->filter_block_builder != nullptr) {
     FlushFilterBlock(end_slice);  // no more filter block
   }
@@ -721,8 +806,9 @@ Status BlockBasedTableBuilder::Finish() {
   // Write meta blocks and metaindex block with the following order.
   //    1. [meta block: filter]
   //    2. [other meta blocks]
-  //    3. [meta block: properties]
-  //    4. [metaindex block]
+  //    3. [meta block: compression dictionary]
+  //    4. [meta block: properties]
+  //    5. [metaindex block]
   // write meta blocks
   MetaIndexBuilder meta_index_builder;
   for (const auto& item : r->data_index_blocks.meta_blocks) {
@@ -731,6 +817,14 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && r->compression_dict) {
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(
+        r->compression_dict->data(), kNoCompression, &compression_dict_block_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(block_based_table::kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -853,8 +947,10 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are accounted uncompressed, so output files are not overgrown while the
+  // compression dictionary is trained.
+  return (rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
+      rep_->metadata_writer->offset) + rep_->buffered_data.size();
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
@@ -39,12 +39,23 @@ namespace rocksdb {
 
 class BlockBuilder;
 class BlockHandle;
+class CompressionDict;
 class WritableFile;
 struct BlockBasedTableOptions;
 
 extern const uint64_t kBlockBasedTableMagicNumber;
 extern const uint64_t kLegacyBlockBasedTableMagicNumber;
 
+// Compresses the block with the specified compression type. Returns the raw block and sets *type
+// to kNoCompression, if compression is not supported or its ratio is not good enough.
+// format_version is the block format as defined in include/rocksdb/table.h.
+// compression_dict is only used by ZSTD, when it is specified.
+Slice CompressBlock(const Slice& raw,
+                    const CompressionOptions& compression_options,
+                    CompressionType* type, uint32_t format_version,
+                    std::string* compressed_output,
+                    const CompressionDict* compression_dict = nullptr);
+
 class BlockBasedTableBuilder : public TableBuilder {
  public:
   // Create a builder that will store the contents of the table it is
@@ -112,7 +123,8 @@ class BlockBasedTableBuilder : public TableBuilder {
       FileWriterWithOffsetAndCachePrefix* writer_info);
   // Directly write block content to the file. Returns number of bytes written to file.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const CompressionDict* compression_dict = nullptr);
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
@@ -130,6 +142,17 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called.
   void FlushDataBlock(const Slice& next_block_first_key);
 
+  // Updates properties and index after the data block with the specified last key was written to
+  // disk.
+  void FinishDataBlock(
+      size_t data_block_size, std::string* last_key, const Slice& next_block_first_key);
+
+  // Keeps the current data block in memory, so the compression dictionary could be trained on it.
+  void BufferDataBlock(const Slice& next_block_first_key);
+
+  // Trains the compression dictionary on buffered data blocks and writes them to disk.
+  void WriteBufferedDataBlocks();
+
   // Flush the current filter block into disk. next_block_first_key should be nullptr if this is the
   // last block written to disk.
   // REQUIRES: Finish(), Abandon() have not been called.
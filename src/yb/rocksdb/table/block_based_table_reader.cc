@@ -23,8 +23,10 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 #include <cinttypes>
 
 #include "yb/rocksdb/db/dbformat.h"
@@ -56,6 +58,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
@@ -236,6 +239,8 @@ struct BlockBasedTable::Rep {
   // block to extract prefix without knowing if a key is internal or not.
   unique_ptr<SliceTransform> internal_prefix_transform;
   DataIndexLoadMode data_index_load_mode;
+  // Dictionary used to compress data blocks, if any.
+  unique_ptr<UncompressionDict> uncompression_dict;
   yb::MemTrackerPtr mem_tracker;
 };
 
@@ -467,6 +472,23 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
         "Cannot find Properties block from file.");
   }
 
+  // Read the compression dictionary, that is only present when data blocks are compressed with it.
+  BlockHandle compression_dict_handle;
+  if (FindMetaBlock(
+          meta_iter.get(), block_based_table::kCompressionDictBlock,
+          &compression_dict_handle).ok()) {
+    BlockContents compression_dict;
+    s = ReadBlockContents(
+        rep->base_reader_with_cache_prefix->reader.get(), rep->footer, ReadOptions::kDefault,
+        compression_dict_handle, &compression_dict, rep->ioptions.env, rep->mem_tracker,
+        false /* do_uncompress */);
+    if (!s.ok()) {
+      return s;
+    }
+    rep->uncompression_dict = std::make_unique<UncompressionDict>(
+        compression_dict.data.ToBuffer());
+  }
+
   // Determine whether whole key filtering is supported.
   if (rep->table_properties) {
     rep->whole_key_filtering &=
@@ -625,6 +647,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (data_index_reader) {
     usage += data_index_reader->ApproximateMemoryUsage();
   }
+  if (rep_->uncompression_dict) {
+    usage += rep_->uncompression_dict->ApproximateMemoryUsage();
+  }
   return usage;
 }
 
@@ -688,7 +713,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* uncompression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -732,7 +758,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, uncompression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -760,7 +786,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* uncompression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -769,7 +796,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, uncompression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -1122,6 +1149,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  // Only data blocks are compressed with the dictionary.
+  const UncompressionDict* uncompression_dict =
+      block_type == BlockType::kData ? rep_->uncompression_dict.get() : nullptr;
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1142,7 +1172,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, uncompression_dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1150,13 +1180,14 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr, uncompression_dict);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                uncompression_dict);
       }
     }
   }
@@ -1175,7 +1206,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, uncompression_dict);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1419,6 +1450,118 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
   return s;
 }
 
+void BlockBasedTable::PrefetchKeys(const ReadOptions& read_options, const Slice* internal_keys,
+                                   size_t count, bool skip_filters) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  if (block_cache == nullptr || !read_options.fill_cache ||
+      read_options.read_tier == kBlockCacheTier) {
+    return;
+  }
+  Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
+  const bool is_block_based_filter = rep_->filter_type == FilterType::kBlockBasedFilter;
+
+  IndexIteratorHolder iiter_holder(this, read_options);
+  InternalIterator& iiter = *iiter_holder.iter();
+  if (!iiter.status().ok()) {
+    return;
+  }
+
+  // Find data blocks, that could contain the keys. Statistics are not updated here, since Get
+  // checks the filter and the block cache again.
+  std::vector<BlockHandle> handles;
+  for (size_t i = 0; i != count; ++i) {
+    const Slice& internal_key = internal_keys[i];
+    CachableEntry<FilterBlockReader> filter_entry;
+    Slice filter_key;
+    if (!skip_filters) {
+      filter_key = GetFilterKeyFromInternalKey(internal_key);
+      filter_entry = GetFilter(read_options.query_id, false /* no_io */, &filter_key);
+    }
+    FilterBlockReader* filter = filter_entry.value;
+    if (is_block_based_filter || filter == nullptr || filter->KeyMayMatch(filter_key)) {
+      iiter.Seek(internal_key);
+      if (iiter.Valid()) {
+        Slice handle_value = iiter.value();
+        BlockHandle handle;
+        if (handle.DecodeFrom(&handle_value).ok() &&
+            (!is_block_based_filter || filter == nullptr ||
+             filter->KeyMayMatch(filter_key, handle.offset()))) {
+          handles.push_back(handle);
+        }
+      }
+    }
+    filter_entry.Release(block_cache);
+  }
+
+  std::sort(handles.begin(), handles.end(), [](const BlockHandle& lhs, const BlockHandle& rhs) {
+    return lhs.offset() < rhs.offset();
+  });
+  handles.erase(std::unique(handles.begin(), handles.end(),
+                            [](const BlockHandle& lhs, const BlockHandle& rhs) {
+                              return lhs.offset() == rhs.offset();
+                            }),
+                handles.end());
+
+  FileReaderWithCachePrefix* reader = GetBlockReader(BlockType::kData);
+  auto is_cached = [&read_options](Cache* cache, const Slice& key) {
+    auto* handle = cache->Lookup(key, read_options.query_id);
+    if (handle == nullptr) {
+      return false;
+    }
+    cache->Release(handle);
+    return true;
+  };
+  auto block_cached = [&](const BlockHandle& handle) {
+    char cache_key[block_based_table::kCacheKeyBufferSize];
+    if (is_cached(block_cache, GetCacheKey(reader->cache_key_prefix, handle, cache_key))) {
+      return true;
+    }
+    return block_cache_compressed != nullptr &&
+           is_cached(block_cache_compressed,
+                     GetCacheKey(reader->compressed_cache_key_prefix, handle, cache_key));
+  };
+  handles.erase(std::remove_if(handles.begin(), handles.end(), block_cached), handles.end());
+  if (handles.size() < 2) {
+    // Nothing to read together, Get will read the block itself.
+    return;
+  }
+
+  Statistics* statistics = rep_->ioptions.statistics;
+  std::vector<BlockContents> contents(handles.size());
+  std::vector<Status> statuses(handles.size());
+  {
+    StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
+    ReadBlockContentsBatch(
+        reader->reader.get(), rep_->footer, read_options, handles.data(), handles.size(),
+        contents.data(), statuses.data(), rep_->ioptions.env, rep_->mem_tracker,
+        block_cache_compressed == nullptr, rep_->uncompression_dict.get());
+  }
+
+  for (size_t i = 0; i != handles.size(); ++i) {
+    if (!statuses[i].ok()) {
+      continue;
+    }
+    char cache_key[block_based_table::kCacheKeyBufferSize];
+    char compressed_cache_key[block_based_table::kCacheKeyBufferSize];
+    Slice key = GetCacheKey(reader->cache_key_prefix, handles[i], cache_key);
+    Slice ckey;
+    if (block_cache_compressed != nullptr) {
+      ckey = GetCacheKey(reader->compressed_cache_key_prefix, handles[i], compressed_cache_key);
+    }
+    // Failure to cache the block is ignored, Get will read the block by itself in this case.
+    CachableEntry<Block> block;
+    auto status = PutDataBlockToCache(
+        key, ckey, block_cache, block_cache_compressed, read_options, statistics, &block,
+        new Block(std::move(contents[i])), rep_->table_options.format_version, rep_->mem_tracker,
+        rep_->uncompression_dict.get());
+    if (block.cache_handle != nullptr) {
+      block_cache->Release(block.cache_handle);
+    } else {
+      delete block.value;
+    }
+  }
+}
+
 Status BlockBasedTable::Prefetch(const Slice* const begin,
                                  const Slice* const end) {
   auto& comparator = *rep_->comparator;
@@ -1482,7 +1625,8 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker,
+      rep_->uncompression_dict.get());
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
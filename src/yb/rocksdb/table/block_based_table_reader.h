@@ -53,6 +53,7 @@ class InternalKeyComparator;
 class Iterator;
 class TableCache;
 class TableReader;
+class UncompressionDict;
 class WritableFile;
 struct BlockBasedTableOptions;
 struct EnvOptions;
@@ -150,6 +151,11 @@ class BlockBasedTable : public TableReader {
   Status Get(const ReadOptions& readOptions, const Slice& key,
              GetContext* get_context, bool skip_filters = false) override;
 
+  // Looks up data blocks for all keys first, and then reads the blocks missing from the block
+  // cache together. Does nothing when there is no block cache to keep the blocks in.
+  void PrefetchKeys(const ReadOptions& read_options, const Slice* internal_keys, size_t count,
+                    bool skip_filters = false) override;
+
   // Pre-fetch the disk blocks that correspond to the key range specified by
   // (kbegin, kend). The call will return return error status in the event of
   // IO or iteration error.
@@ -247,7 +253,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* uncompression_dict);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -262,7 +269,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* uncompression_dict);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -0,0 +1,325 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/columnar_table_builder.h"
+
+#include <assert.h>
+
+#include <algorithm>
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/table/block_based_table_builder.h"
+#include "yb/rocksdb/table/columnar_table_factory.h"
+#include "yb/rocksdb/table/meta_blocks.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+#include "yb/rocksdb/util/file_reader_writer.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Format version used for footer and compressed blocks, see GetCompressFormatForVersion.
+constexpr uint32_t kColumnarTableFormatVersion = 2;
+
+// Appends the size of the prefix shared by value with previous, followed by the rest of value.
+void AppendDelta(const std::string& previous, const Slice& value, std::string* out) {
+  const size_t limit = std::min(previous.size(), value.size());
+  size_t shared = 0;
+  while (shared < limit && previous[shared] == value[shared]) {
+    ++shared;
+  }
+  PutVarint32(out, static_cast<uint32_t>(shared));
+  PutLengthPrefixedSlice(out, Slice(value.data() + shared, value.size() - shared));
+}
+
+} // namespace
+
+// kColumnarTableMagicNumber was picked by running
+//    echo rocksdb.table.columnar | sha1sum
+// and taking the leading 64 bits.
+extern const uint64_t kColumnarTableMagicNumber = 0x23f21543ce447e98ull;
+
+ColumnarTableBuilder::ColumnarTableBuilder(
+    const ImmutableCFOptions& ioptions,
+    const ColumnarTableOptions& table_options,
+    const IntTblPropCollectorFactories& int_tbl_prop_collector_factories,
+    uint32_t column_family_id,
+    WritableFileWriter* base_file,
+    WritableFileWriter* data_file,
+    CompressionType compression_type,
+    const CompressionOptions& compression_opts)
+    : ioptions_(ioptions),
+      table_options_(table_options),
+      base_file_(base_file),
+      data_file_(data_file),
+      compression_type_(compression_type),
+      compression_opts_(compression_opts) {
+  properties_.format_version = 0;
+  properties_.num_data_index_blocks = 1;
+  properties_.user_collected_properties[ColumnarTablePropertyNames::kSplitSst] =
+      data_file_ ? "1" : "0";
+  if (table_options_.key_splitter) {
+    properties_.user_collected_properties[ColumnarTablePropertyNames::kKeySplitterName] =
+        table_options_.key_splitter->Name();
+  }
+
+  for (auto& collector_factories : int_tbl_prop_collector_factories) {
+    table_properties_collectors_.emplace_back(
+        collector_factories->CreateIntTblPropCollector(column_family_id));
+  }
+}
+
+ColumnarTableBuilder::~ColumnarTableBuilder() {
+}
+
+void ColumnarTableBuilder::Add(const Slice& key, const Slice& value) {
+  assert(!closed_);
+  if (!ok()) {
+    return;
+  }
+
+  const Slice user_key = ExtractUserKey(key);
+  const uint64_t key_footer = DecodeFixed64(user_key.cend());
+  size_t row_size = user_key.size();
+  size_t column_size = 0;
+  if (table_options_.key_splitter) {
+    table_options_.key_splitter->Split(user_key, &row_size, &column_size);
+    assert(row_size + column_size <= user_key.size());
+  }
+  const Slice row(user_key.data(), row_size);
+  const Slice column(row.cend(), column_size);
+  const Slice version(column.cend(), user_key.cend());
+
+  if (block_entries_ == 0 || row != Slice(last_row_)) {
+    if (row_run_ != 0) {
+      PutVarint32(&rows_, row_run_);
+    }
+    AppendDelta(last_row_, row, &rows_);
+    last_row_.assign(row.cdata(), row.size());
+    row_run_ = 0;
+  }
+  ++row_run_;
+
+  auto column_it = column_ids_.emplace(
+      column.ToBuffer(), static_cast<uint32_t>(columns_.size())).first;
+  const uint32_t column_id = column_it->second;
+  if (column_id == columns_.size()) {
+    columns_.push_back(column_it->first);
+    values_.emplace_back();
+  }
+  PutVarint32(&column_refs_, column_id);
+
+  AppendDelta(last_version_, version, &versions_);
+  last_version_.assign(version.cdata(), version.size());
+
+  if (key_footer_run_ == 0 || key_footer != last_key_footer_) {
+    if (key_footer_run_ != 0) {
+      PutVarint64(&key_footers_, last_key_footer_);
+      PutVarint32(&key_footers_, key_footer_run_);
+    }
+    last_key_footer_ = key_footer;
+    key_footer_run_ = 0;
+  }
+  ++key_footer_run_;
+
+  auto& column_values = values_[column_id];
+  if (column_values.run == 0 || value != Slice(column_values.last_value)) {
+    if (column_values.run != 0) {
+      PutVarint32(&column_values.encoded, column_values.run);
+      PutLengthPrefixedSlice(&column_values.encoded, column_values.last_value);
+    }
+    column_values.last_value.assign(value.cdata(), value.size());
+    column_values.run = 0;
+  }
+  ++column_values.run;
+
+  ++block_entries_;
+  block_raw_size_ += key.size() + value.size();
+  last_key_.assign(key.cdata(), key.size());
+
+  properties_.num_entries++;
+  properties_.raw_key_size += key.size();
+  properties_.raw_value_size += value.size();
+
+  NotifyCollectTableCollectorsOnAdd(
+      key, value, TotalFileSize(), table_properties_collectors_, ioptions_.info_log);
+
+  if (block_raw_size_ >= table_options_.block_size) {
+    FlushBlock();
+  }
+}
+
+void ColumnarTableBuilder::FlushBlock() {
+  if (!ok() || block_entries_ == 0) {
+    return;
+  }
+
+  PutVarint32(&rows_, row_run_);
+  PutVarint64(&key_footers_, last_key_footer_);
+  PutVarint32(&key_footers_, key_footer_run_);
+
+  std::string columns;
+  PutVarint32(&columns, static_cast<uint32_t>(columns_.size()));
+  for (const auto& column : columns_) {
+    PutLengthPrefixedSlice(&columns, column);
+  }
+  columns.append(column_refs_);
+
+  std::string values;
+  for (auto& column_values : values_) {
+    PutVarint32(&column_values.encoded, column_values.run);
+    PutLengthPrefixedSlice(&column_values.encoded, column_values.last_value);
+    values.append(column_values.encoded);
+  }
+
+  block_contents_.clear();
+  PutVarint32(&block_contents_, block_entries_);
+  PutLengthPrefixedSlice(&block_contents_, rows_);
+  PutLengthPrefixedSlice(&block_contents_, columns);
+  PutLengthPrefixedSlice(&block_contents_, versions_);
+  PutLengthPrefixedSlice(&block_contents_, key_footers_);
+  PutLengthPrefixedSlice(&block_contents_, values);
+
+  auto type = compression_type_;
+  const Slice contents = CompressBlock(
+      block_contents_, compression_opts_, &type, kColumnarTableFormatVersion, &compressed_output_);
+  BlockHandle handle;
+  if (data_file_) {
+    status_ = WriteBlock(contents, type, data_file_, &data_offset_, &handle);
+  } else {
+    status_ = WriteBlock(contents, type, base_file_, &base_offset_, &handle);
+  }
+  compressed_output_.clear();
+  if (ok()) {
+    PutLengthPrefixedSlice(&index_, last_key_);
+    handle.AppendEncodedTo(&index_);
+    properties_.num_data_blocks++;
+  }
+
+  ResetBlock();
+}
+
+void ColumnarTableBuilder::ResetBlock() {
+  block_entries_ = 0;
+  block_raw_size_ = 0;
+  rows_.clear();
+  last_row_.clear();
+  row_run_ = 0;
+  column_ids_.clear();
+  columns_.clear();
+  column_refs_.clear();
+  versions_.clear();
+  last_version_.clear();
+  key_footers_.clear();
+  last_key_footer_ = 0;
+  key_footer_run_ = 0;
+  values_.clear();
+}
+
+Status ColumnarTableBuilder::WriteBlock(
+    const Slice& contents, CompressionType type, WritableFileWriter* file, uint64_t* offset,
+    BlockHandle* handle) {
+  handle->set_offset(*offset);
+  handle->set_size(contents.size());
+  RETURN_NOT_OK(file->Append(contents));
+
+  char trailer[kBlockTrailerSize];
+  trailer[0] = type;
+  auto crc = crc32c::Value(contents.data(), contents.size());
+  crc = crc32c::Extend(crc, trailer, 1);  // Extend to cover block type
+  EncodeFixed32(trailer + 1, crc32c::Mask(crc));
+  RETURN_NOT_OK(file->Append(Slice(trailer, kBlockTrailerSize)));
+
+  *offset += contents.size() + kBlockTrailerSize;
+  return Status::OK();
+}
+
+Status ColumnarTableBuilder::Finish() {
+  assert(!closed_);
+  closed_ = true;
+
+  FlushBlock();
+  if (!ok()) {
+    return status_;
+  }
+
+  properties_.data_size = data_file_ ? data_offset_ : base_offset_;
+
+  //  Write the following blocks to the base file
+  //  1. [index block]
+  //  2. [meta block: properties]
+  //  3. [metaindex block]
+  //  4. [footer]
+  BlockHandle index_block_handle;
+  properties_.data_index_size = index_.size() + kBlockTrailerSize;
+  status_ = WriteBlock(index_, kNoCompression, base_file_, &base_offset_, &index_block_handle);
+  if (!ok()) {
+    return status_;
+  }
+
+  PropertyBlockBuilder property_block_builder;
+  property_block_builder.AddTableProperty(properties_);
+  property_block_builder.Add(properties_.user_collected_properties);
+  NotifyCollectTableCollectorsOnFinish(table_properties_collectors_,
+                                       ioptions_.info_log,
+                                       &property_block_builder);
+
+  BlockHandle property_block_handle;
+  status_ = WriteBlock(
+      property_block_builder.Finish(), kNoCompression, base_file_, &base_offset_,
+      &property_block_handle);
+  if (!ok()) {
+    return status_;
+  }
+
+  MetaIndexBuilder meta_index_builder;
+  meta_index_builder.Add(kPropertiesBlock, property_block_handle);
+  BlockHandle metaindex_block_handle;
+  status_ = WriteBlock(
+      meta_index_builder.Finish(), kNoCompression, base_file_, &base_offset_,
+      &metaindex_block_handle);
+  if (!ok()) {
+    return status_;
+  }
+
+  Footer footer(kColumnarTableMagicNumber, kColumnarTableFormatVersion);
+  footer.set_checksum(kCRC32c);
+  footer.set_metaindex_handle(metaindex_block_handle);
+  footer.set_index_handle(index_block_handle);
+  std::string footer_encoding;
+  footer.AppendEncodedTo(&footer_encoding);
+  status_ = base_file_->Append(footer_encoding);
+  if (ok()) {
+    base_offset_ += footer_encoding.size();
+  }
+  return status_;
+}
+
+void ColumnarTableBuilder::Abandon() {
+  closed_ = true;
+}
+
+uint64_t ColumnarTableBuilder::NumEntries() const {
+  return properties_.num_entries;
+}
+
+uint64_t ColumnarTableBuilder::TotalFileSize() const {
+  return base_offset_ + data_offset_;
+}
+
+uint64_t ColumnarTableBuilder::BaseFileSize() const {
+  return base_offset_;
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,144 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_COLUMNAR_TABLE_BUILDER_H
+#define YB_ROCKSDB_TABLE_COLUMNAR_TABLE_BUILDER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/rocksdb/table.h"
+#include "yb/rocksdb/table_properties.h"
+#include "yb/rocksdb/db/table_properties_collector.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/table/table_builder.h"
+
+namespace rocksdb {
+
+// Columnar table layout:
+//   [data block 1]
+//   ...
+//   [data block N]
+//   [index block]
+//   [properties block]
+//   [metaindex block]
+//   [footer]
+// Data blocks are stored in the data file, when the SST is split, and other blocks in the base
+// file. Each block is followed by the usual trailer with compression type and checksum.
+//
+// Index block contains an entry per data block: the last internal key of the block and the block
+// handle, both length prefixed.
+//
+// Data block consists of the number of entries, followed by length prefixed sections:
+//   rows: runs of entries with the same row, each run is stored as the size of the prefix shared
+//         with the previous row, the rest of the row and the number of entries in the run.
+//   columns: dictionary of columns in the block, followed by the column index of each entry.
+//   versions: version of each entry, stored as the size of the prefix shared with the previous
+//             version and the rest of the version.
+//   key footers: runs of entries with the same packed sequence number and value type.
+//   values: values of the first column in the dictionary, then of the second one and so on.
+//           Values of each column are stored as runs of equal values: the number of entries in
+//           the run and the length prefixed value.
+class ColumnarTableBuilder : public TableBuilder {
+ public:
+  ColumnarTableBuilder(
+      const ImmutableCFOptions& ioptions,
+      const ColumnarTableOptions& table_options,
+      const IntTblPropCollectorFactories& int_tbl_prop_collector_factories,
+      uint32_t column_family_id,
+      WritableFileWriter* base_file,
+      WritableFileWriter* data_file,
+      CompressionType compression_type,
+      const CompressionOptions& compression_opts);
+
+  ColumnarTableBuilder(const ColumnarTableBuilder&) = delete;
+  void operator=(const ColumnarTableBuilder&) = delete;
+
+  ~ColumnarTableBuilder();
+
+  void Add(const Slice& key, const Slice& value) override;
+
+  Status status() const override { return status_; }
+
+  Status Finish() override;
+
+  void Abandon() override;
+
+  uint64_t NumEntries() const override;
+
+  uint64_t TotalFileSize() const override;
+
+  uint64_t BaseFileSize() const override;
+
+  TableProperties GetTableProperties() const override { return properties_; }
+
+ private:
+  // Values of a single column in the current block.
+  struct ColumnValues {
+    std::string encoded;
+    std::string last_value;
+    uint32_t run = 0;
+  };
+
+  bool ok() const { return status_.ok(); }
+
+  void FlushBlock();
+
+  void ResetBlock();
+
+  // Appends the block with trailer to the file, advancing offset.
+  Status WriteBlock(const Slice& contents, CompressionType type, WritableFileWriter* file,
+                    uint64_t* offset, BlockHandle* handle);
+
+  const ImmutableCFOptions& ioptions_;
+  const ColumnarTableOptions table_options_;
+  WritableFileWriter* const base_file_;
+  WritableFileWriter* const data_file_;
+  const CompressionType compression_type_;
+  const CompressionOptions compression_opts_;
+
+  std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors_;
+  TableProperties properties_;
+  Status status_;
+  bool closed_ = false;
+
+  uint64_t base_offset_ = 0;
+  uint64_t data_offset_ = 0;
+  std::string index_;
+  std::string last_key_;
+
+  // State of the current block.
+  uint32_t block_entries_ = 0;
+  size_t block_raw_size_ = 0;
+  std::string rows_;
+  std::string last_row_;
+  uint32_t row_run_ = 0;
+  std::unordered_map<std::string, uint32_t> column_ids_;
+  std::vector<std::string> columns_;
+  std::string column_refs_;
+  std::string versions_;
+  std::string last_version_;
+  std::string key_footers_;
+  uint64_t last_key_footer_ = 0;
+  uint32_t key_footer_run_ = 0;
+  std::vector<ColumnValues> values_;
+
+  std::string block_contents_;
+  std::string compressed_output_;
+};
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_TABLE_COLUMNAR_TABLE_BUILDER_H
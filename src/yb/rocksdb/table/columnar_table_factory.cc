@@ -0,0 +1,125 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/columnar_table_factory.h"
+
+#include "yb/rocksdb/table/block_based_table_factory.h"
+#include "yb/rocksdb/table/columnar_table_builder.h"
+#include "yb/rocksdb/table/columnar_table_reader.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/table/table_builder.h"
+
+#include "yb/util/format.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Columnar tables do not have filters, so they are never filtered out. Other tables are filtered
+// by the filter of the base factory.
+class ColumnarAwareFileFilter : public TableAwareReadFileFilter {
+ public:
+  explicit ColumnarAwareFileFilter(std::shared_ptr<TableAwareReadFileFilter> base_filter)
+      : base_filter_(std::move(base_filter)) {}
+
+  bool Filter(TableReader* reader) const override {
+    return dynamic_cast<ColumnarTableReader*>(reader) != nullptr || base_filter_->Filter(reader);
+  }
+
+ private:
+  std::shared_ptr<TableAwareReadFileFilter> base_filter_;
+};
+
+} // namespace
+
+std::shared_ptr<Cache> GetBlockBasedTableCache(TableFactory* factory) {
+  auto* block_based_factory = dynamic_cast<BlockBasedTableFactory*>(factory);
+  if (!block_based_factory || block_based_factory->table_options().no_block_cache) {
+    return nullptr;
+  }
+  return block_based_factory->table_options().block_cache;
+}
+
+const char ColumnarTablePropertyNames::kSplitSst[] = "rocksdb.columnar.table.split.sst";
+const char ColumnarTablePropertyNames::kKeySplitterName[] =
+    "rocksdb.columnar.table.key.splitter.name";
+
+ColumnarTableFactory::ColumnarTableFactory(
+    const ColumnarTableOptions& table_options, std::shared_ptr<TableFactory> base_factory)
+    : table_options_(table_options), base_factory_(std::move(base_factory)),
+      block_cache_(GetBlockBasedTableCache(base_factory_.get())) {
+}
+
+Status ColumnarTableFactory::NewTableReader(
+    const TableReaderOptions& table_reader_options,
+    unique_ptr<RandomAccessFileReader>&& base_file, uint64_t base_file_size,
+    unique_ptr<TableReader>* table_reader) const {
+  Footer footer;
+  RETURN_NOT_OK(ReadFooterFromFile(base_file.get(), base_file_size, &footer));
+  if (footer.table_magic_number() == kColumnarTableMagicNumber) {
+    return ColumnarTableReader::Open(
+        table_reader_options, std::move(base_file), base_file_size, block_cache_, table_reader);
+  }
+  return base_factory_->NewTableReader(
+      table_reader_options, std::move(base_file), base_file_size, table_reader);
+}
+
+bool ColumnarTableFactory::IsSplitSstForWriteSupported() const {
+  return base_factory_->IsSplitSstForWriteSupported();
+}
+
+TableBuilder* ColumnarTableFactory::NewTableBuilder(
+    const TableBuilderOptions& table_builder_options, uint32_t column_family_id,
+    WritableFileWriter* base_file, WritableFileWriter* data_file) const {
+  if (!table_options_.use_for_full_compactions || !table_builder_options.full_compaction) {
+    return base_factory_->NewTableBuilder(
+        table_builder_options, column_family_id, base_file, data_file);
+  }
+  return new ColumnarTableBuilder(
+      table_builder_options.ioptions, table_options_,
+      *table_builder_options.int_tbl_prop_collector_factories, column_family_id, base_file,
+      data_file, table_builder_options.compression_type, table_builder_options.compression_opts);
+}
+
+Status ColumnarTableFactory::SanitizeOptions(
+    const DBOptions& db_opts, const ColumnFamilyOptions& cf_opts) const {
+  if (table_options_.block_size == 0) {
+    return STATUS(InvalidArgument, "Block size of columnar table should be positive");
+  }
+  return base_factory_->SanitizeOptions(db_opts, cf_opts);
+}
+
+std::string ColumnarTableFactory::GetPrintableTableOptions() const {
+  return yb::Format(
+      "  block_size: $0\n  use_for_full_compactions: $1\n  key_splitter: $2\n"
+      "  base factory ($3) options:\n$4",
+      table_options_.block_size, table_options_.use_for_full_compactions,
+      table_options_.key_splitter ? table_options_.key_splitter->Name() : "nullptr",
+      base_factory_->Name(), base_factory_->GetPrintableTableOptions());
+}
+
+std::shared_ptr<TableAwareReadFileFilter> ColumnarTableFactory::NewTableAwareReadFileFilter(
+    const ReadOptions &read_options, const Slice &user_key) const {
+  auto base_filter = base_factory_->NewTableAwareReadFileFilter(read_options, user_key);
+  if (!base_filter) {
+    return nullptr;
+  }
+  return std::make_shared<ColumnarAwareFileFilter>(std::move(base_filter));
+}
+
+TableFactory* NewColumnarTableFactory(
+    const ColumnarTableOptions& table_options, std::shared_ptr<TableFactory> base_factory) {
+  return new ColumnarTableFactory(table_options, std::move(base_factory));
+}
+
+}  // namespace rocksdb
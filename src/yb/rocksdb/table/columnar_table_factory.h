@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_COLUMNAR_TABLE_FACTORY_H
+#define YB_ROCKSDB_TABLE_COLUMNAR_TABLE_FACTORY_H
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/table.h"
+
+namespace rocksdb {
+
+extern const uint64_t kColumnarTableMagicNumber;
+
+class Cache;
+
+// Returns the block cache of the block-based table factory, that is shared with columnar tables.
+// Returns nullptr for other factories and when the block cache is disabled.
+std::shared_ptr<Cache> GetBlockBasedTableCache(TableFactory* factory);
+
+struct ColumnarTablePropertyNames {
+  // "1" when data blocks are stored in the data file of a split SST.
+  static const char kSplitSst[];
+  static const char kKeySplitterName[];
+};
+
+// Writes columnar tables for full compactions and delegates everything else to the base factory.
+// See NewColumnarTableFactory.
+class ColumnarTableFactory : public TableFactory {
+ public:
+  ColumnarTableFactory(
+      const ColumnarTableOptions& table_options, std::shared_ptr<TableFactory> base_factory);
+
+  const char* Name() const override { return "ColumnarTable"; }
+
+  Status NewTableReader(const TableReaderOptions& table_reader_options,
+                        unique_ptr<RandomAccessFileReader>&& base_file, uint64_t base_file_size,
+                        unique_ptr<TableReader>* table_reader) const override;
+
+  bool IsSplitSstForWriteSupported() const override;
+
+  TableBuilder* NewTableBuilder(const TableBuilderOptions& table_builder_options,
+                                uint32_t column_family_id, WritableFileWriter* base_file,
+                                WritableFileWriter* data_file = nullptr) const override;
+
+  Status SanitizeOptions(const DBOptions& db_opts,
+                         const ColumnFamilyOptions& cf_opts) const override;
+
+  std::string GetPrintableTableOptions() const override;
+
+  void* GetOptions() override { return &table_options_; }
+
+  std::shared_ptr<TableAwareReadFileFilter> NewTableAwareReadFileFilter(
+      const ReadOptions &read_options, const Slice &user_key) const override;
+
+  const ColumnarTableOptions& table_options() const { return table_options_; }
+
+  const std::shared_ptr<TableFactory>& base_factory() const { return base_factory_; }
+
+ private:
+  ColumnarTableOptions table_options_;
+  std::shared_ptr<TableFactory> base_factory_;
+  // Decoded data blocks of columnar tables are cached in the block cache of the base factory.
+  std::shared_ptr<Cache> block_cache_;
+};
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_TABLE_COLUMNAR_TABLE_FACTORY_H
@@ -0,0 +1,425 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/columnar_table_reader.h"
+
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/table/columnar_table_factory.h"
+#include "yb/rocksdb/table/get_context.h"
+#include "yb/rocksdb/table/internal_iterator.h"
+#include "yb/rocksdb/table/meta_blocks.h"
+#include "yb/rocksdb/table/table_builder.h"
+#include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/mem_tracker.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Reverts AppendDelta of ColumnarTableBuilder, previous value is passed in *value.
+bool DecodeDelta(Slice* input, std::string* value) {
+  uint32_t shared;
+  Slice rest;
+  if (!GetVarint32(input, &shared) || shared > value->size() ||
+      !GetLengthPrefixedSlice(input, &rest)) {
+    return false;
+  }
+  value->resize(shared);
+  value->append(rest.cdata(), rest.size());
+  return true;
+}
+
+Status BadBlock() {
+  return STATUS(Corruption, "bad columnar block contents");
+}
+
+void DeleteCachedBlock(const Slice& key, void* value) {
+  delete static_cast<ColumnarBlock*>(value);
+}
+
+class ColumnarTableIterator : public InternalIterator {
+ public:
+  ColumnarTableIterator(const ColumnarTableReader* table, const ReadOptions& read_options)
+      : table_(table), read_options_(read_options) {}
+
+  bool Valid() const override { return valid_; }
+
+  void SeekToFirst() override {
+    if (LoadBlock(0)) {
+      entry_ = 0;
+    }
+  }
+
+  void SeekToLast() override {
+    if (table_->NumBlocks() != 0 && LoadBlock(table_->NumBlocks() - 1)) {
+      entry_ = block_->size() - 1;
+    } else {
+      valid_ = false;
+    }
+  }
+
+  void Seek(const Slice& target) override {
+    if (!LoadBlock(table_->FindBlock(target))) {
+      return;
+    }
+    entry_ = block_->Seek(table_->comparator(), target);
+    if (entry_ == block_->size() && LoadBlock(block_index_ + 1)) {
+      entry_ = 0;
+    }
+  }
+
+  void Next() override {
+    assert(valid_);
+    if (++entry_ == block_->size() && LoadBlock(block_index_ + 1)) {
+      entry_ = 0;
+    }
+  }
+
+  void Prev() override {
+    assert(valid_);
+    if (entry_ != 0) {
+      --entry_;
+    } else if (block_index_ != 0 && LoadBlock(block_index_ - 1)) {
+      entry_ = block_->size() - 1;
+    } else {
+      valid_ = false;
+    }
+  }
+
+  Slice key() const override {
+    assert(valid_);
+    return block_->key(entry_);
+  }
+
+  Slice value() const override {
+    assert(valid_);
+    return block_->value(entry_);
+  }
+
+  Status status() const override { return status_; }
+
+ private:
+  // Makes the block with the specified index current. Returns false and makes iterator invalid if
+  // there is no such block or it could not be read.
+  bool LoadBlock(size_t index) {
+    valid_ = false;
+    if (index >= table_->NumBlocks()) {
+      return false;
+    }
+    if (!block_ || index != block_index_) {
+      block_.reset();
+      status_ = table_->ReadBlock(read_options_, index, &block_);
+      if (!status_.ok()) {
+        return false;
+      }
+      block_index_ = index;
+    }
+    valid_ = true;
+    return true;
+  }
+
+  const ColumnarTableReader* const table_;
+  const ReadOptions read_options_;
+  // Holds the block cache entry, when the block is cached.
+  std::shared_ptr<const ColumnarBlock> block_;
+  size_t block_index_ = 0;
+  size_t entry_ = 0;
+  bool valid_ = false;
+  Status status_;
+};
+
+} // namespace
+
+Status ColumnarBlock::Decode(BlockContents&& contents) {
+  contents_ = std::move(contents);
+  keys_.clear();
+  key_ends_.clear();
+  values_.clear();
+
+  Slice input = contents_.data;
+  uint32_t num_entries;
+  Slice rows, columns, versions, key_footers, values;
+  if (!GetVarint32(&input, &num_entries) ||
+      !GetLengthPrefixedSlice(&input, &rows) ||
+      !GetLengthPrefixedSlice(&input, &columns) ||
+      !GetLengthPrefixedSlice(&input, &versions) ||
+      !GetLengthPrefixedSlice(&input, &key_footers) ||
+      !GetLengthPrefixedSlice(&input, &values)) {
+    return BadBlock();
+  }
+
+  uint32_t num_columns;
+  if (!GetVarint32(&columns, &num_columns)) {
+    return BadBlock();
+  }
+  std::vector<Slice> dictionary(num_columns);
+  for (auto& column : dictionary) {
+    if (!GetLengthPrefixedSlice(&columns, &column)) {
+      return BadBlock();
+    }
+  }
+  std::vector<uint32_t> column_ids(num_entries);
+  // Position of the next value of each column, among values of all columns.
+  std::vector<size_t> value_positions(num_columns + 1);
+  for (auto& column_id : column_ids) {
+    if (!GetVarint32(&columns, &column_id) || column_id >= num_columns) {
+      return BadBlock();
+    }
+    ++value_positions[column_id + 1];
+  }
+
+  std::vector<Slice> column_values;
+  column_values.reserve(num_entries);
+  for (uint32_t column_id = 0; column_id != num_columns; ++column_id) {
+    size_t left = value_positions[column_id + 1];
+    while (left != 0) {
+      uint32_t run;
+      Slice value;
+      if (!GetVarint32(&values, &run) || run == 0 || run > left ||
+          !GetLengthPrefixedSlice(&values, &value)) {
+        return BadBlock();
+      }
+      column_values.insert(column_values.end(), run, value);
+      left -= run;
+    }
+    value_positions[column_id + 1] += value_positions[column_id];
+  }
+
+  values_.reserve(num_entries);
+  key_ends_.reserve(num_entries);
+  std::string row;
+  std::string version;
+  uint32_t row_run = 0;
+  uint64_t key_footer = 0;
+  uint32_t key_footer_run = 0;
+  for (auto column_id : column_ids) {
+    if (row_run == 0 && (!DecodeDelta(&rows, &row) || !GetVarint32(&rows, &row_run) ||
+                         row_run == 0)) {
+      return BadBlock();
+    }
+    if (key_footer_run == 0 && (!GetVarint64(&key_footers, &key_footer) ||
+                                !GetVarint32(&key_footers, &key_footer_run) ||
+                                key_footer_run == 0)) {
+      return BadBlock();
+    }
+    if (!DecodeDelta(&versions, &version)) {
+      return BadBlock();
+    }
+    --row_run;
+    --key_footer_run;
+
+    keys_.append(row);
+    keys_.append(dictionary[column_id].cdata(), dictionary[column_id].size());
+    keys_.append(version);
+    PutFixed64(&keys_, key_footer);
+    key_ends_.push_back(keys_.size());
+    values_.push_back(column_values[value_positions[column_id]++]);
+  }
+
+  return Status::OK();
+}
+
+size_t ColumnarBlock::usable_size() const {
+  return contents_.data.size() + keys_.capacity() + key_ends_.capacity() * sizeof(size_t) +
+         values_.capacity() * sizeof(Slice);
+}
+
+size_t ColumnarBlock::Seek(const InternalKeyComparator& comparator, const Slice& target) const {
+  size_t lower = 0;
+  size_t upper = size();
+  while (lower < upper) {
+    const size_t mid = (lower + upper) / 2;
+    if (comparator.Compare(key(mid), target) < 0) {
+      lower = mid + 1;
+    } else {
+      upper = mid;
+    }
+  }
+  return lower;
+}
+
+ColumnarTableReader::ColumnarTableReader(
+    const TableReaderOptions& table_reader_options, unique_ptr<RandomAccessFileReader>&& file,
+    std::shared_ptr<Cache> block_cache)
+    : ioptions_(table_reader_options.ioptions),
+      internal_comparator_(table_reader_options.internal_comparator),
+      base_file_(std::move(file)),
+      block_cache_(std::move(block_cache)) {
+  cache_key_prefix_.size = 0;
+}
+
+Status ColumnarTableReader::Open(
+    const TableReaderOptions& table_reader_options, unique_ptr<RandomAccessFileReader>&& file,
+    uint64_t file_size, std::shared_ptr<Cache> block_cache,
+    unique_ptr<TableReader>* table_reader) {
+  std::unique_ptr<ColumnarTableReader> reader(
+      new ColumnarTableReader(table_reader_options, std::move(file), std::move(block_cache)));
+  RETURN_NOT_OK(reader->DoOpen(file_size));
+  *table_reader = std::move(reader);
+  return Status::OK();
+}
+
+Status ColumnarTableReader::DoOpen(uint64_t file_size) {
+  RETURN_NOT_OK(ReadFooterFromFile(
+      base_file_.get(), file_size, &footer_, kColumnarTableMagicNumber));
+
+  TableProperties* table_properties = nullptr;
+  RETURN_NOT_OK(ReadTableProperties(
+      base_file_.get(), file_size, kColumnarTableMagicNumber, ioptions_.env, ioptions_.info_log,
+      &table_properties));
+  table_properties_.reset(table_properties);
+  const auto& user_properties = table_properties->user_collected_properties;
+  auto it = user_properties.find(ColumnarTablePropertyNames::kSplitSst);
+  split_sst_ = it != user_properties.end() && it->second == "1";
+
+  RETURN_NOT_OK(ReadBlockContents(
+      base_file_.get(), footer_, ReadOptions(), footer_.index_handle(), &index_contents_,
+      ioptions_.env, ioptions_.block_based_table_mem_tracker, true /* do_uncompress */));
+  Slice input = index_contents_.data;
+  while (!input.empty()) {
+    IndexEntry entry;
+    if (!GetLengthPrefixedSlice(&input, &entry.last_key)) {
+      return STATUS(Corruption, "bad columnar table index");
+    }
+    RETURN_NOT_OK(entry.handle.DecodeFrom(&input));
+    index_.push_back(entry);
+  }
+  if (block_cache_ && !split_sst_) {
+    block_based_table::GenerateCachePrefix(
+        block_cache_.get(), base_file_->file(), &cache_key_prefix_);
+  }
+  return Status::OK();
+}
+
+void ColumnarTableReader::SetDataFileReader(unique_ptr<RandomAccessFileReader>&& data_file) {
+  data_file_ = std::move(data_file);
+  if (block_cache_) {
+    block_based_table::GenerateCachePrefix(
+        block_cache_.get(), data_file_->file(), &cache_key_prefix_);
+  }
+}
+
+InternalIterator* ColumnarTableReader::NewIterator(const ReadOptions& read_options,
+                                                   Arena* arena,
+                                                   bool skip_filters) {
+  if (arena == nullptr) {
+    return new ColumnarTableIterator(this, read_options);
+  } else {
+    auto mem = arena->AllocateAligned(sizeof(ColumnarTableIterator));
+    return new (mem) ColumnarTableIterator(this, read_options);
+  }
+}
+
+size_t ColumnarTableReader::FindBlock(const Slice& target) const {
+  size_t lower = 0;
+  size_t upper = index_.size();
+  while (lower < upper) {
+    const size_t mid = (lower + upper) / 2;
+    if (internal_comparator_->Compare(index_[mid].last_key, target) < 0) {
+      lower = mid + 1;
+    } else {
+      upper = mid;
+    }
+  }
+  return lower;
+}
+
+Status ColumnarTableReader::ReadBlock(
+    const ReadOptions& read_options, size_t index,
+    std::shared_ptr<const ColumnarBlock>* block) const {
+  auto* file = data_file();
+  if (!file) {
+    return STATUS(IllegalState, "data file of columnar table is not set");
+  }
+  const auto& handle = index_[index].handle;
+  Statistics* statistics = ioptions_.statistics;
+  char cache_key_buffer[block_based_table::kCacheKeyBufferSize];
+  Slice cache_key;
+  if (block_cache_) {
+    cache_key = block_based_table::GetCacheKey(cache_key_prefix_, handle, cache_key_buffer);
+    auto* cache_handle = block_cache_->Lookup(cache_key, read_options.query_id, statistics);
+    if (cache_handle) {
+      RecordTick(statistics, BLOCK_CACHE_DATA_HIT);
+      auto cache = block_cache_;
+      block->reset(
+          static_cast<const ColumnarBlock*>(block_cache_->Value(cache_handle)),
+          [cache, cache_handle](const ColumnarBlock*) { cache->Release(cache_handle); });
+      return Status::OK();
+    }
+    RecordTick(statistics, BLOCK_CACHE_DATA_MISS);
+  }
+  if (read_options.read_tier == kBlockCacheTier) {
+    return STATUS(Incomplete, "no blocking io");
+  }
+
+  BlockContents contents;
+  RETURN_NOT_OK(ReadBlockContents(
+      file, footer_, read_options, handle, &contents, ioptions_.env,
+      ioptions_.block_based_table_mem_tracker, true /* do_uncompress */));
+  std::unique_ptr<ColumnarBlock> decoded(new ColumnarBlock);
+  RETURN_NOT_OK(decoded->Decode(std::move(contents)));
+  if (!block_cache_ || !read_options.fill_cache) {
+    block->reset(decoded.release());
+    return Status::OK();
+  }
+
+  Cache::Handle* cache_handle = nullptr;
+  auto* value = decoded.get();
+  auto status = block_cache_->Insert(
+      cache_key, read_options.query_id, value, value->usable_size(), &DeleteCachedBlock,
+      &cache_handle, statistics);
+  if (!status.ok()) {
+    // The cache is full and has strict capacity limit, so the block is used without caching.
+    RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    block->reset(decoded.release());
+    return Status::OK();
+  }
+  decoded.release();
+  RecordTick(statistics, BLOCK_CACHE_ADD);
+  auto cache = block_cache_;
+  block->reset(value, [cache, cache_handle](const ColumnarBlock*) {
+    cache->Release(cache_handle);
+  });
+  return Status::OK();
+}
+
+uint64_t ColumnarTableReader::ApproximateOffsetOf(const Slice& key) {
+  const size_t index = FindBlock(key);
+  if (index < index_.size()) {
+    return index_[index].handle.offset();
+  }
+  return table_properties_->data_size;
+}
+
+size_t ColumnarTableReader::ApproximateMemoryUsage() const {
+  return index_contents_.data.size() + index_.capacity() * sizeof(IndexEntry);
+}
+
+Status ColumnarTableReader::Get(const ReadOptions& read_options, const Slice& key,
+                                GetContext* get_context, bool skip_filters) {
+  ColumnarTableIterator iter(this, read_options);
+  for (iter.Seek(key); iter.Valid(); iter.Next()) {
+    ParsedInternalKey parsed_key;
+    if (!ParseInternalKey(iter.key(), &parsed_key)) {
+      return STATUS(Corruption, "bad internal key in columnar table");
+    }
+    if (!get_context->SaveValue(parsed_key, iter.value())) {
+      break;
+    }
+  }
+  return iter.status();
+}
+
+}  // namespace rocksdb
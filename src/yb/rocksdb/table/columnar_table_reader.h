@@ -0,0 +1,135 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_COLUMNAR_TABLE_READER_H
+#define YB_ROCKSDB_TABLE_COLUMNAR_TABLE_READER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/table/block_based_table_internal.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/table/table_reader.h"
+#include "yb/rocksdb/util/file_reader_writer.h"
+
+namespace rocksdb {
+
+struct TableReaderOptions;
+
+// Data block of a columnar table, decoded to entries in key order.
+class ColumnarBlock {
+ public:
+  Status Decode(BlockContents&& contents);
+
+  size_t size() const { return key_ends_.size(); }
+
+  Slice key(size_t index) const {
+    const size_t begin = index == 0 ? 0 : key_ends_[index - 1];
+    return Slice(keys_.data() + begin, key_ends_[index] - begin);
+  }
+
+  Slice value(size_t index) const { return values_[index]; }
+
+  // Returns index of the first entry with key at or after target, or size() if there is no such
+  // entry.
+  size_t Seek(const InternalKeyComparator& comparator, const Slice& target) const;
+
+  // Memory used by the decoded block, charged to the block cache.
+  size_t usable_size() const;
+
+ private:
+  BlockContents contents_;
+  std::string keys_;
+  std::vector<size_t> key_ends_;
+  std::vector<Slice> values_;
+};
+
+// Reader for tables written by ColumnarTableBuilder. Decoded data blocks are stored in the block
+// cache, when it is specified, keyed the same way as blocks of block-based tables.
+class ColumnarTableReader : public TableReader {
+ public:
+  static Status Open(const TableReaderOptions& table_reader_options,
+                     unique_ptr<RandomAccessFileReader>&& file, uint64_t file_size,
+                     std::shared_ptr<Cache> block_cache,
+                     unique_ptr<TableReader>* table_reader);
+
+  bool IsSplitSst() const override { return split_sst_; }
+
+  void SetDataFileReader(unique_ptr<RandomAccessFileReader>&& data_file) override;
+
+  InternalIterator* NewIterator(const ReadOptions&,
+                                Arena* arena = nullptr,
+                                bool skip_filters = false) override;
+
+  uint64_t ApproximateOffsetOf(const Slice& key) override;
+
+  void SetupForCompaction() override {}
+
+  std::shared_ptr<const TableProperties> GetTableProperties() const override {
+    return table_properties_;
+  }
+
+  size_t ApproximateMemoryUsage() const override;
+
+  Status Get(const ReadOptions& read_options, const Slice& key, GetContext* get_context,
+             bool skip_filters = false) override;
+
+  size_t NumBlocks() const { return index_.size(); }
+
+  // Returns index of the first block that could contain keys at or after target, or NumBlocks()
+  // if there is no such block.
+  size_t FindBlock(const Slice& target) const;
+
+  // Returns the decoded block from the block cache, or reads and decodes it. Returns Incomplete if
+  // the block is not in the block cache and read_options do not allow IO.
+  Status ReadBlock(const ReadOptions& read_options, size_t index,
+                   std::shared_ptr<const ColumnarBlock>* block) const;
+
+  const InternalKeyComparator& comparator() const { return *internal_comparator_; }
+
+ private:
+  struct IndexEntry {
+    Slice last_key;
+    BlockHandle handle;
+  };
+
+  ColumnarTableReader(const TableReaderOptions& table_reader_options,
+                      unique_ptr<RandomAccessFileReader>&& file,
+                      std::shared_ptr<Cache> block_cache);
+
+  Status DoOpen(uint64_t file_size);
+
+  RandomAccessFileReader* data_file() const {
+    return split_sst_ ? data_file_.get() : base_file_.get();
+  }
+
+  const ImmutableCFOptions& ioptions_;
+  const InternalKeyComparatorPtr internal_comparator_;
+  unique_ptr<RandomAccessFileReader> base_file_;
+  unique_ptr<RandomAccessFileReader> data_file_;
+  Footer footer_;
+  std::shared_ptr<const TableProperties> table_properties_;
+  bool split_sst_ = false;
+  BlockContents index_contents_;
+  std::vector<IndexEntry> index_;
+  const std::shared_ptr<Cache> block_cache_;
+  // Generated from the file that contains data blocks.
+  block_based_table::CacheKeyPrefixBuffer cache_key_prefix_;
+};
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_TABLE_COLUMNAR_TABLE_READER_H
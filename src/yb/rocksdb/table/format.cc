@@ -26,6 +26,7 @@
 #include <inttypes.h>
 
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/table/block.h"
@@ -36,6 +37,8 @@
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/xxhash.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/util/encryption_util.h"
 #include "yb/util/encrypted_file.h"
 #include "yb/util/format.h"
@@ -348,46 +351,53 @@ Status VerifyBlockChecksum(
   return Status::OK();
 }
 
+class BlockChecksumValidator : public yb::ReadValidator {
+ public:
+  BlockChecksumValidator(
+      RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
+      const BlockHandle& handle)
+      : file_(file),
+        footer_(footer),
+        options_(options),
+        handle_(handle),
+        expected_read_size_(static_cast<size_t>(handle.size()) + kBlockTrailerSize) {}
+
+  CHECKED_STATUS Validate(const Slice& read_result) const override {
+    if (read_result.size() != expected_read_size_) {
+      return STATUS_FORMAT(
+          Corruption, "Truncated block read in file: $0, block handle: $1, expected size: $2",
+          file_->file()->filename(), handle_.ToDebugString(), expected_read_size_);
+    }
+
+    if (options_.verify_checksums) {
+      return VerifyBlockChecksum(file_, footer_, handle_, read_result.cdata(), handle_.size());
+    }
+    return Status::OK();
+  }
+
+  size_t expected_read_size() const {
+    return expected_read_size_;
+  }
+
+ private:
+  RandomAccessFileReader* file_;
+  const Footer& footer_;
+  const ReadOptions& options_;
+  const BlockHandle& handle_;
+  const size_t expected_read_size_;
+};
+
 // Read a block and check its CRC. When this function returns, *contents will contain the result of
 // reading.
 Status ReadBlock(
     RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
     const BlockHandle& handle, Slice* contents, /* result of reading */ char* buf) {
   *contents = Slice(buf, buf);
-  const size_t expected_read_size = static_cast<size_t>(handle.size()) + kBlockTrailerSize;
+  BlockChecksumValidator validator(file, footer, options, handle);
+  const size_t expected_read_size = validator.expected_read_size();
   Status s;
   {
     PERF_TIMER_GUARD(block_read_time);
-    struct BlockChecksumValidator : public yb::ReadValidator {
-      BlockChecksumValidator(
-          RandomAccessFileReader* file_, const Footer& footer_, const ReadOptions& options_,
-          const BlockHandle& handle_, size_t expected_read_size_)
-          : file(file_),
-            footer(footer_),
-            options(options_),
-            handle(handle_),
-            expected_read_size(expected_read_size_) {}
-
-      CHECKED_STATUS Validate(const Slice& read_result) const override {
-        if (read_result.size() != expected_read_size) {
-          return STATUS_FORMAT(
-              Corruption, "Truncated block read in file: $0, block handle: $1, expected size: $2",
-              file->file()->filename(), handle.ToDebugString(), expected_read_size);
-        }
-
-        if (options.verify_checksums) {
-          return VerifyBlockChecksum(file, footer, handle, read_result.cdata(), handle.size());
-        }
-        return Status::OK();
-      };
-
-      RandomAccessFileReader* file;
-      const Footer& footer;
-      const ReadOptions& options;
-      const BlockHandle& handle;
-      const size_t expected_read_size;
-    } validator(file, footer, options, handle, expected_read_size);
-
     s = file->ReadAndValidate(handle.offset(), expected_read_size, contents, buf, validator);
   }
 
@@ -397,6 +407,29 @@ Status ReadBlock(
   return s;
 }
 
+// Fills contents from the block of size n, that was read with its trailer into buf.
+Status BlockContentsFromReadResult(
+    const Footer& footer, const Slice& read_result, size_t n, std::unique_ptr<char[]> buf,
+    BlockContents* contents, const yb::MemTrackerPtr& mem_tracker,
+    bool decompression_requested, const UncompressionDict* uncompression_dict) {
+  PERF_TIMER_GUARD(block_decompress_time);
+
+  const auto compression_type = static_cast<rocksdb::CompressionType>(read_result.data()[n]);
+
+  if (decompression_requested && compression_type != kNoCompression) {
+    return UncompressBlockContents(
+        read_result.cdata(), n, contents, footer.version(), mem_tracker, uncompression_dict);
+  }
+
+  if (read_result.cdata() != buf.get()) {
+    *contents = BlockContents(Slice(read_result.data(), n), false, compression_type);
+    return Status::OK();
+  }
+
+  *contents = BlockContents(std::move(buf), n, true, compression_type, mem_tracker);
+  return Status::OK();
+}
+
 }  // namespace
 
 TrackedAllocation::TrackedAllocation()
@@ -441,7 +474,8 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         const UncompressionDict* uncompression_dict) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -472,7 +506,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), mem_tracker);
+    return UncompressBlockContents(
+        slice.cdata(), n, contents, footer.version(), mem_tracker, uncompression_dict);
   }
 
   if (slice.cdata() != used_buf) {
@@ -489,6 +524,51 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   return status;
 }
 
+void ReadBlockContentsBatch(RandomAccessFileReader* file, const Footer& footer,
+                            const ReadOptions& options, const BlockHandle* handles,
+                            size_t count, BlockContents* contents, Status* statuses, Env* env,
+                            const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                            const UncompressionDict* uncompression_dict) {
+  std::vector<std::unique_ptr<char[]>> bufs(count);
+  std::vector<yb::RandomAccessFile::ReadRequest> requests(count);
+  size_t total_size = 0;
+  for (size_t i = 0; i != count; ++i) {
+    auto& request = requests[i];
+    request.offset = handles[i].offset();
+    request.length = static_cast<size_t>(handles[i].size()) + kBlockTrailerSize;
+    bufs[i].reset(new char[request.length]);
+    request.scratch = pointer_cast<uint8_t*>(bufs[i].get());
+    total_size += request.length;
+  }
+
+  {
+    PERF_TIMER_GUARD(block_read_time);
+    file->MultiRead(requests.data(), count);
+  }
+  PERF_COUNTER_ADD(block_read_count, count);
+  PERF_COUNTER_ADD(block_read_byte, total_size);
+
+  for (size_t i = 0; i != count; ++i) {
+    const auto& request = requests[i];
+    auto& status = statuses[i];
+    status = request.status;
+    if (status.ok()) {
+      status = BlockChecksumValidator(file, footer, options, handles[i]).Validate(request.result);
+    }
+    if (!status.ok()) {
+      // Files may require a more careful read to be validated, e.g. encrypted files, so retry
+      // the block with a regular read before reporting the failure.
+      status = ReadBlockContents(
+          file, footer, options, handles[i], &contents[i], env, mem_tracker,
+          decompression_requested, uncompression_dict);
+      continue;
+    }
+    status = BlockContentsFromReadResult(
+        footer, request.result, static_cast<size_t>(handles[i].size()), std::move(bufs[i]),
+        &contents[i], mem_tracker, decompression_requested, uncompression_dict);
+  }
+}
+
 //
 // The 'data' points to the raw block contents that was read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -499,7 +579,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
 Status UncompressBlockContents(const char* data, size_t n,
                                BlockContents* contents,
                                uint32_t format_version,
-                               const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+                               const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                               const UncompressionDict* uncompression_dict) {
   std::unique_ptr<char[]> ubuf;
   int decompress_size = 0;
   assert(data[n] != kNoCompression);
@@ -566,9 +647,10 @@ Status UncompressBlockContents(const char* data, size_t n,
       *contents =
           BlockContents(std::move(ubuf), decompress_size, true, kNoCompression, mem_tracker);
       break;
+    case kZSTD:
     case kZSTDNotFinalCompression:
-      ubuf =
-          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
+      ubuf = std::unique_ptr<char[]>(
+          ZSTD_Uncompress(data, n, &decompress_size, uncompression_dict));
       if (!ubuf) {
         static char zstd_corrupt_msg[] =
             "ZSTD not supported or corrupted ZSTD compressed block contents";
@@ -40,6 +40,7 @@ class MemTracker;
 namespace rocksdb {
 
 class Block;
+class UncompressionDict;
 struct ReadOptions;
 
 // the length of the magic number in bytes.
@@ -244,13 +245,29 @@ struct BlockContents {
 
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+// uncompression_dict is used to uncompress data blocks compressed with the dictionary.
 extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const Footer& footer,
                                 const ReadOptions& options,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const UncompressionDict* uncompression_dict = nullptr);
+
+// Read the blocks identified by "handles" from "file", submitting the reads together. The result
+// and status of each block are stored into the corresponding entries of "contents" and "statuses".
+extern void ReadBlockContentsBatch(RandomAccessFileReader* file,
+                                   const Footer& footer,
+                                   const ReadOptions& options,
+                                   const BlockHandle* handles,
+                                   size_t count,
+                                   BlockContents* contents,
+                                   Status* statuses,
+                                   Env* env,
+                                   const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                   bool do_uncompress,
+                                   const UncompressionDict* uncompression_dict = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -262,7 +279,8 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const UncompressionDict* uncompression_dict = nullptr);
 
 // Implementation details follow.  Clients should ignore,
 
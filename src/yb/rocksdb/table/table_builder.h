@@ -83,6 +83,9 @@ struct TableBuilderOptions {
   const CompressionOptions& compression_opts;
   // This is only used for BlockBasedTableBuilder
   bool skip_filters = false;
+  // Whether the table is written by a full compaction, so its data is not going to be merged with
+  // other tables until the next full compaction. Only used for ColumnarTableBuilder.
+  bool full_compaction = false;
 };
 
 // TableBuilder provides the interface used to build a Table
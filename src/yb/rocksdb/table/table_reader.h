@@ -98,6 +98,13 @@ class TableReader {
   virtual Status Get(const ReadOptions& readOptions, const Slice& internal_key,
                      GetContext* get_context, bool skip_filters = false) = 0;
 
+  // Loads into the block cache the data blocks, that Get or Seek for the specified internal keys
+  // would read, so that the subsequent lookups of these keys do not block on I/O one by one.
+  // Blocks missing from the cache are read together. Keys rejected by the filter are skipped.
+  // Errors are ignored, since they will be reported by the subsequent lookups.
+  virtual void PrefetchKeys(const ReadOptions& read_options, const Slice* internal_keys,
+                            size_t count, bool skip_filters = false) {}
+
   // Prefetch data corresponding to a give range of keys
   // Typically this functionality is required for table implementations that
   // persists the data on a non volatile storage medium like disk/SSD
@@ -50,6 +50,7 @@
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/block_based_table_reader.h"
 #include "yb/rocksdb/table/block_builder.h"
+#include "yb/rocksdb/table/columnar_table_factory.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/get_context.h"
 #include "yb/rocksdb/table/internal_iterator.h"
@@ -63,6 +64,7 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/util/enums.h"
+#include "yb/util/result.h"
 
 DECLARE_double(cache_single_touch_ratio);
 
@@ -278,9 +280,11 @@ class KeyConvertingIterator : public InternalIterator {
 class TableConstructor: public Constructor {
  public:
   explicit TableConstructor(const Comparator* cmp,
-                            bool convert_to_internal_key = false)
+                            bool convert_to_internal_key = false,
+                            bool full_compaction = false)
       : Constructor(cmp),
-        convert_to_internal_key_(convert_to_internal_key) {}
+        convert_to_internal_key_(convert_to_internal_key),
+        full_compaction_(full_compaction) {}
   ~TableConstructor() { Reset(); }
 
   virtual Status FinishImpl(const Options& options,
@@ -293,13 +297,15 @@ class TableConstructor: public Constructor {
     file_writer_.reset(test::GetWritableFileWriter(new test::StringSink()));
     unique_ptr<TableBuilder> builder;
     IntTblPropCollectorFactories int_tbl_prop_collector_factories;
+    TableBuilderOptions table_builder_options(ioptions,
+                                              internal_comparator,
+                                              int_tbl_prop_collector_factories,
+                                              options.compression,
+                                              options.compression_opts,
+                                              /* skip_filters */ false);
+    table_builder_options.full_compaction = full_compaction_;
     builder.reset(ioptions.table_factory->NewTableBuilder(
-        TableBuilderOptions(ioptions,
-                            internal_comparator,
-                            int_tbl_prop_collector_factories,
-                            options.compression,
-                            CompressionOptions(),
-                            /* skip_filters */ false),
+        table_builder_options,
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
 
@@ -381,6 +387,7 @@ class TableConstructor: public Constructor {
   unique_ptr<RandomAccessFileReader> file_reader_;
   unique_ptr<TableReader> table_reader_;
   bool convert_to_internal_key_;
+  bool full_compaction_;
 
   TableConstructor();
 
@@ -514,6 +521,7 @@ class DBConstructor: public Constructor {
 
 enum TestType {
   BLOCK_BASED_TABLE_TEST,
+  COLUMNAR_TABLE_TEST,
 #ifndef ROCKSDB_LITE
   PLAIN_TABLE_SEMI_FIXED_PREFIX,
   PLAIN_TABLE_FULL_STR_PREFIX,
@@ -537,6 +545,7 @@ static std::vector<TestArgs> GenerateArgList() {
   std::vector<TestArgs> test_args;
   std::vector<TestType> test_types = {
       BLOCK_BASED_TABLE_TEST,
+      COLUMNAR_TABLE_TEST,
 #ifndef ROCKSDB_LITE
       PLAIN_TABLE_SEMI_FIXED_PREFIX,
       PLAIN_TABLE_FULL_STR_PREFIX,
@@ -570,6 +579,8 @@ static std::vector<TestArgs> GenerateArgList() {
   if (ZSTD_Supported()) {
     compression_types.emplace_back(kZSTDNotFinalCompression, false);
     compression_types.emplace_back(kZSTDNotFinalCompression, true);
+    compression_types.emplace_back(kZSTD, false);
+    compression_types.emplace_back(kZSTD, true);
   }
 
   for (auto test_type : test_types) {
@@ -592,6 +603,24 @@ static std::vector<TestArgs> GenerateArgList() {
       }
 #endif  // !ROCKSDB_LITE
 
+      if (test_type == COLUMNAR_TABLE_TEST) {
+        // Columnar table doesn't use restart index and always uses compression format version 2.
+        for (auto compression_type : compression_types) {
+          if (compression_type.second) {
+            continue;
+          }
+          TestArgs one_arg;
+          one_arg.type = test_type;
+          one_arg.reverse_compare = reverse_compare;
+          one_arg.restart_interval = restart_intervals[0];
+          one_arg.compression = compression_type.first;
+          one_arg.format_version = 2;
+          one_arg.use_mmap = false;
+          test_args.push_back(one_arg);
+        }
+        continue;
+      }
+
       for (auto restart_interval : restart_intervals) {
         for (auto compression_type : compression_types) {
           TestArgs one_arg;
@@ -639,6 +668,17 @@ class FixedOrLessPrefixTransform : public SliceTransform {
   }
 };
 
+// Splits user key into a row of up to 2 bytes, a column of up to 1 byte and the rest as version.
+class TestColumnarKeySplitter : public ColumnarKeySplitter {
+ public:
+  const char* Name() const override { return "TestColumnarKeySplitter"; }
+
+  void Split(const Slice& user_key, size_t* row_size, size_t* column_size) const override {
+    *row_size = std::min<size_t>(user_key.size(), 2);
+    *column_size = std::min<size_t>(user_key.size() - *row_size, 1);
+  }
+};
+
 class HarnessTest : public testing::Test {
  public:
   HarnessTest()
@@ -675,6 +715,19 @@ class HarnessTest : public testing::Test {
             new BlockBasedTableFactory(table_options_));
         constructor_ = new TableConstructor(options_.comparator);
         break;
+      case COLUMNAR_TABLE_TEST:
+        {
+          ColumnarTableOptions columnar_table_options;
+          columnar_table_options.block_size = 256;
+          columnar_table_options.key_splitter = std::make_shared<TestColumnarKeySplitter>();
+          options_.table_factory.reset(NewColumnarTableFactory(
+              columnar_table_options, std::make_shared<BlockBasedTableFactory>(table_options_)));
+        }
+        constructor_ = new TableConstructor(
+            options_.comparator, /* convert_to_internal_key */ true, /* full_compaction */ true);
+        internal_comparator_.reset(
+            new InternalKeyComparator(options_.comparator));
+        break;
 // Plain table is not supported in ROCKSDB_LITE
 #ifndef ROCKSDB_LITE
       case PLAIN_TABLE_SEMI_FIXED_PREFIX:
@@ -966,6 +1019,7 @@ class TableTest : public testing::Test {
 class GeneralTableTest : public TableTest {};
 class BlockBasedTableTest : public TableTest {};
 class PlainTableTest : public TableTest {};
+class ColumnarTableTest : public TableTest {};
 class TablePropertyTest : public testing::Test {};
 
 // This test serves as the living tutorial for the prefix scan of user collected
@@ -1570,6 +1624,55 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+TEST_F(BlockBasedTableTest, ZSTDCompressionDictionary) {
+  if (!ZSTD_Dictionary_Supported()) {
+    fprintf(stderr, "skipping ZSTD dictionary test, not supported\n");
+    return;
+  }
+
+  uint64_t data_size[2];
+  for (bool use_dictionary : {false, true}) {
+    Random rnd(301);
+    TableConstructor c(BytewiseComparator());
+    // Small blocks that share a lot of content with each other, but little inside of a block.
+    for (int i = 0; i < 2000; ++i) {
+      c.Add(StringPrintf("row_%08d_column_%02d", i / 10, i % 10),
+            "value_" + RandomString(&rnd, 16) + "_common_suffix_of_all_values");
+    }
+
+    Options options;
+    options.compression = kZSTD;
+    options.compression_opts.max_dict_bytes = use_dictionary ? 4096 : 0;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 256;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+    data_size[use_dictionary] = c.GetTableReader()->GetTableProperties()->data_size;
+
+    std::unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->SeekToFirst();
+    for (const auto& kv : kvmap) {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(kv.first, iter->key().ToString());
+      ASSERT_EQ(kv.second, iter->value().ToString());
+      iter->Next();
+    }
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+
+    iter->Seek(keys[keys.size() / 2]);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(keys[keys.size() / 2], iter->key().ToString());
+  }
+
+  ASSERT_LT(data_size[true], data_size[false]);
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -2075,6 +2178,180 @@ TEST_F(PlainTableTest, BasicPlainTableProperties) {
 }
 #endif  // !ROCKSDB_LITE
 
+TEST_F(ColumnarTableTest, SplitSst) {
+  ColumnarTableOptions columnar_table_options;
+  columnar_table_options.block_size = 1024;
+  columnar_table_options.key_splitter = std::make_shared<TestColumnarKeySplitter>();
+  ColumnarTableFactory factory(
+      columnar_table_options, std::make_shared<BlockBasedTableFactory>());
+  Options options;
+  const ImmutableCFOptions ioptions(options);
+  const EnvOptions env_options;
+  auto ikc = std::make_shared<InternalKeyComparator>(options.comparator);
+  IntTblPropCollectorFactories int_tbl_prop_collector_factories;
+
+  // Rows of 2 bytes, each with the same set of 1 byte columns and a version.
+  stl_wrappers::KVMap kvmap;
+  SequenceNumber seq = 1;
+  for (int row = 0; row != 100; ++row) {
+    for (char column = 'a'; column <= 'c'; ++column) {
+      std::string user_key = StringPrintf("%02d%cv%d", row, column, row % 7);
+      std::string value = column == 'a' ? "liveness" : StringPrintf("value_%c_%d", column, row);
+      kvmap.emplace(InternalKey(user_key, seq++, kTypeValue).Encode().ToBuffer(), value);
+    }
+  }
+
+  for (bool full_compaction : {false, true}) {
+    unique_ptr<WritableFileWriter> base_writer(
+        test::GetWritableFileWriter(new test::StringSink()));
+    unique_ptr<WritableFileWriter> data_writer(
+        test::GetWritableFileWriter(new test::StringSink()));
+    TableBuilderOptions table_builder_options(
+        ioptions, ikc, int_tbl_prop_collector_factories, kNoCompression, CompressionOptions(),
+        /* skip_filters */ false);
+    table_builder_options.full_compaction = full_compaction;
+    std::unique_ptr<TableBuilder> builder(factory.NewTableBuilder(
+        table_builder_options, TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
+        base_writer.get(), data_writer.get()));
+    for (const auto& entry : kvmap) {
+      builder->Add(entry.first, entry.second);
+    }
+    ASSERT_OK(builder->Finish());
+    ASSERT_OK(base_writer->Flush());
+    ASSERT_OK(data_writer->Flush());
+
+    const auto& base_contents =
+        static_cast<test::StringSink*>(base_writer->writable_file())->contents();
+    const auto& data_contents =
+        static_cast<test::StringSink*>(data_writer->writable_file())->contents();
+    ASSERT_EQ(base_contents.size(), builder->BaseFileSize());
+    ASSERT_EQ(base_contents.size() + data_contents.size(), builder->TotalFileSize());
+    const auto table_properties = builder->GetTableProperties();
+    ASSERT_EQ(kvmap.size(), table_properties.num_entries);
+
+    unique_ptr<RandomAccessFileReader> base_reader(test::GetRandomAccessFileReader(
+        new test::StringSource(base_contents, 1, false)));
+    Footer footer;
+    ASSERT_OK(ReadFooterFromFile(base_reader.get(), base_contents.size(), &footer));
+    ASSERT_EQ(full_compaction ? kColumnarTableMagicNumber : kBlockBasedTableMagicNumber,
+              footer.table_magic_number());
+
+    unique_ptr<TableReader> table_reader;
+    ASSERT_OK(factory.NewTableReader(
+        TableReaderOptions(ioptions, env_options, ikc), std::move(base_reader),
+        base_contents.size(), &table_reader));
+    ASSERT_TRUE(table_reader->IsSplitSst());
+    table_reader->SetDataFileReader(unique_ptr<RandomAccessFileReader>(
+        test::GetRandomAccessFileReader(new test::StringSource(data_contents, 2, false))));
+
+    std::unique_ptr<InternalIterator> iter(table_reader->NewIterator(ReadOptions()));
+    auto expected = kvmap.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+      ASSERT_NE(expected, kvmap.end());
+      ASSERT_EQ(expected->first, iter->key().ToBuffer());
+      ASSERT_EQ(expected->second, iter->value().ToBuffer());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(expected, kvmap.end());
+
+    size_t index = 0;
+    for (const auto& entry : kvmap) {
+      if (index++ % 7 != 0) {
+        continue;
+      }
+      iter->Seek(entry.first);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(entry.first, iter->key().ToBuffer());
+      ASSERT_EQ(entry.second, iter->value().ToBuffer());
+    }
+
+    auto last = kvmap.rbegin();
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev(), ++last) {
+      ASSERT_EQ(last->first, iter->key().ToBuffer());
+    }
+    ASSERT_EQ(last, kvmap.rend());
+
+    if (full_compaction) {
+      ASSERT_GT(table_properties.num_data_blocks, 1U);
+      // Repeated rows, columns and values are stored once per block.
+      ASSERT_LT(data_contents.size(),
+                table_properties.raw_key_size + table_properties.raw_value_size);
+    }
+  }
+}
+
+// Decoded blocks of columnar tables are stored in the block cache of the base factory, and are
+// readable with kBlockCacheTier only when cached.
+TEST_F(ColumnarTableTest, BlockCache) {
+  ColumnarTableOptions columnar_table_options;
+  columnar_table_options.block_size = 1024;
+  columnar_table_options.key_splitter = std::make_shared<TestColumnarKeySplitter>();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1024 * 1024, 4);
+  ColumnarTableFactory factory(
+      columnar_table_options, std::make_shared<BlockBasedTableFactory>(table_options));
+  Options options;
+  const ImmutableCFOptions ioptions(options);
+  const EnvOptions env_options;
+  auto ikc = std::make_shared<InternalKeyComparator>(options.comparator);
+  IntTblPropCollectorFactories int_tbl_prop_collector_factories;
+
+  stl_wrappers::KVMap kvmap;
+  SequenceNumber seq = 1;
+  for (int row = 0; row != 100; ++row) {
+    for (char column = 'a'; column <= 'c'; ++column) {
+      std::string user_key = StringPrintf("%02d%cv%d", row, column, row % 7);
+      kvmap.emplace(InternalKey(user_key, seq++, kTypeValue).Encode().ToBuffer(),
+                    StringPrintf("value_%c_%d", column, row));
+    }
+  }
+
+  unique_ptr<WritableFileWriter> writer(test::GetWritableFileWriter(new test::StringSink()));
+  TableBuilderOptions table_builder_options(
+      ioptions, ikc, int_tbl_prop_collector_factories, kNoCompression, CompressionOptions(),
+      /* skip_filters */ false);
+  table_builder_options.full_compaction = true;
+  std::unique_ptr<TableBuilder> builder(factory.NewTableBuilder(
+      table_builder_options, TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
+      writer.get()));
+  for (const auto& entry : kvmap) {
+    builder->Add(entry.first, entry.second);
+  }
+  ASSERT_OK(builder->Finish());
+  ASSERT_OK(writer->Flush());
+  const auto& contents = static_cast<test::StringSink*>(writer->writable_file())->contents();
+  ASSERT_GT(builder->GetTableProperties().num_data_blocks, 1U);
+
+  unique_ptr<TableReader> table_reader;
+  ASSERT_OK(factory.NewTableReader(
+      TableReaderOptions(ioptions, env_options, ikc),
+      unique_ptr<RandomAccessFileReader>(test::GetRandomAccessFileReader(
+          new test::StringSource(contents, 1, false))),
+      contents.size(), &table_reader));
+
+  ReadOptions cache_only;
+  cache_only.read_tier = kBlockCacheTier;
+  auto count_entries = [&table_reader](const ReadOptions& read_options) -> yb::Result<size_t> {
+    std::unique_ptr<InternalIterator> iter(table_reader->NewIterator(read_options));
+    size_t result = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++result;
+    }
+    RETURN_NOT_OK(iter->status());
+    return result;
+  };
+
+  auto result = count_entries(cache_only);
+  ASSERT_NOK(result);
+  ASSERT_TRUE(result.status().IsIncomplete()) << result.status();
+  ASSERT_EQ(0U, table_options.block_cache->GetUsage());
+
+  ASSERT_EQ(kvmap.size(), ASSERT_RESULT(count_entries(ReadOptions())));
+  ASSERT_GT(table_options.block_cache->GetUsage(), 0U);
+
+  ASSERT_EQ(kvmap.size(), ASSERT_RESULT(count_entries(cache_only)));
+}
+
 TEST_F(GeneralTableTest, ApproximateOffsetOfPlain) {
   TableConstructor c(BytewiseComparator());
   c.Add("k01", "hello");
@@ -142,6 +142,8 @@ DEFINE_string(benchmarks,
               "\treadreverse   -- read N times in reverse order\n"
               "\treadrandom    -- read N times in random order\n"
               "\treadmissing   -- read N missing keys in random order\n"
+              "\tmultireadrandom -- read N keys in random order with MultiGet, "
+              "batch_size keys per call\n"
               "\treadwhilewriting      -- 1 writer, N threads doing random "
               "reads\n"
               "\treadwhilemerging      -- 1 merger, N threads doing random "
@@ -69,6 +69,7 @@ extern const uint64_t kBlockBasedTableMagicNumber;
 extern const uint64_t kLegacyBlockBasedTableMagicNumber;
 extern const uint64_t kPlainTableMagicNumber;
 extern const uint64_t kLegacyPlainTableMagicNumber;
+extern const uint64_t kColumnarTableMagicNumber;
 
 const char* testFileName = "test_file_name";
 
@@ -213,24 +214,23 @@ int SstFileReader::ShowAllCompressionSizes(size_t block_size) {
       std::make_pair(CompressionType::kLZ4Compression, "kLZ4Compression"));
   compress_type.insert(
       std::make_pair(CompressionType::kLZ4HCCompression, "kLZ4HCCompression"));
+  compress_type.insert(
+      std::make_pair(CompressionType::kZSTD, "kZSTD"));
   compress_type.insert(std::make_pair(CompressionType::kZSTDNotFinalCompression,
                                       "kZSTDNotFinalCompression"));
 
   fprintf(stdout, "Block Size: %" ROCKSDB_PRIszt "\n", block_size);
 
-  for (CompressionType i = CompressionType::kNoCompression;
-       i <= CompressionType::kZSTDNotFinalCompression;
-       i = (i == kLZ4HCCompression) ? kZSTDNotFinalCompression
-                                    : CompressionType(i + 1)) {
+  for (const auto& type_and_name : compress_type) {
     CompressionOptions compress_opt;
     TableBuilderOptions tb_opts(imoptions,
                                 ikc,
                                 block_based_table_factories,
-                                i,
+                                type_and_name.first,
                                 compress_opt,
                                 false);
     uint64_t file_size = CalculateCompressedTableSize(tb_opts, block_size);
-    fprintf(stdout, "Compression: %s", compress_type.find(i)->second);
+    fprintf(stdout, "Compression: %s", type_and_name.second);
     fprintf(stdout, " Size: %" PRIu64 "\n", file_size);
   }
   return 0;
@@ -281,6 +281,10 @@ Status SstFileReader::SetTableOptionsByMagicNumber(
 
     options_.table_factory.reset(NewPlainTableFactory(plain_table_options));
     fprintf(stdout, "Sst file format: plain table\n");
+  } else if (table_magic_number == kColumnarTableMagicNumber) {
+    options_.table_factory.reset(NewColumnarTableFactory(
+        ColumnarTableOptions(), std::make_shared<BlockBasedTableFactory>()));
+    fprintf(stdout, "Sst file format: columnar table\n");
   } else {
     char error_msg_buffer[80];
     snprintf(error_msg_buffer, sizeof(error_msg_buffer) - 1,
@@ -25,7 +25,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -49,6 +51,11 @@
 
 #if defined(ZSTD)
 #include <zstd.h>
+// Prepared dictionaries and dictionary training are stable since zstd 1.0.
+#if ZSTD_VERSION_NUMBER >= 10000
+#include <zdict.h>
+#define ROCKSDB_ZSTD_DICTIONARY
+#endif
 #endif
 
 namespace rocksdb {
@@ -88,6 +95,13 @@ inline bool ZSTD_Supported() {
   return false;
 }
 
+inline bool ZSTD_Dictionary_Supported() {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+  return true;
+#endif
+  return false;
+}
+
 inline bool CompressionTypeSupported(CompressionType compression_type) {
   switch (compression_type) {
     case kNoCompression:
@@ -102,6 +116,7 @@ inline bool CompressionTypeSupported(CompressionType compression_type) {
       return LZ4_Supported();
     case kLZ4HCCompression:
       return LZ4_Supported();
+    case kZSTD:
     case kZSTDNotFinalCompression:
       return ZSTD_Supported();
     default:
@@ -124,8 +139,10 @@ inline std::string CompressionTypeToString(CompressionType compression_type) {
       return "LZ4";
     case kLZ4HCCompression:
       return "LZ4HC";
-    case kZSTDNotFinalCompression:
+    case kZSTD:
       return "ZSTD";
+    case kZSTDNotFinalCompression:
+      return "ZSTDNotFinal";
     default:
       assert(false);
       return "";
@@ -189,8 +206,102 @@ inline bool GetDecompressedSizeInfo(const char** input_data,
   *input_data = new_input_data;
   return true;
 }
+
+// Level -1 means the default level of the codec, as it does for zlib.
+inline int ZSTD_Level(const CompressionOptions& opts) {
+  constexpr int kZSTDDefaultLevel = 3;
+  return opts.level < 0 ? kZSTDDefaultLevel : opts.level;
+}
+
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+// Contexts are reused by the thread, because their allocation is expensive compared to
+// compression of a single block.
+inline ZSTD_CCtx* ZSTD_ThreadLocalCCtx() {
+  struct Deleter {
+    void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+  };
+  static thread_local std::unique_ptr<ZSTD_CCtx, Deleter> ctx(ZSTD_createCCtx());
+  return ctx.get();
+}
+
+inline ZSTD_DCtx* ZSTD_ThreadLocalDCtx() {
+  struct Deleter {
+    void operator()(ZSTD_DCtx* ctx) const { ZSTD_freeDCtx(ctx); }
+  };
+  static thread_local std::unique_ptr<ZSTD_DCtx, Deleter> ctx(ZSTD_createDCtx());
+  return ctx.get();
+}
+#endif
+
 }  // namespace compression
 
+// Dictionary used to compress data blocks of an SST file, see
+// CompressionOptions::max_dict_bytes. It is digested once, instead of for every block.
+class CompressionDict {
+ public:
+  CompressionDict(std::string dict, const CompressionOptions& opts) : dict_(std::move(dict)) {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+    zstd_cdict_ = ZSTD_createCDict(dict_.data(), dict_.size(), compression::ZSTD_Level(opts));
+#endif
+  }
+
+  ~CompressionDict() {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+    ZSTD_freeCDict(zstd_cdict_);
+#endif
+  }
+
+  CompressionDict(const CompressionDict&) = delete;
+  void operator=(const CompressionDict&) = delete;
+
+  const std::string& data() const { return dict_; }
+
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+  const ZSTD_CDict* zstd_cdict() const { return zstd_cdict_; }
+#endif
+
+ private:
+  std::string dict_;
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+  ZSTD_CDict* zstd_cdict_ = nullptr;
+#endif
+};
+
+// Dictionary used to uncompress data blocks of an SST file, which were compressed with the
+// corresponding CompressionDict.
+class UncompressionDict {
+ public:
+  explicit UncompressionDict(std::string dict) : dict_(std::move(dict)) {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+    zstd_ddict_ = ZSTD_createDDict(dict_.data(), dict_.size());
+#endif
+  }
+
+  ~UncompressionDict() {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+    ZSTD_freeDDict(zstd_ddict_);
+#endif
+  }
+
+  UncompressionDict(const UncompressionDict&) = delete;
+  void operator=(const UncompressionDict&) = delete;
+
+  const std::string& data() const { return dict_; }
+
+  // Digested dictionary keeps its own copy of the dictionary contents.
+  size_t ApproximateMemoryUsage() const { return 2 * dict_.capacity(); }
+
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+  const ZSTD_DDict* zstd_ddict() const { return zstd_ddict_; }
+#endif
+
+ private:
+  std::string dict_;
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+  ZSTD_DDict* zstd_ddict_ = nullptr;
+#endif
+};
+
 // compress_format_version == 1 -- decompressed size is not included in the
 // block header
 // compress_format_version == 2 -- decompressed size is included in the block
@@ -620,8 +731,10 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+// Compresses input with the dictionary, when it is specified.
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const CompressionDict* dict = nullptr) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +746,20 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen;
+  if (dict == nullptr) {
+    outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
+                           input, length, compression::ZSTD_Level(opts));
+  } else {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+    outlen = ZSTD_compress_usingCDict(
+        compression::ZSTD_ThreadLocalCCtx(), &(*output)[output_header_len], compressBound,
+        input, length, dict->zstd_cdict());
+#else
+    return false;
+#endif
+  }
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -644,8 +768,11 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
   return false;
 }
 
+// Uncompresses input with the dictionary, when it is specified. Blocks compressed without
+// dictionary could be uncompressed with any dictionary.
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const UncompressionDict* dict = nullptr) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -654,8 +781,23 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   }
 
   char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
+  size_t actual_output_length;
+  if (dict == nullptr) {
+    actual_output_length = ZSTD_decompress(output, output_len, input_data, input_length);
+  } else {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+    actual_output_length = ZSTD_decompress_usingDDict(
+        compression::ZSTD_ThreadLocalDCtx(), output, output_len, input_data, input_length,
+        dict->zstd_ddict());
+#else
+    delete[] output;
+    return nullptr;
+#endif
+  }
+  if (ZSTD_isError(actual_output_length)) {
+    delete[] output;
+    return nullptr;
+  }
   assert(actual_output_length == output_len);
   *decompress_size = static_cast<int>(actual_output_length);
   return output;
@@ -663,4 +805,25 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   return nullptr;
 }
 
+// Trains dictionary of at most max_dict_bytes on the samples, which are concatenated in samples
+// and have lengths sample_lens. Returns empty string if dictionary could not be trained, e.g.
+// because there are too few samples.
+inline std::string ZSTD_TrainDictionary(const std::string& samples,
+                                        const std::vector<size_t>& sample_lens,
+                                        size_t max_dict_bytes) {
+#ifdef ROCKSDB_ZSTD_DICTIONARY
+  std::string dict(max_dict_bytes, '\0');
+  size_t dict_len = ZDICT_trainFromBuffer(
+      &dict[0], max_dict_bytes, samples.data(), sample_lens.data(),
+      static_cast<unsigned>(sample_lens.size()));
+  if (ZDICT_isError(dict_len)) {
+    return std::string();
+  }
+  assert(dict_len <= max_dict_bytes);
+  dict.resize(dict_len);
+  return dict;
+#endif
+  return std::string();
+}
+
 }  // namespace rocksdb
@@ -421,6 +421,26 @@ EnvOptions Env::OptimizeForManifestWrite(const EnvOptions& env_options) const {
   return env_options;
 }
 
+EnvOptions Env::OptimizeForCompactionTableWrite(const EnvOptions& env_options,
+                                                const DBOptions& db_options) const {
+  EnvOptions optimized_env_options(env_options);
+  if (db_options.use_direct_io_for_flush_and_compaction) {
+    optimized_env_options.use_direct_writes = true;
+    optimized_env_options.use_mmap_writes = false;
+  }
+  return optimized_env_options;
+}
+
+EnvOptions Env::OptimizeForCompactionTableRead(const EnvOptions& env_options,
+                                               const DBOptions& db_options) const {
+  EnvOptions optimized_env_options(env_options);
+  if (db_options.use_direct_io_for_flush_and_compaction) {
+    optimized_env_options.use_direct_reads = true;
+    optimized_env_options.use_mmap_reads = false;
+  }
+  return optimized_env_options;
+}
+
 EnvOptions::EnvOptions(const DBOptions& options) {
   AssignEnvOptions(this, options);
 }
@@ -613,13 +613,16 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd;
+    bool direct_io = options.use_direct_reads;
     {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_RDONLY);
+      fd = OpenWithDirectIOFallback(fname, O_RDONLY, 0, &direct_io);
     }
     SetFD_CLOEXEC(fd, &options);
     if (fd < 0) {
       s = STATUS_IO_ERROR(fname, errno);
+    } else if (direct_io) {
+      *result = std::make_unique<PosixDirectIORandomAccessFile>(fname, fd, options);
     } else if (options.use_mmap_reads && sizeof(void*) >= 8) {
       // Use of mmap for random reads has been removed because it
       // kills performance when storage is fast.
@@ -647,12 +650,16 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd = -1;
+    bool direct_io = options.use_direct_writes;
     do {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+      fd = OpenWithDirectIOFallback(fname, O_CREAT | O_RDWR | O_TRUNC, 0644, &direct_io);
     } while (fd < 0 && errno == EINTR);
     if (fd < 0) {
       s = STATUS_IO_ERROR(fname, errno);
+    } else if (direct_io) {
+      SetFD_CLOEXEC(fd, &options);
+      *result = std::make_unique<PosixWritableFile>(fname, fd, options);
     } else {
       SetFD_CLOEXEC(fd, &options);
       if (options.use_mmap_writes) {
@@ -668,9 +675,10 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
       if (options.use_mmap_writes && !forceMmapOff) {
         *result = std::make_unique<PosixMmapFile>(fname, fd, page_size_, options);
       } else {
-        // disable mmap writes
+        // disable mmap writes and direct I/O
         EnvOptions no_mmap_writes_options = options;
         no_mmap_writes_options.use_mmap_writes = false;
+        no_mmap_writes_options.use_direct_writes = false;
         *result = std::make_unique<PosixWritableFile>(fname, fd, no_mmap_writes_options);
       }
     }
@@ -711,9 +719,10 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
       if (options.use_mmap_writes && !forceMmapOff) {
         *result = std::make_unique<PosixMmapFile>(fname, fd, page_size_, options);
       } else {
-        // disable mmap writes
+        // disable mmap writes and direct I/O
         EnvOptions no_mmap_writes_options = options;
         no_mmap_writes_options.use_mmap_writes = false;
+        no_mmap_writes_options.use_direct_writes = false;
 
         *result = std::make_unique<PosixWritableFile>(fname, fd, no_mmap_writes_options);
       }
@@ -763,6 +772,22 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
 #endif
   }
 
+  // Opens the file with O_DIRECT when *direct_io is true. Falls back to buffered I/O and resets
+  // *direct_io if the file system does not support O_DIRECT.
+  static int OpenWithDirectIOFallback(
+      const std::string& fname, int flags, mode_t mode, bool* direct_io) {
+#if defined(__linux__)
+    if (*direct_io) {
+      int fd = open(fname.c_str(), flags | O_DIRECT, mode);
+      if (fd >= 0 || errno != EINVAL) {
+        return fd;
+      }
+      LOG(WARNING) << "O_DIRECT is not supported for " << fname << ", using buffered I/O";
+    }
+#endif
+    *direct_io = false;
+    return open(fname.c_str(), flags, mode);
+  }
 };
 
 PosixEnv::PosixEnv()
@@ -84,6 +84,23 @@ Status RandomAccessFileReader::ReadAndValidate(
   return s;
 }
 
+void RandomAccessFileReader::MultiRead(
+    yb::RandomAccessFile::ReadRequest* requests, size_t count) const {
+  uint64_t elapsed = 0;
+  {
+    StopWatch sw(env_, stats_, hist_type_,
+                 (stats_ != nullptr) ? &elapsed : nullptr);
+    IOSTATS_TIMER_GUARD(read_nanos);
+    file_->MultiRead(requests, count);
+    for (size_t i = 0; i != count; ++i) {
+      IOSTATS_ADD_IF_POSITIVE(bytes_read, requests[i].result.size());
+    }
+  }
+  if (stats_ != nullptr && file_read_hist_ != nullptr) {
+    file_read_hist_->Add(elapsed);
+  }
+}
+
 Status WritableFileWriter::Append(const Slice& data) {
   const char* src = data.cdata();
   size_t left = data.size();
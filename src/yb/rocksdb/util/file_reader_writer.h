@@ -111,6 +111,9 @@ class RandomAccessFileReader {
   CHECKED_STATUS ReadAndValidate(
       uint64_t offset, size_t n, Slice* result, char* scratch, const yb::ReadValidator& validator);
 
+  // Performs several reads at once, see yb::RandomAccessFile::MultiRead.
+  void MultiRead(yb::RandomAccessFile::ReadRequest* requests, size_t count) const;
+
   RandomAccessFile* file() { return file_.get(); }
 };
 
@@ -40,7 +40,12 @@
 #include <sys/statfs.h>
 #include <sys/syscall.h>
 #endif
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/util/aligned_buffer.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/posix_logger.h"
 #include "yb/rocksdb/util/sync_point.h"
@@ -51,8 +56,14 @@
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+DECLARE_int32(o_direct_block_alignment_bytes);
+
 namespace rocksdb {
 
+size_t DirectIOAlignment() {
+  return FLAGS_o_direct_block_alignment_bytes;
+}
+
 // A wrapper for fadvise, if the platform doesn't support fadvise,
 // it will simply return Status::NotSupport.
 int Fadvise(int fd, off_t offset, size_t len, int advice) {
@@ -63,6 +74,102 @@ int Fadvise(int fd, off_t offset, size_t len, int advice) {
 #endif
 }
 
+/*
+ * PosixDirectIORandomAccessFile
+ *
+ * pread() based random-access with O_DIRECT
+ */
+PosixDirectIORandomAccessFile::PosixDirectIORandomAccessFile(
+    const std::string& fname, int fd, const EnvOptions& options)
+    : filename_(fname), fd_(fd), alignment_(DirectIOAlignment()) {
+  assert(options.use_direct_reads);
+  assert(!options.use_mmap_reads);
+}
+
+PosixDirectIORandomAccessFile::~PosixDirectIORandomAccessFile() {
+  close(fd_);
+}
+
+Status PosixDirectIORandomAccessFile::ReadAligned(
+    uint64_t offset, size_t n, uint8_t* scratch, size_t* bytes_read) const {
+  size_t left = n;
+  while (left > 0) {
+    ssize_t r = pread(fd_, scratch, left, static_cast<off_t>(offset));
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      *bytes_read = n - left;
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    left -= r;
+    // A read that stops in the middle of a block reached the end of file, and could not be
+    // continued anyway, since the next offset is not aligned.
+    if (r == 0 || r % alignment_ != 0) {
+      break;
+    }
+    scratch += r;
+    offset += r;
+  }
+  *bytes_read = n - left;
+  return Status::OK();
+}
+
+Status PosixDirectIORandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
+                                           uint8_t* scratch) const {
+  const size_t mask = alignment_ - 1;
+  size_t bytes_read = 0;
+  if ((offset & mask) == 0 && (n & mask) == 0 &&
+      (reinterpret_cast<uintptr_t>(scratch) & mask) == 0) {
+    Status s = ReadAligned(offset, n, scratch, &bytes_read);
+    *result = Slice(scratch, s.ok() ? bytes_read : 0);
+    return s;
+  }
+
+  const uint64_t aligned_offset = offset & ~static_cast<uint64_t>(mask);
+  const size_t prefix = static_cast<size_t>(offset - aligned_offset);
+  AlignedBuffer buffer;
+  buffer.Alignment(alignment_);
+  buffer.AllocateNewBuffer(prefix + n);
+  Status s = ReadAligned(
+      aligned_offset, buffer.Capacity(), pointer_cast<uint8_t*>(buffer.Destination()),
+      &bytes_read);
+  if (!s.ok()) {
+    *result = Slice(scratch, static_cast<size_t>(0));
+    return s;
+  }
+  const size_t copied = bytes_read > prefix ? std::min(bytes_read - prefix, n) : 0;
+  memcpy(scratch, buffer.BufferStart() + prefix, copied);
+  *result = Slice(scratch, copied);
+  return Status::OK();
+}
+
+yb::Result<uint64_t> PosixDirectIORandomAccessFile::Size() const {
+  struct stat st;
+  if (fstat(fd_, &st) == -1) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return st.st_size;
+}
+
+yb::Result<uint64_t> PosixDirectIORandomAccessFile::INode() const {
+  struct stat st;
+  if (fstat(fd_, &st) == -1) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return st.st_ino;
+}
+
+size_t PosixDirectIORandomAccessFile::memory_footprint() const {
+  return malloc_usable_size(this) + filename_.capacity();
+}
+
+#ifdef __linux__
+size_t PosixDirectIORandomAccessFile::GetUniqueId(char* id) const {
+  return yb::GetUniqueIdFromFile(fd_, pointer_cast<uint8_t*>(id));
+}
+#endif
+
 /*
  * PosixMmapReadableFile
  *
@@ -357,7 +464,7 @@ Status PosixMmapFile::Allocate(uint64_t offset, uint64_t len) {
  */
 PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
                                      const EnvOptions& options)
-    : filename_(fname), fd_(fd), filesize_(0) {
+    : filename_(fname), fd_(fd), filesize_(0), use_direct_io_(options.use_direct_writes) {
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   allow_fallocate_ = options.allow_fallocate;
   fallocate_with_keep_size_ = options.fallocate_with_keep_size;
@@ -389,6 +496,44 @@ Status PosixWritableFile::Append(const Slice& data) {
   return Status::OK();
 }
 
+Status PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset) {
+  assert(use_direct_io_);
+  assert(offset <= std::numeric_limits<off_t>::max());
+  const char* src = data.cdata();
+  size_t left = data.size();
+  uint64_t write_offset = offset;
+  while (left != 0) {
+    ssize_t done = pwrite(fd_, src, left, static_cast<off_t>(write_offset));
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    left -= done;
+    src += done;
+    write_offset += done;
+  }
+  filesize_ = std::max(filesize_, offset + data.size());
+  return Status::OK();
+}
+
+Status PosixWritableFile::Truncate(uint64_t size) {
+  if (!use_direct_io_) {
+    return Status::OK();
+  }
+  // Cut off the padding of the last page.
+  if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  filesize_ = size;
+  return Status::OK();
+}
+
+size_t PosixWritableFile::GetRequiredBufferAlignment() const {
+  return use_direct_io_ ? DirectIOAlignment() : WritableFile::GetRequiredBufferAlignment();
+}
+
 Status PosixWritableFile::Close() {
   Status s;
 
@@ -41,11 +41,16 @@ namespace rocksdb {
 
 #define STATUS_IO_ERROR(context, err_number) STATUS(IOError, (context), strerror(err_number))
 
+// Alignment of offsets, sizes and buffers of I/O on files opened with O_DIRECT.
+size_t DirectIOAlignment();
+
 class PosixWritableFile : public WritableFile {
  private:
   const std::string filename_;
   int fd_;
   uint64_t filesize_;
+  // The file was opened with O_DIRECT, so only aligned positioned writes are allowed.
+  const bool use_direct_io_;
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   bool allow_fallocate_;
   bool fallocate_with_keep_size_;
@@ -56,11 +61,16 @@ class PosixWritableFile : public WritableFile {
                     const EnvOptions& options);
   ~PosixWritableFile();
 
+  bool UseOSBuffer() const override { return !use_direct_io_; }
+  size_t GetRequiredBufferAlignment() const override;
+
   // Means Close() will properly take care of truncate
-  // and it does not need any additional information
-  virtual Status Truncate(uint64_t size) override { return Status::OK(); }
+  // and it does not need any additional information, unless the file is written with direct I/O,
+  // in which case the last page is padded.
+  virtual Status Truncate(uint64_t size) override;
   virtual Status Close() override;
   virtual Status Append(const Slice& data) override;
+  virtual Status PositionedAppend(const Slice& data, uint64_t offset) override;
   virtual Status Flush() override;
   virtual Status Sync() override;
   virtual Status Fsync() override;
@@ -74,6 +84,31 @@ class PosixWritableFile : public WritableFile {
 #endif
 };
 
+// pread() based random-access file opened with O_DIRECT. Reads are extended to the direct I/O
+// alignment and go through an aligned buffer, unless they are aligned already.
+class PosixDirectIORandomAccessFile : public RandomAccessFile {
+ public:
+  PosixDirectIORandomAccessFile(const std::string& fname, int fd, const EnvOptions& options);
+  ~PosixDirectIORandomAccessFile();
+
+  CHECKED_STATUS Read(uint64_t offset, size_t n, Slice* result, uint8_t* scratch) const override;
+  yb::Result<uint64_t> Size() const override;
+  yb::Result<uint64_t> INode() const override;
+  size_t memory_footprint() const override;
+  const std::string& filename() const override { return filename_; }
+#ifdef __linux__
+  size_t GetUniqueId(char* id) const override;
+#endif
+
+ private:
+  // Reads [offset, offset + n) with offset, n and scratch aligned. Stops at the end of file.
+  CHECKED_STATUS ReadAligned(uint64_t offset, size_t n, uint8_t* scratch, size_t* bytes_read) const;
+
+  std::string filename_;
+  int fd_;
+  const size_t alignment_;
+};
+
 class PosixMmapReadableFile : public RandomAccessFile {
  private:
   int fd_;
@@ -1659,6 +1659,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "max_total_wal_size=4295005604;"
       "compaction_readahead_size=0;"
       "new_table_reader_for_compaction_inputs=true;"
+      "use_direct_io_for_flush_and_compaction=true;"
       "keep_log_file_num=4890;"
       "skip_stats_update_on_db_open=true;"
       "max_manifest_file_size=4295009941;"
@@ -80,6 +80,10 @@ class StackableDB : public DB {
     return db_->MultiGet(options, column_family, keys, values);
   }
 
+  void PrefetchKeys(const ReadOptions& options, const std::vector<Slice>& keys) override {
+    db_->PrefetchKeys(options, keys);
+  }
+
   using DB::AddFile;
   virtual Status AddFile(ColumnFamilyHandle* column_family,
                          const ExternalSstFileInfo* file_info,
@@ -135,7 +135,11 @@ class RocksDBEncryptedFileFactory : public rocksdb::RocksDBFileFactoryWrapper {
   Status NewWritableFile(const std::string& fname, std::unique_ptr<rocksdb::WritableFile>* result,
                          const rocksdb::EnvOptions& options) override {
     std::unique_ptr<rocksdb::WritableFile> underlying;
-    RETURN_NOT_OK(RocksDBFileFactoryWrapper::NewWritableFile(fname, &underlying, options));
+    // Encrypted data is appended at arbitrary offsets, so it cannot be written with direct I/O.
+    rocksdb::EnvOptions underlying_options = options;
+    underlying_options.use_direct_writes = false;
+    RETURN_NOT_OK(RocksDBFileFactoryWrapper::NewWritableFile(
+        fname, &underlying, underlying_options));
     return RocksDBEncryptedWritableFile::Create(
         result, header_manager_.get(), std::move(underlying));
   }
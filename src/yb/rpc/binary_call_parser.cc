@@ -15,12 +15,14 @@
 
 #include "yb/gutil/endian.h"
 
+#include "yb/rpc/circular_read_buffer.h"
 #include "yb/rpc/connection.h"
 #include "yb/rpc/stream.h"
 
 #include "yb/util/logging.h"
 #include "yb/util/size_literals.h"
 
+using yb::operator"" _KB;
 using yb::operator"" _MB;
 
 DEFINE_bool(
@@ -32,6 +34,14 @@ DEFINE_int32(
     "Throttle inbound RPC calls larger than specified size on hitting mem tracker soft limit. "
     "Throttling is disabled if negative value is specified.");
 
+DEFINE_uint64(
+    rpc_zero_copy_min_call_size_bytes, 64_KB,
+    "Minimal size of an inbound call, that is referenced in the receive buffer instead of being "
+    "copied out of it. While referenced, the receive buffer is not reused for further reads, so "
+    "smaller calls are cheaper to copy. 0 to always copy.");
+TAG_FLAG(rpc_zero_copy_min_call_size_bytes, advanced);
+TAG_FLAG(rpc_zero_copy_min_call_size_bytes, runtime);
+
 DECLARE_int32(memory_limit_warn_threshold_percentage);
 
 namespace yb {
@@ -47,13 +57,14 @@ bool ShouldThrottleRpc(
 BinaryCallParser::BinaryCallParser(
     const MemTrackerPtr& parent_tracker, size_t header_size, size_t size_offset,
     size_t max_message_length, IncludeHeader include_header, SkipEmptyMessages skip_empty_messages,
-    BinaryCallParserListener* listener)
+    BinaryCallParserListener* listener, CircularReadBuffer* read_buffer)
     : call_header_buffer_(header_size),
       size_offset_(size_offset),
       max_message_length_(max_message_length),
       include_header_(include_header),
       skip_empty_messages_(skip_empty_messages),
-      listener_(listener) {
+      listener_(listener),
+      read_buffer_(read_buffer) {
   buffer_tracker_ = MemTracker::FindOrCreateTracker("Reading", parent_tracker);
 }
 
@@ -149,8 +160,8 @@ Result<ProcessDataResult> BinaryCallParser::Parse(
     // connections, don't confuse with RAFT heartbeats which are higher level non-empty messages).
     if (!skip_empty_messages_ || data_length > 0) {
       connection->UpdateLastActivity();
-      CallData call_data(call_data_size);
-      IoVecsToBuffer(data, consumed + body_offset, consumed + total_length, call_data.data());
+      CallData call_data = ExtractCallData(
+          connection, data, consumed + body_offset, consumed + total_length);
       RETURN_NOT_OK(listener_->HandleCall(connection, &call_data));
     }
 
@@ -160,5 +171,37 @@ Result<ProcessDataResult> BinaryCallParser::Parse(
   return ProcessDataResult{ consumed, Slice() };
 }
 
+CallData BinaryCallParser::ExtractCallData(
+    const ConnectionPtr& connection, const IoVecs& data, size_t begin, size_t end) {
+  const size_t size = end - begin;
+  const auto min_zero_copy_size = FLAGS_rpc_zero_copy_min_call_size_bytes;
+  if (read_buffer_ && min_zero_copy_size && size >= min_zero_copy_size) {
+    // The call could be referenced only when it does not wrap around the end of the receive
+    // buffer, i.e. it is contained in a single iovec.
+    size_t offset = begin;
+    for (const auto& io_vec : data) {
+      if (offset < io_vec.iov_len) {
+        if (offset + size <= io_vec.iov_len) {
+          auto* start = static_cast<char*>(io_vec.iov_base) + offset;
+          auto holder = read_buffer_->Share(start, size);
+          if (holder) {
+            auto& counter = connection->rpc_metrics().inbound_calls_zero_copy;
+            if (counter) {
+              counter->Increment();
+            }
+            return CallData(std::move(holder), start, size);
+          }
+        }
+        break;
+      }
+      offset -= io_vec.iov_len;
+    }
+  }
+
+  CallData call_data(size);
+  IoVecsToBuffer(data, begin, end, call_data.data());
+  return call_data;
+}
+
 } // namespace rpc
 } // namespace yb
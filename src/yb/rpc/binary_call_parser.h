@@ -38,10 +38,13 @@ class BinaryCallParserListener {
 // Utility class to parse binary calls with fixed length header.
 class BinaryCallParser {
  public:
+  // When read_buffer is not nullptr, large calls that are received into it without wrapping around
+  // are passed to the listener as references to the buffer, instead of copies.
   explicit BinaryCallParser(const MemTrackerPtr& parent_tracker,
                             size_t header_size, size_t size_offset, size_t max_message_length,
                             IncludeHeader include_header, SkipEmptyMessages skip_empty_messages,
-                            BinaryCallParserListener* listener);
+                            BinaryCallParserListener* listener,
+                            CircularReadBuffer* read_buffer = nullptr);
 
   // If tracker_for_throttle is not nullptr - throttle big requests when tracker_for_throttle
   // (or any of its ancestors) exceeds soft memory limit.
@@ -50,6 +53,10 @@ class BinaryCallParser {
                                   const MemTrackerPtr* tracker_for_throttle);
 
  private:
+  // Returns data of the complete call at [begin, end) of data.
+  CallData ExtractCallData(
+      const ConnectionPtr& connection, const IoVecs& data, size_t begin, size_t end);
+
   MemTrackerPtr buffer_tracker_;
   std::vector<char> call_header_buffer_;
   ScopedTrackedConsumption call_data_consumption_;
@@ -59,6 +66,7 @@ class BinaryCallParser {
   const IncludeHeader include_header_;
   const SkipEmptyMessages skip_empty_messages_;
   BinaryCallParserListener* const listener_;
+  CircularReadBuffer* const read_buffer_;
 };
 
 // Returns whether we should throttle RPC call based on its size and memory consumption.
@@ -14,6 +14,10 @@
 #ifndef YB_RPC_CALL_DATA_H
 #define YB_RPC_CALL_DATA_H
 
+#include <memory>
+
+#include "yb/util/strongly_typed_bool.h"
+
 namespace yb {
 namespace rpc {
 
@@ -26,10 +30,16 @@ struct CallData {
   explicit CallData(size_t size, ShouldReject should_reject = ShouldReject::kFalse)
       : data_(!should_reject && size ? static_cast<char*>(malloc(size)) : nullptr), size_(size) {}
 
+  // Call data that references size bytes at data, which are kept alive by holder, instead of
+  // owning a copy of them.
+  CallData(std::shared_ptr<void> holder, char* data, size_t size)
+      : data_(data), size_(size), holder_(std::move(holder)) {}
+
   CallData(const CallData&) = delete;
   void operator=(const CallData&) = delete;
 
-  CallData(CallData&& rhs) : data_(rhs.data_), size_(rhs.size_) {
+  CallData(CallData&& rhs)
+      : data_(rhs.data_), size_(rhs.size_), holder_(std::move(rhs.holder_)) {
     rhs.data_ = nullptr;
     rhs.size_ = 0;
   }
@@ -38,6 +48,7 @@ struct CallData {
     Reset();
     std::swap(data_, rhs.data_);
     std::swap(size_, rhs.size_);
+    holder_ = std::move(rhs.holder_);
     return *this;
   }
 
@@ -46,7 +57,9 @@ struct CallData {
   }
 
   void Reset() {
-    if (data_) {
+    if (holder_) {
+      holder_.reset();
+    } else if (data_) {
       free(data_);
     }
     size_ = 0;
@@ -72,6 +85,8 @@ struct CallData {
  private:
   char* data_;
   size_t size_;
+  // Keeps data_ alive, when the call data is not owned.
+  std::shared_ptr<void> holder_;
 };
 
 } // namespace rpc
@@ -16,10 +16,31 @@
 namespace yb {
 namespace rpc {
 
+// Buffer memory, that is charged to the receive memory tracker while the buffer is alive.
+class CircularReadBuffer::Storage {
+ public:
+  Storage(const MemTrackerPtr& tracker, size_t capacity)
+      : consumption_(tracker, capacity), data_(static_cast<char*>(malloc(capacity))) {
+  }
+
+  ~Storage() {
+    free(data_);
+  }
+
+  char* data() const {
+    return data_;
+  }
+
+ private:
+  ScopedTrackedConsumption consumption_;
+  char* const data_;
+};
+
 CircularReadBuffer::CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker)
-    : consumption_(MemTracker::FindOrCreateTracker("Receive", parent_tracker, AddToParent::kFalse),
-                   capacity),
-      buffer_(static_cast<char*>(malloc(capacity))), capacity_(capacity) {
+    : tracker_(MemTracker::FindOrCreateTracker("Receive", parent_tracker, AddToParent::kFalse)),
+      storage_(std::make_shared<Storage>(tracker_, capacity)),
+      buffer_(storage_->data()),
+      capacity_(capacity) {
 }
 
 bool CircularReadBuffer::Empty() {
@@ -27,7 +48,8 @@ bool CircularReadBuffer::Empty() {
 }
 
 void CircularReadBuffer::Reset() {
-  buffer_.reset();
+  storage_.reset();
+  buffer_ = nullptr;
 }
 
 Result<IoVecs> CircularReadBuffer::PrepareAppend() {
@@ -35,6 +57,13 @@ Result<IoVecs> CircularReadBuffer::PrepareAppend() {
     return STATUS(IllegalState, "Read buffer was reset");
   }
 
+  if (shared_) {
+    shared_ = false;
+    if (storage_.use_count() != 1) {
+      Relocate();
+    }
+  }
+
   IoVecs result;
 
   if (!prepend_.empty()) {
@@ -43,11 +72,11 @@ Result<IoVecs> CircularReadBuffer::PrepareAppend() {
 
   size_t end = pos_ + size_;
   if (end < capacity_) {
-    result.push_back(iovec{buffer_.get() + end, capacity_ - end});
+    result.push_back(iovec{buffer_ + end, capacity_ - end});
   }
   size_t start = end <= capacity_ ? 0 : end - capacity_;
   if (pos_ > start) {
-    result.push_back(iovec{buffer_.get() + start, pos_ - start});
+    result.push_back(iovec{buffer_ + start, pos_ - start});
   }
 
   if (result.empty()) {
@@ -76,10 +105,10 @@ IoVecs CircularReadBuffer::AppendedVecs() {
 
   size_t end = pos_ + size_;
   if (end <= capacity_) {
-    result.push_back(iovec{buffer_.get() + pos_, size_});
+    result.push_back(iovec{buffer_ + pos_, size_});
   } else {
-    result.push_back(iovec{buffer_.get() + pos_, capacity_ - pos_});
-    result.push_back(iovec{buffer_.get(), end - capacity_});
+    result.push_back(iovec{buffer_ + pos_, capacity_ - pos_});
+    result.push_back(iovec{buffer_, end - capacity_});
   }
 
   return result;
@@ -107,5 +136,24 @@ bool CircularReadBuffer::ReadyToRead() {
   return prepend_.empty() && (had_prepend_ || !Empty());
 }
 
+std::shared_ptr<void> CircularReadBuffer::Share(const char* data, size_t size) {
+  if (!buffer_ || data < buffer_ || data + size > buffer_ + capacity_) {
+    return nullptr;
+  }
+  shared_ = true;
+  return storage_;
+}
+
+void CircularReadBuffer::Relocate() {
+  // The old storage stays charged to the memory tracker until the last reference is released.
+  auto new_storage = std::make_shared<Storage>(tracker_, capacity_);
+  if (size_) {
+    IoVecsToBuffer(AppendedVecs(), 0, size_, new_storage->data());
+  }
+  storage_ = std::move(new_storage);
+  buffer_ = storage_->data();
+  pos_ = 0;
+}
+
 } // namespace rpc
 } // namespace yb
@@ -14,6 +14,8 @@
 #ifndef YB_RPC_CIRCULAR_READ_BUFFER_H
 #define YB_RPC_CIRCULAR_READ_BUFFER_H
 
+#include <memory>
+
 #include "yb/rpc/stream.h"
 
 #include "yb/util/mem_tracker.h"
@@ -21,12 +23,6 @@
 namespace yb {
 namespace rpc {
 
-struct FreeMemory {
-  void operator()(void* data) const {
-    free(data);
-  }
-};
-
 // StreamReadBuffer implementation that is based on circular buffer of fixed capacity.
 class CircularReadBuffer : public StreamReadBuffer {
  public:
@@ -42,9 +38,23 @@ class CircularReadBuffer : public StreamReadBuffer {
   bool Full() override;
   void Consume(size_t count, const Slice& prepend) override;
 
+  // Returns an owner of the buffer memory, so appended data at [data, data + size) could be used
+  // after it is consumed without copying. Returns nullptr if the data is not in the buffer.
+  // Once the buffer is shared, new data is never appended into it: the next PrepareAppend moves not
+  // consumed data to a new buffer, unless all references are gone. Shared memory stays charged to
+  // the receive memory tracker until the last reference is released.
+  std::shared_ptr<void> Share(const char* data, size_t size);
+
  private:
-  ScopedTrackedConsumption consumption_;
-  std::unique_ptr<char, FreeMemory> buffer_;
+  class Storage;
+
+  // Moves not consumed data to the beginning of a new buffer.
+  void Relocate();
+
+  MemTrackerPtr tracker_;
+  std::shared_ptr<Storage> storage_;
+  char* buffer_;
+  bool shared_ = false;
   const size_t capacity_;
   size_t pos_ = 0;
   size_t size_ = 0;
@@ -207,7 +207,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // Also can be configured to log _all_ RPC traces for help debugging.
   virtual void LogTrace() const = 0;
 
-  void QueueResponse(bool is_success);
+  virtual void QueueResponse(bool is_success);
 
   // The serialized bytes of the request param protobuf. Set by ParseFrom().
   // This references memory held by 'request_data_'.
@@ -59,6 +59,7 @@
 #include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/rpc_service.h"
 #include "yb/rpc/rpc_util.h"
+#include "yb/rpc/shared_memory_channel.h"
 #include "yb/rpc/tcp_stream.h"
 #include "yb/rpc/yb_rpc.h"
 
@@ -71,6 +72,7 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
+#include "yb/util/thread.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
@@ -84,6 +86,7 @@ using std::shared_ptr;
 using strings::Substitute;
 
 DECLARE_int32(num_connections_to_server);
+DECLARE_bool(rpc_thread_per_core);
 DEFINE_int32(rpc_default_keepalive_time_ms, 65000,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -103,6 +106,28 @@ namespace rpc {
 class Messenger;
 class ServerBuilder;
 
+namespace {
+
+// Assigns CPUs to reactors in thread per core mode. Each messenger continues from the CPU after the
+// last one used by the previous messenger, so reactors of all messengers are spread over the CPUs
+// available to the process.
+std::vector<int> ReactorCpus(int num_reactors) {
+  std::vector<int> result;
+  if (!FLAGS_rpc_thread_per_core) {
+    return result;
+  }
+  static std::atomic<size_t> next_cpu_index{0};
+  const auto cpus = GetAffinityCpus();
+  const auto start = next_cpu_index.fetch_add(num_reactors);
+  result.reserve(num_reactors);
+  for (int i = 0; i != num_reactors; ++i) {
+    result.push_back(cpus[(start + i) % cpus.size()]);
+  }
+  return result;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // MessengerBuilder
 // ------------------------------------------------------------------------------------------------
@@ -204,6 +229,11 @@ void Messenger::Shutdown() {
     acceptor->Shutdown();
   }
 
+  auto* shared_memory_client = shared_memory_client_.get();
+  if (shared_memory_client) {
+    shared_memory_client->Shutdown();
+  }
+
   for (auto* reactor : reactors) {
     reactor->Shutdown();
   }
@@ -365,13 +395,37 @@ Status Messenger::TEST_GetReactorMetrics(size_t reactor_idx, ReactorMetrics* met
 
 void Messenger::ShutdownAcceptor() {
   std::unique_ptr<Acceptor> acceptor;
+  std::unique_ptr<SharedMemoryServer> shared_memory_server;
   {
     std::lock_guard<percpu_rwlock> guard(lock_);
     acceptor.swap(acceptor_);
+    shared_memory_server.swap(shared_memory_server_);
   }
   if (acceptor) {
     acceptor->Shutdown();
   }
+  if (shared_memory_server) {
+    shared_memory_server->Shutdown();
+  }
+}
+
+Result<int> Messenger::ListenSharedMemory(size_t num_channels, const std::string& server_uuid) {
+  std::lock_guard<percpu_rwlock> guard(lock_);
+  if (closing_) {
+    return STATUS(ServiceUnavailable, "Messenger is closing");
+  }
+  if (!shared_memory_server_) {
+    shared_memory_server_ = VERIFY_RESULT(SharedMemoryServer::Create(
+        this, num_channels, server_uuid));
+  }
+  return shared_memory_server_->fd();
+}
+
+Status Messenger::ConnectSharedMemory(int fd) {
+  auto client = VERIFY_RESULT(SharedMemoryClient::Connect(fd));
+  LOG(INFO) << name_ << ": connected shared memory channel to server " << client->server_uuid();
+  shared_memory_client_.reset(client.release());
+  return Status::OK();
 }
 
 rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
@@ -389,8 +443,12 @@ rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
         return *high_priority_thread_pool;
       }
       const ThreadPoolOptions& options = normal_thread_pool_->options();
-      high_priority_thread_pool_.reset(new rpc::ThreadPool(
-          name_ + "-high-pri", options.queue_limit, options.max_workers));
+      high_priority_thread_pool = new rpc::ThreadPool(
+          name_ + "-high-pri", options.queue_limit, options.max_workers, options.cpus);
+      if (metric_entity_) {
+        high_priority_thread_pool->InstantiateMetrics(metric_entity_);
+      }
+      high_priority_thread_pool_.reset(high_priority_thread_pool);
       return *high_priority_thread_pool_.get();
   }
   FATAL_INVALID_ENUM_VALUE(ServicePriority, priority);
@@ -489,6 +547,18 @@ void Messenger::QueueOutboundCall(OutboundCallPtr call) {
   reactor->QueueOutboundCall(std::move(call));
 }
 
+void Messenger::RegisterSharedMemoryRemote(const std::string& server_uuid, const HostPort& remote) {
+  auto* client = shared_memory_client_.get();
+  if (client) {
+    client->AddRemote(server_uuid, remote);
+  }
+}
+
+bool Messenger::QueueSharedMemoryCall(const HostPort& remote, const OutboundCallPtr& call) {
+  auto* client = shared_memory_client_.get();
+  return client && client->Serves(remote) && client->Send(call);
+}
+
 void Messenger::QueueInboundCall(InboundCallPtr call) {
   auto service = rpc_service(call->service_name());
   if (PREDICT_FALSE(!service)) {
@@ -558,13 +628,18 @@ Messenger::Messenger(const MessengerBuilder &bld)
       metric_entity_(bld.metric_entity_),
       io_thread_pool_(name_, FLAGS_io_thread_pool_size),
       scheduler_(&io_thread_pool_.io_service()),
-      normal_thread_pool_(new rpc::ThreadPool(name_, bld.queue_limit_, bld.workers_limit_)),
+      reactor_cpus_(ReactorCpus(bld.num_reactors_)),
+      normal_thread_pool_(new rpc::ThreadPool(
+          name_, bld.queue_limit_, bld.workers_limit_)),
       rpc_metrics_(new RpcMetrics(bld.metric_entity_)),
       num_connections_to_server_(bld.num_connections_to_server_) {
 #ifndef NDEBUG
   creation_stack_trace_.Collect(/* skip_frames */ 1);
 #endif
   VLOG(1) << "Messenger constructor for " << this << " called at:\n" << GetStackTrace();
+  if (metric_entity_) {
+    normal_thread_pool_->InstantiateMetrics(metric_entity_);
+  }
   for (int i = 0; i < bld.num_reactors_; i++) {
     reactors_.emplace_back(std::make_unique<Reactor>(this, i, bld));
   }
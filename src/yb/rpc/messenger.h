@@ -201,6 +201,20 @@ class Messenger : public ProxyContext {
   // Start accepting connections.
   CHECKED_STATUS StartAcceptor();
 
+  // Start accepting calls from local processes through shared memory channels. Returns file
+  // descriptor of the shared memory segment, that should be passed to those processes.
+  // server_uuid identifies this server to the clients of the segment.
+  Result<int> ListenSharedMemory(size_t num_channels, const std::string& server_uuid);
+
+  // Claims a shared memory channel of the segment created by ListenSharedMemory of a local
+  // server. Calls are sent through it to the addresses registered by RegisterSharedMemoryRemote.
+  CHECKED_STATUS ConnectSharedMemory(int fd);
+
+  // Notifies that the server with the specified uuid is reachable at remote. If it is the server
+  // of the connected shared memory channel, calls to remote are sent through the channel. So the
+  // local server is recognized by its identity, not by the address that it is bound to.
+  void RegisterSharedMemoryRemote(const std::string& server_uuid, const HostPort& remote);
+
   // Register a new RpcService to handle inbound requests.
   CHECKED_STATUS RegisterService(const std::string& service_name,
                          const scoped_refptr<RpcService>& service);
@@ -216,6 +230,8 @@ class Messenger : public ProxyContext {
   // that reactor to assign and send the call.
   void QueueOutboundCall(OutboundCallPtr call) override;
 
+  bool QueueSharedMemoryCall(const HostPort& remote, const OutboundCallPtr& call) override;
+
   // Enqueue a call for processing on the server.
   void QueueInboundCall(InboundCallPtr call) override;
 
@@ -280,6 +296,12 @@ class Messenger : public ProxyContext {
 
   rpc::ThreadPool& ThreadPool(ServicePriority priority = ServicePriority::kNormal);
 
+  // CPUs that reactor threads are pinned to, indexed by reactor. Empty when thread per core mode
+  // is disabled.
+  const std::vector<int>& reactor_cpus() const {
+    return reactor_cpus_;
+  }
+
   RpcMetrics& rpc_metrics() override {
     return *rpc_metrics_;
   }
@@ -342,6 +364,12 @@ class Messenger : public ProxyContext {
 
   // Acceptor which is listening on behalf of this messenger.
   std::unique_ptr<Acceptor> acceptor_;
+
+  // Serves calls of local processes through shared memory.
+  std::unique_ptr<SharedMemoryServer> shared_memory_server_;
+
+  // Sends calls to the local server through shared memory.
+  AtomicUniquePtr<SharedMemoryClient> shared_memory_client_;
   IpAddress outbound_address_v4_;
   IpAddress outbound_address_v6_;
 
@@ -363,6 +391,8 @@ class Messenger : public ProxyContext {
   IoThreadPool io_thread_pool_;
   Scheduler scheduler_;
 
+  const std::vector<int> reactor_cpus_;
+
   // Thread pools that are used by services running in this messenger.
   std::unique_ptr<rpc::ThreadPool> normal_thread_pool_;
 
@@ -196,6 +196,9 @@ OutboundCall::OutboundCall(const RemoteMethod* remote_method,
       remote_method_(remote_method),
       callback_(std::move(callback)),
       callback_thread_pool_(callback_thread_pool),
+      callback_priority_(
+          controller->invoke_callback_mode() == InvokeCallbackMode::kHighPriorityThreadPool
+              ? ServicePriority::kHigh : ServicePriority::kNormal),
       trace_(new Trace),
       outbound_call_metrics_(outbound_call_metrics),
       remote_method_pool_(RemoteMethodsCache::Instance().Find(*remote_method_)),
@@ -366,7 +369,7 @@ bool OutboundCall::SetState(State new_state) {
 void OutboundCall::InvokeCallback() {
   if (callback_thread_pool_) {
     callback_task_.SetOutboundCall(shared_from(this));
-    callback_thread_pool_->Enqueue(&callback_task_);
+    callback_thread_pool_->Enqueue(&callback_task_, callback_priority_);
     TRACE_TO(trace_, "Callback called asynchronously.");
   } else {
     InvokeCallbackSync();
@@ -377,6 +377,9 @@ class OutboundCall : public RpcCall {
 
   ThreadPool* callback_thread_pool_;
 
+  // Priority of the callback task in callback_thread_pool_.
+  const ServicePriority callback_priority_;
+
   // Buffers for storing segments of the wire-format request.
   RefCntBuffer buffer_;
 
@@ -130,6 +130,7 @@ ThreadPool* Proxy::GetCallbackThreadPool(
       return nullptr;
       break;
     case InvokeCallbackMode::kThreadPool:
+    case InvokeCallbackMode::kHighPriorityThreadPool:
       return &context_->CallbackThreadPool();
   }
   FATAL_INVALID_ENUM_VALUE(InvokeCallbackMode, invoke_callback_mode);
@@ -275,6 +276,9 @@ void Proxy::QueueCall(RpcController* controller, const Endpoint& endpoint) {
   uint8_t idx = num_calls_.fetch_add(1) % num_connections_to_server_;
   ConnectionId conn_id(endpoint, idx, protocol_);
   controller->call_->SetConnectionId(conn_id, &remote_.host());
+  if (context_->QueueSharedMemoryCall(remote_, controller->call_)) {
+    return;
+  }
   context_->QueueOutboundCall(controller->call_);
 }
 
@@ -71,6 +71,10 @@ class ProxyContext {
   // that reactor to assign and send the call.
   virtual void QueueOutboundCall(OutboundCallPtr call) = 0;
 
+  // Send a call through the shared memory channel to the server reachable at remote, if such
+  // channel exists. Returns false if the call should be sent over the network.
+  virtual bool QueueSharedMemoryCall(const HostPort& remote, const OutboundCallPtr& call) = 0;
+
   // Enqueue a call for processing on the server.
   virtual void QueueInboundCall(InboundCallPtr call) = 0;
 
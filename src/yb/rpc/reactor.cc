@@ -121,6 +121,7 @@ Reactor::Reactor(Messenger* messenger,
                  int index,
                  const MessengerBuilder &bld)
     : messenger_(messenger),
+      index_(index),
       name_(StringPrintf("%s_R%03d", messenger->name().c_str(), index)),
       log_prefix_(name_ + ": "),
       loop_(kDefaultLibEvFlags),
@@ -478,6 +479,14 @@ void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
+  const auto& cpus = messenger_->reactor_cpus();
+  if (!cpus.empty()) {
+    // Calls received by this reactor are queued to the thread pool lane of its CPU.
+    const int cpu = cpus[index_];
+    auto status = PinCurrentThreadToCpu(cpu);
+    LOG_IF_WITH_PREFIX(WARNING, !status.ok())
+        << "Failed to pin reactor to CPU " << cpu << ": " << status;
+  }
   loop_.run(/* flags */ 0);
   VLOG_WITH_PREFIX(1) << "thread exiting.";
 }
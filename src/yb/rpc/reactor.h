@@ -424,6 +424,9 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  // Index of this reactor in the messenger, also used to choose the CPU to pin its thread to.
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
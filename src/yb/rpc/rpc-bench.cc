@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <chrono>
 #include <string>
 #include <thread>
 
@@ -37,6 +38,7 @@
 
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rtest.proxy.h"
+#include "yb/rpc/thread_pool.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/test_util.h"
 
@@ -149,6 +151,132 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+namespace {
+
+// Task that enqueues the next task of its chain to the same pool, like RPC handlers that continue
+// processing in a separate task.
+class ChainTask : public ThreadPoolTask {
+ public:
+  void Init(ThreadPool* pool, ChainTask* next, CountDownLatch* latch) {
+    pool_ = pool;
+    next_ = next;
+    latch_ = latch;
+  }
+
+  void Run() override {
+    if (next_) {
+      pool_->Enqueue(next_);
+    }
+  }
+
+  void Done(const Status& status) override {
+    latch_->CountDown();
+  }
+
+  virtual ~ChainTask() {}
+
+ private:
+  ThreadPool* pool_ = nullptr;
+  ChainTask* next_ = nullptr;
+  CountDownLatch* latch_ = nullptr;
+};
+
+// High priority task that measures time it spent in the queue.
+class LatencyTask : public ThreadPoolTask {
+ public:
+  void Start(ThreadPool* pool) {
+    latch_.Reset(1);
+    start_ = std::chrono::steady_clock::now();
+    pool->Enqueue(this, ServicePriority::kHigh);
+  }
+
+  void Run() override {
+    latency_ = std::chrono::steady_clock::now() - start_;
+  }
+
+  void Done(const Status& status) override {
+    latch_.CountDown();
+  }
+
+  std::chrono::steady_clock::duration Wait() {
+    latch_.Wait();
+    return latency_;
+  }
+
+  virtual ~LatencyTask() {}
+
+ private:
+  // Coarse clock granularity is a few milliseconds, that is much more than the measured latency.
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration latency_;
+  CountDownLatch latch_{0};
+};
+
+} // namespace
+
+// Measures throughput of the thread pool, when it is loaded with tasks that enqueue continuations,
+// and queueing latency of high priority tasks under this load.
+TEST_F(RpcBench, BenchmarkThreadPool) {
+  constexpr size_t kWorkers = 16;
+  constexpr size_t kChains = 256;
+  constexpr size_t kChainLength = 4;
+#if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
+  constexpr int kNumProducers = 2;
+#else
+  constexpr int kNumProducers = 8;
+#endif
+
+  ThreadPool pool("bench", kChains * kChainLength * kNumProducers, kWorkers);
+  std::atomic<bool> stop(false);
+  std::atomic<size_t> total_tasks(0);
+  std::vector<std::thread> producers;
+  for (int i = 0; i != kNumProducers; ++i) {
+    producers.emplace_back([&pool, &stop, &total_tasks] {
+      CDSAttacher attacher;
+      std::vector<ChainTask> tasks(kChains * kChainLength);
+      while (!stop.load(std::memory_order_acquire)) {
+        CountDownLatch latch(tasks.size());
+        for (size_t j = 0; j != tasks.size(); ++j) {
+          auto next = (j + 1) % kChainLength == 0 ? nullptr : &tasks[j + 1];
+          tasks[j].Init(&pool, next, &latch);
+        }
+        for (size_t j = 0; j != kChains; ++j) {
+          pool.Enqueue(&tasks[j * kChainLength]);
+        }
+        latch.Wait();
+        total_tasks += tasks.size();
+      }
+    });
+  }
+
+  Stopwatch sw(Stopwatch::ALL_THREADS);
+  sw.start();
+  LatencyTask latency_task;
+  std::chrono::steady_clock::duration total_latency = std::chrono::steady_clock::duration::zero();
+  std::chrono::steady_clock::duration max_latency = std::chrono::steady_clock::duration::zero();
+  size_t latency_samples = 0;
+  auto deadline = CoarseMonoClock::Now() + 10s;
+  while (CoarseMonoClock::Now() < deadline) {
+    latency_task.Start(&pool);
+    auto latency = latency_task.Wait();
+    total_latency += latency;
+    max_latency = std::max(max_latency, latency);
+    ++latency_samples;
+    std::this_thread::sleep_for(1ms);
+  }
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : producers) {
+    thread.join();
+  }
+  sw.stop();
+
+  LOG(INFO) << "Tasks/sec:                     "
+            << total_tasks.load() / sw.elapsed().wall_seconds();
+  LOG(INFO) << "High priority avg queue time:  "
+            << MonoDelta(total_latency / std::max<size_t>(latency_samples, 1));
+  LOG(INFO) << "High priority max queue time:  " << MonoDelta(max_latency);
+}
+
 } // namespace rpc
 } // namespace yb
 
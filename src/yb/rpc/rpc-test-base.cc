@@ -327,7 +327,8 @@ TestServer::TestServer(std::unique_ptr<ServiceIf> service,
                                       &thread_pool_,
                                       &messenger_->scheduler(),
                                       std::move(service),
-                                      messenger_->metric_entity()));
+                                      messenger_->metric_entity(),
+                                      options.priority));
 
   EXPECT_OK(messenger_->ListenAddress(
       rpc::CreateConnectionContextFactory<rpc::YBInboundConnectionContext>(),
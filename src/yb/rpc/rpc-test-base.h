@@ -140,6 +140,7 @@ struct TestServerOptions {
   MessengerOptions messenger_options = kDefaultServerMessengerOptions;
   size_t n_worker_threads = 3;
   Endpoint endpoint;
+  ServicePriority priority = ServicePriority::kNormal;
 };
 
 class TestServer {
@@ -53,7 +53,10 @@ YB_DEFINE_ENUM(InvokeCallbackMode,
     // On reactor thread.
     (kReactorThread)
     // On thread pool.
-    (kThreadPool));
+    (kThreadPool)
+    // On thread pool, before tasks with normal priority. Used for latency sensitive calls, such as
+    // Raft replication, that should not wait behind user requests.
+    (kHighPriorityThreadPool));
 
 // Controller for managing properties of a single RPC call, on the client side.
 //
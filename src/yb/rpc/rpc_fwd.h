@@ -46,6 +46,7 @@ namespace rpc {
 
 class Acceptor;
 class AcceptorPool;
+class CircularReadBuffer;
 class ConnectionContext;
 class GrowableBufferAllocator;
 class MessengerBuilder;
@@ -62,6 +63,8 @@ class Protocol;
 class Scheduler;
 class SecureContext;
 class ServicePoolImpl;
+class SharedMemoryClient;
+class SharedMemoryServer;
 class Stream;
 class StreamReadBuffer;
 class ThreadPool;
@@ -33,6 +33,12 @@ METRIC_DEFINE_counter(server, rpc_inbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC inbound calls.");
 
+METRIC_DEFINE_counter(server, rpc_inbound_calls_zero_copy,
+                      "Number of received RPC messages referenced in the receive buffer.",
+                      yb::MetricUnit::kRequests,
+                      "Number of received RPC calls and responses that reference the receive "
+                      "buffer instead of being copied out of it.");
+
 METRIC_DEFINE_gauge_int64(server, rpc_outbound_calls_alive,
                           "Number of alive RPC outbound calls.",
                           yb::MetricUnit::kRequests,
@@ -52,6 +58,7 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     connections_created = METRIC_rpc_connections_created.Instantiate(metric_entity);
     inbound_calls_alive = METRIC_rpc_inbound_calls_alive.Instantiate(metric_entity, 0);
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
+    inbound_calls_zero_copy = METRIC_rpc_inbound_calls_zero_copy.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
   }
@@ -26,6 +26,7 @@ struct RpcMetrics {
   scoped_refptr<Counter> connections_created;
   scoped_refptr<AtomicGauge<int64_t>> inbound_calls_alive;
   scoped_refptr<Counter> inbound_calls_created;
+  scoped_refptr<Counter> inbound_calls_zero_copy;
   scoped_refptr<AtomicGauge<int64_t>> outbound_calls_alive;
   scoped_refptr<Counter> outbound_calls_created;
 };
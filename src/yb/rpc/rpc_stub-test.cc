@@ -57,6 +57,9 @@ DEFINE_bool(is_panic_test_child, false, "Used by TestRpcPanic");
 DECLARE_bool(socket_inject_short_recvs);
 DECLARE_int32(rpc_slow_query_threshold_ms);
 DECLARE_int32(TEST_delay_connect_ms);
+DECLARE_uint64(rpc_zero_copy_min_call_size_bytes);
+DECLARE_int32(rpc_queue_delay_target_ms);
+DECLARE_int32(rpc_queue_delay_interval_ms);
 
 using namespace std::chrono_literals;
 
@@ -90,6 +93,12 @@ using std::vector;
 using rpc_test::AddRequestPartialPB;
 using rpc_test::CalculatorServiceProxy;
 
+namespace {
+
+const std::string kSharedMemoryServerUuid = "shared_memory_server";
+
+} // namespace
+
 class RpcStubTest : public RpcTestBase {
  public:
   void SetUp() override {
@@ -112,6 +121,37 @@ class RpcStubTest : public RpcTestBase {
     ASSERT_EQ(30, resp.result());
   }
 
+  // Sends echo calls with random data of up to max_message_size bytes in parallel, and checks
+  // their responses.
+  void CheckEchoCalls(ProxyCache* proxy_cache, int num_calls, size_t max_message_size) {
+    CalculatorServiceProxy p(proxy_cache, server_hostport_);
+
+    std::vector<EchoRequestPB> reqs(num_calls);
+    std::vector<EchoResponsePB> resps(num_calls);
+    std::vector<RpcController> controllers(num_calls);
+
+    CountDownLatch latch(num_calls);
+    for (int i = 0; i < num_calls; i++) {
+      reqs[i].set_data(RandomHumanReadableString(RandomUniformInt<size_t>(1, max_message_size)));
+      controllers[i].set_timeout(60s);
+      p.EchoAsync(reqs[i], &resps[i], &controllers[i], [&latch]() { latch.CountDown(); });
+    }
+
+    latch.Wait();
+
+    for (int i = 0; i < num_calls; i++) {
+      ASSERT_OK(controllers[i].status());
+      ASSERT_EQ(resps[i].data(), reqs[i].data());
+    }
+  }
+
+  int NumOutboundConnections(Messenger* messenger) {
+    DumpRunningRpcsRequestPB dump_req;
+    DumpRunningRpcsResponsePB dump_resp;
+    EXPECT_OK(messenger->DumpRunningRpcs(dump_req, &dump_resp));
+    return dump_resp.outbound_connections_size();
+  }
+
   template <class T>
   struct ProxyWithMessenger {
     AutoShutdownMessengerHolder messenger;
@@ -315,6 +355,111 @@ TEST_F(RpcStubTest, TestBigCallData) {
   }
 }
 
+// Checks calls that reference the receive buffer, while further calls are received into it.
+TEST_F(RpcStubTest, ZeroCopyCalls) {
+  constexpr int kNumCalls = 200;
+  constexpr size_t kMaxMessageSize = 64_KB;
+
+  FLAGS_rpc_zero_copy_min_call_size_bytes = 1;
+
+  ASSERT_NO_FATALS(CheckEchoCalls(proxy_cache_.get(), kNumCalls, kMaxMessageSize));
+
+  // Calls were referenced in the receive buffer instead of being copied.
+  ASSERT_GT(server_messenger()->rpc_metrics().inbound_calls_zero_copy->value(), 0);
+}
+
+// Checks calls sent through shared memory channels, including ones that do not fit into the pipe.
+TEST_F(RpcStubTest, SharedMemoryCalls) {
+  constexpr int kNumCalls = 100;
+  constexpr size_t kMaxMessageSize = 512_KB;
+
+  auto fd = ASSERT_RESULT(server_messenger()->ListenSharedMemory(4, kSharedMemoryServerUuid));
+  ASSERT_OK(client_messenger_->ConnectSharedMemory(fd));
+  client_messenger_->RegisterSharedMemoryRemote(kSharedMemoryServerUuid, server_hostport_);
+
+  ASSERT_NO_FATALS(CheckEchoCalls(proxy_cache_.get(), kNumCalls, kMaxMessageSize));
+
+  // Nothing should be sent over the network.
+  ASSERT_EQ(0, NumOutboundConnections(client_messenger_.get()));
+}
+
+// Checks that calls of a client, that could not claim a shared memory channel because all of them
+// are in use, are sent over the network.
+TEST_F(RpcStubTest, SharedMemoryNoFreeChannel) {
+  constexpr int kNumCalls = 10;
+  constexpr size_t kMaxMessageSize = 64_KB;
+
+  auto fd = ASSERT_RESULT(server_messenger()->ListenSharedMemory(1, kSharedMemoryServerUuid));
+  ASSERT_OK(client_messenger_->ConnectSharedMemory(fd));
+  client_messenger_->RegisterSharedMemoryRemote(kSharedMemoryServerUuid, server_hostport_);
+
+  auto other_messenger = CreateAutoShutdownMessengerHolder("OtherClient");
+  auto status = other_messenger->ConnectSharedMemory(fd);
+  ASSERT_TRUE(status.IsServiceUnavailable()) << status;
+  other_messenger->RegisterSharedMemoryRemote(kSharedMemoryServerUuid, server_hostport_);
+  ProxyCache other_proxy_cache(other_messenger.get());
+
+  ASSERT_NO_FATALS(CheckEchoCalls(&other_proxy_cache, kNumCalls, kMaxMessageSize));
+  ASSERT_EQ(1, NumOutboundConnections(other_messenger.get()));
+
+  // The client that claimed the channel still uses it.
+  ASSERT_NO_FATALS(CheckEchoCalls(proxy_cache_.get(), kNumCalls, kMaxMessageSize));
+  ASSERT_EQ(0, NumOutboundConnections(client_messenger_.get()));
+}
+
+// Checks that calls are sent over the network after the peer serving the shared memory channel
+// died and broke the channel.
+TEST_F(RpcStubTest, SharedMemoryBrokenByDeadPeer) {
+  constexpr int kNumCalls = 10;
+  constexpr size_t kMaxMessageSize = 64_KB;
+
+  // The channel is served by a separate server, so the server reachable over the network is still
+  // alive after the channel peer is shut down.
+  auto peer = StartTestServer(
+      "SharedMemoryPeer", IpAddress(boost::asio::ip::address_v4::loopback()));
+  auto fd = ASSERT_RESULT(peer.messenger()->ListenSharedMemory(4, kSharedMemoryServerUuid));
+  ASSERT_OK(client_messenger_->ConnectSharedMemory(fd));
+  client_messenger_->RegisterSharedMemoryRemote(kSharedMemoryServerUuid, server_hostport_);
+
+  ASSERT_NO_FATALS(CheckEchoCalls(proxy_cache_.get(), kNumCalls, kMaxMessageSize));
+  ASSERT_EQ(0, NumOutboundConnections(client_messenger_.get()));
+
+  // Stops the shared memory server of the peer, that breaks its channels.
+  peer.messenger()->ShutdownAcceptor();
+
+  ASSERT_NO_FATALS(CheckEchoCalls(proxy_cache_.get(), kNumCalls, kMaxMessageSize));
+  ASSERT_EQ(1, NumOutboundConnections(client_messenger_.get()));
+}
+
+// Checks that the shared memory channel is used for the server identified by its uuid, while the
+// server is bound to the wildcard address and the client connects to other addresses.
+TEST_F(RpcStubTest, SharedMemoryCallsMatchServerUuid) {
+  const auto& bound_endpoint = server().bound_endpoint();
+  ASSERT_TRUE(bound_endpoint.address().is_unspecified());
+  ASSERT_FALSE(HostPort(bound_endpoint) == server_hostport_);
+
+  auto fd = ASSERT_RESULT(server_messenger()->ListenSharedMemory(4, kSharedMemoryServerUuid));
+  ASSERT_OK(client_messenger_->ConnectSharedMemory(fd));
+
+  // Address of another server, so calls go over the network.
+  client_messenger_->RegisterSharedMemoryRemote("other_server", server_hostport_);
+  ASSERT_NO_FATALS(SendSimpleCall());
+  ASSERT_EQ(1, NumOutboundConnections(client_messenger_.get()));
+
+  // Another address of the same server, calls to it go through the channel.
+  HostPort alias("localhost", server_hostport_.port());
+  client_messenger_->RegisterSharedMemoryRemote(kSharedMemoryServerUuid, alias);
+  CalculatorServiceProxy p(proxy_cache_.get(), alias);
+  RpcController controller;
+  AddRequestPB req;
+  req.set_x(10);
+  req.set_y(20);
+  AddResponsePB resp;
+  ASSERT_OK(p.Add(req, &resp, &controller));
+  ASSERT_EQ(30, resp.result());
+  ASSERT_EQ(1, NumOutboundConnections(client_messenger_.get()));
+}
+
 TEST_F(RpcStubTest, TestRespondDeferred) {
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
 
@@ -530,6 +675,52 @@ TEST_F(RpcStubTest, TestDontHandleTimedOutCalls) {
   ASSERT_EQ(1, timed_out_in_queue->value());
 }
 
+// Sends sleep calls that build a standing queue, and returns the number of calls that were shed.
+size_t SendCallsWithStandingQueue(ProxyCache* proxy_cache, const HostPort& remote) {
+  FLAGS_rpc_queue_delay_target_ms = 10;
+  FLAGS_rpc_queue_delay_interval_ms = 50;
+
+  CalculatorServiceProxy p(proxy_cache, remote);
+  constexpr size_t kNumCalls = 100;
+  std::vector<AsyncSleep> sleeps(kNumCalls);
+  CountDownLatch latch(kNumCalls);
+  for (auto& sleep : sleeps) {
+    sleep.rpc.set_timeout(30s);
+    sleep.req.set_sleep_micros(20 * 1000);
+    p.SleepAsync(sleep.req, &sleep.resp, &sleep.rpc, [&latch]() { latch.CountDown(); });
+  }
+  latch.Wait();
+
+  size_t shed = 0;
+  for (auto& sleep : sleeps) {
+    if (!sleep.rpc.status().ok()) {
+      EXPECT_TRUE(sleep.rpc.status().IsServiceUnavailable()) << sleep.rpc.status();
+      ++shed;
+    }
+  }
+  LOG(INFO) << "Shed calls: " << shed;
+  EXPECT_LT(shed, kNumCalls);
+  return shed;
+}
+
+// Checks that calls are shed when there is a standing queue, and the rest of calls succeed.
+TEST_F(RpcStubTest, ShedByQueueDelay) {
+  auto shed = SendCallsWithStandingQueue(proxy_cache_.get(), server_hostport_);
+  ASSERT_GT(shed, 0);
+  ASSERT_EQ(shed, server().service_pool().RpcsShedByQueueDelayMetric()->value());
+}
+
+// Checks that calls to high priority service are never shed.
+TEST_F(RpcStubTest, DontShedHighPriorityService) {
+  TestServerOptions options;
+  options.priority = ServicePriority::kHigh;
+  StartTestServerWithGeneratedCode(&server_hostport_, options);
+
+  auto shed = SendCallsWithStandingQueue(proxy_cache_.get(), server_hostport_);
+  ASSERT_EQ(shed, 0);
+  ASSERT_EQ(0, server().service_pool().RpcsShedByQueueDelayMetric()->value());
+}
+
 TEST_F(RpcStubTest, TestDumpCallsInFlight) {
   CountDownLatch latch(1);
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
@@ -40,6 +40,10 @@ class ConnectionContextWithCallId : public ConnectionContextBase {
     return processed_call_count_.load(std::memory_order_acquire);
   }
 
+  size_t num_calls_being_handled() const {
+    return calls_being_handled_.size();
+  }
+
  private:
   virtual uint64_t ExtractCallId(InboundCall* call) = 0;
   void ListenIdle(IdleListener listener) override { idle_listener_ = std::move(listener); }
@@ -68,6 +68,12 @@ class ServiceIf {
 
   virtual void Shutdown();
   virtual std::string service_name() const = 0;
+
+  // Whether calls to this service could be shed when its queue delay stays above
+  // rpc_queue_delay_target_ms.
+  virtual bool CanShedByQueueDelay() const {
+    return true;
+  }
 };
 
 }  // namespace rpc
@@ -32,6 +32,7 @@
 
 #include "yb/rpc/service_pool.h"
 
+#include <cmath>
 #include <memory>
 #include <queue>
 #include <string>
@@ -55,6 +56,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/lockfree.h"
+#include "yb/util/locks.h"
 #include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
@@ -76,6 +78,17 @@ DEFINE_int64(backpressure_recovery_period_ms, 600000,
              "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
 TAG_FLAG(backpressure_recovery_period_ms, runtime);
+DEFINE_int32(rpc_queue_delay_target_ms, 0,
+             "Target time that calls spend in the service queue. When the minimum queue time stays "
+             "above the target for rpc_queue_delay_interval_ms, calls are shed at increasing rate "
+             "(CoDel), until queue time drops below the target. 0 to disable.");
+TAG_FLAG(rpc_queue_delay_target_ms, advanced);
+TAG_FLAG(rpc_queue_delay_target_ms, runtime);
+DEFINE_int32(rpc_queue_delay_interval_ms, 500,
+             "Interval during which queue time should stay above rpc_queue_delay_target_ms, before "
+             "calls are shed. Should be about the worst case processing time of a call.");
+TAG_FLAG(rpc_queue_delay_interval_ms, advanced);
+TAG_FLAG(rpc_queue_delay_interval_ms, runtime);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -106,6 +119,12 @@ METRIC_DEFINE_counter(server, rpcs_queue_overflow,
                       "Number of RPCs dropped because the service queue "
                       "was full.");
 
+METRIC_DEFINE_counter(server, rpcs_shed_by_queue_delay,
+                      "RPCs Shed By Queue Delay",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPCs dropped because the queue time of the service "
+                      "stayed above rpc_queue_delay_target_ms.");
+
 namespace yb {
 namespace rpc {
 
@@ -122,16 +141,20 @@ class ServicePoolImpl final : public InboundCallHandler {
                   ThreadPool* thread_pool,
                   Scheduler* scheduler,
                   ServiceIfPtr service,
-                  const scoped_refptr<MetricEntity>& entity)
+                  const scoped_refptr<MetricEntity>& entity,
+                  ServicePriority priority)
       : max_queued_calls_(max_tasks),
         thread_pool_(*thread_pool),
         scheduler_(*scheduler),
         service_(std::move(service)),
+        can_shed_by_queue_delay_(
+            priority == ServicePriority::kNormal && service_->CanShedByQueueDelay()),
         incoming_queue_time_(METRIC_rpc_incoming_queue_time.Instantiate(entity)),
         rpcs_timed_out_in_queue_(METRIC_rpcs_timed_out_in_queue.Instantiate(entity)),
         rpcs_timed_out_early_in_queue_(
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        rpcs_shed_by_queue_delay_(METRIC_rpcs_shed_by_queue_delay.Instantiate(entity)),
         check_timeout_strand_(scheduler->io_service()),
         log_prefix_(Format("$0: ", service_->service_name())) {
 
@@ -145,6 +168,16 @@ class ServicePoolImpl final : public InboundCallHandler {
                   description, MetricUnit::kRequests, description)),
               static_cast<int64>(0) /* initial_value */);
 
+          id = Format("rpcs_shedding_$0", service_->service_name());
+          EscapeMetricNameForPrometheus(&id);
+          description = id + " metric for ServicePoolImpl, 1 when calls are shed because of "
+                        "queue delay";
+          shedding_ = entity->FindOrCreateGauge(
+              std::unique_ptr<GaugePrototype<int64_t>>(new OwningGaugePrototype<int64_t>(
+                  entity->prototype().name(), std::move(id),
+                  description, MetricUnit::kUnits, description)),
+              static_cast<int64>(0) /* initial_value */);
+
           LOG_WITH_PREFIX(INFO) << "yb::rpc::ServicePoolImpl created at " << this;
   }
 
@@ -204,6 +237,10 @@ class ServicePoolImpl final : public InboundCallHandler {
     return rpcs_queue_overflow_.get();
   }
 
+  const Counter* RpcsShedByQueueDelayMetric() const {
+    return rpcs_shed_by_queue_delay_.get();
+  }
+
   std::string service_name() const {
     return service_->service_name();
   }
@@ -255,6 +292,11 @@ class ServicePoolImpl final : public InboundCallHandler {
       error_message = kTimedOutInQueue;
     } else if (PREDICT_FALSE(ShouldDropRequestDuringHighLoad(incoming))) {
       error_message = "The server is overloaded. Call waited in the queue past max_time_in_queue.";
+    } else if (PREDICT_FALSE(ShouldShed(incoming->GetTimeInQueue()))) {
+      if (incoming->TryStartProcessing()) {
+        Shed(incoming);
+      }
+      return;
     } else {
       TRACE_TO(incoming->trace(), "Handling call");
 
@@ -280,6 +322,65 @@ class ServicePoolImpl final : public InboundCallHandler {
     }
   }
 
+  void Shed(const InboundCallPtr& call) {
+    const auto err_msg = Format(
+        "$0 request on $1 from $2 dropped due to queue delay above $3 ms",
+        call->method_name(), service_->service_name(), call->remote_address(),
+        FLAGS_rpc_queue_delay_target_ms);
+    YB_LOG_EVERY_N_SECS(WARNING, 3) << LogPrefix() << err_msg;
+    rpcs_shed_by_queue_delay_->Increment();
+    call->RespondFailure(
+        ErrorStatusPB::ERROR_SERVER_TOO_BUSY, STATUS(ServiceUnavailable, err_msg));
+  }
+
+  // Decides whether the call should be shed, given its time in queue, using CoDel algorithm.
+  // Calls are shed only after queue time stays above the target for the whole interval, i.e.
+  // there is a standing queue rather than a burst. After that calls are shed at increasing rate,
+  // until queue time drops below the target.
+  bool ShouldShed(MonoDelta time_in_queue) {
+    const auto target_ms = GetAtomicFlag(&FLAGS_rpc_queue_delay_target_ms);
+    if (target_ms <= 0 || !can_shed_by_queue_delay_) {
+      return false;
+    }
+    const auto now = CoarseMonoClock::Now();
+    const CoarseDuration interval = GetAtomicFlag(&FLAGS_rpc_queue_delay_interval_ms) * 1ms;
+
+    std::lock_guard<simple_spinlock> lock(codel_mutex_);
+    if (time_in_queue.ToMilliseconds() < target_ms) {
+      first_above_time_ = CoarseTimePoint();
+      if (shedding_state_) {
+        shedding_state_ = false;
+        shedding_->set_value(0);
+      }
+      return false;
+    }
+    if (first_above_time_ == CoarseTimePoint()) {
+      first_above_time_ = now + interval;
+      return false;
+    }
+    if (!shedding_state_) {
+      if (now < first_above_time_) {
+        return false;
+      }
+      shedding_state_ = true;
+      shedding_->set_value(1);
+      // Shedding was stopped recently, so continue from the rate it has reached.
+      shed_count_ = shed_count_ > 2 && now - shed_next_ < interval * 16 ? shed_count_ - 2 : 1;
+      shed_next_ = now + ShedInterval(interval);
+      return true;
+    }
+    if (now < shed_next_) {
+      return false;
+    }
+    ++shed_count_;
+    shed_next_ += ShedInterval(interval);
+    return true;
+  }
+
+  CoarseDuration ShedInterval(CoarseDuration interval) const {
+    return std::chrono::duration_cast<CoarseDuration>(interval / std::sqrt(shed_count_));
+  }
+
   bool ShouldDropRequestDuringHighLoad(const InboundCallPtr& incoming) {
     CoarseTimePoint last_backpressure_at(last_backpressure_at_.load(std::memory_order_acquire));
 
@@ -403,11 +504,23 @@ class ServicePoolImpl final : public InboundCallHandler {
   ThreadPool& thread_pool_;
   Scheduler& scheduler_;
   ServiceIfPtr service_;
+  // Calls of high priority services, such as consensus, are never shed, since failing them would
+  // make the overload worse, e.g. by triggering leader elections.
+  const bool can_shed_by_queue_delay_;
   scoped_refptr<Histogram> incoming_queue_time_;
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_timed_out_early_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  scoped_refptr<Counter> rpcs_shed_by_queue_delay_;
   scoped_refptr<AtomicGauge<int64_t>> rpcs_in_queue_;
+  scoped_refptr<AtomicGauge<int64_t>> shedding_;
+
+  // CoDel state, see ShouldShed.
+  simple_spinlock codel_mutex_;
+  CoarseTimePoint first_above_time_;
+  CoarseTimePoint shed_next_;
+  size_t shed_count_ = 0;
+  bool shedding_state_ = false;
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
   std::atomic<int64_t> queued_calls_{0};
@@ -457,9 +570,10 @@ ServicePool::ServicePool(size_t max_tasks,
                          ThreadPool* thread_pool,
                          Scheduler* scheduler,
                          ServiceIfPtr service,
-                         const scoped_refptr<MetricEntity>& metric_entity)
+                         const scoped_refptr<MetricEntity>& metric_entity,
+                         ServicePriority priority)
     : impl_(new ServicePoolImpl(
-        max_tasks, thread_pool, scheduler, std::move(service), metric_entity)) {
+        max_tasks, thread_pool, scheduler, std::move(service), metric_entity, priority)) {
 }
 
 ServicePool::~ServicePool() {
@@ -489,6 +603,10 @@ const Counter* ServicePool::RpcsQueueOverflowMetric() const {
   return impl_->RpcsQueueOverflowMetric();
 }
 
+const Counter* ServicePool::RpcsShedByQueueDelayMetric() const {
+  return impl_->RpcsShedByQueueDelayMetric();
+}
+
 std::string ServicePool::service_name() const {
   return impl_->service_name();
 }
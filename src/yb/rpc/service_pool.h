@@ -66,7 +66,8 @@ class ServicePool : public RpcService {
               ThreadPool* thread_pool,
               Scheduler* scheduler,
               ServiceIfPtr service,
-              const scoped_refptr<MetricEntity>& metric_entity);
+              const scoped_refptr<MetricEntity>& metric_entity,
+              ServicePriority priority = ServicePriority::kNormal);
   virtual ~ServicePool();
 
   void StartShutdown() override;
@@ -76,6 +77,7 @@ class ServicePool : public RpcService {
   void Handle(InboundCallPtr call) override;
   const Counter* RpcsTimedOutInQueueMetricForTests() const;
   const Counter* RpcsQueueOverflowMetric() const;
+  const Counter* RpcsShedByQueueDelayMetric() const;
   std::string service_name() const;
 
   ServiceIfPtr TEST_get_service() const;
@@ -0,0 +1,835 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/shared_memory_channel.h"
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <condition_variable>
+#include <thread>
+
+#include <boost/container/small_vector.hpp>
+
+#include "yb/gutil/endian.h"
+#include "yb/gutil/port.h"
+
+#include "yb/rpc/constants.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/outbound_call.h"
+#include "yb/rpc/remote_method.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/yb_rpc.h"
+
+#include "yb/util/errno.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/net/sockaddr.h"
+#include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/thread.h"
+
+using namespace std::literals;
+using namespace yb::size_literals;
+
+DECLARE_int32(rpc_max_message_size);
+
+namespace yb {
+namespace rpc {
+
+YB_DEFINE_ENUM(SharedMemoryChannelState, (kFree)(kActive)(kBroken)(kClosed));
+
+namespace {
+
+const uint64_t kSharedMemoryChannelsMagic = 0x3143505244424d53; // "SMBDRPC1"
+
+// Uuids of servers are 32 hex characters, there is some extra space for the future.
+constexpr size_t kMaxServerUuidSize = 64;
+
+// Size of each pipe of a channel, should be power of 2.
+constexpr size_t kPipeSize = 128_KB;
+
+// Max time to wait for a futex, before checking that the other side is alive.
+const MonoDelta kWaitSlice = 100ms;
+
+#if defined(__linux__)
+
+// Futexes in shared memory should not use FUTEX_PRIVATE_FLAG, since they are shared between
+// processes.
+void FutexWait(std::atomic<uint32_t>* address, uint32_t expected, MonoDelta timeout) {
+  struct timespec ts;
+  timeout.ToTimeSpec(&ts);
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>* address) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAKE, INT_MAX, nullptr,
+          nullptr, 0);
+}
+
+#else
+
+// Without futexes waiters just poll.
+void FutexWait(std::atomic<uint32_t>* address, uint32_t expected, MonoDelta timeout) {
+  if (address->load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+void FutexWake(std::atomic<uint32_t>* address) {
+}
+
+#endif
+
+bool ProcessAlive(pid_t pid) {
+  return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+} // namespace
+
+// Event that could be waited and notified by different processes.
+class SharedMemoryEvent {
+ public:
+  // Returns the value that should be passed to Wait. Should be obtained before checking the
+  // condition that is waited for, so notification after the check is not lost.
+  uint32_t Prepare() const {
+    return seq_.load();
+  }
+
+  void Wait(uint32_t seq, MonoDelta timeout) {
+    waiters_.fetch_add(1);
+    FutexWait(&seq_, seq, timeout);
+    waiters_.fetch_sub(1);
+  }
+
+  void Notify() {
+    seq_.fetch_add(1);
+    if (waiters_.load() != 0) {
+      FutexWake(&seq_);
+    }
+  }
+
+ private:
+  std::atomic<uint32_t> seq_{0};
+  std::atomic<uint32_t> waiters_{0};
+};
+
+// Byte stream from a single writer to a single reader.
+class SharedMemoryPipe {
+ public:
+  void Reset() {
+    write_pos_.store(0, std::memory_order_relaxed);
+    read_pos_.store(0, std::memory_order_release);
+  }
+
+  // Copies up to size bytes of written data to out. Returns number of copied bytes.
+  size_t Read(char* out, size_t size) {
+    const auto read_pos = read_pos_.load(std::memory_order_relaxed);
+    size = std::min<size_t>(size, write_pos_.load(std::memory_order_acquire) - read_pos);
+    if (size == 0) {
+      return 0;
+    }
+    const size_t offset = read_pos & (kPipeSize - 1);
+    const size_t head = std::min(size, kPipeSize - offset);
+    memcpy(out, data_ + offset, head);
+    memcpy(out + head, data_, size - head);
+    read_pos_.store(read_pos + size, std::memory_order_release);
+    writable_.Notify();
+    return size;
+  }
+
+  // Writes the whole data, waiting for free space when the pipe is full. Before each wait invokes
+  // check, and stops writing if it returns an error.
+  template <class Check>
+  CHECKED_STATUS Write(Slice data, const Check& check) {
+    for (;;) {
+      data.remove_prefix(WriteSome(data));
+      if (data.empty()) {
+        return Status::OK();
+      }
+      const auto seq = writable_.Prepare();
+      if (write_pos_.load(std::memory_order_relaxed) - read_pos_.load(std::memory_order_acquire) <
+              kPipeSize) {
+        continue;
+      }
+      RETURN_NOT_OK(check());
+      writable_.Wait(seq, kWaitSlice);
+    }
+  }
+
+  SharedMemoryEvent& readable() {
+    return readable_;
+  }
+
+ private:
+  size_t WriteSome(const Slice& data) {
+    const auto write_pos = write_pos_.load(std::memory_order_relaxed);
+    const size_t size = std::min<size_t>(
+        data.size(), kPipeSize - (write_pos - read_pos_.load(std::memory_order_acquire)));
+    if (size == 0) {
+      return 0;
+    }
+    const size_t offset = write_pos & (kPipeSize - 1);
+    const size_t head = std::min(size, kPipeSize - offset);
+    memcpy(data_ + offset, data.data(), head);
+    memcpy(data_, data.data() + head, size - head);
+    write_pos_.store(write_pos + size, std::memory_order_release);
+    readable_.Notify();
+    return size;
+  }
+
+  // Total number of bytes written to and read from the pipe.
+  std::atomic<uint64_t> write_pos_{0};
+  std::atomic<uint64_t> read_pos_{0};
+
+  SharedMemoryEvent readable_;
+  SharedMemoryEvent writable_;
+
+  char data_[kPipeSize];
+};
+
+struct CACHELINE_ALIGNED SharedMemoryChannel {
+  // Pid of the client process that claimed this channel, 0 if the channel is free.
+  std::atomic<pid_t> owner_pid{0};
+  std::atomic<SharedMemoryChannelState> state{SharedMemoryChannelState::kFree};
+  SharedMemoryPipe requests;
+  SharedMemoryPipe responses;
+};
+
+struct CACHELINE_ALIGNED SharedMemoryChannelsHeader {
+  SharedMemoryChannelsHeader(size_t num_channels_, const std::string& server_uuid_)
+      : num_channels(num_channels_), server_pid(getpid()),
+        server_uuid_size(server_uuid_.size()) {
+    memcpy(server_uuid, server_uuid_.data(), server_uuid_size);
+  }
+
+  static size_t SegmentSize(size_t num_channels) {
+    return sizeof(SharedMemoryChannelsHeader) + num_channels * sizeof(SharedMemoryChannel);
+  }
+
+  SharedMemoryChannel& channel(size_t idx) {
+    return reinterpret_cast<SharedMemoryChannel*>(this + 1)[idx];
+  }
+
+  const uint64_t magic = kSharedMemoryChannelsMagic;
+  const uint64_t num_channels;
+  const pid_t server_pid;
+  const uint64_t server_uuid_size;
+  char server_uuid[kMaxServerUuidSize];
+
+  // Notified by clients when they write requests to any channel.
+  SharedMemoryEvent requests_written;
+};
+
+// Assembles length prefixed frames from the data read from a pipe.
+class SharedMemoryFrameReader {
+ public:
+  // Reads available data from the pipe, and invokes handler for each complete frame. Returns true
+  // if any data was read.
+  template <class Handler>
+  Result<bool> Read(SharedMemoryPipe* pipe, const Handler& handler) {
+    bool result = false;
+    for (;;) {
+      if (length_size_ < kMsgLengthPrefixLength) {
+        const auto read = pipe->Read(length_ + length_size_, kMsgLengthPrefixLength - length_size_);
+        length_size_ += read;
+        result = result || read != 0;
+        if (length_size_ < kMsgLengthPrefixLength) {
+          return result;
+        }
+        const size_t frame_size = NetworkByteOrder::Load32(length_);
+        if (frame_size > FLAGS_rpc_max_message_size) {
+          return STATUS_FORMAT(
+              NetworkError, "The frame had a length of $0, but we only support messages up to $1 "
+                            "bytes long.", frame_size, FLAGS_rpc_max_message_size);
+        }
+        frame_ = CallData(frame_size);
+        frame_filled_ = 0;
+      }
+      const auto read = pipe->Read(frame_.data() + frame_filled_, frame_.size() - frame_filled_);
+      frame_filled_ += read;
+      result = result || read != 0;
+      if (frame_filled_ < frame_.size()) {
+        return result;
+      }
+      length_size_ = 0;
+      RETURN_NOT_OK(handler(&frame_));
+    }
+  }
+
+ private:
+  char length_[kMsgLengthPrefixLength];
+  size_t length_size_ = 0;
+  CallData frame_;
+  size_t frame_filled_ = 0;
+};
+
+// Server state of a channel claimed by a client.
+class SharedMemoryServerChannel {
+ public:
+  SharedMemoryServerChannel(
+      std::shared_ptr<SharedMemorySegment> segment, SharedMemoryChannel* channel)
+      : segment_(std::move(segment)), channel_(channel),
+        owner_pid_(channel->owner_pid.load(std::memory_order_acquire)) {}
+
+  pid_t owner_pid() const {
+    return owner_pid_;
+  }
+
+  SharedMemoryFrameReader& reader() {
+    return reader_;
+  }
+
+  // Writes the response to the channel. Waits for free space in the pipe without holding mutex_,
+  // and gives up at the deadline of the call, breaking the channel if the response was partially
+  // written.
+  CHECKED_STATUS Send(
+      const boost::container::small_vector_base<RefCntBuffer>& buffers, CoarseTimePoint deadline) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto can_write = [this] { return closed_ || !writing_; };
+      if (deadline == CoarseTimePoint::max()) {
+        writer_cond_.wait(lock, can_write);
+      } else if (!writer_cond_.wait_until(lock, deadline, can_write)) {
+        return STATUS_FORMAT(
+            TimedOut, "Timed out waiting for shared memory channel of process $0", owner_pid_);
+      }
+      if (closed_) {
+        return STATUS_FORMAT(Aborted, "Shared memory channel of process $0 closed", owner_pid_);
+      }
+      writing_ = true;
+    }
+    Status status;
+    for (const auto& buffer : buffers) {
+      status = channel_->responses.Write(buffer.AsSlice(), [this, deadline] {
+        if (CoarseMonoClock::now() >= deadline) {
+          return STATUS_FORMAT(
+              TimedOut, "Timed out writing response to shared memory channel of process $0",
+              owner_pid_);
+        }
+        return CheckClient();
+      });
+      if (!status.ok()) {
+        break;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!status.ok()) {
+      // Part of the response could be already written, so the channel cannot be used anymore.
+      BreakUnlocked();
+    }
+    writing_ = false;
+    writer_cond_.notify_all();
+    return status;
+  }
+
+  void Break() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BreakUnlocked();
+  }
+
+  // Waits for the response that is being written to finish.
+  void Close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    writer_cond_.notify_all();
+    writer_cond_.wait(lock, [this] { return !writing_; });
+  }
+
+ private:
+  CHECKED_STATUS CheckClient() {
+    if (channel_->state.load(std::memory_order_acquire) != SharedMemoryChannelState::kActive) {
+      return STATUS_FORMAT(Aborted, "Shared memory channel of process $0 closed", owner_pid_);
+    }
+    if (!ProcessAlive(owner_pid_)) {
+      return STATUS_FORMAT(NetworkError, "Process $0 is not alive", owner_pid_);
+    }
+    return Status::OK();
+  }
+
+  void BreakUnlocked() {
+    closed_ = true;
+    writer_cond_.notify_all();
+    auto expected = SharedMemoryChannelState::kActive;
+    channel_->state.compare_exchange_strong(expected, SharedMemoryChannelState::kBroken);
+    channel_->responses.readable().Notify();
+  }
+
+  const std::shared_ptr<SharedMemorySegment> segment_;
+  SharedMemoryChannel* const channel_;
+  const pid_t owner_pid_;
+
+  // Used only by the dispatcher thread.
+  SharedMemoryFrameReader reader_;
+
+  // Protects closed_ and writing_. Writes of responses are serialized by writing_, so at most one
+  // response is written to the channel at a time.
+  std::mutex mutex_;
+  std::condition_variable writer_cond_;
+  bool closed_ = false;
+  bool writing_ = false;
+};
+
+namespace {
+
+class SharedMemoryInboundCall : public YBInboundCall {
+ public:
+  SharedMemoryInboundCall(
+      RpcMetrics* rpc_metrics, std::shared_ptr<SharedMemoryServerChannel> channel)
+      : YBInboundCall(rpc_metrics, RemoteMethod()), channel_(std::move(channel)) {}
+
+  const Endpoint& remote_address() const override {
+    static const Endpoint endpoint;
+    return endpoint;
+  }
+
+  const Endpoint& local_address() const override {
+    static const Endpoint endpoint;
+    return endpoint;
+  }
+
+  size_t ObjectSize() const override { return sizeof(*this); }
+
+ protected:
+  void QueueResponse(bool is_success) override {
+    TRACE_TO(trace_, is_success ? "Queueing success response" : "Queueing failure response");
+    LogTrace();
+    bool expected = false;
+    if (!responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+      LOG_WITH_PREFIX(DFATAL) << "Response already queued";
+      return;
+    }
+    boost::container::small_vector<RefCntBuffer, 4> buffers;
+    Serialize(&buffers);
+    NotifyTransferred(channel_->Send(buffers, GetClientDeadline()), nullptr /* conn */);
+  }
+
+ private:
+  std::shared_ptr<SharedMemoryServerChannel> channel_;
+};
+
+} // namespace
+
+Result<std::unique_ptr<SharedMemoryServer>> SharedMemoryServer::Create(
+    Messenger* messenger, size_t num_channels, const std::string& server_uuid) {
+  if (server_uuid.size() > kMaxServerUuidSize) {
+    return STATUS_FORMAT(InvalidArgument, "Too long server uuid: $0", server_uuid);
+  }
+  auto segment = std::make_shared<SharedMemorySegment>(VERIFY_RESULT(SharedMemorySegment::Create(
+      SharedMemoryChannelsHeader::SegmentSize(num_channels))));
+  auto* header = new (segment->GetAddress()) SharedMemoryChannelsHeader(
+      num_channels, server_uuid);
+  for (size_t i = 0; i != num_channels; ++i) {
+    // Default initialization, so pipe buffers are not touched and do not consume memory.
+    new (&header->channel(i)) SharedMemoryChannel;
+  }
+  std::unique_ptr<SharedMemoryServer> result(new SharedMemoryServer(messenger, std::move(segment)));
+  RETURN_NOT_OK(result->Start());
+  return result;
+}
+
+SharedMemoryServer::SharedMemoryServer(
+    Messenger* messenger, std::shared_ptr<SharedMemorySegment> segment)
+    : messenger_(messenger),
+      segment_(std::move(segment)),
+      header_(static_cast<SharedMemoryChannelsHeader*>(segment_->GetAddress())),
+      call_tracker_(MemTracker::FindOrCreateTracker(
+          "Shared Memory", MemTracker::FindOrCreateTracker(
+              "Call", messenger->parent_mem_tracker()))),
+      channels_(header_->num_channels) {
+}
+
+SharedMemoryServer::~SharedMemoryServer() {
+  Shutdown();
+}
+
+Status SharedMemoryServer::Start() {
+  return Thread::Create("rpc", "shm_dispatcher", &SharedMemoryServer::Run, this, &thread_);
+}
+
+int SharedMemoryServer::fd() const {
+  return segment_->GetFd();
+}
+
+void SharedMemoryServer::Shutdown() {
+  if (stop_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  if (thread_) {
+    header_->requests_written.Notify();
+    thread_->Join();
+  }
+  // Clients fall back to the network after their channel breaks.
+  for (auto& channel : channels_) {
+    if (channel) {
+      channel->Break();
+    }
+  }
+  channels_.clear();
+}
+
+void SharedMemoryServer::Run() {
+  const auto kCheckOwnersInterval = 1s;
+  auto next_check_owners = CoarseMonoClock::now() + kCheckOwnersInterval;
+  while (!stop_.load(std::memory_order_acquire)) {
+    const auto seq = header_->requests_written.Prepare();
+    const auto now = CoarseMonoClock::now();
+    const bool check_owners = now >= next_check_owners;
+    if (check_owners) {
+      next_check_owners = now + kCheckOwnersInterval;
+    }
+    bool has_requests = false;
+    for (size_t i = 0; i != header_->num_channels; ++i) {
+      auto& channel = header_->channel(i);
+      auto owner_pid = channel.owner_pid.load(std::memory_order_acquire);
+      if (owner_pid == 0) {
+        continue;
+      }
+      switch (channel.state.load(std::memory_order_acquire)) {
+        case SharedMemoryChannelState::kFree:
+          // The client died while claiming the channel.
+          if (check_owners && !ProcessAlive(owner_pid)) {
+            channel.owner_pid.compare_exchange_strong(owner_pid, 0);
+          }
+          break;
+        case SharedMemoryChannelState::kActive:
+          if (check_owners && !ProcessAlive(owner_pid)) {
+            CloseChannel(i);
+          } else if (ProcessChannel(i)) {
+            has_requests = true;
+          }
+          break;
+        case SharedMemoryChannelState::kBroken:
+          if (check_owners && !ProcessAlive(owner_pid)) {
+            CloseChannel(i);
+          }
+          break;
+        case SharedMemoryChannelState::kClosed:
+          CloseChannel(i);
+          break;
+      }
+    }
+    if (!has_requests) {
+      header_->requests_written.Wait(seq, kWaitSlice);
+    }
+  }
+}
+
+bool SharedMemoryServer::ProcessChannel(size_t idx) {
+  auto& channel = header_->channel(idx);
+  auto& server_channel = channels_[idx];
+  if (!server_channel) {
+    server_channel = std::make_shared<SharedMemoryServerChannel>(segment_, &channel);
+  }
+  auto result = server_channel->reader().Read(
+      &channel.requests, [this, &server_channel](CallData* call_data) {
+        return HandleCall(server_channel, call_data);
+      });
+  if (!result.ok()) {
+    LOG(WARNING) << "Failed to process requests from process " << server_channel->owner_pid()
+                 << ": " << result.status();
+    server_channel->Break();
+    return false;
+  }
+  return *result;
+}
+
+Status SharedMemoryServer::HandleCall(
+    const std::shared_ptr<SharedMemoryServerChannel>& channel, CallData* call_data) {
+  auto call = InboundCall::Create<SharedMemoryInboundCall>(&messenger_->rpc_metrics(), channel);
+  RETURN_NOT_OK(call->ParseFrom(call_tracker_, call_data));
+  messenger_->QueueInboundCall(call);
+  return Status::OK();
+}
+
+void SharedMemoryServer::CloseChannel(size_t idx) {
+  auto& server_channel = channels_[idx];
+  if (server_channel) {
+    // Waits for responses that are being written to finish.
+    server_channel->Close();
+    server_channel.reset();
+  }
+  auto& channel = header_->channel(idx);
+  channel.state.store(SharedMemoryChannelState::kFree, std::memory_order_release);
+  channel.owner_pid.store(0, std::memory_order_release);
+}
+
+Result<std::unique_ptr<SharedMemoryClient>> SharedMemoryClient::Connect(int fd) {
+  const int own_fd = dup(fd);
+  if (own_fd == -1) {
+    return STATUS_FORMAT(
+        IOError, "Failed to duplicate shared memory descriptor $0: $1", fd, ErrnoToString(errno));
+  }
+  bool close_fd = true;
+  auto se = ScopeExit([own_fd, &close_fd] {
+    if (close_fd) {
+      close(own_fd);
+    }
+  });
+  struct stat st;
+  if (fstat(own_fd, &st) == -1) {
+    return STATUS_FORMAT(
+        IOError, "Failed to stat shared memory descriptor $0: $1", fd, ErrnoToString(errno));
+  }
+  if (st.st_size < sizeof(SharedMemoryChannelsHeader)) {
+    return STATUS_FORMAT(Corruption, "Shared memory channels segment is too small: $0",
+                         st.st_size);
+  }
+  auto* header = static_cast<SharedMemoryChannelsHeader*>(
+      mmap(nullptr, sizeof(SharedMemoryChannelsHeader), PROT_READ, MAP_SHARED, own_fd, 0));
+  if (header == MAP_FAILED) {
+    return STATUS_FORMAT(
+        IOError, "Failed to map shared memory descriptor $0: $1", fd, ErrnoToString(errno));
+  }
+  const bool valid = header->magic == kSharedMemoryChannelsMagic &&
+                     SharedMemoryChannelsHeader::SegmentSize(header->num_channels) == st.st_size &&
+                     header->server_uuid_size <= kMaxServerUuidSize;
+  munmap(header, sizeof(SharedMemoryChannelsHeader));
+  if (!valid) {
+    return STATUS_FORMAT(Corruption, "Invalid shared memory channels segment of size $0",
+                         st.st_size);
+  }
+
+  auto segment = VERIFY_RESULT(SharedMemorySegment::Open(
+      own_fd, SharedMemorySegment::AccessMode::kReadWrite, st.st_size));
+  // The segment owns the descriptor from now on.
+  close_fd = false;
+  header = static_cast<SharedMemoryChannelsHeader*>(segment.GetAddress());
+
+  const pid_t pid = getpid();
+  for (size_t i = 0; i != header->num_channels; ++i) {
+    auto& channel = header->channel(i);
+    pid_t expected = 0;
+    if (!channel.owner_pid.compare_exchange_strong(expected, pid)) {
+      continue;
+    }
+    channel.requests.Reset();
+    channel.responses.Reset();
+    channel.state.store(SharedMemoryChannelState::kActive, std::memory_order_release);
+    std::unique_ptr<SharedMemoryClient> result(
+        new SharedMemoryClient(std::move(segment), &channel));
+    RETURN_NOT_OK(result->Start());
+    return result;
+  }
+
+  return STATUS_FORMAT(
+      ServiceUnavailable, "All $0 shared memory channels are in use", header->num_channels);
+}
+
+SharedMemoryClient::SharedMemoryClient(SharedMemorySegment segment, SharedMemoryChannel* channel)
+    : segment_(std::move(segment)),
+      header_(static_cast<SharedMemoryChannelsHeader*>(segment_.GetAddress())),
+      channel_(channel),
+      server_uuid_(header_->server_uuid, header_->server_uuid_size) {
+}
+
+void SharedMemoryClient::AddRemote(const std::string& server_uuid, const HostPort& remote) {
+  if (server_uuid != server_uuid_) {
+    return;
+  }
+  std::lock_guard<rw_spinlock> lock(remotes_mutex_);
+  if (remotes_.insert(remote).second) {
+    LOG(INFO) << "Sending calls to " << remote << " through shared memory channel to server "
+              << server_uuid_;
+  }
+}
+
+bool SharedMemoryClient::Serves(const HostPort& remote) const {
+  SharedLock<rw_spinlock> lock(remotes_mutex_);
+  return remotes_.count(remote) != 0;
+}
+
+SharedMemoryClient::~SharedMemoryClient() {
+  Shutdown();
+}
+
+Status SharedMemoryClient::Start() {
+  return Thread::Create("rpc", "shm_client", &SharedMemoryClient::Run, this, &thread_);
+}
+
+void SharedMemoryClient::Shutdown() {
+  if (shutdown_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  usable_.store(false, std::memory_order_release);
+  if (thread_) {
+    channel_->responses.readable().Notify();
+    thread_->Join();
+  }
+  FailPendingCalls(STATUS(Aborted, "Shared memory client is shutting down"));
+  for (auto state : {SharedMemoryChannelState::kActive, SharedMemoryChannelState::kBroken}) {
+    if (channel_->state.compare_exchange_strong(state, SharedMemoryChannelState::kClosed)) {
+      break;
+    }
+  }
+  header_->requests_written.Notify();
+}
+
+bool SharedMemoryClient::Send(const OutboundCallPtr& call) {
+  if (!usable_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  // The server breaks the channel when it shuts down, calls written to it would never be answered.
+  if (channel_->state.load(std::memory_order_acquire) != SharedMemoryChannelState::kActive) {
+    Break(STATUS(NetworkError, "Shared memory channel was closed by server"));
+    return false;
+  }
+
+  const MonoDelta timeout = call->controller()->timeout();
+  const auto deadline =
+      timeout.Initialized() ? CoarseMonoClock::now() + timeout : CoarseTimePoint::max();
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_calls_.emplace(call->call_id(), PendingCall{call, deadline});
+  }
+  // The channel could break before the call was added, and nobody would complete it then.
+  if (!usable_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_calls_.erase(call->call_id());
+    return false;
+  }
+  call->SetQueued();
+
+  boost::container::small_vector<RefCntBuffer, 4> buffers;
+  call->Serialize(&buffers);
+  Status status;
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    for (const auto& buffer : buffers) {
+      status = channel_->requests.Write(buffer.AsSlice(), [this] {
+        return CheckChannel();
+      });
+      if (!status.ok()) {
+        break;
+      }
+    }
+  }
+  header_->requests_written.Notify();
+
+  if (!status.ok()) {
+    // Part of the request could be already written, so the channel cannot be used anymore.
+    Break(status);
+    return true;
+  }
+  call->SetSent();
+  return true;
+}
+
+Status SharedMemoryClient::CheckChannel() {
+  if (!usable_.load(std::memory_order_acquire)) {
+    return STATUS(Aborted, "Shared memory client is shutting down");
+  }
+  if (channel_->state.load(std::memory_order_acquire) != SharedMemoryChannelState::kActive) {
+    return STATUS(NetworkError, "Shared memory channel was closed by server");
+  }
+  if (!ProcessAlive(header_->server_pid)) {
+    return STATUS_FORMAT(NetworkError, "Server process $0 is not alive", header_->server_pid);
+  }
+  return Status::OK();
+}
+
+void SharedMemoryClient::Run() {
+  SharedMemoryFrameReader reader;
+  while (usable_.load(std::memory_order_acquire)) {
+    const auto seq = channel_->responses.readable().Prepare();
+    auto result = reader.Read(&channel_->responses, [this](CallData* call_data) {
+      return HandleResponse(call_data);
+    });
+    if (!result.ok()) {
+      Break(result.status());
+      return;
+    }
+    if (!*result) {
+      auto status = CheckChannel();
+      if (!status.ok()) {
+        if (usable_.load(std::memory_order_acquire)) {
+          Break(status);
+        }
+        return;
+      }
+    }
+    ExpireCalls(CoarseMonoClock::now());
+    if (!*result) {
+      channel_->responses.readable().Wait(seq, kWaitSlice);
+    }
+  }
+}
+
+Status SharedMemoryClient::HandleResponse(CallData* call_data) {
+  CallResponse response;
+  RETURN_NOT_OK(response.ParseFrom(call_data));
+
+  OutboundCallPtr call;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    auto it = pending_calls_.find(response.call_id());
+    if (it != pending_calls_.end()) {
+      call = std::move(it->second.call);
+      pending_calls_.erase(it);
+    }
+  }
+  if (!call) {
+    // The call already failed due to a timeout.
+    VLOG(1) << "Got response to call id " << response.call_id() << " after client timed out";
+    return Status::OK();
+  }
+
+  call->SetResponse(std::move(response));
+  return Status::OK();
+}
+
+void SharedMemoryClient::Break(const Status& status) {
+  LOG(WARNING) << "Shared memory channel to server " << server_uuid_ << " broken: " << status;
+  usable_.store(false, std::memory_order_release);
+  auto expected = SharedMemoryChannelState::kActive;
+  channel_->state.compare_exchange_strong(expected, SharedMemoryChannelState::kBroken);
+  FailPendingCalls(status);
+}
+
+void SharedMemoryClient::FailPendingCalls(const Status& status) {
+  std::unordered_map<int32_t, PendingCall> pending_calls;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_calls.swap(pending_calls_);
+  }
+  for (auto& pending_call : pending_calls) {
+    pending_call.second.call->SetFailed(status);
+  }
+}
+
+void SharedMemoryClient::ExpireCalls(CoarseTimePoint now) {
+  std::vector<OutboundCallPtr> expired_calls;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    for (auto it = pending_calls_.begin(); it != pending_calls_.end();) {
+      if (it->second.deadline <= now) {
+        expired_calls.push_back(std::move(it->second.call));
+        it = pending_calls_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto& call : expired_calls) {
+    call->SetTimedOut();
+  }
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,173 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_SHARED_MEMORY_CHANNEL_H
+#define YB_RPC_SHARED_MEMORY_CHANNEL_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/monotime.h"
+#include "yb/util/net/net_util.h"
+#include "yb/util/result.h"
+#include "yb/util/shared_mem.h"
+
+namespace yb {
+
+class MemTracker;
+class Thread;
+
+namespace rpc {
+
+class SharedMemoryServerChannel;
+struct SharedMemoryChannel;
+struct SharedMemoryChannelsHeader;
+
+// Shared memory transport for calls from processes running on the same host as the server, such
+// as PostgreSQL backends talking to the local tablet server. It bypasses the network stack and
+// reactor threads on both sides.
+//
+// The server creates a shared memory segment with a fixed number of channels, and passes its file
+// descriptor to the local processes. The segment also holds uuid of the server, so clients send
+// through it only calls addressed to that server, whatever address they use to reach it. A client
+// claims a free channel, that consists of a pipe for requests and a pipe for responses. Calls use
+// the same wire format as over TCP, and waiting for data is done with futexes.
+//
+// The server reads requests of all channels from a single dispatcher thread, that enqueues them to
+// services as reactors do. Responses are written to the channel by the thread that responds.
+class SharedMemoryServer {
+ public:
+  static Result<std::unique_ptr<SharedMemoryServer>> Create(
+      Messenger* messenger, size_t num_channels, const std::string& server_uuid);
+
+  ~SharedMemoryServer();
+
+  // File descriptor of the shared memory segment, that should be passed to clients.
+  int fd() const;
+
+  void Shutdown();
+
+ private:
+  SharedMemoryServer(Messenger* messenger, std::shared_ptr<SharedMemorySegment> segment);
+
+  CHECKED_STATUS Start();
+
+  void Run();
+
+  // Reads requests of the channel with the specified index. Returns true if any data was read.
+  bool ProcessChannel(size_t idx);
+
+  CHECKED_STATUS HandleCall(
+      const std::shared_ptr<SharedMemoryServerChannel>& channel, CallData* call_data);
+
+  // Drops state of the channel with the specified index and makes it available to clients.
+  void CloseChannel(size_t idx);
+
+  Messenger* const messenger_;
+  const std::shared_ptr<SharedMemorySegment> segment_;
+  SharedMemoryChannelsHeader* const header_;
+  std::shared_ptr<MemTracker> call_tracker_;
+
+  // Server state of active channels. Accessed only by the dispatcher thread.
+  std::vector<std::shared_ptr<SharedMemoryServerChannel>> channels_;
+
+  std::atomic<bool> stop_{false};
+  scoped_refptr<Thread> thread_;
+};
+
+// Client side of a shared memory channel.
+class SharedMemoryClient {
+ public:
+  // Claims a free channel in the shared memory segment with the specified file descriptor. The
+  // descriptor is duplicated, so the caller keeps ownership of it.
+  static Result<std::unique_ptr<SharedMemoryClient>> Connect(int fd);
+
+  ~SharedMemoryClient();
+
+  // Uuid of the server that created the segment.
+  const std::string& server_uuid() const {
+    return server_uuid_;
+  }
+
+  // Calls to remote are sent through the channel from now on, if server_uuid is the uuid of the
+  // server that created the segment.
+  void AddRemote(const std::string& server_uuid, const HostPort& remote);
+
+  // Whether calls to remote could be sent through the channel.
+  bool Serves(const HostPort& remote) const;
+
+  // Sends the call through the channel. Returns false if the channel could not be used, in this
+  // case the call should be sent over the network.
+  bool Send(const OutboundCallPtr& call);
+
+  // Fails pending calls and releases the channel.
+  void Shutdown();
+
+ private:
+  struct PendingCall {
+    OutboundCallPtr call;
+    CoarseTimePoint deadline;
+  };
+
+  SharedMemoryClient(SharedMemorySegment segment, SharedMemoryChannel* channel);
+
+  CHECKED_STATUS Start();
+
+  void Run();
+
+  CHECKED_STATUS HandleResponse(CallData* call_data);
+
+  // Returns error if requests could not be sent through the channel anymore.
+  CHECKED_STATUS CheckChannel();
+
+  // Stops using the channel and fails all pending calls.
+  void Break(const Status& status);
+
+  void FailPendingCalls(const Status& status);
+
+  void ExpireCalls(CoarseTimePoint now);
+
+  SharedMemorySegment segment_;
+  SharedMemoryChannelsHeader* const header_;
+  SharedMemoryChannel* const channel_;
+  const std::string server_uuid_;
+
+  // Addresses that the client uses to reach the server.
+  mutable rw_spinlock remotes_mutex_;
+  std::unordered_set<HostPort, HostPortHash> remotes_;
+
+  // Set to false when the channel is broken or the client is shut down.
+  std::atomic<bool> usable_{true};
+  std::atomic<bool> shutdown_{false};
+
+  // Serializes writes of requests to the channel.
+  std::mutex send_mutex_;
+
+  std::mutex pending_mutex_;
+  std::unordered_map<int32_t, PendingCall> pending_calls_;
+
+  scoped_refptr<Thread> thread_;
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_SHARED_MEMORY_CHANNEL_H
@@ -14,16 +14,25 @@
 //
 
 #include <atomic>
+#include <functional>
 #include <thread>
 
 #include <gtest/gtest.h>
 
+#include "yb/gutil/casts.h"
+#include "yb/gutil/strings/util.h"
+
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/metrics.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
+DECLARE_bool(rpc_thread_per_core);
+
+METRIC_DEFINE_entity(test_entity);
+
 namespace yb {
 namespace rpc {
 
@@ -79,6 +88,29 @@ class TestTask final : public ThreadPoolTask {
   std::atomic<TestTaskState> state_ = { TestTaskState::IDLE };
 };
 
+class FunctorTask final : public ThreadPoolTask {
+ public:
+  FunctorTask() {}
+
+  void Init(std::function<void()> run, CountDownLatch* latch) {
+    run_ = std::move(run);
+    latch_ = latch;
+  }
+
+ private:
+  void Run() override {
+    run_();
+  }
+
+  void Done(const Status& status) override {
+    ASSERT_OK(status);
+    latch_->CountDown();
+  }
+
+  std::function<void()> run_;
+  CountDownLatch* latch_ = nullptr;
+};
+
 TEST_F(ThreadPoolTest, TestSingleThread) {
   constexpr size_t kTotalTasks = 100;
   constexpr size_t kTotalWorkers = 1;
@@ -113,11 +145,33 @@ TEST_F(ThreadPoolTest, TestSingleProducer) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestMultiProducers) {
+// Returns sum of values of per core thread pool gauges with the specified suffix, and the number of
+// such gauges.
+std::pair<int64_t, size_t> SumPerCoreGauges(
+    const scoped_refptr<MetricEntity>& entity, const std::string& suffix) {
+  std::pair<int64_t, size_t> result(0, 0);
+  for (const auto& entry : entity->UnsafeMetricsMapForTests()) {
+    const std::string name = entry.first->name();
+    if (!HasSuffixString(name, suffix)) {
+      continue;
+    }
+    if (suffix == "_steals") {
+      result.first += down_cast<AtomicGauge<uint64_t>*>(entry.second.get())->value();
+    } else {
+      result.first += down_cast<AtomicGauge<int64_t>*>(entry.second.get())->value();
+    }
+    ++result.second;
+  }
+  return result;
+}
+
+void TestMultiProducers(size_t total_workers) {
   constexpr size_t kTotalTasks = 10000;
-  constexpr size_t kTotalWorkers = 4;
   constexpr size_t kProducers = 4;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool("test", kTotalTasks, total_workers);
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_test_entity.Instantiate(&registry, "test");
+  pool.InstantiateMetrics(entity);
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -141,6 +195,210 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   for (auto& thread : threads) {
     thread.join();
   }
+
+  auto queue_depth = SumPerCoreGauges(entity, "_queue_depth");
+  auto steals = SumPerCoreGauges(entity, "_steals");
+  LOG(INFO) << "Workers: " << total_workers << ", lanes: " << queue_depth.second
+            << ", steals: " << steals.first;
+  if (FLAGS_rpc_thread_per_core) {
+    ASSERT_EQ(queue_depth.second, std::min(GetAffinityCpus().size(), total_workers));
+    ASSERT_EQ(steals.second, queue_depth.second);
+  } else {
+    ASSERT_EQ(queue_depth.second, 0U);
+  }
+  // All tasks were taken from the lanes they were queued to.
+  ASSERT_EQ(queue_depth.first, 0);
+}
+
+TEST_F(ThreadPoolTest, TestMultiProducers) {
+  TestMultiProducers(4 /* total_workers */);
+}
+
+// Tasks are queued to the lanes of producer cores, and workers steal them from lanes that don't
+// have own workers.
+TEST_F(ThreadPoolTest, TestMultiProducersThreadPerCore) {
+  FLAGS_rpc_thread_per_core = true;
+  TestMultiProducers(2 /* total_workers */);
+  TestMultiProducers(64 /* total_workers */);
+}
+
+// Two tasks are queued to the lane of one core, and the first one waits for the second one, so the
+// second one has to be stolen by the worker of the other lane.
+TEST_F(ThreadPoolTest, TestStealThreadPerCore) {
+  FLAGS_rpc_thread_per_core = true;
+  const auto cpus = GetAffinityCpus();
+  if (cpus.size() < 2) {
+    LOG(INFO) << "Test requires at least 2 CPUs, available: " << yb::ToString(cpus);
+    return;
+  }
+  ThreadPool pool(ThreadPoolOptions{
+      "test", 10 /* queue_limit */, 2 /* max_workers */, {cpus[0], cpus[1]}});
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_test_entity.Instantiate(&registry, "test");
+  pool.InstantiateMetrics(entity);
+
+  CountDownLatch second_done(1);
+  CountDownLatch latch(2);
+  std::vector<FunctorTask> tasks(2);
+  tasks[0].Init([&second_done] { second_done.Wait(); }, &latch);
+  tasks[1].Init([&second_done] { second_done.CountDown(); }, &latch);
+  std::thread producer([&pool, &tasks, cpu = cpus[0]] {
+    CDSAttacher attacher;
+    ASSERT_OK(PinCurrentThreadToCpu(cpu));
+    for (auto& task : tasks) {
+      ASSERT_TRUE(pool.Enqueue(&task));
+    }
+  });
+  producer.join();
+  latch.Wait();
+
+  ASSERT_EQ(SumPerCoreGauges(entity, "_queue_depth"), std::make_pair<int64_t, size_t>(0, 2));
+  ASSERT_EQ(SumPerCoreGauges(entity, "_steals"), std::make_pair<int64_t, size_t>(1, 2));
+}
+
+// Every CPU gets own lane even with a single worker, and a task queued by a thread pinned to a CPU
+// without workers is stolen by the worker of another lane.
+TEST_F(ThreadPoolTest, TestLanePerCpu) {
+  FLAGS_rpc_thread_per_core = true;
+  const auto cpus = GetAffinityCpus();
+  if (cpus.size() < 2) {
+    LOG(INFO) << "Test requires at least 2 CPUs, available: " << yb::ToString(cpus);
+    return;
+  }
+  ThreadPool pool("test", 10 /* queue_limit */, 1 /* max_workers */);
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_test_entity.Instantiate(&registry, "test");
+  pool.InstantiateMetrics(entity);
+
+  CountDownLatch latch(1);
+  FunctorTask task;
+  task.Init([] {}, &latch);
+  std::thread producer([&pool, &task, cpu = cpus.back()] {
+    CDSAttacher attacher;
+    ASSERT_OK(PinCurrentThreadToCpu(cpu));
+    ASSERT_TRUE(pool.Enqueue(&task));
+  });
+  producer.join();
+  latch.Wait();
+
+  ASSERT_EQ(SumPerCoreGauges(entity, "_queue_depth"),
+            std::make_pair<int64_t, size_t>(0, cpus.size()));
+  ASSERT_EQ(SumPerCoreGauges(entity, "_steals"),
+            std::make_pair<int64_t, size_t>(1, cpus.size()));
+}
+
+// Each task enqueues the next task of its chain, so those are executed from the local queues
+// of workers, or stolen by other workers.
+TEST_F(ThreadPoolTest, TestContinuations) {
+  constexpr size_t kChains = 100;
+  constexpr size_t kChainLength = 100;
+  constexpr size_t kTotalWorkers = 4;
+  ThreadPool pool("test", kChains, kTotalWorkers);
+
+  CountDownLatch latch(kChains * kChainLength);
+  std::vector<FunctorTask> tasks(kChains * kChainLength);
+  for (size_t i = 0; i != tasks.size(); ++i) {
+    auto next = (i + 1) % kChainLength == 0 ? nullptr : &tasks[i + 1];
+    tasks[i].Init([&pool, next] {
+      ASSERT_TRUE(pool.OwnsThisThread());
+      if (next) {
+        ASSERT_TRUE(pool.Enqueue(next));
+      }
+    }, &latch);
+  }
+  for (size_t i = 0; i != kChains; ++i) {
+    ASSERT_TRUE(pool.Enqueue(&tasks[i * kChainLength]));
+  }
+  latch.Wait();
+}
+
+// Checks that a chain of continuations is executed, when other workers are idle and could steal
+// them.
+TEST_F(ThreadPoolTest, TestContinuationsWithIdleWorkers) {
+  constexpr size_t kTotalWorkers = 4;
+  constexpr size_t kChainLength = 100;
+  ThreadPool pool("test", kChainLength, kTotalWorkers);
+
+  // Start all workers, so there are idle workers that could steal continuations.
+  {
+    CountDownLatch started(kTotalWorkers);
+    CountDownLatch latch(kTotalWorkers);
+    std::vector<FunctorTask> tasks(kTotalWorkers);
+    for (auto& task : tasks) {
+      task.Init([&started] {
+        started.CountDown();
+        started.Wait();
+      }, &latch);
+      ASSERT_TRUE(pool.Enqueue(&task));
+    }
+    latch.Wait();
+  }
+
+  CountDownLatch latch(kChainLength);
+  std::vector<FunctorTask> tasks(kChainLength);
+  for (size_t i = 0; i != tasks.size(); ++i) {
+    auto next = i + 1 == tasks.size() ? nullptr : &tasks[i + 1];
+    tasks[i].Init([&pool, next] {
+      if (next) {
+        ASSERT_TRUE(pool.Enqueue(next));
+      }
+    }, &latch);
+  }
+  ASSERT_TRUE(pool.Enqueue(&tasks.front()));
+  latch.Wait();
+}
+
+// Checks that a continuation is executed by another worker, while the worker that enqueued it is
+// blocked waiting for it.
+TEST_F(ThreadPoolTest, TestBlockedOnContinuation) {
+  ThreadPool pool("test", 2 /* max_tasks */, 2 /* max_workers */);
+
+  CountDownLatch latch(2);
+  CountDownLatch continuation_done(1);
+  FunctorTask continuation;
+  continuation.Init([&continuation_done] {
+    continuation_done.CountDown();
+  }, &latch);
+  FunctorTask task;
+  task.Init([&pool, &continuation, &continuation_done] {
+    ASSERT_TRUE(pool.Enqueue(&continuation));
+    ASSERT_TRUE(continuation_done.WaitFor(MonoDelta::FromSeconds(10)));
+  }, &latch);
+  ASSERT_TRUE(pool.Enqueue(&task));
+  latch.Wait();
+}
+
+// Checks that high priority task is executed before normal tasks enqueued earlier.
+TEST_F(ThreadPoolTest, TestHighPriority) {
+  constexpr size_t kNormalTasks = 10;
+  ThreadPool pool("test", kNormalTasks + 2, 1 /* max_workers */);
+
+  CountDownLatch started(1);
+  CountDownLatch release(1);
+  CountDownLatch latch(kNormalTasks + 2);
+  std::atomic<size_t> executed(0);
+  std::vector<size_t> order(kNormalTasks + 1);
+  std::vector<FunctorTask> tasks(kNormalTasks + 2);
+  tasks[0].Init([&started, &release] {
+    started.CountDown();
+    release.Wait();
+  }, &latch);
+  for (size_t i = 1; i != tasks.size(); ++i) {
+    tasks[i].Init([&executed, &order, i] {
+      order[i - 1] = executed++;
+    }, &latch);
+  }
+
+  ASSERT_TRUE(pool.Enqueue(&tasks[0]));
+  started.Wait();
+  for (size_t i = 1; i <= kNormalTasks; ++i) {
+    ASSERT_TRUE(pool.Enqueue(&tasks[i]));
+  }
+  ASSERT_TRUE(pool.Enqueue(&tasks.back(), ServicePriority::kHigh));
+  release.CountDown();
+  latch.Wait();
+
+  ASSERT_EQ(0, order.back());
 }
 
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
@@ -15,7 +15,11 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <sched.h>
+
+#include <algorithm>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <thread>
 
@@ -23,9 +27,27 @@
 #include <cds/gc/dhp.h>
 
 #include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/thread.h"
 
+DEFINE_bool(rpc_thread_per_core, false,
+            "Pin reactor threads and RPC workers to CPU cores. Each core gets its own queue of RPC "
+            "tasks, so inbound calls are handled on the core of the reactor that received them "
+            "when possible, and idle workers steal tasks queued on other cores.");
+TAG_FLAG(rpc_thread_per_core, advanced);
+
+DEFINE_int32(rpc_continuation_steal_delay_us, 1000,
+             "Continuations enqueued by an RPC worker are executed by that worker, but idle "
+             "workers steal them when they were not picked up during this time, for instance "
+             "because the enqueuing worker is blocked waiting for them.");
+TAG_FLAG(rpc_continuation_steal_delay_us, advanced);
+TAG_FLAG(rpc_continuation_steal_delay_us, runtime);
+
+using namespace std::literals;
+
 namespace yb {
 namespace rpc {
 
@@ -36,25 +58,121 @@ class Worker;
 typedef cds::container::BasketQueue<cds::gc::DHP, ThreadPoolTask*> TaskQueue;
 typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
-struct ThreadPoolShare {
-  ThreadPoolOptions options;
+// Tasks enqueued on a particular core, and workers pinned to it.
+// Thread pool has a single lane when thread per core mode is disabled.
+struct ThreadPoolLane {
+  // CPU that workers of this lane are pinned to, -1 when thread per core mode is disabled.
+  int cpu = -1;
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
 
+  // Instantiated only in thread per core mode.
+  scoped_refptr<AtomicGauge<int64_t>> queue_depth;
+  scoped_refptr<AtomicGauge<uint64_t>> steals;
+
+  bool Pop(ThreadPoolTask** task) {
+    if (!task_queue.pop(*task)) {
+      return false;
+    }
+    if (queue_depth) {
+      queue_depth->Decrement();
+    }
+    return true;
+  }
+};
+
+// Continuation tasks, i.e. tasks enqueued by a worker of the same pool. The owner executes them
+// in LIFO order, while their data is still hot in its cache, and other workers steal them in
+// FIFO order, once they waited for rpc_continuation_steal_delay_us.
+struct WorkerQueue {
+  struct Entry {
+    ThreadPoolTask* task;
+    CoarseTimePoint queued_time;
+  };
+
+  std::mutex mutex;
+  std::deque<Entry> tasks;
+};
+
+struct ThreadPoolShare {
+  ThreadPoolOptions options;
+  std::vector<std::unique_ptr<ThreadPoolLane>> lanes;
+
+  // Tasks enqueued with high priority, they are taken before any other tasks.
+  TaskQueue high_priority_queue;
+
+  // Local queues of created workers, indexed by worker index.
+  std::vector<std::atomic<WorkerQueue*>> worker_queues;
+
+  // Total number of tasks in local queues, so workers don't scan them when they are empty.
+  std::atomic<size_t> local_tasks{0};
+
+  // Index of the lane by CPU, for CPUs that have own lane.
+  std::vector<ssize_t> cpu_to_lane;
+
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)), worker_queues(options.max_workers) {
+    if (!FLAGS_rpc_thread_per_core) {
+      lanes.push_back(std::make_unique<ThreadPoolLane>());
+      return;
+    }
+    // Every CPU gets own lane, even when there are fewer workers than CPUs. Tasks queued to lanes
+    // without workers are stolen by workers of other lanes.
+    const auto cpus = options.cpus.empty() ? GetAffinityCpus() : options.cpus;
+    const size_t num_lanes = std::max<size_t>(cpus.size(), 1);
+    lanes.reserve(num_lanes);
+    while (lanes.size() != num_lanes) {
+      const int cpu = cpus[lanes.size()];
+      if (cpu_to_lane.size() <= static_cast<size_t>(cpu)) {
+        cpu_to_lane.resize(cpu + 1, -1);
+      }
+      cpu_to_lane[cpu] = lanes.size();
+      lanes.push_back(std::make_unique<ThreadPoolLane>());
+      lanes.back()->cpu = cpu;
+    }
+  }
+
+  ~ThreadPoolShare() {
+    for (auto& queue : worker_queues) {
+      delete queue.load(std::memory_order_acquire);
+    }
+  }
+
+  // Lane of the core that the current thread is pinned to, for instance the core of the reactor
+  // that received an inbound call. Otherwise lane of the core that the thread is running on.
+  ThreadPoolLane& CurrentLane() {
+    if (lanes.size() == 1) {
+      return *lanes.front();
+    }
+    const int pinned_cpu = CurrentThreadPinnedCpu();
+#if defined(__APPLE__)
+    // OSX doesn't have a way to get the CPU, so we'll pick one by thread id.
+    size_t cpu = pinned_cpu >= 0
+        ? pinned_cpu : std::hash<std::thread::id>()(std::this_thread::get_id());
+#else
+    size_t cpu = pinned_cpu >= 0 ? pinned_cpu : sched_getcpu();
+#endif // defined(__APPLE__)
+    if (cpu < cpu_to_lane.size() && cpu_to_lane[cpu] >= 0) {
+      return *lanes[cpu_to_lane[cpu]];
+    }
+    return *lanes[cpu % lanes.size()];
+  }
 };
 
 namespace {
 
 const std::string kRpcThreadCategory = "rpc_thread_pool";
 
+thread_local Worker* current_worker = nullptr;
+
 } // namespace
 
 class Worker {
  public:
   explicit Worker(ThreadPoolShare* share, size_t index)
-      : share_(share) {
+      : share_(share), lane_index_(index % share->lanes.size()),
+        lane_(share->lanes[lane_index_].get()), queue_(new WorkerQueue) {
+    share_->worker_queues[index].store(queue_, std::memory_order_release);
     auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
     CHECK_OK(yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_));
   }
@@ -66,6 +184,19 @@ class Worker {
   Worker(const Worker& worker) = delete;
   void operator=(const Worker& worker) = delete;
 
+  // Returns worker of the pool with the specified share, that runs the current thread.
+  static Worker* Current(ThreadPoolShare* share) {
+    return current_worker && current_worker->share_ == share ? current_worker : nullptr;
+  }
+
+  void PushLocal(ThreadPoolTask* task) {
+    {
+      std::lock_guard<std::mutex> lock(queue_->mutex);
+      queue_->tasks.push_back({task, CoarseMonoClock::Now()});
+    }
+    share_->local_tasks.fetch_add(1, std::memory_order_acq_rel);
+  }
+
   void Stop() {
     stop_requested_ = true;
     std::lock_guard<std::mutex> lock(mutex_);
@@ -94,6 +225,12 @@ class Worker {
   // does not have free hands (worker queue empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    current_worker = this;
+    if (lane_->cpu >= 0) {
+      auto status = PinCurrentThreadToCpu(lane_->cpu);
+      LOG_IF(WARNING, !status.ok()) << "Failed to pin worker to CPU " << lane_->cpu << ": "
+                                    << status;
+    }
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -106,7 +243,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (TryPopTask(task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -122,36 +259,126 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (TryPopTask(task)) {
         return true;
       }
 
-      cond_.wait(lock);
+      // Continuations of other workers could not be stolen yet, so wake up when the first of them
+      // could be, in case its owner did not pick it up.
+      if (next_steal_time_ == CoarseTimePoint::max()) {
+        cond_.wait(lock);
+      } else {
+        cond_.wait_for(lock, next_steal_time_ - CoarseMonoClock::Now());
+      }
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (TryPopTask(task)) {
         return true;
       }
     }
     return false;
   }
 
+  // Takes task in the following order: high priority tasks, continuations of this worker,
+  // tasks of the lane of this worker. When there is nothing to do, steals tasks from other lanes
+  // and then continuations of other workers.
+  bool TryPopTask(ThreadPoolTask** task) {
+    if (share_->high_priority_queue.pop(*task)) {
+      return true;
+    }
+    if (PopLocal(task)) {
+      return true;
+    }
+    if (lane_->Pop(task)) {
+      return true;
+    }
+    const auto num_lanes = share_->lanes.size();
+    for (size_t i = 1; i < num_lanes; ++i) {
+      if (share_->lanes[(lane_index_ + i) % num_lanes]->Pop(task)) {
+        IncrementSteals();
+        return true;
+      }
+    }
+    if (StealLocal(task)) {
+      IncrementSteals();
+      return true;
+    }
+    return false;
+  }
+
+  bool PopLocal(ThreadPoolTask** task) {
+    if (share_->local_tasks.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(queue_->mutex);
+    if (queue_->tasks.empty()) {
+      return false;
+    }
+    *task = queue_->tasks.back().task;
+    queue_->tasks.pop_back();
+    share_->local_tasks.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+  }
+
+  // Steals the oldest continuation of another worker, that waited long enough for its owner.
+  // Otherwise sets next_steal_time_ to the time when the first of them could be stolen.
+  bool StealLocal(ThreadPoolTask** task) {
+    next_steal_time_ = CoarseTimePoint::max();
+    if (share_->local_tasks.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    const auto steal_delay = FLAGS_rpc_continuation_steal_delay_us * 1us;
+    const auto now = CoarseMonoClock::Now();
+    for (const auto& entry : share_->worker_queues) {
+      auto* queue = entry.load(std::memory_order_acquire);
+      if (!queue || queue == queue_) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      if (queue->tasks.empty()) {
+        continue;
+      }
+      const auto steal_time = queue->tasks.front().queued_time + steal_delay;
+      if (steal_time > now) {
+        next_steal_time_ = std::min(next_steal_time_, steal_time);
+        continue;
+      }
+      *task = queue->tasks.front().task;
+      queue->tasks.pop_front();
+      share_->local_tasks.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+    return false;
+  }
+
+  void IncrementSteals() {
+    if (lane_->steals) {
+      lane_->steals->Increment();
+    }
+  }
+
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
-      auto pushed = share_->waiting_workers.push(this);
+      auto pushed = lane_->waiting_workers.push(this);
       DCHECK(pushed); // BasketQueue always succeed.
       added_to_waiting_workers_ = true;
     }
   }
 
   ThreadPoolShare* share_;
+  const size_t lane_index_;
+  ThreadPoolLane* const lane_;
+  // Owned by share, since other workers could steal from it.
+  WorkerQueue* const queue_;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
   std::atomic<bool> stop_requested_ = {false};
   bool waiting_task_ = false;
   bool added_to_waiting_workers_ = false;
+  // Time when a continuation of another worker could be stolen, set by StealLocal.
+  CoarseTimePoint next_steal_time_ = CoarseTimePoint::max();
 };
 
 } // namespace
@@ -174,18 +401,65 @@ class ThreadPool::Impl {
     return share_.options;
   }
 
-  bool Enqueue(ThreadPoolTask* task) {
+  void InstantiateMetrics(const scoped_refptr<MetricEntity>& entity) {
+    for (const auto& lane_ptr : share_.lanes) {
+      auto& lane = *lane_ptr;
+      if (lane.cpu < 0) {
+        return;
+      }
+      auto prefix = Format("rpc_tp_$0_core_$1_", share_.options.name, lane.cpu);
+      EscapeMetricNameForPrometheus(&prefix);
+      auto id = prefix + "queue_depth";
+      auto description = Format("Number of RPC tasks queued on core $0 of $1 thread pool",
+                                lane.cpu, share_.options.name);
+      lane.queue_depth = entity->FindOrCreateGauge(
+          std::unique_ptr<GaugePrototype<int64_t>>(new OwningGaugePrototype<int64_t>(
+              entity->prototype().name(), std::move(id),
+              description, MetricUnit::kTasks, description)),
+          static_cast<int64_t>(0) /* initial_value */);
+      id = prefix + "steals";
+      description = Format("Number of RPC tasks stolen by workers of core $0 of $1 thread pool",
+                           lane.cpu, share_.options.name);
+      lane.steals = entity->FindOrCreateGauge(
+          std::unique_ptr<GaugePrototype<uint64_t>>(new OwningGaugePrototype<uint64_t>(
+              entity->prototype().name(), std::move(id),
+              description, MetricUnit::kTasks, description, EXPOSE_AS_COUNTER)),
+          static_cast<uint64_t>(0) /* initial_value */);
+    }
+  }
+
+  bool Enqueue(ThreadPoolTask* task, ServicePriority priority) {
     ++adding_;
     if (closing_) {
       --adding_;
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
-    DCHECK(added); // BasketQueue always succeed.
-    Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
+    auto& lane = share_.CurrentLane();
+    Worker* current = nullptr;
+    if (priority == ServicePriority::kHigh) {
+      bool added = share_.high_priority_queue.push(task);
+      DCHECK(added); // BasketQueue always succeed.
+    } else if ((current = Worker::Current(&share_)) != nullptr) {
+      // The current worker takes the continuation as soon as it finishes its task. But it could
+      // block waiting for the continuation, so an idle worker is still woken up. It steals the
+      // continuation only if it was not picked up during rpc_continuation_steal_delay_us.
+      current->PushLocal(task);
+    } else {
+      bool added = lane.task_queue.push(task);
+      DCHECK(added); // BasketQueue always succeed.
+      if (lane.queue_depth) {
+        lane.queue_depth->Increment();
+      }
+    }
+    // Prefer worker of the current core, then wake up any other waiting worker, it would steal
+    // the task.
+    if (NotifyWaitingWorker(&lane)) {
+      --adding_;
+      return true;
+    }
+    for (const auto& other_lane : share_.lanes) {
+      if (other_lane.get() != &lane && NotifyWaitingWorker(other_lane.get())) {
         --adding_;
         return true;
       }
@@ -213,7 +487,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (const auto& lane : share_.lanes) {
+          CHECK(lane->task_queue.empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -232,9 +508,26 @@ class ThreadPool::Impl {
     }
     workers_.clear();
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
+    while (share_.high_priority_queue.pop(task)) {
       task->Done(shutdown_status_);
     }
+    for (const auto& lane : share_.lanes) {
+      while (lane->Pop(&task)) {
+        task->Done(shutdown_status_);
+      }
+    }
+    // All workers are stopped, so local queues could be accessed without locking.
+    for (const auto& entry : share_.worker_queues) {
+      auto* queue = entry.load(std::memory_order_acquire);
+      if (!queue) {
+        continue;
+      }
+      for (auto& local_entry : queue->tasks) {
+        local_entry.task->Done(shutdown_status_);
+      }
+      share_.local_tasks.fetch_sub(queue->tasks.size(), std::memory_order_acq_rel);
+      queue->tasks.clear();
+    }
   }
 
   bool Owns(Thread* thread) {
@@ -242,6 +535,16 @@ class ThreadPool::Impl {
   }
 
  private:
+  static bool NotifyWaitingWorker(ThreadPoolLane* lane) {
+    Worker* worker = nullptr;
+    while (lane->waiting_workers.pop(worker)) {
+      if (worker->Notify()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   ThreadPoolShare share_;
   std::vector<std::unique_ptr<Worker>> workers_;
   std::atomic<size_t> created_workers_ = {0};
@@ -276,8 +579,12 @@ bool ThreadPool::IsCurrentThreadRpcWorker() {
   return thread != nullptr && thread->category() == kRpcThreadCategory;
 }
 
-bool ThreadPool::Enqueue(ThreadPoolTask* task) {
-  return impl_->Enqueue(task);
+void ThreadPool::InstantiateMetrics(const scoped_refptr<MetricEntity>& entity) {
+  impl_->InstantiateMetrics(entity);
+}
+
+bool ThreadPool::Enqueue(ThreadPoolTask* task, ServicePriority priority) {
+  return impl_->Enqueue(task, priority);
 }
 
 void ThreadPool::Shutdown() {
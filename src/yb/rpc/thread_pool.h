@@ -18,13 +18,18 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/gutil/port.h"
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/rpc/rpc_fwd.h"
 
 #include "yb/util/tostring.h"
 
 namespace yb {
 
+class MetricEntity;
 class Status;
 class Thread;
 
@@ -46,9 +51,12 @@ struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
   size_t max_workers;
+  // CPUs that get own task queue in thread per core mode, all CPUs available to the process when
+  // empty.
+  std::vector<int> cpus;
 
   std::string ToString() const {
-    return YB_STRUCT_TO_STRING(name, queue_limit, max_workers);
+    return YB_STRUCT_TO_STRING(name, queue_limit, max_workers, cpus);
   }
 };
 
@@ -69,7 +77,15 @@ class ThreadPool {
 
   const ThreadPoolOptions& options() const;
 
-  bool Enqueue(ThreadPoolTask* task);
+  // Creates per core queue depth and steal count metrics, when running in thread per core mode.
+  // Should be invoked before tasks are enqueued.
+  void InstantiateMetrics(const scoped_refptr<MetricEntity>& entity);
+
+  // Tasks with high priority are executed before other tasks. Tasks enqueued by a worker of this
+  // pool are queued to the local queue of this worker, and are executed by it in LIFO order, unless
+  // stolen by idle workers. Such tasks don't wake up idle workers, so the worker should not block
+  // waiting for them.
+  bool Enqueue(ThreadPoolTask* task, ServicePriority priority = ServicePriority::kNormal);
   void Shutdown();
 
   static bool IsCurrentThreadRpcWorker();
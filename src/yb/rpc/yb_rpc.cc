@@ -102,7 +102,7 @@ YBConnectionContext::YBConnectionContext(
     const MemTrackerPtr& call_tracker)
     : parser_(buffer_tracker, kMsgLengthPrefixLength, 0 /* size_offset */,
               FLAGS_rpc_max_message_size, IncludeHeader::kFalse, rpc::SkipEmptyMessages::kTrue,
-              this),
+              this, &read_buffer_),
       read_buffer_(receive_buffer_size, buffer_tracker),
       call_tracker_(call_tracker) {}
 
@@ -478,9 +478,10 @@ Status YBInboundCall::ParseParam(google::protobuf::Message *message) {
 }
 
 void YBInboundCall::RespondBadMethod() {
+  auto conn = connection();
   auto err = Format("Call on service $0 received from $1 with an invalid method name: $2",
                     remote_method_.service_name(),
-                    connection()->ToString(),
+                    conn ? conn->ToString() : AsString(remote_address()),
                     remote_method_.method_name());
   LOG(WARNING) << err;
   RespondFailure(ErrorStatusPB::ERROR_NO_SUCH_METHOD, STATUS(InvalidArgument, err));
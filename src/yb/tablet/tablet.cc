@@ -190,6 +190,12 @@ TAG_FLAG(backfill_index_timeout_grace_margin_ms, runtime);
 DEFINE_bool(cleanup_intents_sst_files, true,
             "Cleanup intents files that are no more relevant to any running transaction.");
 
+DEFINE_bool(tablet_split_compact_shared_files, true,
+            "Schedule compaction of SST files shared with the parent tablet after tablet split, "
+            "so data outside of the tablet key bounds is removed from disk.");
+TAG_FLAG(tablet_split_compact_shared_files, advanced);
+TAG_FLAG(tablet_split_compact_shared_files, runtime);
+
 DEFINE_test_flag(int32, TEST_slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -647,6 +653,7 @@ Status Tablet::OpenKeyValueTablet() {
   if (transaction_participant_) {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     docdb::SetLogPrefix(&rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
+    docdb::DisableColumnarSst(&rocksdb_options);
 
     rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
@@ -692,9 +699,46 @@ Status Tablet::OpenKeyValueTablet() {
 }
 
 void Tablet::RegularDbFilesChanged() {
-  std::lock_guard<std::mutex> lock(num_sst_files_changed_listener_mutex_);
-  if (num_sst_files_changed_listener_) {
-    num_sst_files_changed_listener_();
+  {
+    std::lock_guard<std::mutex> lock(num_sst_files_changed_listener_mutex_);
+    if (num_sst_files_changed_listener_) {
+      num_sst_files_changed_listener_();
+    }
+  }
+  // Previous compaction could be completed, or the shared files could be busy when compaction was
+  // requested, so retry it here.
+  TriggerPostSplitCompactionIfNeeded();
+}
+
+bool Tablet::HasSstFilesWithDataOutsideKeyBounds() const {
+  if (!regular_db_ || (key_bounds_.lower.empty() && key_bounds_.upper.empty())) {
+    return false;
+  }
+  std::vector<rocksdb::LiveFileMetaData> files;
+  regular_db_->GetLiveFilesMetaData(&files);
+  for (const auto& file : files) {
+    if (!key_bounds_.IsWithinBounds(file.smallest.key) ||
+        (!key_bounds_.upper.empty() &&
+         Slice(file.largest.key).compare(key_bounds_.upper.AsSlice()) >= 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Tablet::TriggerPostSplitCompactionIfNeeded() {
+  // Invoked from RocksDB background threads, so RocksDB instances could be reset concurrently.
+  ScopedRWOperation scoped_operation(&pending_op_counter_);
+  if (!scoped_operation.ok() || !FLAGS_tablet_split_compact_shared_files ||
+      state_ != State::kOpen || !HasSstFilesWithDataOutsideKeyBounds()) {
+    return;
+  }
+  // Compaction filter drops keys outside of key bounds, so full compaction rewrites shared files
+  // to contain only data of this tablet.
+  auto status = regular_db_->ScheduleFullCompaction();
+  if (!status.ok() && !status.IsBusy()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60) << LogPrefix() << "Failed to schedule post split compaction: "
+                                     << status;
   }
 }
 
@@ -813,6 +857,9 @@ Status Tablet::DoEnableCompactions() {
       return intents_db_status;
     }
   }
+  if (regular_db_status.ok()) {
+    TriggerPostSplitCompactionIfNeeded();
+  }
   return regular_db_status;
 }
 
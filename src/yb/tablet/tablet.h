@@ -500,6 +500,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   uint64_t GetCurrentVersionSstFilesUncompressedSize() const;
   uint64_t GetCurrentVersionNumSSTFiles() const;
 
+  // Returns true if regular DB has SST files containing keys outside of tablet key bounds, i.e.
+  // files shared with the parent tablet after split that are not compacted yet.
+  bool HasSstFilesWithDataOutsideKeyBounds() const;
+
   void ListenNumSSTFilesChanged(std::function<void()> listener);
 
   // Returns the number of memtables in intents and regular db-s.
@@ -782,6 +786,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void RegularDbFilesChanged();
 
+  // Schedules full compaction of regular DB if it contains data outside of tablet key bounds.
+  void TriggerPostSplitCompactionIfNeeded();
+
   HybridTime ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) override;
 
   void MinRunningHybridTimeSatisfied() override {
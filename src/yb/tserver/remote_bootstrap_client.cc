@@ -122,10 +122,11 @@ using tablet::RaftGroupReplicaSuperBlockPB;
 
 std::atomic<int32_t> remote_bootstrap_clients_started_{0};
 
-RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id, FsManager* fs_manager)
+RemoteBootstrapClient::RemoteBootstrapClient(
+    std::string tablet_id, FsManager* fs_manager, const scoped_refptr<MetricEntity>& metric_entity)
     : tablet_id_(std::move(tablet_id)),
       log_prefix_(Format("T $0 P $1: Remote bootstrap client: ", tablet_id_, fs_manager->uuid())),
-      downloader_(&log_prefix_, fs_manager) {
+      downloader_(&log_prefix_, fs_manager, metric_entity) {
   AddComponent<RemoteBootstrapSnapshotsComponent>();
 }
 
@@ -401,6 +402,8 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
     RETURN_NOT_OK(component->Download());
   }
 
+  downloader_.Finish();
+
   // We sleep here to simulate the transfer of very large files.
   if (PREDICT_FALSE(FLAGS_simulate_long_remote_bootstrap_sec > 0)) {
     LOG_WITH_PREFIX(INFO) << "Sleeping " << FLAGS_simulate_long_remote_bootstrap_sec
@@ -642,16 +645,14 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  std::vector<RemoteBootstrapFileDownloader::FileToDownload> files;
+  files.reserve(new_superblock_.kv_store().rocksdb_files().size());
   for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
+    files.push_back({&file_pb, rocksdb_dir, DataIdPB()});
+    files.back().data_id.set_type(DataIdPB::ROCKSDB_FILE);
   }
+  UpdateStatusMessage(Format("Downloading $0 RocksDB files", files.size()));
+  RETURN_NOT_OK(downloader_.DownloadFiles(std::move(files)));
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
   auto intents_tmp_dir = JoinPathSegments(rocksdb_dir, tablet::kIntentsSubdir);
@@ -89,14 +89,17 @@ class RemoteBootstrapComponent {
 // This class is not thread-safe.
 //
 // TODO:
-// * Parallelize download of blocks and WAL segments.
+// * Parallelize download of WAL segments.
 //
 class RemoteBootstrapClient {
  public:
 
   // Construct the remote bootstrap client.
   // 'fs_manager' and 'messenger' must remain valid until this object is destroyed.
-  RemoteBootstrapClient(std::string tablet_id, FsManager* fs_manager);
+  // Download metrics are reported to 'metric_entity', when it is not null.
+  RemoteBootstrapClient(
+      std::string tablet_id, FsManager* fs_manager,
+      const scoped_refptr<MetricEntity>& metric_entity = nullptr);
 
   // Attempt to clean up resources on the remote end by sending an
   // EndRemoteBootstrapSession() RPC
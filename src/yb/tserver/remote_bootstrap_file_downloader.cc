@@ -13,6 +13,12 @@
 
 #include "yb/tserver/remote_bootstrap_file_downloader.h"
 
+#include <deque>
+#include <future>
+#include <unordered_set>
+
+#include <boost/optional.hpp>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/fs/fs_manager.h"
@@ -24,8 +30,9 @@
 #include "yb/util/crc.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
-#include "yb/util/net/rate_limiter.h"
+#include "yb/util/thread.h"
 
 using namespace yb::size_literals;
 
@@ -49,6 +56,30 @@ DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
+DEFINE_int32(remote_bootstrap_max_concurrent_files, 4,
+             "Maximum number of files downloaded concurrently by a single remote bootstrap "
+             "session.");
+TAG_FLAG(remote_bootstrap_max_concurrent_files, advanced);
+TAG_FLAG(remote_bootstrap_max_concurrent_files, runtime);
+
+DEFINE_int32(remote_bootstrap_max_outstanding_chunks, 4,
+             "Maximum number of outstanding chunk requests while downloading a single file "
+             "during remote bootstrap.");
+TAG_FLAG(remote_bootstrap_max_outstanding_chunks, advanced);
+TAG_FLAG(remote_bootstrap_max_outstanding_chunks, runtime);
+
+METRIC_DEFINE_counter(server, remote_bootstrap_bytes_downloaded,
+                      "Remote Bootstrap Bytes Downloaded", yb::MetricUnit::kBytes,
+                      "Number of bytes downloaded by remote bootstrap sessions of this server.");
+METRIC_DEFINE_counter(server, remote_bootstrap_partial_chunks,
+                      "Remote Bootstrap Partial Chunks", yb::MetricUnit::kRequests,
+                      "Number of remote bootstrap chunks that were received shorter than "
+                      "requested, so the rest of them was requested again.");
+METRIC_DEFINE_histogram(server, remote_bootstrap_session_download_rate,
+                        "Remote Bootstrap Session Download Rate", yb::MetricUnit::kBytes,
+                        "Average download rate in bytes per second of each completed remote "
+                        "bootstrap session of this server.", 60000000000LU, 2);
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -77,9 +108,42 @@ CHECKED_STATUS ExtractRemoteError(
 
 extern std::atomic<int32_t> remote_bootstrap_clients_started_;
 
+namespace {
+
+uint64_t RemoteBootstrapClientRate() {
+  auto remote_bootstrap_clients_started =
+      remote_bootstrap_clients_started_.load(std::memory_order_acquire);
+  if (remote_bootstrap_clients_started < 1) {
+    YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: "
+                               << remote_bootstrap_clients_started;
+    return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
+  }
+  return static_cast<uint64_t>(
+      FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+}
+
+} // namespace
+
+struct RemoteBootstrapFileDownloader::ChunkFetch {
+  uint64_t offset;
+  int32_t max_length;
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+  std::promise<void> promise;
+  std::future<void> future;
+};
+
 RemoteBootstrapFileDownloader::RemoteBootstrapFileDownloader(
-    const std::string* log_prefix, FsManager* fs_manager)
+    const std::string* log_prefix, FsManager* fs_manager,
+    const scoped_refptr<MetricEntity>& metric_entity)
     : log_prefix_(*log_prefix), fs_manager_(*fs_manager) {
+  if (metric_entity) {
+    bytes_downloaded_counter_ = METRIC_remote_bootstrap_bytes_downloaded.Instantiate(metric_entity);
+    partial_chunks_counter_ = METRIC_remote_bootstrap_partial_chunks.Instantiate(metric_entity);
+    session_rate_histogram_ =
+        METRIC_remote_bootstrap_session_download_rate.Instantiate(metric_entity);
+  }
 }
 
 void RemoteBootstrapFileDownloader::Start(
@@ -88,6 +152,33 @@ void RemoteBootstrapFileDownloader::Start(
   proxy_ = std::move(proxy);
   session_id_ = std::move(session_id);
   session_idle_timeout_ = session_idle_timeout;
+  start_time_ = MonoTime::Now();
+
+  // Rate limiter is shared by all files downloaded concurrently by this session.
+  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
+    rate_limiter_ = std::make_unique<RateLimiter>(&RemoteBootstrapClientRate);
+  } else {
+    // Inactive RateLimiter.
+    rate_limiter_ = std::make_unique<RateLimiter>();
+  }
+  rate_limiter_->Init();
+}
+
+uint64_t RemoteBootstrapFileDownloader::AverageRate() const {
+  auto elapsed = MonoTime::Now().GetDeltaSince(start_time_);
+  if (!start_time_.Initialized() || elapsed.ToMicroseconds() <= 0) {
+    return 0;
+  }
+  return MonoTime::kMicrosecondsPerSecond * bytes_downloaded() / elapsed.ToMicroseconds();
+}
+
+void RemoteBootstrapFileDownloader::Finish() {
+  auto rate = AverageRate();
+  LOG_WITH_PREFIX(INFO) << "Downloaded " << bytes_downloaded() << " bytes, "
+                        << "average rate: " << rate << " bytes/sec";
+  if (session_rate_histogram_) {
+    session_rate_histogram_->Increment(rate);
+  }
 }
 
 Env& RemoteBootstrapFileDownloader::env() const {
@@ -100,16 +191,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string existing_file;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        existing_file = it->second;
+      }
+    }
+    if (!existing_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << existing_file;
+      auto link_status = env().LinkFile(existing_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << existing_file
                              << ": " << link_status;
     }
   }
@@ -125,94 +223,228 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
                                DataIdPB::IdType_Name(data_id->type()), file_path));
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
+  if (file_pb.size_bytes() != 0 && file->Size() != file_pb.size_bytes()) {
+    return STATUS_FORMAT(
+        Corruption, "Downloaded file $0 has size $1, while $2 expected",
+        file_path, file->Size(), file_pb.size_bytes());
+  }
+
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
   return Status::OK();
 }
 
-template<class Appendable>
-Status RemoteBootstrapFileDownloader::DownloadFile(
-    const DataIdPB& data_id, Appendable* appendable) {
+Status RemoteBootstrapFileDownloader::DownloadFiles(std::vector<FileToDownload> files) {
+  // Files with the same inode are hard linked after the first one of them is downloaded.
+  std::vector<FileToDownload*> to_download;
+  std::vector<FileToDownload*> to_link;
+  std::unordered_set<uint64_t> inodes;
+  for (auto& file : files) {
+    auto inode = file.file_pb->inode();
+    if (inode != 0 && !inodes.insert(inode).second) {
+      to_link.push_back(&file);
+    } else {
+      to_download.push_back(&file);
+    }
+  }
+
+  std::atomic<size_t> next_file{0};
+  std::mutex status_mutex;
+  Status status;
+  auto worker = [this, &to_download, &next_file, &status_mutex, &status] {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(status_mutex);
+        if (!status.ok()) {
+          return;
+        }
+      }
+      auto idx = next_file.fetch_add(1, std::memory_order_acq_rel);
+      if (idx >= to_download.size()) {
+        return;
+      }
+      auto& file = *to_download[idx];
+      auto start = MonoTime::Now();
+      auto file_status = DownloadFile(*file.file_pb, file.dir, &file.data_id);
+      if (!file_status.ok()) {
+        std::lock_guard<std::mutex> lock(status_mutex);
+        if (status.ok()) {
+          status = file_status;
+        }
+        return;
+      }
+      auto elapsed = MonoTime::Now().GetDeltaSince(start);
+      LOG_WITH_PREFIX(INFO)
+          << "Downloaded file " << file.file_pb->name() << " of size "
+          << file.file_pb->size_bytes() << " in " << elapsed.ToSeconds() << " seconds";
+    }
+  };
+
+  auto num_threads = std::min<size_t>(
+      std::max(FLAGS_remote_bootstrap_max_concurrent_files, 1), to_download.size());
+  std::vector<scoped_refptr<Thread>> threads;
+  // Current thread also downloads files, so one thread less is started.
+  for (size_t i = 1; i < num_threads; ++i) {
+    scoped_refptr<Thread> thread;
+    auto thread_status = Thread::Create(
+        "remote-bootstrap", Format("rb-download-$0", i), worker, &thread);
+    if (!thread_status.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to start download thread: " << thread_status;
+      break;
+    }
+    threads.push_back(std::move(thread));
+  }
+  worker();
+  for (const auto& thread : threads) {
+    thread->Join();
+  }
+  RETURN_NOT_OK(status);
+
+  for (auto* file : to_link) {
+    RETURN_NOT_OK(DownloadFile(*file->file_pb, file->dir, &file->data_id));
+  }
+
+  return Status::OK();
+}
+
+int32_t RemoteBootstrapFileDownloader::NextChunkMaxLength() {
   constexpr int kBytesReservedForMessageHeaders = 16384;
 
-  // For periodic sync, indicates number of bytes which need to be sync'ed.
-  size_t periodic_sync_unsynced_bytes = 0;
-  uint64_t offset = 0;
   int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
                                 FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  if (rate_limiter_->active()) {
+    auto max_size = rate_limiter_->GetMaxSizeForNextTransmission();
+    if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
+      max_size = std::numeric_limits<decltype(max_length)>::max();
+    }
+    max_length = std::min(max_length, decltype(max_length)(max_size));
+  }
+  return max_length;
+}
 
-  std::unique_ptr<RateLimiter> rate_limiter;
-
-  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
-      auto remote_bootstrap_clients_started =
-          remote_bootstrap_clients_started_.load(std::memory_order_acquire);
-      if (remote_bootstrap_clients_started < 1) {
-        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: "
-                                   << remote_bootstrap_clients_started;
-        return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
-      }
-      return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
-    };
-
-    rate_limiter = std::make_unique<RateLimiter>(rate_updater);
-  } else {
-    // Inactive RateLimiter.
-    rate_limiter = std::make_unique<RateLimiter>();
+void RemoteBootstrapFileDownloader::ChunkReceived(size_t size) {
+  bytes_downloaded_.fetch_add(size, std::memory_order_acq_rel);
+  if (bytes_downloaded_counter_) {
+    bytes_downloaded_counter_->IncrementBy(size);
   }
+  // Holding the mutex while sleeping is intentional, it throttles all downloads of this session.
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  rate_limiter_->UpdateDataSizeAndMaybeSleep(size);
+}
 
-  rpc::RpcController controller;
-  controller.set_timeout(session_idle_timeout_);
-  FetchDataRequestPB req;
+std::unique_ptr<RemoteBootstrapFileDownloader::ChunkFetch>
+    RemoteBootstrapFileDownloader::FetchChunkAsync(
+        const DataIdPB& data_id, uint64_t offset, int32_t max_length) {
+  auto result = std::make_unique<ChunkFetch>();
+  result->offset = offset;
+  result->max_length = max_length;
+  result->future = result->promise.get_future();
+  result->controller.set_timeout(session_idle_timeout_);
+  result->req.set_session_id(session_id_);
+  *result->req.mutable_data_id() = data_id;
+  result->req.set_offset(offset);
+  result->req.set_max_length(max_length);
+  auto* fetch = result.get();
+  proxy_->FetchDataAsync(fetch->req, &fetch->resp, &fetch->controller, [fetch] {
+    fetch->promise.set_value();
+  });
+  return result;
+}
 
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
-    if (rate_limiter->active()) {
-      auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
-      if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
-        max_size = std::numeric_limits<decltype(max_length)>::max();
-      }
-      max_length = std::min(max_length, decltype(max_length)(max_size));
+template<class Appendable>
+Status RemoteBootstrapFileDownloader::DownloadFile(
+    const DataIdPB& data_id, Appendable* appendable) {
+  // For periodic sync, indicates number of bytes which need to be sync'ed.
+  size_t periodic_sync_unsynced_bytes = 0;
+  uint64_t offset = 0;
+  // Offset of the next chunk to request.
+  uint64_t request_offset = 0;
+  // Data length is unknown until the first chunk is received, so only one chunk is requested
+  // before it.
+  boost::optional<uint64_t> total_data_length;
+  const size_t max_outstanding_chunks = std::max(FLAGS_remote_bootstrap_max_outstanding_chunks, 1);
+
+  std::deque<std::unique_ptr<ChunkFetch>> fetches;
+  // Outstanding requests refer to the memory owned by fetches, so wait for them to complete.
+  auto wait_outstanding_fetches = [&fetches] {
+    for (const auto& fetch : fetches) {
+      fetch->future.wait();
+    }
+    fetches.clear();
+  };
+  auto se = ScopeExit(wait_outstanding_fetches);
+
+  for (;;) {
+    while (fetches.size() < max_outstanding_chunks &&
+           (total_data_length ? request_offset < *total_data_length : fetches.empty())) {
+      auto max_length = NextChunkMaxLength();
+      fetches.push_back(FetchChunkAsync(data_id, request_offset, max_length));
+      request_offset += max_length;
     }
-    req.set_max_length(max_length);
 
-    FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+    auto fetch = std::move(fetches.front());
+    fetches.pop_front();
+    fetch->future.wait();
+    RETURN_NOT_OK_UNWIND_PREPEND(
+        fetch->controller.status(), fetch->controller, "Unable to fetch data from remote");
+    const auto& chunk = fetch->resp.chunk();
+    DCHECK_LE(chunk.data().size(), fetch->max_length);
 
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, chunk),
                           Format("Error validating data item $0", data_id));
+    if (total_data_length && *total_data_length != chunk.total_data_length()) {
+      return STATUS_FORMAT(
+          IllegalState, "Length of $0 changed during download from $1 to $2",
+          data_id, *total_data_length, chunk.total_data_length());
+    }
+    total_data_length = chunk.total_data_length();
+    if (chunk.data().empty() && offset < *total_data_length) {
+      return STATUS_FORMAT(
+          IllegalState, "Empty chunk of $0 received at offset $1, while its length is $2",
+          data_id, offset, *total_data_length);
+    }
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
     VLOG_WITH_PREFIX(3)
-        << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
+        << "resp size: " << fetch->resp.ByteSize() << ", chunk size: " << chunk.data().size();
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
-    }
-    offset += resp.chunk().data().size();
+    offset += chunk.data().size();
+    ChunkReceived(chunk.data().size());
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += chunk.data().size();
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         RETURN_NOT_OK(appendable->Sync());
         periodic_sync_unsynced_bytes = 0;
       }
     }
+
+    if (offset >= *total_data_length) {
+      break;
+    }
+
+    const uint64_t fetch_end = std::min(fetch->offset + fetch->max_length, *total_data_length);
+    if (offset < fetch_end) {
+      // Remote returned less data than requested, for instance because of its own rate limit.
+      // Chunks that are already requested start after this one, so only the rest of this chunk
+      // is requested, and it is the next one to be written.
+      if (partial_chunks_counter_) {
+        partial_chunks_counter_->Increment();
+      }
+      fetches.push_front(FetchChunkAsync(data_id, offset, fetch_end - offset));
+    }
   }
 
-  VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter->GetRate();
+  if (offset != *total_data_length) {
+    return STATUS_FORMAT(
+        Corruption, "Downloaded $0 bytes of $1, while its length is $2",
+        offset, data_id, *total_data_length);
+  }
 
   return Status::OK();
 }
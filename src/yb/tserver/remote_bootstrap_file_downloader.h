@@ -14,9 +14,12 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -24,8 +27,10 @@
 
 #include "yb/tserver/remote_bootstrap.pb.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/status.h"
+#include "yb/util/net/rate_limiter.h"
 
 namespace yb {
 
@@ -39,7 +44,10 @@ class RemoteBootstrapServiceProxy;
 
 class RemoteBootstrapFileDownloader {
  public:
-  RemoteBootstrapFileDownloader(const std::string* log_prefix, FsManager* fs_manager);
+  // Metrics are not collected when metric_entity is null.
+  RemoteBootstrapFileDownloader(
+      const std::string* log_prefix, FsManager* fs_manager,
+      const scoped_refptr<MetricEntity>& metric_entity);
 
   void Start(
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
@@ -48,6 +56,16 @@ class RemoteBootstrapFileDownloader {
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  struct FileToDownload {
+    const tablet::FilePB* file_pb;
+    std::string dir;
+    DataIdPB data_id;
+  };
+
+  // Downloads provided files using up to remote_bootstrap_max_concurrent_files threads.
+  // Files sharing the same inode are downloaded once and hard linked afterwards.
+  CHECKED_STATUS DownloadFiles(std::vector<FileToDownload> files);
+
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
   //
@@ -66,9 +84,33 @@ class RemoteBootstrapFileDownloader {
     return session_id_;
   }
 
+  // Total number of bytes received by this downloader.
+  uint64_t bytes_downloaded() const {
+    return bytes_downloaded_.load(std::memory_order_acquire);
+  }
+
+  // Average download rate in bytes per second since Start.
+  uint64_t AverageRate() const;
+
+  // Reports average download rate of the session to metrics, should be called once all files are
+  // downloaded.
+  void Finish();
+
  private:
+  struct ChunkFetch;
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
+  // Sends async request for the chunk of data_id starting at offset.
+  std::unique_ptr<ChunkFetch> FetchChunkAsync(
+      const DataIdPB& data_id, uint64_t offset, int32_t max_length);
+
+  // Returns max length of the next chunk request, taking rate limit into account.
+  int32_t NextChunkMaxLength();
+
+  // Updates rate limiter with received data size, sleeps if download is too fast.
+  void ChunkReceived(size_t size);
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -81,7 +123,18 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
+  MonoTime start_time_;
+  std::atomic<uint64_t> bytes_downloaded_{0};
+
+  std::mutex rate_limiter_mutex_;
+  std::unique_ptr<RateLimiter> rate_limiter_;
+
+  std::mutex inode2file_mutex_;
   std::unordered_map<uint64_t, std::string> inode2file_;
+
+  scoped_refptr<Counter> bytes_downloaded_counter_;
+  scoped_refptr<Counter> partial_chunks_counter_;
+  scoped_refptr<Histogram> session_rate_histogram_;
 };
 
 CHECKED_STATUS UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
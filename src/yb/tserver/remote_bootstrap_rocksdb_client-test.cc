@@ -20,6 +20,10 @@
 
 using std::shared_ptr;
 
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_max_concurrent_files);
+DECLARE_int32(remote_bootstrap_max_outstanding_chunks);
+
 namespace yb {
 namespace tserver {
 
@@ -31,6 +35,9 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+ protected:
+  void CheckDownloadedRocksDBFiles();
 };
 
 // Basic begin / end remote bootstrap session.
@@ -40,10 +47,7 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
   ASSERT_OK(client_->Finish());
 }
 
-// Basic RocksDB files download unit test.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->FetchAll(&listener));
+void RemoteBootstrapRocksDBClientTest::CheckDownloadedRocksDBFiles() {
   auto tablet_peer_checkpoint_dir =
       tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
 
@@ -81,5 +85,22 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Basic RocksDB files download unit test.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
+}
+
+// Download files concurrently with many small chunks requested at the same time.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesConcurrently) {
+  FLAGS_remote_bootstrap_max_chunk_size = 1000;
+  FLAGS_remote_bootstrap_max_concurrent_files = 3;
+  FLAGS_remote_bootstrap_max_outstanding_chunks = 8;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
+}
+
 } // namespace tserver
 } // namespace yb
@@ -474,7 +474,45 @@ Status RemoteBootstrapSession::GetLogSegmentPiece(uint64_t segment_seqno, GetDat
 
 Status RemoteBootstrapSession::GetRocksDBFilePiece(
     const std::string& file_name, GetDataPieceInfo* info) {
-  return GetFilePiece(checkpoint_dir_, file_name, env(), info);
+  // Client downloads several files concurrently, so keep a few of them opened.
+  constexpr size_t kMaxOpenedRocksDBFiles = 16;
+
+  OpenedRocksDBFile opened_file;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = opened_rocksdb_files_.find(file_name);
+    if (it != opened_rocksdb_files_.end()) {
+      opened_file = it->second;
+    }
+  }
+
+  if (!opened_file.file) {
+    auto file_path = JoinPathSegments(checkpoint_dir_, file_name);
+    if (!env()->FileExists(file_path)) {
+      info->error_code = RemoteBootstrapErrorPB::ROCKSDB_FILE_NOT_FOUND;
+      return STATUS(NotFound, Substitute("Unable to find RocksDB file $0 in directory $1",
+                                         file_name, checkpoint_dir_));
+    }
+    std::unique_ptr<RandomAccessFile> readable_file;
+    RETURN_NOT_OK(env()->NewRandomAccessFile(file_path, &readable_file));
+    opened_file.size = VERIFY_RESULT(readable_file->Size());
+    opened_file.file = std::move(readable_file);
+    VLOG(2) << "Opened RocksDB file. File path: " << file_path << ", file size: "
+            << opened_file.size;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (opened_rocksdb_files_.emplace(file_name, opened_file).second) {
+      opened_rocksdb_files_order_.push_back(file_name);
+      if (opened_rocksdb_files_order_.size() > kMaxOpenedRocksDBFiles) {
+        opened_rocksdb_files_.erase(opened_rocksdb_files_order_.front());
+        opened_rocksdb_files_order_.pop_front();
+      }
+    }
+  }
+
+  info->data_size = opened_file.size;
+  return ReadFileChunkToBuf(
+      opened_file.file.get(), Substitute("rocksdb file $0", file_name), info);
 }
 
 Status RemoteBootstrapSession::GetFilePiece(
@@ -571,11 +609,23 @@ bool RemoteBootstrapSession::Succeeded() {
 }
 
 void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
   if (!rate_limiter_.IsInitialized()) {
     InitRateLimiter();
   }
 }
 
+uint64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  // Sleeping while holding the mutex throttles concurrent requests of the same session.
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  rate_limiter_.UpdateDataSizeAndMaybeSleep(data_size);
+}
+
 
 void RemoteBootstrapSession::InitRateLimiter() {
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0 && nsessions_) {
@@ -32,6 +32,7 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_SESSION_H_
 #define YB_TSERVER_REMOTE_BOOTSTRAP_SESSION_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -128,11 +129,15 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Change the peer's role to VOTER.
   CHECKED_STATUS ChangeRole();
 
-  void InitRateLimiter();
+  void InitRateLimiter() REQUIRES(rate_limiter_mutex_);
 
   void EnsureRateLimiterIsInitialized();
 
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Rate limiter methods are thread safe, since the client could request several data pieces
+  // concurrently.
+  uint64_t GetMaxSizeForNextTransmission();
+
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -213,11 +218,22 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Directory where the checkpoint files are stored for this session (only for rocksdb).
   std::string checkpoint_dir_;
 
+  struct OpenedRocksDBFile {
+    std::shared_ptr<RandomAccessFile> file;
+    uint64_t size;
+  };
+
+  // Recently opened checkpoint files, so they are not reopened for each requested data piece.
+  std::unordered_map<std::string, OpenedRocksDBFile> opened_rocksdb_files_ GUARDED_BY(mutex_);
+  std::deque<std::string> opened_rocksdb_files_order_ GUARDED_BY(mutex_);
+
   // Time when this session was initialized.
   MonoTime start_time_;
 
+  std::mutex rate_limiter_mutex_;
+
   // Used to limit the transmission rate.
-  RateLimiter rate_limiter_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
@@ -81,20 +81,20 @@ Status RemoteBootstrapSnapshotsComponent::Download() {
                         Format("Failed to create & sync top snapshots directory $0",
                                top_snapshots_dir));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::SNAPSHOT_FILE);
+  std::vector<RemoteBootstrapFileDownloader::FileToDownload> files;
+  files.reserve(kv_store.snapshot_files().size());
   for (auto const& file_pb : kv_store.snapshot_files()) {
     const string snapshot_dir = JoinPathSegments(top_snapshots_dir, file_pb.snapshot_id());
 
     RETURN_NOT_OK_PREPEND(fs_manager().CreateDirIfMissingAndSync(snapshot_dir),
                           Format("Failed to create & sync snapshot directory $0", snapshot_dir));
 
-    const std::string file_path = JoinPathSegments(snapshot_dir, file_pb.file().name());
-    data_id.set_snapshot_id(file_pb.snapshot_id());
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb.file(), snapshot_dir, &data_id));
+    files.push_back({&file_pb.file(), snapshot_dir, DataIdPB()});
+    files.back().data_id.set_type(DataIdPB::SNAPSHOT_FILE);
+    files.back().data_id.set_snapshot_id(file_pb.snapshot_id());
   }
 
-  return Status::OK();
+  return downloader_.DownloadFiles(std::move(files));
 }
 
 Status RemoteBootstrapSnapshotsSource::Init() {
@@ -31,6 +31,12 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
       error, s, ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR, context);
 }
 
+void SetupError(TabletServerErrorPB* error, const Status& s) {
+  auto ts_error = TabletServerError::FromStatus(s);
+  StatusToPB(s, error->mutable_status());
+  error->set_code(ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR);
+}
+
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
   std::shared_ptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
   if (!consensus) {
@@ -56,6 +56,10 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
                           const Status& s,
                           rpc::RpcContext* context);
 
+// Fills error without responding. Used when the error is related to a part of the RPC only,
+// for instance a single read of MultiRead.
+void SetupError(TabletServerErrorPB* error, const Status& s);
+
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer);
 
 // Template helpers.
@@ -128,6 +128,11 @@ DEFINE_bool(start_pgsql_proxy, false,
 
 DEFINE_bool(tserver_enable_metrics_snapshotter, false, "Should metrics snapshotter be enabled");
 
+DEFINE_int32(shared_memory_rpc_channels, 64,
+             "Number of shared memory channels, through which local processes such as PostgreSQL "
+             "backends could send RPC calls to this tablet server. 0 to disable.");
+TAG_FLAG(shared_memory_rpc_channels, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -254,6 +259,15 @@ Status TabletServer::Init() {
     shared_object_->SetEndpoint(bound_addresses.front());
   }
 
+  if (FLAGS_shared_memory_rpc_channels > 0) {
+    auto fd = messenger()->ListenSharedMemory(FLAGS_shared_memory_rpc_channels, permanent_uuid());
+    if (fd.ok()) {
+      shared_memory_rpc_fd_ = *fd;
+    } else {
+      LOG(WARNING) << "Failed to create shared memory RPC channels: " << fd.status();
+    }
+  }
+
   return Status::OK();
 }
 
@@ -458,6 +472,10 @@ int TabletServer::GetSharedMemoryFd() {
   return shared_object_.GetFd();
 }
 
+int TabletServer::GetSharedMemoryRpcFd() {
+  return shared_memory_rpc_fd_;
+}
+
 void TabletServer::SetYSQLCatalogVersion(uint64_t new_version) {
   std::lock_guard<simple_spinlock> l(lock_);
   if (new_version > ysql_catalog_version_) {
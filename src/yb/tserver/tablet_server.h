@@ -188,6 +188,10 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Returns the file descriptor of this tablet server's shared memory segment.
   int GetSharedMemoryFd();
 
+  // Returns the file descriptor of the shared memory segment with RPC channels of this tablet
+  // server, or -1 if they are not available.
+  int GetSharedMemoryRpcFd();
+
   // Currently only used by cdc.
   virtual int32_t cluster_config_version() const {
     return std::numeric_limits<int32_t>::max();
@@ -263,6 +267,8 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Shared memory owned by the tablet server.
   TServerSharedObject shared_object_;
 
+  int shared_memory_rpc_fd_ = -1;
+
   std::atomic<client::TransactionPool*> transaction_pool_{nullptr};
   std::mutex transaction_pool_mutex_;
   std::unique_ptr<client::TransactionManager> transaction_manager_holder_;
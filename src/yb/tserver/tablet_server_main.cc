@@ -212,6 +212,7 @@ int TabletServerMain(int argc, char** argv) {
     LOG_AND_RETURN_FROM_MAIN_NOT_OK(pg_process_conf_result);
     auto& pg_process_conf = *pg_process_conf_result;
     pg_process_conf.master_addresses = tablet_server_options->master_addresses_flag;
+    pg_process_conf.tserver_rpc_shm_fd = server->GetSharedMemoryRpcFd();
     pg_process_conf.certs_dir = FLAGS_certs_dir.empty()
         ? server::DefaultCertsDir(*server->fs_manager())
         : FLAGS_certs_dir;
@@ -33,6 +33,7 @@
 #include "yb/tserver/tablet_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -185,6 +186,9 @@ TAG_FLAG(index_backfill_additional_delay_before_backfilling_ms, runtime);
 DEFINE_test_flag(int32, TEST_write_rejection_percentage, 0,
                  "Reject specified percentage of writes.");
 
+DEFINE_test_flag(int32, TEST_write_delay_ms, 0,
+                 "Delay handling of each write request by this number of milliseconds.");
+
 DEFINE_test_flag(bool, assert_reads_from_follower_rejected_because_of_staleness, false,
                  "If set, we verify that the consistency level is CONSISTENT_PREFIX, and that "
                  "a follower receives the request, but that it gets rejected because it's a stale "
@@ -1229,6 +1233,9 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
     context.RespondSuccess();
     return;
   }
+  if (PREDICT_FALSE(FLAGS_TEST_write_delay_ms > 0)) {
+    std::this_thread::sleep_for(FLAGS_TEST_write_delay_ms * 1ms);
+  }
   TRACE("Start Write");
   TRACE_EVENT1("tserver", "TabletServiceImpl::Write",
                "tablet_id", req->tablet_id());
@@ -1487,6 +1494,25 @@ struct ReadContext {
   bool allow_retry = false;
   RequestScope request_scope;
 
+  // When set, rows data is collected here instead of being attached to the RPC context.
+  std::vector<faststring>* sidecars = nullptr;
+
+  size_t AddSidecar(faststring* rows_data) {
+    if (sidecars) {
+      sidecars->push_back(std::move(*rows_data));
+      return sidecars->size() - 1;
+    }
+    return context->AddRpcSidecar(*rows_data);
+  }
+
+  void ResetSidecars() {
+    if (sidecars) {
+      sidecars->clear();
+    } else {
+      context->ResetRpcSidecars();
+    }
+  }
+
   bool transactional() const {
     return tablet->IsTransactionalRequest(req->pgsql_batch_size() > 0);
   }
@@ -1777,24 +1803,21 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   CompleteRead(&read_context);
 }
 
-void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
+Status TabletServiceImpl::ReadWithRestarts(ReadContext* read_context) {
   for (;;) {
     read_context->resp->Clear();
-    read_context->context->ResetRpcSidecars();
+    read_context->ResetSidecars();
     VLOG(1) << "Read time: " << read_context->read_time
             << ", safe: " << read_context->safe_ht_to_read;
     auto result = DoRead(read_context);
     if (!result.ok()) {
       WARN_NOT_OK(result.status(), "DoRead");
-      SetupErrorAndRespond(
-          read_context->resp->mutable_error(), result.status(), TabletServerErrorPB::UNKNOWN_ERROR,
-          read_context->context);
-      return;
+      return result.status();
     }
     read_context->read_time = *result;
     // If read was successful, then restart time is invalid. Finishing.
     if (!read_context->read_time) {
-      break;
+      return Status::OK();
     }
     if (!read_context->allow_retry) {
       // The read time is specified, than we read as part of transaction. So we should restart
@@ -1805,16 +1828,24 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
       restart_read_time->set_local_limit_ht(read_context->read_time.local_limit.ToUint64());
       // Global limit is ignored by caller, so we don't set it.
       down_cast<Tablet*>(read_context->tablet.get())->metrics()->restart_read_requests->Increment();
-      break;
+      return Status::OK();
     }
 
     if (CoarseMonoClock::now() > read_context->context->GetClientDeadline()) {
       TRACE("Read timed out");
-      SetupErrorAndRespond(read_context->resp->mutable_error(), STATUS(TimedOut, ""),
-                           TabletServerErrorPB::UNKNOWN_ERROR, read_context->context);
-      return;
+      return STATUS(TimedOut, "");
     }
   }
+}
+
+void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
+  auto status = ReadWithRestarts(read_context);
+  if (!status.ok()) {
+    SetupErrorAndRespond(
+        read_context->resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR,
+        read_context->context);
+    return;
+  }
   if (read_context->req->include_trace() && Trace::CurrentTrace() != nullptr) {
     read_context->resp->set_trace_buffer(Trace::CurrentTrace()->DumpToString(true));
   }
@@ -1856,6 +1887,169 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   TRACE("Done Read");
 }
 
+namespace {
+
+// Attaches rows data collected by a single read of MultiRead to the RPC, updating sidecar
+// indexes in the read response accordingly.
+template <class Responses>
+void AttachMultiReadSidecars(
+    std::vector<faststring>* sidecars, rpc::RpcContext* context, Responses* responses) {
+  for (auto& response : *responses) {
+    if (response.has_rows_data_sidecar()) {
+      response.set_rows_data_sidecar(
+          context->AddRpcSidecar((*sidecars)[response.rows_data_sidecar()]));
+    }
+  }
+}
+
+} // namespace
+
+// State of MultiRead shared by its reads. The response is sent by the read that completes last.
+struct TabletServiceImpl::MultiReadContext {
+  MultiReadContext(
+      const MultiReadRequestPB* req_, MultiReadResponsePB* resp_, rpc::RpcContext context_)
+      : req(req_), resp(resp_), context(std::move(context_)), sidecars(req->reads_size()),
+        statuses(req->reads_size()), running_reads(req->reads_size()) {}
+
+  const MultiReadRequestPB* req;
+  MultiReadResponsePB* resp;
+  rpc::RpcContext context;
+  HostPortPB host_port_pb;
+  std::vector<std::vector<faststring>> sidecars;
+  std::vector<Status> statuses;
+  std::atomic<size_t> running_reads;
+};
+
+void TabletServiceImpl::MultiRead(const MultiReadRequestPB* req,
+                                  MultiReadResponsePB* resp,
+                                  rpc::RpcContext context) {
+  TRACE("Start MultiRead");
+  VLOG(2) << "Received MultiRead RPC with " << req->reads_size() << " reads";
+
+  const size_t count = req->reads_size();
+  if (count == 0) {
+    resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+    context.RespondSuccess();
+    return;
+  }
+
+  auto multi_read_context = std::make_shared<MultiReadContext>(req, resp, std::move(context));
+  const auto& remote_address = multi_read_context->context.remote_address();
+  multi_read_context->host_port_pb.set_host(remote_address.address().to_string());
+  multi_read_context->host_port_pb.set_port(remote_address.port());
+  for (size_t idx = 0; idx != count; ++idx) {
+    resp->add_responses();
+  }
+
+  // Reads are served concurrently using the read pool, the same way as Redis batches in DoRead.
+  // Each read collects its rows data separately, since RPC sidecars could not be added
+  // concurrently. The service thread does not wait for reads submitted to the pool, the response
+  // is sent by the read that completes last.
+  for (size_t idx = 0; idx != count; ++idx) {
+    auto func = [this, multi_read_context, idx] {
+      auto& mrc = *multi_read_context;
+      mrc.statuses[idx] = DoMultiReadEntry(
+          const_cast<MultiReadRequestPB*>(mrc.req)->mutable_reads(idx),
+          mrc.resp->mutable_responses(idx), &mrc.context, &mrc.host_port_pb, &mrc.sidecars[idx]);
+      if (mrc.running_reads.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        CompleteMultiRead(&mrc);
+      }
+    };
+
+    Status s;
+    bool run_async = FLAGS_parallelize_read_ops && (idx != count - 1);
+    if (run_async) {
+      s = server_->tablet_manager()->read_pool()->SubmitFunc(func);
+    }
+
+    if (!s.ok() || !run_async) {
+      func();
+    }
+  }
+}
+
+void TabletServiceImpl::CompleteMultiRead(MultiReadContext* multi_read_context) {
+  auto* resp = multi_read_context->resp;
+  auto& context = multi_read_context->context;
+  for (size_t idx = 0; idx != multi_read_context->statuses.size(); ++idx) {
+    auto* read_resp = resp->mutable_responses(idx);
+    const auto& status = multi_read_context->statuses[idx];
+    if (!status.ok()) {
+      read_resp->Clear();
+      SetupError(read_resp->mutable_error(), status);
+    } else {
+      auto* sidecars = &multi_read_context->sidecars[idx];
+      AttachMultiReadSidecars(sidecars, &context, read_resp->mutable_ql_batch());
+      AttachMultiReadSidecars(sidecars, &context, read_resp->mutable_pgsql_batch());
+    }
+    read_resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+  }
+  resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+
+  context.RespondSuccess();
+  TRACE("Done MultiRead");
+}
+
+Status TabletServiceImpl::DoMultiReadEntry(
+    ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext* context,
+    HostPortPB* host_port_pb, std::vector<faststring>* sidecars) {
+  // Reads that have to write intents, i.e. serializable reads or reads with row marks, are
+  // always sent using the regular Read RPC.
+  if (req->has_transaction() || !req->redis_batch().empty() ||
+      req->consistency_level() != YBConsistencyLevel::STRONG) {
+    return STATUS(NotSupported, "Read is not supported by MultiRead",
+                  TabletServerError(TabletServerErrorPB::OPERATION_NOT_SUPPORTED));
+  }
+  for (const auto& pg_req : req->pgsql_batch()) {
+    if (pg_req.has_ysql_catalog_version() &&
+        pg_req.ysql_catalog_version() < server_->ysql_catalog_version()) {
+      return STATUS(QLError, "Catalog Version Mismatch: A DDL occurred while processing "
+                             "this query. Try Again.",
+                    TabletServerError(TabletServerErrorPB::MISMATCHED_SCHEMA));
+    }
+    if (IsValidRowMarkType(GetRowMarkTypeFromPB(pg_req))) {
+      return STATUS(NotSupported, "Read request with row mark types is not supported by MultiRead",
+                    TabletServerError(TabletServerErrorPB::OPERATION_NOT_SUPPORTED));
+    }
+  }
+
+  TabletPeerPtr tablet_peer;
+  auto status = server_->tablet_peer_lookup()->GetTabletPeer(req->tablet_id(), &tablet_peer);
+  if (!status.ok()) {
+    return status.IsServiceUnavailable()
+        ? status
+        : status.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_FOUND));
+  }
+  RETURN_NOT_OK(CheckPeerIsReady(*tablet_peer, AllowSplitTablet::kFalse));
+  RETURN_NOT_OK(CheckPeerIsLeader(*tablet_peer));
+
+  ReadContext read_context = {req, resp, context};
+  read_context.tablet = tablet_peer->shared_tablet();
+  if (!read_context.tablet) {
+    return STATUS(IllegalState, "Tablet is not running",
+                  TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+  read_context.sidecars = sidecars;
+  read_context.host_port_pb = host_port_pb;
+
+  if (server_->Clock()) {
+    server::UpdateClock(*req, server_->Clock());
+  }
+
+  read_context.read_time = ReadHybridTime::FromReadTimePB(*req);
+  read_context.allow_retry = !read_context.read_time;
+  read_context.require_lease = tablet::RequireLease::kTrue;
+  RETURN_NOT_OK(read_context.PickReadTime(server_->Clock()));
+
+  if (read_context.transactional()) {
+    read_context.request_scope = RequestScope(
+        down_cast<Tablet*>(read_context.tablet.get())->transaction_participant());
+    read_context.read_time.serial_no = read_context.request_scope.request_id();
+  }
+
+  return ReadWithRestarts(&read_context);
+}
+
 void HandleRedisReadRequestAsync(
     tablet::AbstractTablet* tablet,
     CoarseTimePoint deadline,
@@ -1949,7 +2143,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
         read_context->read_time.local_limit = read_context->safe_ht_to_read;
         return read_context->read_time;
       }
-      result.response.set_rows_data_sidecar(read_context->context->AddRpcSidecar(result.rows_data));
+      result.response.set_rows_data_sidecar(read_context->AddSidecar(&result.rows_data));
       read_context->resp->add_ql_batch()->Swap(&result.response);
     }
     return ReadHybridTime();
@@ -1970,7 +2164,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
         read_context->read_time.local_limit = read_context->safe_ht_to_read;
         return read_context->read_time;
       }
-      result.response.set_rows_data_sidecar(read_context->context->AddRpcSidecar(result.rows_data));
+      result.response.set_rows_data_sidecar(read_context->AddSidecar(&result.rows_data));
       read_context->resp->add_pgsql_batch()->Swap(&result.response);
     }
     return ReadHybridTime();
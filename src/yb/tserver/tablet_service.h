@@ -47,6 +47,8 @@
 #include "yb/tserver/tserver_admin.service.h"
 #include "yb/tserver/tserver_service.service.h"
 
+#include "yb/util/faststring.h"
+
 namespace yb {
 class Schema;
 class Status;
@@ -72,6 +74,9 @@ class TabletServiceImpl : public TabletServerServiceIf {
 
   void Read(const ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext context) override;
 
+  void MultiRead(
+      const MultiReadRequestPB* req, MultiReadResponsePB* resp, rpc::RpcContext context) override;
+
   void NoOp(const NoOpRequestPB* req, NoOpResponsePB* resp, rpc::RpcContext context) override;
 
   void Publish(
@@ -176,10 +181,23 @@ class TabletServiceImpl : public TabletServerServiceIf {
   // Read implementation. If restart is required returns restart time, in case of success
   // returns invalid ReadHybridTime. Otherwise returns error status.
   Result<ReadHybridTime> DoRead(ReadContext* read_context);
-  // Completes read, invokes DoRead in loop, adjusting read time due to read restart time.
-  // Sends response, etc.
+  // Invokes DoRead in loop, adjusting read time due to read restart time.
+  CHECKED_STATUS ReadWithRestarts(ReadContext* read_context);
+  // Completes read, invokes ReadWithRestarts and sends response.
   void CompleteRead(ReadContext* read_context);
 
+  // Serves a single read of MultiRead, without responding to the RPC.
+  // Rows data is collected to sidecars, instead of being attached to the RPC directly, since
+  // reads of the same MultiRead are served concurrently.
+  CHECKED_STATUS DoMultiReadEntry(
+      ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext* context,
+      HostPortPB* host_port_pb, std::vector<faststring>* sidecars);
+
+  struct MultiReadContext;
+
+  // Attaches results of all reads of MultiRead to the RPC and responds to it.
+  void CompleteMultiRead(MultiReadContext* multi_read_context);
+
   TabletServerIf *const server_;
 };
 
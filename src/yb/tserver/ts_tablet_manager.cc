@@ -1039,7 +1039,8 @@ Status TSTabletManager::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB
   LOG(INFO) << init_msg;
   TRACE(init_msg);
 
-  auto rb_client = std::make_unique<RemoteBootstrapClient>(tablet_id, fs_manager_);
+  auto rb_client = std::make_unique<RemoteBootstrapClient>(
+      tablet_id, fs_manager_, server_->metric_entity());
 
   // Download and persist the remote superblock in TABLET_DATA_COPYING state.
   if (replacing_tablet) {
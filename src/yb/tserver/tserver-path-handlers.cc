@@ -42,11 +42,13 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/server/webui_util.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet.h"
@@ -56,6 +58,7 @@
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/url-coding.h"
 
 namespace {
@@ -356,6 +359,10 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/maintenance-manager", "",
       std::bind(&TabletServerPathHandlers::HandleMaintenanceManagerPage, this, _1, _2),
       true /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/compactions", "",
+      std::bind(&TabletServerPathHandlers::HandleCompactionsPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
   server->RegisterPathHandler(
       "/api/v1/health-check", "TServer Health Check",
       std::bind(&TabletServerPathHandlers::HandleHealthCheck, this, _1, _2),
@@ -640,6 +647,9 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
+  *output << GetDashboardLine("compactions", "Compactions",
+                              "Compactions and flushes scheduled on this node and tablets "
+                              "ordered by compaction debt.");
 }
 
 string TabletServerPathHandlers::GetDashboardLine(const std::string& link,
@@ -709,6 +719,62 @@ void TabletServerPathHandlers::HandleMaintenanceManagerPage(const Webserver::Web
   *output << "</table>\n";
 }
 
+void TabletServerPathHandlers::HandleCompactionsPage(const Webserver::WebRequest& req,
+                                                     std::stringstream* output) {
+  *output << "<h1>Compactions</h1>\n";
+  auto* thread_pool = docdb::CompactionsAndFlushesThreadPool();
+  if (thread_pool == nullptr) {
+    *output << "<p>Compaction thread pool is not initialized yet.</p>\n";
+  } else {
+    auto tasks = thread_pool->TasksSnapshot();
+    *output << Substitute("<p>Max running tasks: $0, tasks in pool: $1</p>\n",
+                          thread_pool->max_running_tasks(), tasks.size());
+    auto rate_limiter = docdb::NodeCompactFlushRateLimiter();
+    if (rate_limiter) {
+      *output << Substitute(
+          "<p>Flushed and compacted through node write rate limit: $0</p>\n",
+          HumanReadableNumBytes::ToString(rate_limiter->GetTotalBytesThrough()));
+    }
+    *output << "<h3>Compaction and flush tasks</h3>\n";
+    *output << "<table class='table table-striped'>\n";
+    *output << "  <tr><th>Serial no</th><th>Priority</th><th>State</th><th>Task</th></tr>\n";
+    for (const auto& task : tasks) {
+      *output << Substitute("<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n",
+                            task.serial_no, task.priority, EscapeForHtmlToString(task.state),
+                            EscapeForHtmlToString(task.description));
+    }
+    *output << "</table>\n";
+  }
+
+  // Tablets with the most SST files have the highest read amplification, so they go first.
+  std::vector<std::pair<uint64_t, std::shared_ptr<TabletPeer>>> peers_by_sst_files;
+  vector<std::shared_ptr<TabletPeer>> peers;
+  tserver_->tablet_manager()->GetTabletPeers(&peers);
+  for (auto& peer : peers) {
+    auto tablet = peer->shared_tablet();
+    if (tablet) {
+      peers_by_sst_files.emplace_back(tablet->GetCurrentVersionNumSSTFiles(), std::move(peer));
+    }
+  }
+  std::sort(peers_by_sst_files.begin(), peers_by_sst_files.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+  *output << "<h3>Tablets by number of SST files</h3>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Table name</th><th>Tablet ID</th><th>Num SST Files</th>"
+             "<th>SST files size</th></tr>\n";
+  for (const auto& entry : peers_by_sst_files) {
+    const auto& peer = entry.second;
+    auto tablet = peer->shared_tablet();
+    *output << Substitute("<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n",
+                          EscapeForHtmlToString(peer->tablet_metadata()->table_name()),
+                          TabletLink(peer->tablet_id()), entry.first,
+                          HumanReadableNumBytes::ToString(
+                              tablet ? tablet->GetCurrentVersionSstFilesSize() : 0));
+  }
+  *output << "</table>\n";
+}
+
 void TabletServerPathHandlers::HandleHealthCheck(const Webserver::WebRequest& req,
                                                  std::stringstream* output) {
   JsonWriter jw(output, JsonWriter::COMPACT);
@@ -72,6 +72,8 @@ class TabletServerPathHandlers {
                             std::stringstream* output);
   void HandleMaintenanceManagerPage(const Webserver::WebRequest& req,
                                     std::stringstream* output);
+  void HandleCompactionsPage(const Webserver::WebRequest& req,
+                             std::stringstream* output);
   void HandleHealthCheck(const Webserver::WebRequest& req,
                          std::stringstream* output);
   std::string ConsensusStatePBToHtml(const consensus::ConsensusStatePB& cstate) const;
@@ -47,6 +47,7 @@
 #include "yb/util/crc.h"
 #include "yb/util/env.h"
 #include "yb/util/env_util.h"
+#include "yb/util/format.h"
 #include "yb/util/malloc.h"
 #include "yb/util/memenv/memenv.h"
 #include "yb/util/os-util.h"
@@ -59,6 +60,7 @@
 
 DECLARE_int32(o_direct_block_size_bytes);
 DECLARE_bool(TEST_simulate_fs_without_fallocate);
+DECLARE_bool(use_io_uring_for_multi_reads);
 
 #if !defined(__APPLE__)
 #include <linux/falloc.h>
@@ -567,6 +569,39 @@ TEST_F(TestEnv, TestOpenEmptyRandomAccessFile) {
   ASSERT_EQ(0, size);
 }
 
+TEST_F(TestEnv, TestMultiRead) {
+  const size_t kFileSize = 64 * 1024;
+  const size_t kNumReads = 100;
+  const size_t kReadSize = 1000;
+  Env* env = Env::Default();
+  string test_file = JoinPathSegments(GetTestDataDirectory(), "test_file");
+  ASSERT_NO_FATALS(WriteTestFile(env, test_file, kFileSize));
+  std::unique_ptr<RandomAccessFile> readable_file;
+  ASSERT_OK(env->NewRandomAccessFile(test_file, &readable_file));
+
+  for (bool use_io_uring : {false, true}) {
+    FLAGS_use_io_uring_for_multi_reads = use_io_uring;
+    std::vector<uint8_t> scratch(kNumReads * kReadSize);
+    std::vector<RandomAccessFile::ReadRequest> requests(kNumReads);
+    for (size_t i = 0; i != kNumReads; ++i) {
+      // The last read crosses the end of file.
+      requests[i].offset = i + 1 == kNumReads ? kFileSize - kReadSize / 2 : i * 613 % kFileSize;
+      requests[i].length = kReadSize;
+      requests[i].scratch = scratch.data() + i * kReadSize;
+    }
+    readable_file->MultiRead(requests.data(), requests.size());
+    for (size_t i = 0; i != kNumReads; ++i) {
+      SCOPED_TRACE(Format("use_io_uring: $0, read: $1", use_io_uring, i));
+      const auto& request = requests[i];
+      ASSERT_OK(request.status);
+      ASSERT_EQ(std::min(kReadSize, kFileSize - request.offset), request.result.size());
+      for (size_t j = 0; j != request.result.size(); ++j) {
+        ASSERT_EQ((request.offset + j) * 31 & 0xff, request.result[j]);
+      }
+    }
+  }
+}
+
 TEST_F(TestEnv, TestOverwrite) {
   string test_path = GetTestPath("test_env_wf");
 
@@ -138,6 +138,25 @@ class RandomAccessFile : public FileWithUniqueId {
     return Read(offset, n, result, reinterpret_cast<uint8_t*>(scratch));
   }
 
+  struct ReadRequest {
+    uint64_t offset;
+    size_t length;
+    uint8_t* scratch;
+    Slice result;
+    Status status;
+  };
+
+  // Performs several reads, storing the result and status of each one into its request, with the
+  // same semantics as Read. Implementations may submit the reads to the device together.
+  //
+  // Safe for concurrent use by multiple threads.
+  virtual void MultiRead(ReadRequest* requests, size_t count) const {
+    for (size_t i = 0; i != count; ++i) {
+      auto& request = requests[i];
+      request.status = Read(request.offset, request.length, &request.result, request.scratch);
+    }
+  }
+
   // Returns the size of the file
   virtual Result<uint64_t> Size() const = 0;
 
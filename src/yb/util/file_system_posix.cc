@@ -22,6 +22,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <vector>
+
 #ifdef __linux__
 #include <linux/fs.h>
 #include <sys/statfs.h>
@@ -31,11 +33,19 @@
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/io_uring.h"
 #include "yb/util/malloc.h"
 #include "yb/util/thread_restrictions.h"
 
 DECLARE_bool(suicide_on_eio);
 
+DEFINE_bool(use_io_uring_for_multi_reads, false,
+            "Submit batches of random access file reads through io_uring with a single system "
+            "call, instead of issuing one pread per read. Ignored if io_uring is not supported.");
+TAG_FLAG(use_io_uring_for_multi_reads, advanced);
+TAG_FLAG(use_io_uring_for_multi_reads, runtime);
+
 // For platforms without fdatasync (like OS X)
 #ifndef fdatasync
 #define fdatasync fsync
@@ -199,6 +209,45 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+void PosixRandomAccessFile::MultiRead(ReadRequest* requests, size_t count) const {
+  IoUring* ring = count > 1 && FLAGS_use_io_uring_for_multi_reads ? IoUring::ForCurrentThread()
+                                                                   : nullptr;
+  if (!ring) {
+    RandomAccessFile::MultiRead(requests, count);
+    return;
+  }
+
+  ThreadRestrictions::AssertIOAllowed();
+  std::vector<IoUringRead> reads(count);
+  for (size_t i = 0; i != count; ++i) {
+    reads[i] = IoUringRead{fd_, requests[i].offset, requests[i].length, requests[i].scratch, 0};
+  }
+  ring->Read(reads.data(), count);
+
+  for (size_t i = 0; i != count; ++i) {
+    auto& request = requests[i];
+    const auto result = reads[i].result;
+    if (result == -ECANCELED) {
+      request.status = Read(request.offset, request.length, &request.result, request.scratch);
+    } else if (result < 0) {
+      request.result = Slice(request.scratch, static_cast<size_t>(0));
+      request.status = STATUS_IO_ERROR(filename_, -result);
+    } else if (result > 0 && static_cast<size_t>(result) < request.length) {
+      // Short read, read the rest in the same way as Read does.
+      Slice rest;
+      request.status = Read(
+          request.offset + result, request.length - result, &rest, request.scratch + result);
+      request.result = Slice(request.scratch, static_cast<size_t>(result) + rest.size());
+    } else {
+      request.result = Slice(request.scratch, static_cast<size_t>(result));
+      request.status = Status::OK();
+    }
+  }
+  if (!use_os_buffer_) {
+    Fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);  // free OS pages
+  }
+}
+
 Result<uint64_t> PosixRandomAccessFile::Size() const {
   TRACE_EVENT1("io", __PRETTY_FUNCTION__, "path", filename_);
   ThreadRestrictions::AssertIOAllowed();
@@ -50,6 +50,9 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual CHECKED_STATUS Read(uint64_t offset, size_t n, Slice* result,
                       uint8_t* scratch) const override;
 
+  // Submits the reads through io_uring when FLAGS_use_io_uring_for_multi_reads is set.
+  void MultiRead(ReadRequest* requests, size_t count) const override;
+
   Result<uint64_t> Size() const override;
 
   Result<uint64_t> INode() const override;
@@ -0,0 +1,251 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/io_uring.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <glog/logging.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define YB_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace yb {
+
+#ifdef YB_HAVE_IO_URING
+
+namespace {
+
+constexpr unsigned kRingEntries = 64;
+
+template <class T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+void UnmapAndClose(void* sq_ring, size_t sq_ring_size, void* cq_ring, size_t cq_ring_size,
+                   void* sqes, size_t sqes_size, int ring_fd) {
+  if (sqes) {
+    munmap(sqes, sqes_size);
+  }
+  if (cq_ring && cq_ring != sq_ring) {
+    munmap(cq_ring, cq_ring_size);
+  }
+  if (sq_ring) {
+    munmap(sq_ring, sq_ring_size);
+  }
+  if (ring_fd >= 0) {
+    close(ring_fd);
+  }
+}
+
+} // namespace
+
+IoUring::~IoUring() {
+  UnmapAndClose(sq_ring_, sq_ring_size_, cq_ring_, cq_ring_size_, sqes_, sqes_size_, ring_fd_);
+}
+
+int IoUring::Init(unsigned entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = syscall(__NR_io_uring_setup, entries, &params);
+  if (ring_fd_ < 0) {
+    return errno;
+  }
+
+  sq_entries_ = params.sq_entries;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+  single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    return errno;
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      return errno;
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    sqes_ = nullptr;
+    return errno;
+  }
+
+  sq_tail_ = RingField<unsigned>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = RingField<unsigned>(sq_ring_, params.sq_off.ring_mask);
+  sq_array_ = RingField<unsigned>(sq_ring_, params.sq_off.array);
+  cq_head_ = RingField<unsigned>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<unsigned>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = RingField<unsigned>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  return 0;
+}
+
+size_t IoUring::Reap(IoUringRead* reads) {
+  // This thread is the only consumer of the completion queue.
+  unsigned head = *cq_head_;
+  const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  size_t reaped = 0;
+  for (; head != tail; ++head, ++reaped) {
+    const auto& cqe = static_cast<io_uring_cqe*>(cqes_)[head & *cq_mask_];
+    reads[cqe.user_data].result = cqe.res;
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return reaped;
+}
+
+void IoUring::Read(IoUringRead* reads, size_t count) {
+  std::vector<iovec> iovecs(count);
+  // Reads are queued to the submission queue in order. The first "queued" reads are queued,
+  // "unsubmitted" of them are still in the submission queue, and "in_flight" are being executed by
+  // the kernel.
+  size_t queued = 0;
+  unsigned unsubmitted = 0;
+  size_t in_flight = 0;
+  size_t completed = 0;
+  int error = 0;
+  while (completed < count) {
+    while (queued < count && unsubmitted + in_flight < sq_entries_) {
+      // This thread is the only producer of the submission queue.
+      const unsigned tail = *sq_tail_;
+      const unsigned index = tail & *sq_mask_;
+      auto& sqe = static_cast<io_uring_sqe*>(sqes_)[index];
+      memset(&sqe, 0, sizeof(sqe));
+      iovecs[queued].iov_base = reads[queued].buffer;
+      iovecs[queued].iov_len = reads[queued].length;
+      sqe.opcode = IORING_OP_READV;
+      sqe.fd = reads[queued].fd;
+      sqe.off = reads[queued].offset;
+      sqe.addr = reinterpret_cast<uint64_t>(&iovecs[queued]);
+      sqe.len = 1;
+      sqe.user_data = queued;
+      sq_array_[index] = index;
+      __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      ++queued;
+      ++unsubmitted;
+    }
+
+    const int submitted = syscall(
+        __NR_io_uring_enter, ring_fd_, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (submitted < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+        const auto reaped = Reap(reads);
+        completed += reaped;
+        in_flight -= reaped;
+        continue;
+      }
+      error = errno;
+      break;
+    }
+    unsubmitted -= submitted;
+    in_flight += submitted;
+    const auto reaped = Reap(reads);
+    completed += reaped;
+    in_flight -= reaped;
+  }
+
+  if (error == 0) {
+    return;
+  }
+
+  // The ring failed. Take back the reads which were not consumed by the kernel, and wait for the
+  // ones it is executing, since they write into the caller's buffers.
+  LOG(WARNING) << "io_uring_enter failed: " << strerror(error) << ", falling back to pread";
+  broken_ = true;
+  __atomic_store_n(sq_tail_, *sq_tail_ - unsubmitted, __ATOMIC_RELEASE);
+  for (size_t i = queued - unsubmitted; i != count; ++i) {
+    reads[i].result = -ECANCELED;
+  }
+  while (in_flight > 0) {
+    if (syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+        errno != EINTR) {
+      LOG(FATAL) << "Unable to wait for in flight io_uring reads: " << strerror(errno);
+    }
+    in_flight -= Reap(reads);
+  }
+}
+
+IoUring* IoUring::ForCurrentThread() {
+  static thread_local std::unique_ptr<IoUring> ring;
+  static thread_local bool initialized = false;
+  if (!initialized) {
+    initialized = true;
+    std::unique_ptr<IoUring> new_ring(new IoUring());
+    const int error = new_ring->Init(kRingEntries);
+    if (error == 0) {
+      ring = std::move(new_ring);
+    } else {
+      LOG(WARNING) << "Failed to create io_uring: " << strerror(error);
+    }
+  }
+  return ring && !ring->broken_ ? ring.get() : nullptr;
+}
+
+#else // YB_HAVE_IO_URING
+
+IoUring::~IoUring() {
+}
+
+int IoUring::Init(unsigned entries) {
+  return ENOSYS;
+}
+
+size_t IoUring::Reap(IoUringRead* reads) {
+  return 0;
+}
+
+void IoUring::Read(IoUringRead* reads, size_t count) {
+  for (size_t i = 0; i != count; ++i) {
+    reads[i].result = -ECANCELED;
+  }
+}
+
+IoUring* IoUring::ForCurrentThread() {
+  return nullptr;
+}
+
+#endif // YB_HAVE_IO_URING
+
+} // namespace yb
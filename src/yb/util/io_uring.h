@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_IO_URING_H
+#define YB_UTIL_IO_URING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+namespace yb {
+
+struct IoUringRead {
+  int fd;
+  uint64_t offset;
+  size_t length;
+  uint8_t* buffer;
+
+  // Number of bytes read, or negative errno. -ECANCELED means that the read was not submitted
+  // because of a failure of the ring itself, so the caller should fall back to pread.
+  ssize_t result;
+};
+
+// Minimal io_uring wrapper, that submits a batch of file reads with as few system calls as
+// possible. Does not depend on liburing, and is available only when built with io_uring kernel
+// headers.
+//
+// Each thread has its own ring, so no synchronization is required.
+class IoUring {
+ public:
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  void operator=(const IoUring&) = delete;
+
+  // Returns the ring of the current thread, or nullptr if io_uring is not supported or the ring
+  // could not be created.
+  static IoUring* ForCurrentThread();
+
+  // Submits the reads and waits for all of them to complete. Short reads are not retried.
+  void Read(IoUringRead* reads, size_t count);
+
+ private:
+  IoUring() = default;
+
+  // Returns 0 on success or errno.
+  int Init(unsigned entries);
+
+  // Stores results of completed reads and returns their number.
+  size_t Reap(IoUringRead* reads);
+
+  int ring_fd_ = -1;
+  bool broken_ = false;
+  unsigned sq_entries_ = 0;
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  void* cqes_ = nullptr;
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_IO_URING_H
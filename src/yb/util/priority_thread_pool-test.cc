@@ -290,4 +290,45 @@ TEST(PriorityThreadPoolTest, ChangePriority) {
   ASSERT_EQ(running, std::vector<int>({2, 5, 6}));
 }
 
+TEST(PriorityThreadPoolTest, TasksSnapshot) {
+  const int kMaxRunningTasks = 2;
+  PriorityThreadPool thread_pool(kMaxRunningTasks);
+  Share share;
+  std::vector<int> running;
+
+  auto se = ScopeExit([&share, &thread_pool] {
+    thread_pool.StartShutdown();
+    share.StopAll();
+    thread_pool.CompleteShutdown();
+  });
+
+  ASSERT_EQ(thread_pool.max_running_tasks(), kMaxRunningTasks);
+  ASSERT_TRUE(thread_pool.TasksSnapshot().empty());
+
+  SubmitTask(1, &share, &thread_pool);
+  auto task3 = SubmitTask(3, &share, &thread_pool);
+  SubmitTask(2, &share, &thread_pool);
+
+  share.FillRunningTaskPriorities(&running);
+  ASSERT_EQ(running, std::vector<int>({2, 3}));
+
+  auto snapshot = thread_pool.TasksSnapshot();
+  ASSERT_EQ(snapshot.size(), 3);
+  std::vector<int> priorities;
+  for (const auto& info : snapshot) {
+    priorities.push_back(info.priority);
+  }
+  ASSERT_EQ(priorities, std::vector<int>({3, 2, 1}));
+  ASSERT_EQ(snapshot[0].serial_no, task3);
+  ASSERT_EQ(snapshot[0].state, "kRunning");
+  ASSERT_EQ(snapshot[0].description, "{ index: 3 }");
+  // Task 1 was started first and then paused in favor of task 2.
+  ASSERT_EQ(snapshot[2].state, "kPaused");
+
+  share.Stop(3);
+  share.FillRunningTaskPriorities(&running);
+  ASSERT_EQ(running, std::vector<int>({1, 2}));
+  ASSERT_EQ(thread_pool.TasksSnapshot().size(), 2);
+}
+
 } // namespace yb
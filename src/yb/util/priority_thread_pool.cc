@@ -102,6 +102,12 @@ class PriorityThreadPoolInternalTask {
     state_.store(value, std::memory_order_relaxed);
   }
 
+  PriorityThreadPoolTaskInfo Info() const {
+    return PriorityThreadPoolTaskInfo {
+      serial_no_, priority(), yb::ToString(state()), TaskToString()
+    };
+  }
+
   std::string ToString() const {
     return Format("{ task: $0 worker: $1 state: $2 priority: $3 serial: $4 }",
                   TaskToString(), worker_, state(), priority(), serial_no_);
@@ -504,6 +510,21 @@ class PriorityThreadPool::Impl : public PriorityThreadPoolWorkerContext {
     return DoStateToString();
   }
 
+  std::vector<PriorityThreadPoolTaskInfo> TasksSnapshot() {
+    std::vector<PriorityThreadPoolTaskInfo> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& index = tasks_.get<PriorityTag>();
+    result.reserve(index.size());
+    for (const auto& task : index) {
+      result.push_back(task.Info());
+    }
+    return result;
+  }
+
+  size_t max_running_tasks() const {
+    return max_running_tasks_;
+  }
+
  private:
   std::string DoStateToString() REQUIRES(mutex_) {
     return Format(
@@ -717,6 +738,14 @@ std::string PriorityThreadPool::StateToString() {
   return impl_->StateToString();
 }
 
+std::vector<PriorityThreadPoolTaskInfo> PriorityThreadPool::TasksSnapshot() {
+  return impl_->TasksSnapshot();
+}
+
+size_t PriorityThreadPool::max_running_tasks() const {
+  return impl_->max_running_tasks();
+}
+
 bool PriorityThreadPool::ChangeTaskPriority(size_t serial_no, int priority) {
   return impl_->ChangeTaskPriority(serial_no, priority);
 }
@@ -15,6 +15,7 @@
 #define YB_UTIL_PRIORITY_THREAD_POOL_H
 
 #include <memory>
+#include <vector>
 
 #include "yb/util/locks.h"
 #include "yb/util/status.h"
@@ -54,6 +55,15 @@ class PriorityThreadPoolTask {
   const size_t serial_no_;
 };
 
+// Point in time description of task in the pool, used for diagnostics.
+struct PriorityThreadPoolTaskInfo {
+  size_t serial_no;
+  int priority;
+  // One of: kPaused, kNotStarted, kRunning.
+  std::string state;
+  std::string description;
+};
+
 // Tasks submitted to this pool have assigned priority and are picked from queue using it.
 class PriorityThreadPool {
  public:
@@ -99,6 +109,12 @@ class PriorityThreadPool {
   // Dumps state to string, useful for debugging.
   std::string StateToString();
 
+  // Returns snapshot of tasks that are currently present in the pool, ordered by priority,
+  // highest priority first.
+  std::vector<PriorityThreadPoolTaskInfo> TasksSnapshot();
+
+  size_t max_running_tasks() const;
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
@@ -39,6 +39,7 @@
 #include <unistd.h>
 
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/prctl.h>
 #endif // defined(__linux__)
 
@@ -57,6 +58,7 @@
 #include "yb/gutil/mathlimits.h"
 #include "yb/gutil/once.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/errno.h"
 #include "yb/util/logging.h"
@@ -551,6 +553,55 @@ void SetThreadName(const std::string& name) {
   }
 }
 
+namespace {
+
+thread_local int pinned_cpu = -1;
+
+} // namespace
+
+Status PinCurrentThreadToCpu(int cpu) {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return STATUS(RuntimeError, Format("Failed to pin thread to CPU $0", cpu), Errno(err));
+  }
+  pinned_cpu = cpu;
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Thread affinity is not supported on this platform");
+#endif // defined(__linux__)
+}
+
+int CurrentThreadPinnedCpu() {
+  return pinned_cpu;
+}
+
+std::vector<int> GetAffinityCpus() {
+  std::vector<int> result;
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0 /* pid */, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        result.push_back(cpu);
+      }
+    }
+  } else {
+    LOG(WARNING) << "Failed to get CPU affinity: " << ErrnoToString(errno);
+  }
+#endif // defined(__linux__)
+  if (result.empty()) {
+    for (int cpu = 0; cpu != base::NumCPUs(); ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
 void InitThreading() {
   std::call_once(init_threading_internal_once_flag, InitThreadingInternal);
 }
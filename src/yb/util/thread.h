@@ -407,6 +407,16 @@ void InitThreading();
 
 void SetThreadName(const std::string& name);
 
+// Restricts the current thread to run only on the specified CPU.
+Status PinCurrentThreadToCpu(int cpu);
+
+// Returns CPU that the current thread was pinned to by PinCurrentThreadToCpu, or -1 if it was not
+// pinned.
+int CurrentThreadPinnedCpu();
+
+// Returns CPUs that this process is allowed to run on, in ascending order.
+std::vector<int> GetAffinityCpus();
+
 class CDSAttacher {
  public:
   CDSAttacher();
@@ -24,6 +24,7 @@
 #include "yb/rpc/rpc_context.h"
 
 #include "yb/util/crypt.h"
+#include "yb/util/flag_tags.h"
 
 #include "yb/yql/cql/cqlserver/cql_service.h"
 
@@ -71,6 +72,9 @@ METRIC_DEFINE_counter(server, cql_processors_created,
                       yb::MetricUnit::kUnits,
                       "Number of created CQL Processors.");
 
+DEFINE_test_flag(int32, cql_processor_delay_call_ms, 0,
+                 "Delay the processing of each CQL call by this number of milliseconds.");
+
 DECLARE_bool(use_cassandra_authentication);
 
 namespace yb {
@@ -158,15 +162,22 @@ void CQLProcessor::Shutdown() {
 
 void CQLProcessor::ProcessCall(rpc::InboundCallPtr call) {
   call_ = std::dynamic_pointer_cast<CQLInboundCall>(std::move(call));
+  if (PREDICT_FALSE(FLAGS_cql_processor_delay_call_ms > 0)) {
+    SleepFor(MonoDelta::FromMilliseconds(FLAGS_cql_processor_delay_call_ms));
+  }
   unique_ptr<CQLRequest> request;
   unique_ptr<CQLResponse> response;
 
   // Parse the CQL request. If the parser failed, it sets the error message in response.
   parse_begin_ = MonoTime::Now();
-  const auto& context = static_cast<const CQLConnectionContext&>(call_->connection()->context());
-  const auto compression_scheme = context.compression_scheme();
-  if (!CQLRequest::ParseRequest(call_->serialized_request(), compression_scheme,
-                                &request, &response)) {
+  // Small requests are already decoded by the connection context when received.
+  if (!call_->TakeDecodedRequest(&request, &response)) {
+    const auto& context =
+        static_cast<const CQLConnectionContext&>(call_->connection()->context());
+    const auto compression_scheme = context.compression_scheme();
+    CQLRequest::ParseRequest(call_->serialized_request(), compression_scheme, &request, &response);
+  }
+  if (request == nullptr) {
     cql_metrics_->num_errors_parsing_cql_->Increment();
     PrepareAndSendResponse(response);
     return;
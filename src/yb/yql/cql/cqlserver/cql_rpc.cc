@@ -24,6 +24,7 @@
 #include "yb/rpc/rpc_introspection.pb.h"
 
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/size_literals.h"
 
 using yb::cqlserver::CQLMessage;
@@ -55,6 +56,19 @@ DEFINE_int32(max_message_length, 254_MB,
 DEFINE_bool(cql_server_always_send_events, false,
             "All CQL connections automatically subscribed for all CQL events.");
 
+DEFINE_int32(cql_decode_on_reactor_max_message_size, 4_KB,
+             "Uncompressed CQL requests not larger than this size are decoded on the reactor "
+             "thread as soon as they are received. 0 to always decode them in the service "
+             "thread.");
+TAG_FLAG(cql_decode_on_reactor_max_message_size, advanced);
+TAG_FLAG(cql_decode_on_reactor_max_message_size, runtime);
+
+DEFINE_int32(cql_max_in_flight_calls_per_connection, 4096,
+             "The maximum number of calls being handled for a single CQL connection. Calls "
+             "received above this limit are rejected with OVERLOADED error. 0 for no limit.");
+TAG_FLAG(cql_max_in_flight_calls_per_connection, advanced);
+TAG_FLAG(cql_max_in_flight_calls_per_connection, runtime);
+
 namespace yb {
 namespace cqlserver {
 
@@ -64,7 +78,7 @@ CQLConnectionContext::CQLConnectionContext(
     : ql_session_(new ql::QLSession()),
       parser_(buffer_tracker, CQLMessage::kMessageHeaderLength, CQLMessage::kHeaderPosLength,
               FLAGS_max_message_length, rpc::IncludeHeader::kTrue, rpc::SkipEmptyMessages::kFalse,
-              this),
+              this, &read_buffer_),
       read_buffer_(receive_buffer_size, buffer_tracker),
       call_tracker_(call_tracker) {
   VLOG(1) << "CQL Connection Context: FLAGS_cql_server_always_send_events = " <<
@@ -95,11 +109,36 @@ Status CQLConnectionContext::HandleCall(
     return STATUS_SUBSTITUTE(NetworkError, "Bad data: $0", s.ToUserMessage());
   }
 
+  // Checked before the call is stored, so at most the configured number of calls are admitted.
+  const auto calls_in_flight = num_calls_being_handled();
+  const bool too_many_calls_in_flight =
+      FLAGS_cql_max_in_flight_calls_per_connection > 0 &&
+      calls_in_flight >= static_cast<size_t>(FLAGS_cql_max_in_flight_calls_per_connection);
+
+  // The call is stored even when rejected, because the response is sent through this context.
   s = Store(call.get());
   if (!s.ok()) {
     return s;
   }
 
+  if (too_many_calls_in_flight) {
+    call->RespondFailure(
+        rpc::ErrorStatusPB::ERROR_SERVER_TOO_BUSY,
+        STATUS_FORMAT(ServiceUnavailable, "Too many calls in flight: $0", calls_in_flight));
+    return Status::OK();
+  }
+
+  // Small requests are decoded here, so the pipelined requests of a connection do not wait for
+  // a service thread to be decoded. Compressed requests depend on the compression scheme that
+  // could be changed by a STARTUP request that is still being processed, so they are left to the
+  // service thread.
+  const Slice& request = call->serialized_request();
+  if (request.size() >= CQLMessage::kMessageHeaderLength &&
+      static_cast<int64_t>(request.size()) <= FLAGS_cql_decode_on_reactor_max_message_size &&
+      (request[CQLMessage::kHeaderPosFlags] & CQLMessage::kCompressionFlag) == 0) {
+    call->DecodeRequest();
+  }
+
   reactor->messenger()->QueueInboundCall(call);
 
   return Status::OK();
@@ -205,6 +244,25 @@ void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer,
   QueueResponse(/* is_success */ true);
 }
 
+void CQLInboundCall::DecodeRequest() {
+  TRACE_EVENT0("rpc", "CQLInboundCall::DecodeRequest");
+  CQLRequest::ParseRequest(
+      serialized_request_, CQLMessage::CompressionScheme::kNone, &decoded_request_,
+      &decode_error_response_);
+  request_decoded_ = true;
+}
+
+bool CQLInboundCall::TakeDecodedRequest(
+    std::unique_ptr<CQLRequest>* request, std::unique_ptr<CQLResponse>* error_response) {
+  if (!request_decoded_) {
+    return false;
+  }
+  request_decoded_ = false;
+  *request = std::move(decoded_request_);
+  *error_response = std::move(decode_error_response_);
+  return true;
+}
+
 void CQLInboundCall::GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb) const {
   std::shared_ptr<const CQLRequest> request =
 #ifdef THREAD_SANITIZER
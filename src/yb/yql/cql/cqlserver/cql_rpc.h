@@ -129,6 +129,15 @@ class CQLInboundCall : public rpc::InboundCall {
   const std::string& method_name() const override;
   void RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_code, const Status& status) override;
   void RespondSuccess(const RefCntBuffer& buffer, const yb::rpc::RpcMethodMetrics& metrics);
+
+  // Decodes the uncompressed request right after it is received, so the processor does not
+  // have to.
+  void DecodeRequest();
+
+  // Takes the result of DecodeRequest. Returns false if the request was not decoded.
+  bool TakeDecodedRequest(
+      std::unique_ptr<CQLRequest>* request, std::unique_ptr<CQLResponse>* error_response);
+
   void GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb) const;
   void SetRequest(std::shared_ptr<const CQLRequest> request, CQLServiceImpl* service_impl) {
     service_impl_ = service_impl;
@@ -154,6 +163,11 @@ class CQLInboundCall : public rpc::InboundCall {
   // Pointer to the containing CQL service implementation.
   CQLServiceImpl* service_impl_;
 
+  // Result of DecodeRequest.
+  bool request_decoded_ = false;
+  std::unique_ptr<CQLRequest> decoded_request_;
+  std::unique_ptr<CQLResponse> decode_error_response_;
+
   ScopedTrackedConsumption consumption_;
 };
 
@@ -27,6 +27,9 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(cql_server_always_send_events);
+DECLARE_int32(cql_decode_on_reactor_max_message_size);
+DECLARE_int32(cql_max_in_flight_calls_per_connection);
+DECLARE_int32(cql_processor_delay_call_ms);
 
 namespace yb {
 namespace cqlserver {
@@ -249,6 +252,52 @@ TEST_F(TestCQLService, InvalidRequest) {
                     "\x00\x00\x00\x0a" "\x00\x17" "Request length too long"));
 }
 
+TEST_F(TestCQLService, DecodeInServiceThread) {
+  FLAGS_cql_decode_on_reactor_max_message_size = 0;
+
+  // Send STARTUP request using version V4
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\x01" "\x00\x00\x00\x16"
+                    "\x00\x01" "\x00\x0b" "CQL_VERSION"
+                               "\x00\x05" "3.0.0"),
+      BINARY_STRING("\x84\x00\x00\x00\x02" "\x00\x00\x00\x00"));
+
+  // Send an unknown opcode
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\xff" "\x00\x00\x00\x22"
+                    "\x00\x00\x00\x0a" "\x00\x1c" "Unsupported protocol version"),
+      BINARY_STRING("\x84\x00\x00\x00\x00" "\x00\x00\x00\x14"
+                    "\x00\x00\x00\x0a" "\x00\x0e" "Unknown opcode"));
+}
+
+TEST_F(TestCQLService, MaxInFlightCallsPerConnection) {
+  FLAGS_cql_max_in_flight_calls_per_connection = 1;
+  FLAGS_cql_processor_delay_call_ms = 1000;
+
+  // Send two pipelined OPTIONS requests with stream ids 1 and 2. The first one is still being
+  // processed when the second one is received, so the second one is rejected right away.
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x01\x05" "\x00\x00\x00\x00"
+                    "\x04\x00\x00\x02\x05" "\x00\x00\x00\x00"),
+      BINARY_STRING("\x84\x00\x00\x02\x00" "\x00\x00\x00\x1c"
+                    "\x00\x00\x10\x01" "\x00\x16" "CQL service queue full"
+                    "\x84\x00\x00\x01\x06" "\x00\x00\x00\x3b"
+                    "\x00\x02" "\x00\x0b" "COMPRESSION"
+                               "\x00\x02" "\x00\x03" "lz4" "\x00\x06" "snappy"
+                               "\x00\x0b" "CQL_VERSION"
+                               "\x00\x02" "\x00\x05" "3.0.0" "\x00\x05" "3.4.2"));
+
+  // Once the first call is done, a new call is admitted.
+  FLAGS_cql_processor_delay_call_ms = 0;
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x03\x05" "\x00\x00\x00\x00"),
+      BINARY_STRING("\x84\x00\x00\x03\x06" "\x00\x00\x00\x3b"
+                    "\x00\x02" "\x00\x0b" "COMPRESSION"
+                               "\x00\x02" "\x00\x03" "lz4" "\x00\x06" "snappy"
+                               "\x00\x0b" "CQL_VERSION"
+                               "\x00\x02" "\x00\x05" "3.0.0" "\x00\x05" "3.4.2"));
+}
+
 TEST_F(TestCQLService, TestCQLServerEventConst) {
   std::unique_ptr<SchemaChangeEventResponse> response(
       new SchemaChangeEventResponse("", "", "", "", {}));
@@ -94,5 +94,93 @@ CHECKED_STATUS Executor::ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB
   return Status::OK();
 }
 
+std::unique_ptr<QLWriteRequestTemplate> Executor::BuildWriteRequestTemplate(
+    const PTInsertStmt *tnode) {
+  // Only INSERT statements with bind variables, i.e. prepared statements that are executed many
+  // times, and with column values that are either bind variables or constants are supported.
+  if (tnode->bind_variables().empty() ||
+      tnode->InsertingValue()->opcode() != TreeNodeOpcode::kPTInsertValuesClause ||
+      !tnode->subscripted_col_args().empty() || !tnode->json_col_args().empty()) {
+    return nullptr;
+  }
+
+  auto result = std::make_unique<QLWriteRequestTemplate>();
+  QLWriteRequestPB *req = &result->request;
+  for (const ColumnArg& col : tnode->column_args()) {
+    if (!col.IsInitialized()) {
+      continue;
+    }
+
+    const ColumnDesc *col_desc = col.desc();
+    QLWriteRequestTemplate::ExprGroup group;
+    int index;
+    if (col_desc->is_hash()) {
+      group = QLWriteRequestTemplate::ExprGroup::kHashed;
+      index = req->hashed_column_values_size();
+    } else if (col_desc->is_primary()) {
+      group = QLWriteRequestTemplate::ExprGroup::kRange;
+      index = req->range_column_values_size();
+    } else {
+      group = QLWriteRequestTemplate::ExprGroup::kRegular;
+      index = req->column_values_size();
+    }
+    QLExpressionPB *expr_pb = CreateQLExpression(req, *col_desc);
+
+    const PTExpr::SharedPtr& expr = col.expr();
+    switch (expr->expr_op()) {
+      case ExprOperator::kBindVar:
+        result->bind_vars.push_back(QLWriteRequestTemplate::BindVarLocation {
+            group, index, static_cast<const PTBindVar*>(expr.get()), col_desc->is_primary() });
+        break;
+
+      case ExprOperator::kConst:
+        // Null primary key values are reported by the regular execution path.
+        if (!PTConstToPB(expr, expr_pb->mutable_value()).ok() ||
+            (col_desc->is_primary() && IsNull(expr_pb->value()))) {
+          return nullptr;
+        }
+        break;
+
+      default:
+        // Collections could contain bind variables, and function calls should be evaluated on
+        // each execution.
+        return nullptr;
+    }
+  }
+
+  if (!ColumnRefsToPB(tnode, req->mutable_column_refs()).ok()) {
+    return nullptr;
+  }
+  return result;
+}
+
+CHECKED_STATUS Executor::WriteRequestFromTemplate(const PTInsertStmt *tnode,
+                                                  const QLWriteRequestTemplate& request_template,
+                                                  QLWriteRequestPB *req) {
+  req->MergeFrom(request_template.request);
+  for (const auto& bind_var : request_template.bind_vars) {
+    QLExpressionPB *expr_pb = nullptr;
+    switch (bind_var.group) {
+      case QLWriteRequestTemplate::ExprGroup::kHashed:
+        expr_pb = req->mutable_hashed_column_values(bind_var.index);
+        break;
+      case QLWriteRequestTemplate::ExprGroup::kRange:
+        expr_pb = req->mutable_range_column_values(bind_var.index);
+        break;
+      case QLWriteRequestTemplate::ExprGroup::kRegular:
+        expr_pb = req->mutable_column_values(bind_var.index)->mutable_expr();
+        break;
+    }
+    RETURN_NOT_OK(PTExprToPB(bind_var.bind_var, expr_pb));
+
+    // Null values not allowed for primary key: checking here catches nulls introduced by bind.
+    if (bind_var.is_primary && expr_pb->has_value() && IsNull(expr_pb->value())) {
+      LOG(INFO) << "Unexpected null value. Current request: " << req->DebugString();
+      return exec_context_->Error(tnode, ErrorCode::NULL_ARGUMENT_FOR_PRIMARY_KEY);
+    }
+  }
+  return Status::OK();
+}
+
 }  // namespace ql
 }  // namespace yb
@@ -1138,8 +1138,20 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
     return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
   }
 
+  const QLWriteRequestTemplate* request_template = tnode->write_request_template(
+      [this, tnode] { return BuildWriteRequestTemplate(tnode); });
+
   // Set the values for columns.
-  if (tnode->InsertingValue()->opcode() == TreeNodeOpcode::kPTInsertJsonClause) {
+  if (request_template != nullptr) {
+    // Column values and references come from the template, only bind variables are evaluated.
+    s = WriteRequestFromTemplate(tnode, *request_template, req);
+    if (PREDICT_FALSE(!s.ok())) {
+      ErrorCode error_code =
+          s.code() == Status::kNotSupported || s.code() == Status::kRuntimeError ?
+          ErrorCode::INVALID_REQUEST : ErrorCode::INVALID_ARGUMENTS;
+      return exec_context_->Error(tnode, s, error_code);
+    }
+  } else if (tnode->InsertingValue()->opcode() == TreeNodeOpcode::kPTInsertJsonClause) {
     // Error messages are already formatted and don't need additional wrap
     RETURN_NOT_OK(
         InsertJsonClauseToPB(tnode,
@@ -1159,9 +1171,11 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
   }
 
   // Setup the column values that need to be read.
-  s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  if (request_template == nullptr) {
+    s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
   }
 
   // Set the IF clause.
@@ -326,6 +326,14 @@ class Executor : public QLExprExecutor {
   // Convert column arguments to protobuf.
   CHECKED_STATUS ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB *req);
 
+  // Build write request template for the INSERT statement, see QLWriteRequestTemplate.
+  std::unique_ptr<QLWriteRequestTemplate> BuildWriteRequestTemplate(const PTInsertStmt *tnode);
+
+  // Fill the write request from the template and values of the bind variables.
+  CHECKED_STATUS WriteRequestFromTemplate(const PTInsertStmt *tnode,
+                                          const QLWriteRequestTemplate& request_template,
+                                          QLWriteRequestPB *req);
+
   // Convert INSERT JSON clause to protobuf.
   CHECKED_STATUS InsertJsonClauseToPB(const PTInsertStmt *insert_stmt,
                                       const PTInsertJsonClause *json_clause,
@@ -18,6 +18,10 @@
 #ifndef YB_YQL_CQL_QL_PTREE_PT_INSERT_H_
 #define YB_YQL_CQL_QL_PTREE_PT_INSERT_H_
 
+#include <mutex>
+
+#include "yb/common/ql_protocol.pb.h"
+
 #include "yb/yql/cql/ql/ptree/column_desc.h"
 #include "yb/yql/cql/ql/ptree/list_node.h"
 #include "yb/yql/cql/ql/ptree/pt_dml.h"
@@ -30,6 +34,28 @@ namespace ql {
 
 //--------------------------------------------------------------------------------------------------
 
+// Skeleton of the write request for an INSERT statement, that is built once and shared by all
+// executions of the prepared statement. Values of constants are already evaluated in the request,
+// so an execution only has to patch in the values of the bind variables.
+struct QLWriteRequestTemplate {
+  // Group of the column expressions in QLWriteRequestPB.
+  enum class ExprGroup {
+    kHashed,
+    kRange,
+    kRegular,
+  };
+
+  struct BindVarLocation {
+    ExprGroup group;
+    int index;
+    const PTBindVar* bind_var;
+    bool is_primary;
+  };
+
+  QLWriteRequestPB request;
+  std::vector<BindVarLocation> bind_vars;
+};
+
 class PTInsertStmt : public PTDmlStmt {
  public:
   //------------------------------------------------------------------------------------------------
@@ -80,6 +106,16 @@ class PTInsertStmt : public PTDmlStmt {
     return inserting_value_;
   }
 
+  // Returns the write request template of this statement, building it with builder on the first
+  // call. Returns nullptr when the statement cannot be executed from a template.
+  template <class Builder>
+  const QLWriteRequestTemplate* write_request_template(const Builder& builder) const {
+    std::call_once(write_request_template_once_, [this, &builder] {
+      write_request_template_ = builder();
+    });
+    return write_request_template_.get();
+  }
+
  private:
 
   //
@@ -112,6 +148,9 @@ class PTInsertStmt : public PTDmlStmt {
 
   // -- The semantic analyzer will decorate this node with the following information --
 
+  // -- The executor will decorate this node with the following information --
+  mutable std::once_flag write_request_template_once_;
+  mutable std::unique_ptr<QLWriteRequestTemplate> write_request_template_;
 };
 
 }  // namespace ql
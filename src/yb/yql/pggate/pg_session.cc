@@ -266,24 +266,30 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
   if (pg_session_.buffering_enabled_ && !force_non_bufferable &&
       op->type() == YBOperation::Type::PGSQL_WRITE) {
     const auto& wop = *down_cast<client::YBPgsqlWriteOp*>(op.get());
+    RowIdentifier row_id(wop);
+    // Operations on the same row as an in flight operation must not be sent until it completes.
+    if (PREDICT_FALSE(pg_session_.in_flight_keys_.count(row_id))) {
+      RETURN_NOT_OK(pg_session_.WaitForInFlightOperations());
+    }
     // Check for buffered operation related to same row.
     // If multiple operations are performed in context of single RPC second operation will not
     // see the results of first operation on DocDB side.
     // Multiple operations on same row must be performed in context of different RPC.
     // Flush is required in this case.
-    if (PREDICT_FALSE(!buffered_keys.insert(RowIdentifier(wop)).second)) {
+    if (PREDICT_FALSE(!buffered_keys.insert(row_id).second)) {
       RETURN_NOT_OK(pg_session_.FlushBufferedOperationsImpl());
-      buffered_keys.insert(RowIdentifier(wop));
+      buffered_keys.insert(row_id);
     }
     buffered_ops_.push_back({std::move(op), relation_id});
-    // Flush buffers in case limit of operations in single RPC exceeded.
+    // Send buffers in case limit of operations in single RPC exceeded.
     return PREDICT_TRUE(buffered_keys.size() < FLAGS_ysql_session_max_batch_size)
         ? Status::OK()
-        : pg_session_.FlushBufferedOperationsImpl();
+        : pg_session_.SendBufferedOperations();
   }
 
-  // Flush all buffered operations (if any) before performing non-bufferable operation
-  if (!buffered_keys.empty()) {
+  // Flush all buffered and in flight operations (if any) before performing non-bufferable
+  // operation.
+  if (!buffered_keys.empty() || !pg_session_.in_flight_ops_.empty()) {
     RETURN_NOT_OK(pg_session_.FlushBufferedOperationsImpl());
   }
   bool needs_pessimistic_locking = false;
@@ -750,40 +756,88 @@ void PgSession::InvalidateTableCache(const PgObjectId& table_id) {
 }
 
 void PgSession::StartOperationsBuffering() {
-  DCHECK(buffered_keys_.empty());
+  DCHECK(buffered_ops_.empty());
   buffering_enabled_ = true;
 }
 
-void PgSession::ResetOperationsBuffering() {
+Status PgSession::ResetOperationsBuffering() {
   VLOG_IF(1, !buffered_keys_.empty())
           << "Dropping " << buffered_keys_.size() << " pending operations";
+  // Operations which were already sent can't be dropped.
+  auto status = WaitForInFlightOperations();
+  LOG_IF(WARNING, !status.ok()) << "In flight operations failed: " << status;
   buffering_enabled_ = false;
   buffered_keys_.clear();
   buffered_ops_.clear();
   buffered_txn_ops_.clear();
+  return status;
 }
 
 Status PgSession::FlushBufferedOperations() {
-  DCHECK(buffering_enabled_);
   buffering_enabled_ = false;
   return FlushBufferedOperationsImpl();
 }
 
+Status PgSession::StopOperationsBuffering() {
+  DCHECK(buffering_enabled_);
+  buffering_enabled_ = false;
+  return buffered_ops_.empty() ? Status::OK() : FlushBufferedOperationsImpl();
+}
+
 Status PgSession::FlushBufferedOperationsImpl() {
+  auto status = SendBufferedOperations();
+  // Wait for operations which were sent even if sending others failed.
+  auto wait_status = WaitForInFlightOperations();
+  return status.ok() ? wait_status : status;
+}
+
+Status PgSession::SendBufferedOperations() {
   auto ops = std::move(buffered_ops_);
   auto txn_ops = std::move(buffered_txn_ops_);
-  buffered_keys_.clear();
   buffered_ops_.clear();
   buffered_txn_ops_.clear();
+  for (auto& key : buffered_keys_) {
+    in_flight_keys_.insert(key);
+  }
+  buffered_keys_.clear();
+  Status status;
   if (!ops.empty()) {
-    RETURN_NOT_OK(FlushBufferedOperationsImpl(ops, false /* transactional */));
+    status = SendBufferedOperations(std::move(ops), false /* transactional */);
   }
-  if (!txn_ops.empty()) {
+  if (status.ok() && !txn_ops.empty()) {
     // No transactional operations are expected in the initdb mode.
     DCHECK(!YBCIsInitDbModeEnvVarSet());
-    RETURN_NOT_OK(FlushBufferedOperationsImpl(txn_ops, true /* transactional */));
+    status = SendBufferedOperations(std::move(txn_ops), true /* transactional */);
   }
-  return Status::OK();
+  if (!status.ok()) {
+    // Keys of the operations which were not sent should not stay in flight.
+    WARN_NOT_OK(WaitForInFlightOperations(), "Failed to complete in flight operations");
+    return status;
+  }
+  const size_t max_in_flight = std::max(FLAGS_ysql_session_max_in_flight_write_batches, 0);
+  return in_flight_ops_.size() > max_in_flight ? WaitForInFlightOperations() : Status::OK();
+}
+
+Status PgSession::WaitForInFlightOperations() {
+  auto in_flight_ops = std::move(in_flight_ops_);
+  in_flight_ops_.clear();
+  in_flight_keys_.clear();
+  Status result;
+  for (auto& in_flight : in_flight_ops) {
+    auto status = in_flight.result.GetStatus();
+    if (status.ok()) {
+      for (const auto& buffered_op : in_flight.ops) {
+        status = HandleResponse(*buffered_op.operation, buffered_op.relation_id);
+        if (!status.ok()) {
+          break;
+        }
+      }
+    }
+    if (result.ok()) {
+      result = status;
+    }
+  }
+  return result;
 }
 
 bool PgSession::ShouldHandleTransactionally(const client::YBPgsqlOp& op) {
@@ -836,7 +890,7 @@ Result<bool> PgSession::IsInitDbDone() {
   return resp.done() || resp.pg_proc_exists();
 }
 
-Status PgSession::FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional) {
+Status PgSession::SendBufferedOperations(PgsqlOpBuffer ops, bool transactional) {
   DCHECK(ops.size() > 0 && ops.size() <= FLAGS_ysql_session_max_batch_size);
   auto session = VERIFY_RESULT(GetSession(transactional, false /* read_only_op */));
   if (session != session_.get()) {
@@ -853,12 +907,8 @@ Status PgSession::FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool tra
         << ", initdb mode: " << YBCIsInitDbModeEnvVarSet();
     RETURN_NOT_OK(session->Apply(op));
   }
-  const auto status = session->FlushFuture().get();
-  RETURN_NOT_OK(CombineErrorsToStatus(session->GetPendingErrors(), status));
-
-  for (const auto& buffered_op : ops) {
-    RETURN_NOT_OK(HandleResponse(*buffered_op.operation, buffered_op.relation_id));
-  }
+  in_flight_ops_.push_back(InFlightOperations{
+      std::move(ops), PgSessionAsyncRunResult(session->FlushFuture(), session->shared_from_this())});
   return Status::OK();
 }
 
@@ -870,11 +920,45 @@ Result<uint64_t> PgSession::GetSharedCatalogVersion() {
   }
 }
 
-bool PgSession::ForeignKeyReferenceExists(uint32_t table_id, std::string&& ybctid) {
+Result<bool> PgSession::ForeignKeyReferenceExists(
+    uint32_t table_id, std::string&& ybctid, const YbctidReader& reader) {
   PgForeignKeyReference reference = {table_id, std::move(ybctid)};
+  if (fk_reference_cache_.find(reference) != fk_reference_cache_.end()) {
+    return true;
+  }
+
+  // Read the requested row together with other pending references to the same table.
+  const size_t max_batch_size = std::max(FLAGS_ysql_session_max_batch_size, 1);
+  std::vector<std::string> batch;
+  batch.push_back(reference.ybctid);
+  for (const auto& intent : fk_reference_intent_) {
+    if (batch.size() >= max_batch_size) {
+      break;
+    }
+    if (intent.table_id == table_id && intent.ybctid != reference.ybctid) {
+      batch.push_back(intent.ybctid);
+    }
+  }
+  std::vector<Slice> ybctids(batch.begin(), batch.end());
+  auto existing_ybctids = VERIFY_RESULT(reader(table_id, ybctids));
+
+  // References which were not found are left to the regular check, which reports the violation.
+  for (auto& ybctid : batch) {
+    fk_reference_intent_.erase({table_id, std::move(ybctid)});
+  }
+  for (auto& ybctid : existing_ybctids) {
+    fk_reference_cache_.emplace(table_id, std::move(ybctid));
+  }
   return fk_reference_cache_.find(reference) != fk_reference_cache_.end();
 }
 
+void PgSession::AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid) {
+  PgForeignKeyReference reference = {table_id, std::move(ybctid)};
+  if (fk_reference_cache_.find(reference) == fk_reference_cache_.end()) {
+    fk_reference_intent_.emplace(std::move(reference));
+  }
+}
+
 Status PgSession::CacheForeignKeyReference(uint32_t table_id, std::string&& ybctid) {
   PgForeignKeyReference reference = {table_id, std::move(ybctid)};
   fk_reference_cache_.emplace(reference);
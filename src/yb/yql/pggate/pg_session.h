@@ -14,6 +14,7 @@
 #ifndef YB_YQL_PGGATE_PG_SESSION_H_
 #define YB_YQL_PGGATE_PG_SESSION_H_
 
+#include <functional>
 #include <unordered_set>
 
 #include <boost/optional.hpp>
@@ -28,6 +29,7 @@
 
 #include "yb/util/oid_generator.h"
 #include "yb/util/result.h"
+#include "yb/util/slice.h"
 
 #include "yb/yql/pggate/pg_env.h"
 #include "yb/yql/pggate/pg_tabledesc.h"
@@ -185,9 +187,14 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // and collected operations has not been flushed. All ot them will be silently ignored.
   void StartOperationsBuffering();
   // Clean all previously buffered operations (from previous failed query).
-  void ResetOperationsBuffering();
+  // Returns error of operations, that were already sent by the failed query.
+  CHECKED_STATUS ResetOperationsBuffering();
   // Flush all pending operations.
   CHECKED_STATUS FlushBufferedOperations();
+  // Stop operation buffering, but keep transactional operations buffered. They are sent together
+  // with the writes of the following statements when a read needs them, when the buffer is full
+  // or when the transaction commits. Non-transactional operations are flushed.
+  CHECKED_STATUS StopOperationsBuffering();
 
   // Run (apply + flush) the given operation to read and write database content.
   // Template is used here to handle all kind of derived operations
@@ -251,6 +258,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   void InvalidateForeignKeyReferenceCache() {
     fk_reference_cache_.clear();
+    fk_reference_intent_.clear();
   }
 
   // Check if initdb has already been run before. Needed to make initdb idempotent.
@@ -260,9 +268,19 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // the shared memory has not been initialized (e.g. in initdb).
   Result<uint64_t> GetSharedCatalogVersion();
 
-  // Returns true if the row referenced by ybctid exists in FK reference cache (Used for caching
-  // foreign key checks).
-  bool ForeignKeyReferenceExists(uint32_t table_id, std::string&& ybctid);
+  // Reads rows with the given ybctids from the table and returns ybctids of the existing ones.
+  using YbctidReader = std::function<Result<std::vector<std::string>>(
+      uint32_t table_id, const std::vector<Slice>& ybctids)>;
+
+  // Returns true if the row referenced by ybctid exists (Used for caching foreign key checks).
+  // If the row is not in FK reference cache, it is read by the reader in one batch with other
+  // pending references to the same table, and the existing rows are added to the cache.
+  Result<bool> ForeignKeyReferenceExists(
+      uint32_t table_id, std::string&& ybctid, const YbctidReader& reader);
+
+  // Adds the row referenced by ybctid to the pending references, which are checked in batch by
+  // ForeignKeyReferenceExists.
+  void AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid);
 
   // Adds the row referenced by ybctid to FK reference cache.
   CHECKED_STATUS CacheForeignKeyReference(uint32_t table_id, std::string&& ybctid);
@@ -276,8 +294,22 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
       bool use_cache = false);
 
  private:
+  // Batch of buffered write operations sent in background.
+  struct InFlightOperations {
+    PgsqlOpBuffer ops;
+    PgSessionAsyncRunResult result;
+  };
+
+  // Sends buffered operations and waits for them and for all in flight operations to complete.
   CHECKED_STATUS FlushBufferedOperationsImpl();
-  CHECKED_STATUS FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional);
+
+  // Sends buffered operations in background. Waits for in flight operations first if the
+  // ysql_session_max_in_flight_write_batches limit is reached.
+  CHECKED_STATUS SendBufferedOperations();
+  CHECKED_STATUS SendBufferedOperations(PgsqlOpBuffer ops, bool transactional);
+
+  // Waits for all in flight operations and handles their responses.
+  CHECKED_STATUS WaitForInFlightOperations();
 
   // Helper class to run multiple operations on single session.
   // This class allows to keep implementation of RunAsync template method simple
@@ -351,12 +383,17 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   std::unordered_map<TableId, std::shared_ptr<client::YBTable>> table_cache_;
   std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>> fk_reference_cache_;
+  // References to be checked in batch on the next cache miss.
+  std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>>
+      fk_reference_intent_;
 
   // Should write operations be buffered?
   bool buffering_enabled_ = false;
   PgsqlOpBuffer buffered_ops_;
   PgsqlOpBuffer buffered_txn_ops_;
   std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> buffered_keys_;
+  std::vector<InFlightOperations> in_flight_ops_;
+  std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> in_flight_keys_;
 
   const tserver::TServerSharedObject* const tserver_shared_object_;
   const YBCPgCallbacks& pg_callbacks_;
@@ -22,6 +22,7 @@
 #include "yb/yql/pggate/pg_insert.h"
 #include "yb/yql/pggate/pg_update.h"
 #include "yb/yql/pggate/pg_delete.h"
+#include "yb/yql/pggate/pg_doc_op.h"
 #include "yb/yql/pggate/pg_truncate_colocated.h"
 #include "yb/yql/pggate/pg_select.h"
 #include "yb/yql/pggate/pg_txn_manager.h"
@@ -30,6 +31,8 @@
 #include "yb/util/flag_tags.h"
 #include "yb/client/client_fwd.h"
 #include "yb/client/client_utils.h"
+#include "yb/common/pg_system_attr.h"
+#include "yb/common/row_mark.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/secure_stream.h"
 #include "yb/server/secure.h"
@@ -86,6 +89,44 @@ std::unique_ptr<tserver::TServerSharedObject> InitTServerSharedObject() {
       tserver::TServerSharedObject::OpenReadOnly(FLAGS_pggate_tserver_shm_fd)));
 }
 
+// Reads rows with the given ybctids from the table in one batch of requests, one per tablet, and
+// returns ybctids of the rows that exist.
+Result<std::vector<std::string>> FetchExistingYbctids(const PgSession::ScopedRefPtr& session,
+                                                      const PgObjectId& table_id,
+                                                      const std::vector<Slice>& ybctids) {
+  auto table_desc = VERIFY_RESULT(session->LoadTable(table_id));
+  auto read_op = table_desc->NewPgsqlSelect();
+  read_op->mutable_request()->add_targets()->set_column_id(
+      static_cast<int>(PgSystemAttrNum::kYBTupleId));
+  auto doc_op = make_shared<PgDocReadOp>(
+      session, table_desc, table_desc->num_hash_key_columns(), std::move(read_op));
+
+  // Postgres checks foreign keys with SELECT FOR KEY SHARE, so lock the rows the same way.
+  PgExecParameters exec_params;
+  exec_params.limit_count = 0;
+  exec_params.limit_offset = 0;
+  exec_params.limit_use_default = true;
+  exec_params.rowmark = static_cast<int>(RowMarkType::ROW_MARK_KEYSHARE);
+  doc_op->Initialize(&exec_params);
+  RETURN_NOT_OK(doc_op->SetBatchArgYbctid(&ybctids, table_desc.get()));
+  RETURN_NOT_OK(doc_op->Execute());
+
+  std::vector<std::string> result;
+  result.reserve(ybctids.size());
+  std::list<PgDocResult> rowsets;
+  do {
+    rowsets.clear();
+    RETURN_NOT_OK(doc_op->GetResult(&rowsets));
+    for (auto& rowset : rowsets) {
+      RETURN_NOT_OK(rowset.ProcessSystemColumns());
+      for (const auto& ybctid : rowset.ybctids()) {
+        result.push_back(ybctid.ToBuffer());
+      }
+    }
+  } while (!rowsets.empty());
+  return result;
+}
+
 } // namespace
 
 using std::make_shared;
@@ -147,6 +188,15 @@ PgApiImpl::PgApiImpl(const YBCPgTypeEntity *YBCDataTypeArray, int count, YBCPgCa
     type_map_[type_entity->type_oid] = type_entity;
   }
 
+  // Calls to the local tserver go through shared memory, when it provides channels for them.
+  // The client recognizes the local tserver by its uuid, stored in the shared memory segment.
+  if (tserver_shared_object_ && FLAGS_pggate_tserver_rpc_shm_fd != -1) {
+    auto status = messenger_holder_.messenger->ConnectSharedMemory(FLAGS_pggate_tserver_rpc_shm_fd);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to connect to shared memory RPC channels: " << status;
+    }
+  }
+
   async_client_init_.Start();
 }
 
@@ -684,14 +734,18 @@ void PgApiImpl::StartOperationsBuffering() {
   pg_session_->StartOperationsBuffering();
 }
 
-void PgApiImpl::ResetOperationsBuffering() {
-  pg_session_->ResetOperationsBuffering();
+Status PgApiImpl::ResetOperationsBuffering() {
+  return pg_session_->ResetOperationsBuffering();
 }
 
 Status PgApiImpl::FlushBufferedOperations() {
   return pg_session_->FlushBufferedOperations();
 }
 
+Status PgApiImpl::StopOperationsBuffering() {
+  return pg_session_->StopOperationsBuffering();
+}
+
 Status PgApiImpl::DmlExecWriteOp(PgStatement *handle, int32_t *rows_affected_count) {
   switch (handle->stmt_op()) {
     case StmtOp::STMT_INSERT:
@@ -982,8 +1036,17 @@ Status PgApiImpl::ExitSeparateDdlTxnMode(bool success) {
   return pg_txn_manager_->ExitSeparateDdlTxnMode(success);
 }
 
-bool PgApiImpl::ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid) {
-  return pg_session_->ForeignKeyReferenceExists(table_id, std::move(ybctid));
+Result<bool> PgApiImpl::ForeignKeyReferenceExists(
+    YBCPgOid database_id, YBCPgOid table_id, std::string&& ybctid) {
+  return pg_session_->ForeignKeyReferenceExists(
+      table_id, std::move(ybctid),
+      [this, database_id](YBCPgOid table_id, const std::vector<Slice>& ybctids) {
+        return FetchExistingYbctids(pg_session_, PgObjectId(database_id, table_id), ybctids);
+      });
+}
+
+void PgApiImpl::AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid) {
+  pg_session_->AddForeignKeyReferenceIntent(table_id, std::move(ybctid));
 }
 
 Status PgApiImpl::CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid) {
@@ -318,8 +318,9 @@ class PgApiImpl {
 
   // Buffer write operations.
   void StartOperationsBuffering();
-  void ResetOperationsBuffering();
+  CHECKED_STATUS ResetOperationsBuffering();
   CHECKED_STATUS FlushBufferedOperations();
+  CHECKED_STATUS StopOperationsBuffering();
 
   //------------------------------------------------------------------------------------------------
   // Insert.
@@ -412,7 +413,9 @@ class PgApiImpl {
   CHECKED_STATUS OperatorAppendArg(PgExpr *op_handle, PgExpr *arg);
 
   // Foreign key reference caching.
-  bool ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid);
+  Result<bool> ForeignKeyReferenceExists(
+      YBCPgOid database_id, YBCPgOid table_id, std::string&& ybctid);
+  void AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS DeleteForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   void ClearForeignKeyReferenceCache();
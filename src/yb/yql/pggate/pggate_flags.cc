@@ -42,6 +42,9 @@ DEFINE_string(pggate_master_addresses, "",
 DEFINE_int32(pggate_tserver_shm_fd, -1,
               "File descriptor of the local tablet server's shared memory.");
 
+DEFINE_int32(pggate_tserver_rpc_shm_fd, -1,
+             "File descriptor of the local tablet server's shared memory RPC channels.");
+
 DEFINE_test_flag(bool, pggate_ignore_tserver_shm, false,
               "Ignore the shared memory of the local tablet server.");
 
@@ -58,6 +61,12 @@ DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
 
+DEFINE_int32(ysql_session_max_in_flight_write_batches, 2,
+             "Maximum number of batches of buffered writes which are sent in background while "
+             "the statement continues execution. Reads, writes to a row of an in flight batch and "
+             "the end of the statement wait for the batches to complete. 0 means that buffered "
+             "writes are flushed synchronously when the batch size limit is reached.");
+
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
@@ -463,14 +463,18 @@ void YBCPgStartOperationsBuffering() {
   return pgapi->StartOperationsBuffering();
 }
 
-void YBCPgResetOperationsBuffering() {
-  return pgapi->ResetOperationsBuffering();
+YBCStatus YBCPgResetOperationsBuffering() {
+  return ToYBCStatus(pgapi->ResetOperationsBuffering());
 }
 
 YBCStatus YBCPgFlushBufferedOperations() {
   return ToYBCStatus(pgapi->FlushBufferedOperations());
 }
 
+YBCStatus YBCPgStopOperationsBuffering() {
+  return ToYBCStatus(pgapi->StopOperationsBuffering());
+}
+
 YBCStatus YBCPgDmlExecWriteOp(YBCPgStatement handle, int32_t *rows_affected_count) {
   return ToYBCStatus(pgapi->DmlExecWriteOp(handle, rows_affected_count));
 }
@@ -650,8 +654,21 @@ YBCStatus YBCPgExitSeparateDdlTxnMode(bool success) {
 }
 
 // Referential Integrity Caching
-bool YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
-  return pgapi->ForeignKeyReferenceExists(table_id, std::string(ybctid, ybctid_size));
+YBCStatus YBCForeignKeyReferenceExists(YBCPgOid database_id, YBCPgOid table_id,
+                                       const char* ybctid, int64_t ybctid_size, bool* exists) {
+  auto result = pgapi->ForeignKeyReferenceExists(
+      database_id, table_id, std::string(ybctid, ybctid_size));
+  if (!result.ok()) {
+    return ToYBCStatus(result.status());
+  }
+  *exists = *result;
+  return YBCStatusOK();
+}
+
+YBCStatus YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid,
+                                          int64_t ybctid_size) {
+  pgapi->AddForeignKeyReferenceIntent(table_id, std::string(ybctid, ybctid_size));
+  return YBCStatusOK();
 }
 
 YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
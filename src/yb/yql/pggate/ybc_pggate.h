@@ -305,8 +305,9 @@ YBCStatus YBCPgDmlBuildYBTupleId(YBCPgStatement handle, const YBCPgAttrValueDesc
 
 // Buffer write operations.
 void YBCPgStartOperationsBuffering();
-void YBCPgResetOperationsBuffering();
+YBCStatus YBCPgResetOperationsBuffering();
 YBCStatus YBCPgFlushBufferedOperations();
+YBCStatus YBCPgStopOperationsBuffering();
 
 // INSERT ------------------------------------------------------------------------------------------
 YBCStatus YBCPgNewInsert(YBCPgOid database_oid,
@@ -392,8 +393,14 @@ YBCStatus YBCPgNewOperator(YBCPgStatement stmt, const char *opname,
 YBCStatus YBCPgOperatorAppendArg(YBCPgExpr op_handle, YBCPgExpr arg);
 
 // Referential Integrity Check Caching.
-// Check if foreign key reference exists in cache.
-bool YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
+// Check if foreign key reference exists. References missing from cache are read in one batch
+// with the pending references to the same table.
+YBCStatus YBCForeignKeyReferenceExists(YBCPgOid database_id, YBCPgOid table_id,
+                                       const char* ybctid, int64_t ybctid_size, bool* exists);
+
+// Add a reference to be checked in batch by YBCForeignKeyReferenceExists.
+YBCStatus YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid,
+                                          int64_t ybctid_size);
 
 // Add an entry to foreign key reference cache.
 YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
@@ -24,6 +24,7 @@
 #include "yb/tserver/tablet_server.h"
 
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pgwrapper/libpq_utils.h"
 #include "yb/yql/pgwrapper/pg_wrapper.h"
@@ -47,6 +48,10 @@ DECLARE_int64(retryable_rpc_single_call_timeout_ms);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
+DECLARE_int32(TEST_write_delay_ms);
+
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_Read);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_MultiRead);
 
 namespace yb {
 namespace pgwrapper {
@@ -714,10 +719,136 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ForeignKeySnapshot)) {
   TestForeignKey(IsolationLevel::SNAPSHOT_ISOLATION);
 }
 
+// Referenced rows of a multi-row insert are checked in batches.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ForeignKeyBulkInsert)) {
+  constexpr int kParentRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE parent (id INT PRIMARY KEY)"));
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE child (id INT PRIMARY KEY, parent_id INT REFERENCES parent)"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO parent SELECT generate_series(1, $0)", kParentRows));
+
+  // The child insert does not read any user table other than parent, so read RPCs received by
+  // tablet servers are FK checks.
+  auto read_rpcs = [this] {
+    uint64_t result = 0;
+    for (const auto& mini_tserver : cluster_->mini_tablet_servers()) {
+      const auto& metric_entity = mini_tserver->server()->metric_entity();
+      result += METRIC_handler_latency_yb_tserver_TabletServerService_Read.Instantiate(
+          metric_entity)->TotalCount();
+      result += METRIC_handler_latency_yb_tserver_TabletServerService_MultiRead.Instantiate(
+          metric_entity)->TotalCount();
+    }
+    return result;
+  };
+
+  auto start = MonoTime::Now();
+  auto read_rpcs_before = read_rpcs();
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, (i % $0) + 1 FROM generate_series(1, $1) AS i",
+      kParentRows, kParentRows * 5));
+  auto fk_read_rpcs = read_rpcs() - read_rpcs_before;
+  auto finish = MonoTime::Now();
+  LOG(INFO) << "Time: " << finish - start << ", FK check read RPCs: " << fk_read_rpcs;
+  // Checked one by one, every referenced parent row would need its own read RPC.
+  ASSERT_LT(fk_read_rpcs, kParentRows / 10U);
+
+  auto status = conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, i FROM generate_series($0, $1) AS i",
+      kParentRows * 5 + 1, kParentRows * 5 + 10);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "violates foreign key constraint");
+
+  auto count = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM child"));
+  ASSERT_EQ(count, kParentRows * 5);
+}
+
 // ------------------------------------------------------------------------------------------------
 // A test performing manual transaction control on system tables.
 // ------------------------------------------------------------------------------------------------
 
+class PgMiniTestSmallWriteBatch : public PgMiniTest {
+ protected:
+  static constexpr int kWriteBatchSize = 10;
+
+  void BeforePgProcessStart() override {
+    FLAGS_ysql_session_max_batch_size = kWriteBatchSize;
+    FLAGS_ysql_session_max_in_flight_write_batches = 2;
+  }
+};
+
+// Full write batches of a statement are sent in background while the statement continues, and
+// errors of those batches fail the statement.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(InFlightWriteBatches), PgMiniTestSmallWriteBatch) {
+  constexpr int kBatches = 12;
+  constexpr int kRows = kBatches * kWriteBatchSize;
+  constexpr int kWriteDelayMs = 500;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE t2 (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t2 VALUES ($0, 0)", kRows / 2));
+
+  FLAGS_TEST_write_delay_ms = kWriteDelayMs;
+  auto start = MonoTime::Now();
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i FROM generate_series(1, $0) AS i", kRows));
+  auto elapsed = MonoTime::Now() - start;
+  LOG(INFO) << "Time: " << elapsed;
+  // Every write RPC is delayed, so sending the batches one after another would take at least
+  // kBatches delays.
+  ASSERT_LT(elapsed, MonoDelta::FromMilliseconds(kBatches * kWriteDelayMs * 3 / 4));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kRows);
+
+  // The duplicate key is in a batch that is still in flight when the following batches are sent.
+  auto status = conn.ExecuteFormat(
+      "INSERT INTO t2 SELECT i, i FROM generate_series(1, $0) AS i", kRows);
+  FLAGS_TEST_write_delay_ms = 0;
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "duplicate key value");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t2")), 1);
+}
+
+// In a transaction block, writes of a statement stay buffered until a read needs them, the buffer
+// is full or the transaction commits, so a loop of single-row inserts is sent in batches.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(SingleRowInsertsInTransactionBlock),
+          PgMiniTestSmallWriteBatch) {
+  constexpr int kBatches = 4;
+  constexpr int kRows = kBatches * kWriteBatchSize;
+  constexpr int kWriteDelayMs = 500;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+
+  FLAGS_TEST_write_delay_ms = kWriteDelayMs;
+  auto start = MonoTime::Now();
+  ASSERT_OK(conn.Execute("BEGIN"));
+  for (int i = 1; i <= kRows; ++i) {
+    ASSERT_OK(conn.ExecuteFormat("INSERT INTO t VALUES ($0, $0)", i));
+  }
+  ASSERT_OK(conn.Execute("COMMIT"));
+  auto elapsed = MonoTime::Now() - start;
+  FLAGS_TEST_write_delay_ms = 0;
+  LOG(INFO) << "Time: " << elapsed;
+  // Waiting for the write of every statement would take kRows delays.
+  ASSERT_LT(elapsed, MonoDelta::FromMilliseconds(kRows * kWriteDelayMs / 4));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kRows);
+
+  // Buffered writes are sent before a read of the same transaction.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t VALUES ($0, 0)", kRows + 1));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kRows + 1);
+
+  // The duplicate key is sent by the commit, which fails and rolls back the transaction.
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t VALUES ($0, 0)", kRows + 2));
+  ASSERT_OK(conn.Execute("INSERT INTO t VALUES (1, 0)"));
+  auto status = conn.Execute("COMMIT");
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "duplicate key value");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kRows);
+}
+
 class PgMiniTestManualSysTableTxn : public PgMiniTest {
   virtual void BeforePgProcessStart() {
     // Enable manual transaction control for operations on system tables. Otherwise, they would
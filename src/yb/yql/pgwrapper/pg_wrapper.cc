@@ -302,6 +302,9 @@ Status PgWrapper::Start() {
   pg_proc_->ShareParentStdout();
   pg_proc_->SetParentDeathSignal(SIGINT);
   pg_proc_->InheritNonstandardFd(conf_.tserver_shm_fd);
+  if (conf_.tserver_rpc_shm_fd != -1) {
+    pg_proc_->InheritNonstandardFd(conf_.tserver_rpc_shm_fd);
+  }
   SetCommonEnv(&pg_proc_.get(), /* yb_enabled */ true);
   RETURN_NOT_OK(pg_proc_->Start());
   LOG(INFO) << "PostgreSQL server running as pid " << pg_proc_->pid();
@@ -416,6 +419,7 @@ void PgWrapper::SetCommonEnv(Subprocess* proc, bool yb_enabled) {
     proc->SetEnv("YB_ENABLED_IN_POSTGRES", "1");
     proc->SetEnv("FLAGS_pggate_master_addresses", conf_.master_addresses);
     proc->SetEnv("FLAGS_pggate_tserver_shm_fd", std::to_string(conf_.tserver_shm_fd));
+    proc->SetEnv("FLAGS_pggate_tserver_rpc_shm_fd", std::to_string(conf_.tserver_rpc_shm_fd));
     // Postgres process can't compute default certs dir by itself
     // as it knows nothing about t-server's root data directory.
     // Solution is to specify it explicitly.
@@ -437,6 +441,7 @@ void PgWrapper::SetCommonEnv(Subprocess* proc, bool yb_enabled) {
     // Pass non-default flags to the child process using FLAGS_... environment variables.
     static const std::vector<string> explicit_flags{"pggate_master_addresses",
                                                     "pggate_tserver_shm_fd",
+                                                    "pggate_tserver_rpc_shm_fd",
                                                     "certs_dir",
                                                     "certs_for_client_dir"};
     std::vector<google::CommandLineFlagInfo> flag_infos;
@@ -40,6 +40,7 @@
 
 #include "yb/yql/redis/redisserver/redis_constants.h"
 #include "yb/yql/redis/redisserver/redis_encoding.h"
+#include "yb/yql/redis/redisserver/redis_parser.h"
 #include "yb/yql/redis/redisserver/redis_rpc.h"
 
 using namespace std::literals;
@@ -71,7 +72,7 @@ namespace redisserver {
 
 #define REDIS_COMMANDS \
     ((get, Get, 2, READ)) \
-    ((mget, MGet, -2, READ)) \
+    ((mget, MGet, -2, MULTI_READ)) \
     ((hget, HGet, 3, READ)) \
     ((tsget, TsGet, 3, READ)) \
     ((hmget, HMGet, -3, READ)) \
@@ -90,7 +91,7 @@ namespace redisserver {
     ((zcard, ZCard, 2, READ)) \
     ((rename, Rename, 3, LOCAL)) \
     ((set, Set, -3, WRITE)) \
-    ((mset, MSet, -3, WRITE)) \
+    ((mset, MSet, -3, MULTI_WRITE)) \
     ((hset, HSet, 4, WRITE)) \
     ((hmset, HMSet, -4, WRITE)) \
     ((hincrby, HIncrBy, 4, WRITE)) \
@@ -164,6 +165,8 @@ BOOST_PP_SEQ_FOR_EACH(DEFINE_HISTOGRAM, ~, REDIS_COMMANDS)
 
 #define READ_OP yb::client::YBRedisReadOp
 #define WRITE_OP yb::client::YBRedisWriteOp
+#define MULTI_READ_OP MultiKeyOps<yb::client::YBRedisReadOp>
+#define MULTI_WRITE_OP MultiKeyOps<yb::client::YBRedisWriteOp>
 #define LOCAL_OP RedisResponsePB
 #define CLUSTER_OP RedisResponsePB
 
@@ -211,10 +214,37 @@ void Command(
   context->Apply(idx, std::move(op), info.metrics);
 }
 
+template<class Op>
+void MultiKeyCommand(
+    const RedisCommandInfo& info,
+    size_t idx,
+    Parser<MultiKeyOps<Op>> parser,
+    BatchContext* context) {
+  VLOG(1) << "Processing " << info.name << ".";
+
+  MultiKeyOps<Op> ops;
+  ops.table = context->table();
+  if (!ops.table) {
+    RespondWithFailure(context->call(), idx, "Could not open YBTable");
+    return;
+  }
+
+  Status s = parser(&ops, context->command(idx));
+  if (!s.ok()) {
+    RespondWithFailure(context->call(), idx, s.message().ToBuffer());
+    return;
+  }
+  context->Apply(idx, std::move(ops.ops), info.metrics);
+}
+
 #define READ_COMMAND(cname) \
     Command<yb::client::YBRedisReadOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
 #define WRITE_COMMAND(cname) \
     Command<yb::client::YBRedisWriteOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
+#define MULTI_READ_COMMAND(cname) \
+    MultiKeyCommand<yb::client::YBRedisReadOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
+#define MULTI_WRITE_COMMAND(cname) \
+    MultiKeyCommand<yb::client::YBRedisWriteOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
 #define LOCAL_COMMAND(cname) \
     BOOST_PP_CAT(Handle, cname)({info, idx, context});
 #define CLUSTER_COMMAND(cname) ClusterCommand(info, idx, context)
@@ -98,6 +98,18 @@ class BatchContext : public RefCountedThreadSafe<BatchContext> {
       std::shared_ptr<client::YBRedisWriteOp> operation,
       const rpc::RpcMethodMetrics& metrics) = 0;
 
+  // Operations of a multi-key command are batched with other operations of their tablets, and
+  // the command is responded when all of them are done.
+  virtual void Apply(
+      size_t index,
+      std::vector<std::shared_ptr<client::YBRedisReadOp>> operations,
+      const rpc::RpcMethodMetrics& metrics) = 0;
+
+  virtual void Apply(
+      size_t index,
+      std::vector<std::shared_ptr<client::YBRedisWriteOp>> operations,
+      const rpc::RpcMethodMetrics& metrics) = 0;
+
   virtual void Apply(
       size_t index,
       std::function<bool(client::YBSession*, const StatusFunctor&)> functor,
@@ -166,13 +166,15 @@ CHECKED_STATUS ParseSetNX(YBRedisWriteOp *op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
-// TODO: support MSET
-CHECKED_STATUS ParseMSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
+CHECKED_STATUS ParseMSet(MultiKeyOps<YBRedisWriteOp>* ops, const RedisClientCommand& args) {
   if (args.size() < 3 || args.size() % 2 == 0) {
     return STATUS_SUBSTITUTE(InvalidCommand,
         "An MSET request must have at least 3, odd number of arguments, found $0", args.size());
   }
-  return STATUS(InvalidCommand, "MSET command not yet supported");
+  for (size_t i = 1; i < args.size(); i += 2) {
+    RETURN_NOT_OK(ParseSet(ops->Add(), RedisClientCommand{args[0], args[i], args[i + 1]}));
+  }
+  return Status::OK();
 }
 
 CHECKED_STATUS ParseHSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
@@ -532,9 +534,11 @@ CHECKED_STATUS ParseHGetLikeCommands(YBRedisReadOp* op, const RedisClientCommand
   return ParseCollection(op, args, boost::none, add_string_subkey, remove_duplicates);
 }
 
-// TODO: Support MGET
-CHECKED_STATUS ParseMGet(YBRedisReadOp* op, const RedisClientCommand& args) {
-  return STATUS(InvalidCommand, "MGET command not yet supported");
+CHECKED_STATUS ParseMGet(MultiKeyOps<YBRedisReadOp>* ops, const RedisClientCommand& args) {
+  for (size_t i = 1; i != args.size(); ++i) {
+    RETURN_NOT_OK(ParseGet(ops->Add(), RedisClientCommand{args[0], args[i]}));
+  }
+  return Status::OK();
 }
 
 CHECKED_STATUS ParseHGet(YBRedisReadOp* op, const RedisClientCommand& args) {
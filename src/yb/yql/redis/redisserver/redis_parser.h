@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/container/small_vector.hpp>
 
@@ -37,6 +38,23 @@ constexpr int64_t kNoneTtl = -1;
 CHECKED_STATUS ParseSet(client::YBRedisWriteOp *op, const RedisClientCommand& args);
 CHECKED_STATUS ParseGet(client::YBRedisReadOp* op, const RedisClientCommand& args);
 
+// Operations of a multi-key command like MGET or MSET, one operation per key.
+template <class Op>
+struct MultiKeyOps {
+  std::shared_ptr<client::YBTable> table;
+  std::vector<std::shared_ptr<Op>> ops;
+
+  Op* Add() {
+    ops.push_back(std::make_shared<Op>(table));
+    return ops.back().get();
+  }
+};
+
+CHECKED_STATUS ParseMSet(
+    MultiKeyOps<client::YBRedisWriteOp>* ops, const RedisClientCommand& args);
+CHECKED_STATUS ParseMGet(
+    MultiKeyOps<client::YBRedisReadOp>* ops, const RedisClientCommand& args);
+
 // TODO: make additional command support here
 
 // RedisParser is a finite state machine with memory.
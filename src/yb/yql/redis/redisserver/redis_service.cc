@@ -165,19 +165,82 @@ OperationType Opposite(OperationType type) {
   FATAL_INVALID_ENUM_VALUE(OperationType, type);
 }
 
+// Collects results of the operations of a multi-key command, like MGET or MSET, that are
+// executed in the blocks of their tablets. The command is responded when the last one is done.
+class MultiKeyResponse {
+ public:
+  MultiKeyResponse(OperationType type, size_t num_operations)
+      : type_(type), elements_(type == OperationType::kRead ? num_operations : 0),
+        operations_left_(num_operations) {
+  }
+
+  // Returns true if it was the last operation of the command.
+  bool OperationDone(size_t sub_index, const Status& status, const RedisResponsePB* response) {
+    if (!status.ok()) {
+      SetStatus(status);
+    } else if (type_ == OperationType::kRead) {
+      // As in Redis, MGET returns nil for keys that do not hold a string value.
+      elements_[sub_index] =
+          response->code() == RedisResponsePB_RedisStatusCode_OK &&
+          response->has_string_response()
+              ? EncodeAsBulkString(response->string_response()).ToBuffer()
+              : kNilResponse;
+    } else if (response->code() != RedisResponsePB_RedisStatusCode_OK) {
+      SetStatus(STATUS(RuntimeError, response->error_message()));
+    }
+    return operations_left_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  void Respond(RedisInboundCall* call, size_t index, const rpc::RpcMethodMetrics& metrics) {
+    if (!status_.ok()) {
+      call->RespondFailure(index, status_);
+      return;
+    }
+    RedisResponsePB response;
+    response.set_code(RedisResponsePB_RedisStatusCode_OK);
+    if (type_ == OperationType::kRead) {
+      auto* array_response = response.mutable_array_response();
+      for (auto& element : elements_) {
+        array_response->add_elements(std::move(element));
+      }
+      array_response->set_encoded(true);
+    }
+    call->RespondSuccess(index, metrics, &response);
+  }
+
+ private:
+  void SetStatus(const Status& status) {
+    std::lock_guard<simple_spinlock> lock(status_mutex_);
+    if (status_.ok()) {
+      status_ = status;
+    }
+  }
+
+  const OperationType type_;
+  // Encoded values for a read command, filled by the operations at their sub indexes.
+  std::vector<std::string> elements_;
+  simple_spinlock status_mutex_;
+  Status status_;
+  std::atomic<size_t> operations_left_;
+};
+
 class Operation {
  public:
   template <class Op>
   Operation(const std::shared_ptr<RedisInboundCall>& call,
             size_t index,
             std::shared_ptr<Op> operation,
-            const rpc::RpcMethodMetrics& metrics)
+            const rpc::RpcMethodMetrics& metrics,
+            std::shared_ptr<MultiKeyResponse> multi_key_response = nullptr,
+            size_t sub_index = 0)
     : type_(std::is_same<Op, YBRedisReadOp>::value ? OperationType::kRead : OperationType::kWrite),
       call_(call),
       index_(index),
       operation_(std::move(operation)),
       metrics_(metrics),
-      manual_response_(ManualResponse::kFalse) {
+      manual_response_(ManualResponse::kFalse),
+      multi_key_response_(std::move(multi_key_response)),
+      sub_index_(sub_index) {
     auto status = operation_->GetPartitionKey(&partition_key_);
     if (!status.ok()) {
       Respond(status);
@@ -303,6 +366,13 @@ class Operation {
       return;
     }
 
+    if (multi_key_response_) {
+      if (multi_key_response_->OperationDone(sub_index_, status, &response())) {
+        multi_key_response_->Respond(call_.get(), index_, metrics_);
+      }
+      return;
+    }
+
     if (status.ok()) {
       if (operation_) {
         call_->RespondSuccess(index_, metrics_, &response());
@@ -331,6 +401,9 @@ class Operation {
   std::string partition_key_;
   rpc::RpcMethodMetrics metrics_;
   ManualResponse manual_response_;
+  // Set when this operation is one of the operations of a multi-key command.
+  std::shared_ptr<MultiKeyResponse> multi_key_response_;
+  size_t sub_index_ = 0;
   client::internal::RemoteTabletPtr tablet_;
   std::atomic<bool> responded_{false};
 };
@@ -903,6 +976,20 @@ class BatchContextImpl : public BatchContext {
     DoApply(index, std::move(operation), metrics);
   }
 
+  void Apply(
+      size_t index,
+      std::vector<std::shared_ptr<client::YBRedisReadOp>> operations,
+      const rpc::RpcMethodMetrics& metrics) override {
+    DoApplyMultiKey(OperationType::kRead, index, std::move(operations), metrics);
+  }
+
+  void Apply(
+      size_t index,
+      std::vector<std::shared_ptr<client::YBRedisWriteOp>> operations,
+      const rpc::RpcMethodMetrics& metrics) override {
+    DoApplyMultiKey(OperationType::kWrite, index, std::move(operations), metrics);
+  }
+
   void Apply(
       size_t index,
       std::function<bool(client::YBSession*, const StatusFunctor&)> functor,
@@ -927,6 +1014,16 @@ class BatchContextImpl : public BatchContext {
     }
   }
 
+  template <class Op>
+  void DoApplyMultiKey(
+      OperationType type, size_t index, std::vector<std::shared_ptr<Op>> operations,
+      const rpc::RpcMethodMetrics& metrics) {
+    auto response = std::make_shared<MultiKeyResponse>(type, operations.size());
+    for (size_t i = 0; i != operations.size(); ++i) {
+      DoApply(index, std::move(operations[i]), metrics, response, i);
+    }
+  }
+
   void LookupDone(
       Operation* operation, int retries, const Result<client::internal::RemoteTabletPtr>& result) {
     const int kMaxRetries = 2;
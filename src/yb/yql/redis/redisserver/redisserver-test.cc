@@ -58,6 +58,8 @@ DECLARE_int32(redis_service_yb_client_timeout_millis);
 DECLARE_int32(redis_max_value_size);
 DECLARE_int32(redis_max_command_size);
 DECLARE_int32(redis_password_caching_duration_ms);
+DECLARE_int32(redis_packed_collection_max_cardinality);
+DECLARE_int32(redis_sorted_set_scan_max_cardinality);
 DECLARE_int32(rpc_max_message_size);
 DECLARE_int32(consensus_max_batch_size_bytes);
 DECLARE_int32(consensus_rpc_timeout_ms);
@@ -3565,6 +3567,109 @@ TEST_F(TestRedisService, TestSortedSets) {
   DoRedisTestArray(__LINE__, {"ZRANGEBYSCORE", "my_z_set", "1", "1"}, {"v1"});
 }
 
+// Tests that ZADD and ZREM with several members give the same results whether scores are read with
+// a single scan of a small sorted set or looked up one member at a time.
+TEST_F(TestRedisService, TestSortedSetScanMaxCardinality) {
+  FLAGS_redis_sorted_set_scan_max_cardinality = 3;
+
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "1", "v1", "2", "v2", "3", "v3"}, 3);
+  SyncClient();
+  // 3 members, so scores are read with a single scan.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "CH", "10", "v1", "2", "v2", "4", "v4"}, 2);
+  SyncClient();
+  // 4 members, so scores are looked up one member at a time.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "CH", "20", "v1", "3", "v3", "5", "v5"}, 2);
+  SyncClient();
+  DoRedisTestScoreValueArray(__LINE__, {"ZRANGEBYSCORE", "z_key", "-inf", "+inf", "WITHSCORES"},
+      {2.0, 3.0, 4.0, 5.0, 20.0}, {"v2", "v3", "v4", "v5", "v1"});
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, 5);
+
+  // 5 members, so scores are looked up one member at a time.
+  DoRedisTestInt(__LINE__, {"ZREM", "z_key", "v1", "v2", "v9"}, 2);
+  SyncClient();
+  // 3 members, so scores are read with a single scan.
+  DoRedisTestInt(__LINE__, {"ZREM", "z_key", "v3", "v4", "v9"}, 2);
+  SyncClient();
+  DoRedisTestScoreValueArray(__LINE__, {"ZRANGEBYSCORE", "z_key", "-inf", "+inf", "WITHSCORES"},
+      {5.0}, {"v5"});
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, 1);
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
+// Tests that small sorted sets and hashes, which are packed in a single value, give the same
+// results as before and after they grow past the packing threshold and are converted.
+TEST_F(TestRedisService, TestPackedCollectionMaxCardinality) {
+  FLAGS_redis_packed_collection_max_cardinality = 3;
+
+  // Packed sorted set.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "1", "v1", "2", "v2", "3", "v3"}, 3);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "CH", "10", "v1", "2", "v2"}, 1);
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "XX", "4", "v4"}, 0);
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "NX", "5", "v3"}, 0);
+  SyncClient();
+  DoRedisTestScoreValueArray(__LINE__, {"ZRANGE", "z_key", "0", "-1", "WITHSCORES"},
+      {2.0, 3.0, 10.0}, {"v2", "v3", "v1"});
+  DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_key", "0", "1"}, {"v1", "v3"});
+  DoRedisTestArray(__LINE__, {"ZRANGEBYSCORE", "z_key", "(2", "10", "LIMIT", "1", "1"}, {"v1"});
+  DoRedisTestDouble(__LINE__, {"ZSCORE", "z_key", "v1"}, 10.0);
+  DoRedisTestNull(__LINE__, {"ZSCORE", "z_key", "v4"});
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, 3);
+  DoRedisTestInt(__LINE__, {"ZREM", "z_key", "v2", "v9"}, 1);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, 2);
+
+  // 4 members, so the sorted set is converted.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "1", "v2", "4", "v4", "5", "v5"}, 3);
+  SyncClient();
+  DoRedisTestScoreValueArray(__LINE__, {"ZRANGEBYSCORE", "z_key", "-inf", "+inf", "WITHSCORES"},
+      {1.0, 3.0, 4.0, 5.0, 10.0}, {"v2", "v3", "v4", "v5", "v1"});
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, 5);
+  DoRedisTestInt(__LINE__, {"ZREM", "z_key", "v1", "v2", "v3", "v9"}, 3);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_key", "0", "-1"}, {"v4", "v5"});
+  DoRedisTestDouble(__LINE__, {"ZSCORE", "z_key", "v5"}, 5.0);
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, 2);
+
+  // Packed hash.
+  DoRedisTestInt(__LINE__, {"HSET", "h_key", "f1", "a"}, 1);
+  SyncClient();
+  DoRedisTestOk(__LINE__, {"HMSET", "h_key", "f2", "b", "f3", "c"});
+  DoRedisTestInt(__LINE__, {"HSET", "h_key", "f1", "x"}, 0);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"HGETALL", "h_key"}, {"f1", "x", "f2", "b", "f3", "c"});
+  DoRedisTestResultsArray(__LINE__, {"HMGET", "h_key", "f2", "f9"},
+      {RedisReply(RedisReplyType::kString, "b"), RedisReply()});
+  DoRedisTestBulkString(__LINE__, {"HGET", "h_key", "f3"}, "c");
+  DoRedisTestNull(__LINE__, {"HGET", "h_key", "f9"});
+  DoRedisTestInt(__LINE__, {"HEXISTS", "h_key", "f2"}, 1);
+  DoRedisTestInt(__LINE__, {"HEXISTS", "h_key", "f9"}, 0);
+  DoRedisTestInt(__LINE__, {"HSTRLEN", "h_key", "f1"}, 1);
+  DoRedisTestInt(__LINE__, {"HLEN", "h_key"}, 3);
+  DoRedisTestInt(__LINE__, {"HDEL", "h_key", "f2", "f9"}, 1);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"HINCRBY", "h_key", "f4", "5"}, 5);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"HKEYS", "h_key"}, {"f1", "f3", "f4"});
+
+  // 4 fields, so the hash is converted.
+  DoRedisTestInt(__LINE__, {"HINCRBY", "h_key", "f5", "7"}, 7);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"HINCRBY", "h_key", "f4", "1"}, 6);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"HGETALL", "h_key"},
+      {"f1", "x", "f3", "c", "f4", "6", "f5", "7"});
+  DoRedisTestInt(__LINE__, {"HDEL", "h_key", "f1", "f3", "f9"}, 2);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"HVALS", "h_key"}, {"6", "7"});
+  DoRedisTestInt(__LINE__, {"HLEN", "h_key"}, 2);
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, ZRangeByScoreInvalidOptions) {
   expected_no_sessions_ = true;
 
@@ -4352,6 +4457,32 @@ TEST_F(TestRedisService, TestSetNX) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestMultiKeyCommands) {
+  DoRedisTestOk(__LINE__, {"MSET", "mkey1", "v1", "mkey2", "v2", "mkey3", "v3"});
+  DoRedisTestInt(__LINE__, {"HSET", "mmap", "subkey", "v"}, 1);
+
+  SyncClient();
+
+  DoRedisTestResultsArray(
+      __LINE__, {"MGET", "mkey3", "mkey_absent", "mkey1", "mmap", "mkey2", "mkey1"},
+      {RedisReply(RedisReplyType::kString, "v3"), RedisReply(),
+       RedisReply(RedisReplyType::kString, "v1"), RedisReply(),
+       RedisReply(RedisReplyType::kString, "v2"), RedisReply(RedisReplyType::kString, "v1")});
+
+  // Pipelined multi-key commands should see the effect of preceding commands.
+  DoRedisTestOk(__LINE__, {"MSET", "mkey1", "w1", "mkey4", "w4"});
+  DoRedisTestResultsArray(
+      __LINE__, {"MGET", "mkey1", "mkey4"},
+      {RedisReply(RedisReplyType::kString, "w1"), RedisReply(RedisReplyType::kString, "w4")});
+
+  SyncClient();
+
+  DoRedisTestExpectError(__LINE__, {"MSET", "mkey1", "v1", "mkey2"});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestAdditionalCommands) {
 
   // The default value is true, but we explicitly set this here for clarity.
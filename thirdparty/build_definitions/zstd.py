@@ -0,0 +1,35 @@
+#
+# Copyright (c) YugaByte, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under the License
+# is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+# or implied. See the License for the specific language governing permissions and limitations
+# under the License.
+#
+
+import os
+import sys
+
+sys.path.append(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from build_definitions import *
+
+class ZStdDependency(Dependency):
+    def __init__(self):
+        super(ZStdDependency, self).__init__(
+                'zstd', '1.4.4', 'https://github.com/facebook/zstd/archive/v{0}.tar.gz',
+                BUILD_GROUP_COMMON)
+        self.copy_sources = False
+
+    def build(self, builder):
+        builder.build_with_cmake(self,
+                                 ['-DCMAKE_BUILD_TYPE=release',
+                                  '-DZSTD_BUILD_PROGRAMS=OFF',
+                                  '-DZSTD_BUILD_TESTS=OFF',
+                                  '-DCMAKE_INSTALL_PREFIX:PATH={}'.format(builder.prefix)],
+                                 src_dir='build/cmake')